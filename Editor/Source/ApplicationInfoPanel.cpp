@@ -1,4 +1,6 @@
 #include "ApplicationInfoPanel.h"
+#include "Editor.h"
+#include "ResourcePanel.h"
 
 #include <Lumos/Core/Application.h>
 #include <Lumos/Scene/SceneManager.h>
@@ -6,6 +8,8 @@
 
 #include <Lumos/Core/Engine.h>
 #include <Lumos/Graphics/Renderers/RenderPasses.h>
+#include <Lumos/Scripting/Lua/LuaManager.h>
+#include <Lumos/Utilities/AssetManager.h>
 #include <Lumos/ImGui/ImGuiUtilities.h>
 #include <imgui/imgui.h>
 #include <imgui/Plugins/implot/implot.h>
@@ -119,6 +123,39 @@ namespace Lumos
                     ImGui::TreePop();
                 }
 
+                if(ImGui::TreeNode("Resources"))
+                {
+                    auto ResourceInfo = [](const char* name, size_t count, const ResourceStats& stats, uint64_t cpuBudget, uint64_t gpuBudget)
+                    {
+                        const float MB = 1024.0f * 1024.0f;
+                        ImGui::TextUnformatted(name);
+                        ImGui::Indent();
+                        ImGui::Text("Count : %u", (uint32_t)count);
+                        ImGui::Text("CPU : %.2f / %.0f MB", stats.CPUBytes / MB, cpuBudget / MB);
+                        ImGui::Text("GPU : %.2f / %.0f MB", stats.GPUBytes / MB, gpuBudget / MB);
+                        ImGui::Text("Hits : %llu Misses : %llu Evictions : %llu", (unsigned long long)stats.Hits, (unsigned long long)stats.Misses, (unsigned long long)stats.Evictions);
+                        ImGui::Unindent();
+                    };
+
+                    auto& models = Application::Get().GetModelLibrary();
+                    auto& fonts  = Application::Get().GetFontLibrary();
+                    ResourceInfo("Models", models->GetResourceCount(), models->GetStats(), models->GetCPUBudget(), models->GetGPUBudget());
+                    ResourceInfo("Fonts", fonts->GetResourceCount(), fonts->GetStats(), fonts->GetCPUBudget(), fonts->GetGPUBudget());
+
+                    if(auto resourcePanel = (ResourcePanel*)m_Editor->GetResourcePanel())
+                    {
+                        auto& textures = resourcePanel->GetTextureLibrary();
+                        ResourceInfo("Textures", textures.GetResourceCount(), textures.GetStats(), textures.GetCPUBudget(), textures.GetGPUBudget());
+                    }
+                    ImGui::TreePop();
+                }
+
+                if(ImGui::TreeNode("Scripts"))
+                {
+                    LuaManager::Get().OnImGui();
+                    ImGui::TreePop();
+                }
+
                 ImGui::NewLine();
                 ImGui::Columns(2);
                 bool VSync = Application::Get().GetWindow()->GetVSync();
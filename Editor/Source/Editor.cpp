@@ -547,6 +547,11 @@ namespace Lumos
                     openReloadScenePopup = true;
                 }
 
+                if(ImGui::MenuItem("Export Binary Scene"))
+                {
+                    Application::Get().GetSceneManager()->GetCurrentScene()->Serialise(m_ProjectSettings.m_ProjectRoot + "Assets/Scenes/", true);
+                }
+
                 ImGui::Separator();
 
                 if(ImGui::BeginMenu("Style"))
@@ -2429,6 +2434,20 @@ namespace Lumos
         return nullptr;
     }
 
+    EditorPanel* Editor::GetResourcePanel()
+    {
+        for(int i = 0; i < int(m_Panels.size()); i++)
+        {
+            EditorPanel* w = m_Panels[i].get();
+            if(w->GetSimpleName() == "Resources")
+            {
+                return w;
+            }
+        }
+
+        return nullptr;
+    }
+
     void Editor::RemovePanel(EditorPanel* panel)
     {
         LUMOS_PROFILE_FUNCTION();
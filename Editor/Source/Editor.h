@@ -189,6 +189,7 @@ namespace Lumos
         void OpenTextFile(const std::string& filePath, const std::function<void()>& callback);
         void RemovePanel(EditorPanel* panel);
         EditorPanel* GetTextEditPanel();
+        EditorPanel* GetResourcePanel();
 
         void ShowPreview();
         void DrawPreview();
@@ -671,6 +671,7 @@ end
         auto volume            = soundNode->GetVolume();
         auto referenceDistance = soundNode->GetReferenceDistance();
         auto rollOffFactor     = soundNode->GetRollOffFactor();
+        auto priority          = soundNode->GetPriority();
 
         ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(2, 2));
         ImGui::Columns(2);
@@ -712,6 +713,12 @@ end
             updated = true;
         }
 
+        if(Lumos::ImGuiUtilities::Property("Priority", priority, 0.0f, 10.0f, 0.1f))
+        {
+            soundNode->SetPriority(priority);
+            updated = true;
+        }
+
         if(Lumos::ImGuiUtilities::Property("Paused", paused))
         {
             soundNode->SetPaused(paused);
@@ -1949,6 +1956,27 @@ end
         {
             ImGui::TextUnformatted("Animation");
 
+            auto& animation        = reg.get<Lumos::Graphics::ModelComponent>(e).Animation;
+            const auto& controller = modelRef->GetAnimationController();
+            if(animation && controller && !controller->GetStateNames().empty())
+            {
+                const auto& stateNames = controller->GetStateNames();
+                size_t state           = Lumos::Maths::Min(animation->GetState(), stateNames.size() - 1);
+
+                if(ImGui::BeginCombo("State", stateNames[state].c_str()))
+                {
+                    for(size_t i = 0; i < stateNames.size(); i++)
+                    {
+                        if(ImGui::Selectable(stateNames[i].c_str(), i == state))
+                            animation->SetState(i);
+                    }
+                    ImGui::EndCombo();
+                }
+
+                ImGui::Checkbox("Playing", &animation->Playing);
+                ImGui::DragFloat("Speed", &animation->Speed, 0.01f, 0.0f, 10.0f);
+            }
+
             auto jointNames = Skeleton->joint_names();
             for(auto& joint : jointNames)
             {
@@ -75,6 +75,8 @@ namespace Lumos
         void DrawFolder(const SharedPtr<DirectoryInformation>& dirInfo, bool defaultOpen = false);
         void RenderBreadCrumbs();
         void RenderBottom();
+
+        const Lumos::TextureLibrary& GetTextureLibrary() const { return m_TextureLibrary; }
         // void GetDirectories(const std::string& path);
 
         void DestroyGraphicsResources() override
@@ -0,0 +1,3 @@
+#shader compute
+CompiledSPV/BloomUpsample.comp.spv
+#shader end
\ No newline at end of file
@@ -0,0 +1,32 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(location = 0) in vec2 outTexCoord;
+
+layout(set = 0, binding = 0) uniform UniformBuffer
+{
+	mat4 InvViewProj;  // Jittered, as the depth was rendered
+	mat4 ViewProj;     // Without jitter
+	mat4 PrevViewProj; // Without jitter
+} ubo;
+
+layout(set = 0, binding = 1) uniform sampler2D u_DepthTexture;
+layout(location = 0) out vec4 outFrag;
+
+// Motion from the camera only, reprojected from depth. Offset in uv to where the surface was last frame
+void main()
+{
+	float depth = texture(u_DepthTexture, outTexCoord).r;
+
+	vec4 position = ubo.InvViewProj * vec4(outTexCoord * 2.0 - 1.0, depth, 1.0);
+	position /= position.w;
+
+	vec4 current  = ubo.ViewProj * position;
+	vec4 previous = ubo.PrevViewProj * position;
+
+	vec2 currentUV  = current.xy / current.w * 0.5 + 0.5;
+	vec2 previousUV = previous.xy / previous.w * 0.5 + 0.5;
+
+	outFrag = vec4(previousUV - currentUV, 0.0, 1.0);
+}
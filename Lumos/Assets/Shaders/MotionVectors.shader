@@ -0,0 +1,7 @@
+#shader vertex
+CompiledSPV/ScreenPass.vert.spv
+#shader end
+
+#shader fragment
+CompiledSPV/MotionVectors.frag.spv
+#shader end
\ No newline at end of file
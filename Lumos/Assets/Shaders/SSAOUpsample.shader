@@ -0,0 +1,3 @@
+#shader compute
+CompiledSPV/SSAOUpsample.comp.spv
+#shader end
\ No newline at end of file
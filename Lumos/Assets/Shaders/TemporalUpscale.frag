@@ -0,0 +1,73 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+
+layout(location = 0) in vec2 outTexCoord;
+
+layout(set = 0, binding = 0) uniform UniformBuffer
+{
+	vec4 Jitter; // xy offset of this frame's samples in uv, z blend factor, w 1 when the history is valid
+	vec4 Size;   // xy input size, zw output size
+} ubo;
+
+layout(set = 0, binding = 1) uniform sampler2D u_Texture;
+layout(set = 0, binding = 2) uniform sampler2D u_History;
+layout(set = 0, binding = 3) uniform sampler2D u_MotionVectors;
+layout(set = 0, binding = 4) uniform sampler2D u_DepthTexture;
+layout(location = 0) out vec4 outFrag;
+
+// Reconstructs the output resolution from jittered frames at the input resolution. Each frame contributes by how
+// close its nearest sample lands to the output pixel, the reprojected history is clipped to the colour range of
+// the current neighbourhood to reject stale samples
+void main()
+{
+	vec2 inputTexel = 1.0 / ubo.Size.xy;
+	vec2 inputUV    = outTexCoord + ubo.Jitter.xy;
+
+	vec3 current = texture(u_Texture, inputUV).rgb;
+
+	// Neighbourhood statistics, and the nearest surface's motion so edges follow the foreground
+	vec3 moment1       = vec3(0.0);
+	vec3 moment2       = vec3(0.0);
+	float closestDepth = 1.0;
+	vec2 closestUV     = inputUV;
+
+	for(int y = -1; y <= 1; y++)
+	{
+		for(int x = -1; x <= 1; x++)
+		{
+			vec2 sampleUV = inputUV + vec2(x, y) * inputTexel;
+			vec3 colour   = texture(u_Texture, sampleUV).rgb;
+			moment1 += colour;
+			moment2 += colour * colour;
+
+			float depth = texture(u_DepthTexture, sampleUV).r;
+			if(depth < closestDepth)
+			{
+				closestDepth = depth;
+				closestUV    = sampleUV;
+			}
+		}
+	}
+
+	vec3 mean      = moment1 / 9.0;
+	vec3 deviation = sqrt(max(moment2 / 9.0 - mean * mean, vec3(0.0)));
+	vec3 minColour = mean - deviation * 1.25;
+	vec3 maxColour = mean + deviation * 1.25;
+
+	vec2 motion    = texture(u_MotionVectors, closestUV).xy;
+	vec2 historyUV = outTexCoord + motion;
+
+	vec3 history = clamp(texture(u_History, historyUV).rgb, minColour, maxColour);
+
+	// Distance in output pixels from the output pixel to the nearest input sample
+	vec2 samplePosition = (floor(inputUV * ubo.Size.xy) + 0.5) * inputTexel;
+	vec2 offset         = (samplePosition - inputUV) * ubo.Size.zw;
+	float weight        = exp(-2.29 * dot(offset, offset));
+
+	float blend = ubo.Jitter.z * weight;
+	if(ubo.Jitter.w < 0.5 || any(lessThan(historyUV, vec2(0.0))) || any(greaterThan(historyUV, vec2(1.0))))
+		blend = 1.0;
+
+	outFrag = vec4(mix(history, current, blend), 1.0);
+}
@@ -8,8 +8,27 @@ namespace Lumos
     AStar::AStar(const std::vector<PathNode*>& nodes)
     {
         // Create node data
-        for(auto it = nodes.begin(); it != nodes.end(); ++it)
-            m_NodeData[*it] = new QueueablePathNode(*it);
+        m_Nodes.reserve(nodes.size());
+        for(uint32_t i = 0; i < uint32_t(nodes.size()); i++)
+        {
+            m_Nodes.emplace_back(nodes[i]);
+            m_NodeIndices[nodes[i]] = i;
+        }
+
+        // Flatten connections, edges leading outside the graph are dropped
+        m_ConnectionOffsets.reserve(nodes.size() + 1);
+        for(auto node : nodes)
+        {
+            m_ConnectionOffsets.push_back(uint32_t(m_Connections.size()));
+            for(size_t i = 0; i < node->NumConnections(); i++)
+            {
+                PathEdge* edge = node->Edge(i);
+                auto otherIt   = m_NodeIndices.find(edge->OtherNode(node));
+                if(otherIt != m_NodeIndices.end())
+                    m_Connections.push_back({ edge, &m_Nodes[otherIt->second] });
+            }
+        }
+        m_ConnectionOffsets.push_back(uint32_t(m_Connections.size()));
     }
 
     AStar::~AStar()
@@ -19,91 +38,46 @@ namespace Lumos
     void AStar::Reset()
     {
         // Clear caches
-        m_OpenList = PathNodePriorityQueue();
         m_ClosedList.clear();
         m_Path.clear();
+        m_PathCost = 0.0f;
 
-        // Reset node data
-        for(auto it = m_NodeData.begin(); it != m_NodeData.end(); ++it)
-        {
-            it->second->Parent = nullptr;
-            it->second->fScore = std::numeric_limits<float>::max();
-            it->second->gScore = std::numeric_limits<float>::max();
-        }
+        // Node data is reset lazily when a search first reaches the node
+        m_Search.Begin(m_Nodes);
     }
 
     bool AStar::FindPath(PathNode* start, PathNode* end)
     {
+        LUMOS_PROFILE_FUNCTION();
         // Clear caches
         Reset();
 
-        // Add start node to open list
-        m_NodeData[start]->gScore = 0.0f;
-        m_NodeData[start]->fScore = m_NodeData[start]->node->HeuristicValue(*end);
-        m_OpenList.Push(m_NodeData[start]);
-
-        bool success = false;
-        while(!m_OpenList.empty())
-        {
-            QueueablePathNode* p = m_OpenList.Top();
+        auto startIt = m_NodeIndices.find(start);
+        auto endIt   = m_NodeIndices.find(end);
+        if(startIt == m_NodeIndices.end() || endIt == m_NodeIndices.end())
+            return false;
 
-            // Move this node to the closed list
-            m_OpenList.Pop();
+        QueueablePathNode* endNode = m_Search.Run(&m_Nodes[startIt->second], start->HeuristicValue(*end), &m_Nodes[endIt->second], [&](QueueablePathNode* p)
+                                                  {
             m_ClosedList.push_back(p);
 
-            // Check if this is the end node
-            if(p->node == end)
+            // For each node connected to the next node, skipping edges that cannot be traversed
+            uint32_t index = uint32_t(p - m_Nodes.data());
+            for(uint32_t i = m_ConnectionOffsets[index]; i < m_ConnectionOffsets[index + 1]; i++)
             {
-                success = true;
-                break;
-            }
-
-            // For each node connected to the next node
-            for(size_t i = 0; i < p->node->NumConnections(); i++)
-            {
-                PathEdge* pq = p->node->Edge(i);
-
-                // Skip an edge that cannot be traversed
-                if(!pq->Traversable())
-                    continue;
-
-                QueueablePathNode* q = m_NodeData[pq->OtherNode(p->node)];
-
-                // Calculate new scores
-                float gScore = p->gScore + pq->Cost();
-                float fScore = gScore + q->node->HeuristicValue(*end);
-
-                // Search for this node on open and closed lists
-                auto closedIt = std::find(m_ClosedList.begin(), m_ClosedList.end(), q);
-                auto openIt   = m_OpenList.Find(q);
-
-                if(closedIt != m_ClosedList.end() || openIt != m_OpenList.end())
-                {
-                    // Check if this path is more efficient that the previous best
-                    if(q->gScore > gScore)
-                    {
-                        q->Parent = p;
-                        q->gScore = gScore;
-                        q->fScore = fScore;
-                        m_OpenList.Update();
-                    }
-                }
-                else
-                {
-                    // Add this path to the open list if it has yet to be considered
-                    q->Parent = p;
-                    q->gScore = gScore;
-                    q->fScore = fScore;
-                    m_OpenList.Push(q);
-                }
-            }
-        }
+                const Connection& connection = m_Connections[i];
+                if(connection.Edge->Traversable())
+                    m_Search.Relax(p, connection.Node, connection.Edge->Cost(), [&]() { return connection.Node->node->HeuristicValue(*end); });
+            } });
 
         // If successful then reconstruct the best path
-        if(success)
+        if(endNode)
         {
+            m_ClosedList.push_back(endNode);
+            m_PathCost = endNode->gScore;
+
             // Add nodes to path
-            QueueablePathNode* n = m_ClosedList.back();
+            QueueablePathNode* n = endNode;
             while(n)
             {
                 m_Path.push_back(n->node);
@@ -114,7 +88,7 @@ namespace Lumos
             std::reverse(m_Path.begin(), m_Path.end());
         }
 
-        return success;
+        return endNode != nullptr;
     }
 
-}
\ No newline at end of file
+}
@@ -1,23 +1,26 @@
 #pragma once
 
 #include "PathNode.h"
-#include "PathNodePriorityQueue.h"
-#include "QueueablePathNode.h"
+#include "PathSearch.h"
 
 namespace Lumos
 {
+    // Node data and connections are stored in flat arrays built once from the graph, so a search
+    // does no allocation or map lookups per node. Edges must exist before the AStar is created,
+    // their weight and traversability are read during each search
     class AStar
     {
     public:
         explicit AStar(const std::vector<PathNode*>& nodes);
         virtual ~AStar();
 
+        // Constant time, node data from earlier searches is invalidated by bumping the generation
         void Reset();
         bool FindPath(PathNode* start, PathNode* end);
 
-        PathNodePriorityQueue OpenList() const
+        const PathNodePriorityQueue& OpenList() const
         {
-            return m_OpenList;
+            return m_Search.OpenList();
         }
 
         const std::vector<QueueablePathNode*>& ClosedList() const
@@ -32,12 +35,23 @@ namespace Lumos
 
         float PathCost() const
         {
-            return m_ClosedList.back()->gScore;
+            return m_PathCost;
         }
 
     private:
-        std::map<PathNode*, QueueablePathNode*> m_NodeData;
-        PathNodePriorityQueue m_OpenList;
+        struct Connection
+        {
+            PathEdge* Edge;
+            QueueablePathNode* Node;
+        };
+
+        std::vector<QueueablePathNode> m_Nodes;
+        std::unordered_map<PathNode*, uint32_t> m_NodeIndices;
+        std::vector<uint32_t> m_ConnectionOffsets; // Node i's connections are [offsets[i], offsets[i + 1])
+        std::vector<Connection> m_Connections;
+        float m_PathCost = 0.0f;
+
+        PathSearch m_Search;
         std::vector<QueueablePathNode*> m_ClosedList;
         std::vector<PathNode*> m_Path;
     };
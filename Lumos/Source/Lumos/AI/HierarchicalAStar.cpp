@@ -0,0 +1,326 @@
+#include "Precompiled.h"
+#include "HierarchicalAStar.h"
+#include <unordered_set>
+
+namespace Lumos
+{
+    HierarchicalAStar::HierarchicalAStar(const std::vector<PathNode*>& nodes, float clusterSize)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        m_Nodes.reserve(nodes.size());
+        for(uint32_t i = 0; i < uint32_t(nodes.size()); i++)
+        {
+            m_Nodes.emplace_back(nodes[i]);
+            m_NodeIndices[nodes[i]] = i;
+        }
+
+        // Flatten connections, edges leading outside the graph are dropped
+        std::unordered_set<PathEdge*> edges;
+        m_ConnectionOffsets.reserve(nodes.size() + 1);
+        for(auto node : nodes)
+        {
+            m_ConnectionOffsets.push_back(uint32_t(m_Connections.size()));
+            for(size_t i = 0; i < node->NumConnections(); i++)
+            {
+                PathEdge* edge = node->Edge(i);
+                auto otherIt   = m_NodeIndices.find(edge->OtherNode(node));
+                if(otherIt == m_NodeIndices.end())
+                    continue;
+
+                m_Connections.push_back({ edge, otherIt->second });
+                if(edges.insert(edge).second)
+                    m_Edges.push_back(edge);
+            }
+        }
+        m_ConnectionOffsets.push_back(uint32_t(m_Connections.size()));
+
+        // Assign clusters from a grid over node positions
+        std::unordered_map<uint64_t, uint32_t> cells;
+        m_NodeClusters.resize(nodes.size());
+        for(uint32_t i = 0; i < uint32_t(nodes.size()); i++)
+        {
+            glm::vec3 position = nodes[i]->GetWorldSpaceTransform()[3];
+            glm::ivec3 cell    = glm::ivec3(glm::floor(position / clusterSize));
+            uint64_t key       = (uint64_t(cell.x & 0x1FFFFF) << 42) | (uint64_t(cell.y & 0x1FFFFF) << 21) | uint64_t(cell.z & 0x1FFFFF);
+
+            auto cellIt = cells.find(key);
+            if(cellIt == cells.end())
+            {
+                cellIt = cells.emplace(key, uint32_t(m_Clusters.size())).first;
+                m_Clusters.emplace_back();
+            }
+            m_NodeClusters[i] = cellIt->second;
+        }
+
+        // Nodes with an edge into another cluster are entrances
+        m_NodeEntrances.resize(nodes.size(), InvalidIndex);
+        for(uint32_t i = 0; i < uint32_t(nodes.size()); i++)
+        {
+            for(uint32_t c = m_ConnectionOffsets[i]; c < m_ConnectionOffsets[i + 1]; c++)
+            {
+                if(m_NodeClusters[m_Connections[c].Node] == m_NodeClusters[i])
+                    continue;
+
+                auto& entrances    = m_Clusters[m_NodeClusters[i]].Entrances;
+                m_NodeEntrances[i] = uint32_t(m_Entrances.size());
+                m_EntranceSlots.push_back(uint32_t(entrances.size()));
+                m_Entrances.push_back(i);
+                entrances.push_back(i);
+                break;
+            }
+        }
+
+        m_AbstractNodes.reserve(m_Entrances.size() + 2);
+        for(auto entrance : m_Entrances)
+            m_AbstractNodes.emplace_back(m_Nodes[entrance].node);
+        m_AbstractNodes.emplace_back(nullptr);
+        m_AbstractNodes.emplace_back(nullptr);
+
+        for(auto edge : m_Edges)
+            edge->AddListener(this);
+    }
+
+    HierarchicalAStar::~HierarchicalAStar()
+    {
+        for(auto edge : m_Edges)
+            edge->RemoveListener(this);
+    }
+
+    bool HierarchicalAStar::SearchCluster(uint32_t source, uint32_t target)
+    {
+        m_LocalSearch.Begin(m_Nodes);
+
+        uint32_t cluster = m_NodeClusters[source];
+        PathNode* goal   = target != InvalidIndex ? m_Nodes[target].node : nullptr;
+        auto heuristic   = [goal](const QueueablePathNode* node)
+        {
+            return goal ? node->node->HeuristicValue(*goal) : 0.0f;
+        };
+
+        QueueablePathNode* sourceNode = &m_Nodes[source];
+        QueueablePathNode* targetNode = goal ? &m_Nodes[target] : nullptr;
+        QueueablePathNode* found      = m_LocalSearch.Run(sourceNode, heuristic(sourceNode), targetNode, [&](QueueablePathNode* p)
+                                                          {
+            uint32_t index = uint32_t(p - m_Nodes.data());
+            for(uint32_t i = m_ConnectionOffsets[index]; i < m_ConnectionOffsets[index + 1]; i++)
+            {
+                const Connection& connection = m_Connections[i];
+                if(!connection.Edge->Traversable() || m_NodeClusters[connection.Node] != cluster)
+                    continue;
+
+                QueueablePathNode* q = &m_Nodes[connection.Node];
+                m_LocalSearch.Relax(p, q, connection.Edge->Cost(), [&]() { return heuristic(q); });
+            } });
+
+        return found || target == InvalidIndex;
+    }
+
+    float HierarchicalAStar::LocalCost(uint32_t node) const
+    {
+        const QueueablePathNode& n = m_Nodes[node];
+        return m_LocalSearch.Reached(n) ? n.gScore : std::numeric_limits<float>::max();
+    }
+
+    void HierarchicalAStar::UpdateCluster(Cluster& cluster)
+    {
+        if(!cluster.Dirty)
+            return;
+
+        LUMOS_PROFILE_FUNCTION_LOW();
+        size_t count = cluster.Entrances.size();
+        cluster.Costs.assign(count * count, std::numeric_limits<float>::max());
+
+        for(size_t i = 0; i < count; i++)
+        {
+            SearchCluster(cluster.Entrances[i], InvalidIndex);
+            for(size_t j = 0; j < count; j++)
+                cluster.Costs[i * count + j] = LocalCost(cluster.Entrances[j]);
+        }
+
+        cluster.Dirty = false;
+    }
+
+    const std::vector<PathNode*>& HierarchicalAStar::Segment(uint32_t from, uint32_t to)
+    {
+        // Stored lowest index first, the graph is undirected so one search serves both directions
+        Cluster& cluster = m_Clusters[m_NodeClusters[from]];
+        uint32_t first   = std::min(from, to);
+        uint32_t last    = std::max(from, to);
+        uint64_t key     = (uint64_t(first) << 32) | last;
+
+        auto segmentIt = cluster.Segments.find(key);
+        if(segmentIt != cluster.Segments.end())
+            return segmentIt->second;
+
+        auto& segment = cluster.Segments[key];
+        if(SearchCluster(first, last))
+        {
+            for(QueueablePathNode* n = &m_Nodes[last]; n; n = n->Parent)
+                segment.push_back(n->node);
+            std::reverse(segment.begin(), segment.end());
+        }
+
+        return segment;
+    }
+
+    void HierarchicalAStar::RefineSegment(size_t index, std::vector<PathNode*>& outPath)
+    {
+        LUMOS_PROFILE_FUNCTION_LOW();
+        uint32_t from = m_AbstractPathIndices[index];
+        uint32_t to   = m_AbstractPathIndices[index + 1];
+
+        // Steps between clusters are single edges
+        if(m_NodeClusters[from] != m_NodeClusters[to])
+        {
+            outPath.push_back(m_Nodes[to].node);
+            return;
+        }
+
+        const auto& segment = Segment(from, to);
+        if(segment.empty())
+            return;
+
+        if(from < to)
+            outPath.insert(outPath.end(), segment.begin() + 1, segment.end());
+        else
+            outPath.insert(outPath.end(), segment.rbegin() + 1, segment.rend());
+    }
+
+    const std::vector<PathNode*>& HierarchicalAStar::Path()
+    {
+        if(!m_PathRefined)
+        {
+            m_Path.clear();
+            if(!m_AbstractPathIndices.empty())
+            {
+                m_Path.push_back(m_Nodes[m_AbstractPathIndices.front()].node);
+                for(size_t i = 0; i < NumSegments(); i++)
+                    RefineSegment(i, m_Path);
+            }
+            m_PathRefined = true;
+        }
+
+        return m_Path;
+    }
+
+    bool HierarchicalAStar::FindPath(PathNode* start, PathNode* end)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        m_AbstractPath.clear();
+        m_AbstractPathIndices.clear();
+        m_Path.clear();
+        m_PathRefined = false;
+        m_PathCost    = 0.0f;
+
+        auto startIt = m_NodeIndices.find(start);
+        auto endIt   = m_NodeIndices.find(end);
+        if(startIt == m_NodeIndices.end() || endIt == m_NodeIndices.end())
+            return false;
+
+        uint32_t startIndex = startIt->second;
+        uint32_t endIndex   = endIt->second;
+        if(startIndex == endIndex)
+        {
+            m_AbstractPath.push_back(start);
+            m_AbstractPathIndices.push_back(startIndex);
+            return true;
+        }
+
+        // Connect the start and end to the entrances of their clusters
+        uint32_t startCluster = m_NodeClusters[startIndex];
+        uint32_t endCluster   = m_NodeClusters[endIndex];
+
+        SearchCluster(startIndex, InvalidIndex);
+        m_StartCosts.clear();
+        for(auto entrance : m_Clusters[startCluster].Entrances)
+            m_StartCosts.push_back(LocalCost(entrance));
+        m_DirectCost = startCluster == endCluster ? LocalCost(endIndex) : std::numeric_limits<float>::max();
+
+        SearchCluster(endIndex, InvalidIndex);
+        m_EndCosts.clear();
+        for(auto entrance : m_Clusters[endCluster].Entrances)
+            m_EndCosts.push_back(LocalCost(entrance));
+
+        // Search the abstract graph
+        m_AbstractSearch.Begin(m_AbstractNodes);
+
+        uint32_t startAbstract              = uint32_t(m_Entrances.size());
+        uint32_t endAbstract                = startAbstract + 1;
+        m_AbstractNodes[startAbstract].node = start;
+        m_AbstractNodes[endAbstract].node   = end;
+
+        auto relax = [&](QueueablePathNode* p, uint32_t index, float cost)
+        {
+            if(cost == std::numeric_limits<float>::max())
+                return;
+
+            QueueablePathNode* q = &m_AbstractNodes[index];
+            m_AbstractSearch.Relax(p, q, cost, [&]() { return q->node->HeuristicValue(*end); });
+        };
+
+        QueueablePathNode* endNode = m_AbstractSearch.Run(&m_AbstractNodes[startAbstract], start->HeuristicValue(*end), &m_AbstractNodes[endAbstract], [&](QueueablePathNode* p)
+                                                          {
+            uint32_t index = uint32_t(p - m_AbstractNodes.data());
+            if(index == startAbstract)
+            {
+                const auto& entrances = m_Clusters[startCluster].Entrances;
+                for(size_t i = 0; i < entrances.size(); i++)
+                    relax(p, m_NodeEntrances[entrances[i]], m_StartCosts[i]);
+                relax(p, endAbstract, m_DirectCost);
+                return;
+            }
+
+            uint32_t node    = m_Entrances[index];
+            uint32_t slot    = m_EntranceSlots[index];
+            uint32_t cluster = m_NodeClusters[node];
+            Cluster& owner   = m_Clusters[cluster];
+            UpdateCluster(owner);
+
+            // Across the cluster
+            size_t count = owner.Entrances.size();
+            for(size_t j = 0; j < count; j++)
+                relax(p, m_NodeEntrances[owner.Entrances[j]], owner.Costs[slot * count + j]);
+
+            if(cluster == endCluster)
+                relax(p, endAbstract, m_EndCosts[slot]);
+
+            // Into neighbouring clusters
+            for(uint32_t i = m_ConnectionOffsets[node]; i < m_ConnectionOffsets[node + 1]; i++)
+            {
+                const Connection& connection = m_Connections[i];
+                if(connection.Edge->Traversable() && m_NodeClusters[connection.Node] != cluster)
+                    relax(p, m_NodeEntrances[connection.Node], connection.Edge->Cost());
+            } });
+
+        if(!endNode)
+            return false;
+
+        m_PathCost = endNode->gScore;
+        for(QueueablePathNode* n = endNode; n; n = n->Parent)
+        {
+            uint32_t index = uint32_t(n - m_AbstractNodes.data());
+            m_AbstractPath.push_back(n->node);
+            m_AbstractPathIndices.push_back(index < startAbstract ? m_Entrances[index] : (index == startAbstract ? startIndex : endIndex));
+        }
+
+        std::reverse(m_AbstractPath.begin(), m_AbstractPath.end());
+        std::reverse(m_AbstractPathIndices.begin(), m_AbstractPathIndices.end());
+        return true;
+    }
+
+    void HierarchicalAStar::OnEdgeChanged(PathEdge* edge)
+    {
+        // Edges between clusters are read live by the abstract search, only an interior edge changes cached costs
+        auto aIt = m_NodeIndices.find(edge->NodeA());
+        auto bIt = m_NodeIndices.find(edge->NodeB());
+        if(aIt == m_NodeIndices.end() || bIt == m_NodeIndices.end())
+            return;
+
+        uint32_t cluster = m_NodeClusters[aIt->second];
+        if(cluster != m_NodeClusters[bIt->second])
+            return;
+
+        m_Clusters[cluster].Dirty = true;
+        m_Clusters[cluster].Segments.clear();
+    }
+}
@@ -0,0 +1,108 @@
+#pragma once
+
+#include "PathEdge.h"
+#include "PathSearch.h"
+#include <unordered_map>
+
+namespace Lumos
+{
+    // HPA* over a PathNode graph. Nodes are grouped into clusters on a world space grid and the ends of
+    // edges crossing between clusters become entrances. The shortest path cost between every pair of
+    // entrances inside a cluster is precomputed, so a query only searches the small graph of entrances
+    // plus the start and end, and each step of that route is refined into graph nodes when it is asked for.
+    // Refined steps are cached per cluster, and a cluster is recomputed the next time it is used after one
+    // of its edges changes traversability or weight. Edges must outlive this object
+    class LUMOS_EXPORT HierarchicalAStar : public PathEdgeListener
+    {
+    public:
+        HierarchicalAStar(const std::vector<PathNode*>& nodes, float clusterSize);
+        virtual ~HierarchicalAStar();
+
+        // Searches the abstract graph only, the result is refined lazily
+        bool FindPath(PathNode* start, PathNode* end);
+
+        // Entrances the last path passes through, including the start and end
+        const std::vector<PathNode*>& AbstractPath() const
+        {
+            return m_AbstractPath;
+        }
+
+        size_t NumSegments() const
+        {
+            return m_AbstractPath.empty() ? 0 : m_AbstractPath.size() - 1;
+        }
+
+        // Appends the nodes after AbstractPath()[index] up to and including AbstractPath()[index + 1]
+        void RefineSegment(size_t index, std::vector<PathNode*>& outPath);
+
+        // Full node path, refining any segments not already cached
+        const std::vector<PathNode*>& Path();
+
+        float PathCost() const
+        {
+            return m_PathCost;
+        }
+
+        uint32_t NumClusters() const
+        {
+            return uint32_t(m_Clusters.size());
+        }
+
+        uint32_t NumEntrances() const
+        {
+            return uint32_t(m_Entrances.size());
+        }
+
+        void OnEdgeChanged(PathEdge* edge) override;
+
+    private:
+        static constexpr uint32_t InvalidIndex = ~0u;
+
+        struct Connection
+        {
+            PathEdge* Edge;
+            uint32_t Node;
+        };
+
+        struct Cluster
+        {
+            std::vector<uint32_t> Entrances; // Node indices
+            std::vector<float> Costs;        // Entrances x Entrances, infinite when unreachable inside the cluster
+            std::unordered_map<uint64_t, std::vector<PathNode*>> Segments;
+            bool Dirty = true;
+        };
+
+        // Search from source without leaving its cluster, runs to completion when target is InvalidIndex
+        bool SearchCluster(uint32_t source, uint32_t target);
+        void UpdateCluster(Cluster& cluster);
+        float LocalCost(uint32_t node) const;
+        const std::vector<PathNode*>& Segment(uint32_t from, uint32_t to);
+
+        // Graph nodes, flattened like AStar
+        std::vector<QueueablePathNode> m_Nodes;
+        std::unordered_map<PathNode*, uint32_t> m_NodeIndices;
+        std::vector<uint32_t> m_ConnectionOffsets;
+        std::vector<Connection> m_Connections;
+        std::vector<uint32_t> m_NodeClusters;
+        std::vector<uint32_t> m_NodeEntrances; // Entrance index of each node, InvalidIndex if it is interior
+        std::vector<PathEdge*> m_Edges;
+        PathSearch m_LocalSearch;
+
+        std::vector<Cluster> m_Clusters;
+        std::vector<uint32_t> m_Entrances;
+        std::vector<uint32_t> m_EntranceSlots; // Position of each entrance in its cluster's list
+
+        // Abstract graph, one node per entrance then the query's start and end
+        std::vector<QueueablePathNode> m_AbstractNodes;
+        PathSearch m_AbstractSearch;
+        std::vector<float> m_StartCosts; // To each entrance of the start cluster
+        std::vector<float> m_EndCosts;   // From each entrance of the end cluster
+        float m_DirectCost = 0.0f;       // Start to end inside a shared cluster
+
+        std::vector<PathNode*> m_AbstractPath;
+        std::vector<uint32_t> m_AbstractPathIndices;
+        std::vector<PathNode*> m_Path;
+        bool m_PathRefined = false;
+        float m_PathCost   = 0.0f;
+    };
+}
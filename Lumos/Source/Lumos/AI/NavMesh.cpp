@@ -0,0 +1,654 @@
+#include "Precompiled.h"
+#include "NavMesh.h"
+#include "Graphics/Renderers/DebugRenderer.h"
+#include "Maths/MathsUtilities.h"
+
+namespace Lumos
+{
+    namespace
+    {
+        const int NeighbourX[4] = { -1, 0, 1, 0 };
+        const int NeighbourZ[4] = { 0, 1, 0, -1 };
+
+        // Sutherland-Hodgman against one axis aligned plane, keeping the side where sign * (p[axis] - value) >= 0
+        void ClipPolygon(const std::vector<glm::vec3>& input, std::vector<glm::vec3>& output, int axis, float value, float sign)
+        {
+            output.clear();
+            for(size_t i = 0; i < input.size(); i++)
+            {
+                const glm::vec3& current = input[i];
+                const glm::vec3& next    = input[(i + 1) % input.size()];
+                float currentDistance    = sign * (current[axis] - value);
+                float nextDistance       = sign * (next[axis] - value);
+
+                if(currentDistance >= 0.0f)
+                    output.push_back(current);
+
+                if((currentDistance >= 0.0f) != (nextDistance >= 0.0f))
+                    output.push_back(current + (next - current) * (currentDistance / (currentDistance - nextDistance)));
+            }
+        }
+
+        // Positive when b is to the left of o -> a on the xz plane
+        float Cross2D(const glm::vec3& o, const glm::vec3& a, const glm::vec3& b)
+        {
+            return (a.x - o.x) * (b.z - o.z) - (a.z - o.z) * (b.x - o.x);
+        }
+
+        bool NearlyEqual(const glm::vec3& a, const glm::vec3& b)
+        {
+            glm::vec3 difference = a - b;
+            return glm::dot(difference, difference) < 1e-6f;
+        }
+    }
+
+    bool NavMesh::Build(const std::vector<glm::vec3>& triangles, const NavMeshSettings& settings)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        m_Settings = settings;
+        m_ColumnOffsets.clear();
+        m_Cells.clear();
+        m_Polygons.clear();
+        m_Links.clear();
+        m_Width = m_Depth = 0;
+
+        if(triangles.size() < 3 || settings.CellSize <= 0.0f)
+            return false;
+
+        glm::vec3 min(FLT_MAX);
+        glm::vec3 max(-FLT_MAX);
+        for(auto& position : triangles)
+        {
+            min = glm::min(min, position);
+            max = glm::max(max, position);
+        }
+
+        const float cellSize = settings.CellSize;
+        m_Origin             = min;
+        m_Width              = int(ceilf((max.x - min.x) / cellSize)) + 1;
+        m_Depth              = int(ceilf((max.z - min.z) / cellSize)) + 1;
+
+        if(uint64_t(m_Width) * uint64_t(m_Depth) > 16 * 1024 * 1024)
+        {
+            LUMOS_LOG_WARN("NavMesh too large for cell size {0} ({1} x {2} columns)", cellSize, m_Width, m_Depth);
+            m_Width = m_Depth = 0;
+            return false;
+        }
+
+        // Rasterise every triangle into solid spans, one per column it covers
+        struct Span
+        {
+            float Min;
+            float Max;
+            bool Walkable;
+        };
+
+        std::vector<std::vector<Span>> columns(m_Width * m_Depth);
+        std::vector<glm::vec3> clipped;
+        std::vector<glm::vec3> scratch;
+        const float walkableNormal = cosf(glm::radians(settings.MaxSlope));
+
+        {
+            LUMOS_PROFILE_SCOPE("NavMesh Rasterise");
+            for(size_t t = 0; t + 2 < triangles.size(); t += 3)
+            {
+                const glm::vec3& a = triangles[t];
+                const glm::vec3& b = triangles[t + 1];
+                const glm::vec3& c = triangles[t + 2];
+
+                glm::vec3 normal = glm::cross(b - a, c - a);
+                float area       = glm::length(normal);
+                if(area <= 0.0f)
+                    continue;
+
+                // Winding is not consistent across imported meshes, so either face counts
+                bool walkable = fabsf(normal.y) / area >= walkableNormal;
+
+                glm::vec3 triangleMin = glm::min(a, glm::min(b, c)) - m_Origin;
+                glm::vec3 triangleMax = glm::max(a, glm::max(b, c)) - m_Origin;
+                int x0                = Maths::Clamp(int(triangleMin.x / cellSize), 0, m_Width - 1);
+                int x1                = Maths::Clamp(int(triangleMax.x / cellSize), 0, m_Width - 1);
+                int z0                = Maths::Clamp(int(triangleMin.z / cellSize), 0, m_Depth - 1);
+                int z1                = Maths::Clamp(int(triangleMax.z / cellSize), 0, m_Depth - 1);
+
+                for(int z = z0; z <= z1; z++)
+                {
+                    for(int x = x0; x <= x1; x++)
+                    {
+                        float cellMinX = m_Origin.x + x * cellSize;
+                        float cellMinZ = m_Origin.z + z * cellSize;
+
+                        clipped = { a, b, c };
+                        ClipPolygon(clipped, scratch, 0, cellMinX, 1.0f);
+                        ClipPolygon(scratch, clipped, 0, cellMinX + cellSize, -1.0f);
+                        ClipPolygon(clipped, scratch, 2, cellMinZ, 1.0f);
+                        ClipPolygon(scratch, clipped, 2, cellMinZ + cellSize, -1.0f);
+
+                        if(clipped.empty())
+                            continue;
+
+                        Span span = { FLT_MAX, -FLT_MAX, walkable };
+                        for(auto& point : clipped)
+                        {
+                            span.Min = Maths::Min(span.Min, point.y);
+                            span.Max = Maths::Max(span.Max, point.y);
+                        }
+
+                        columns[ColumnIndex(x, z)].push_back(span);
+                    }
+                }
+            }
+        }
+
+        // Merge touching spans. The top surface of each solid span is a walkable cell if it has the headroom
+        m_ColumnOffsets.reserve(columns.size() + 1);
+        std::vector<Span> merged;
+        for(auto& column : columns)
+        {
+            m_ColumnOffsets.push_back(uint32_t(m_Cells.size()));
+
+            std::sort(column.begin(), column.end(), [](const Span& a, const Span& b)
+                      { return a.Min < b.Min; });
+
+            merged.clear();
+            for(auto& span : column)
+            {
+                if(merged.empty() || span.Min > merged.back().Max + settings.CellHeight)
+                {
+                    merged.push_back(span);
+                    continue;
+                }
+
+                // Tops within a step of each other keep the surface walkable if either was
+                Span& top = merged.back();
+                if(span.Max > top.Max + settings.MaxClimb)
+                    top.Walkable = span.Walkable;
+                else if(span.Max >= top.Max - settings.MaxClimb)
+                    top.Walkable = top.Walkable || span.Walkable;
+                top.Max = Maths::Max(top.Max, span.Max);
+            }
+
+            for(size_t i = 0; i < merged.size(); i++)
+            {
+                float ceiling = i + 1 < merged.size() ? merged[i + 1].Min : FLT_MAX;
+                if(!merged[i].Walkable || ceiling - merged[i].Max < settings.AgentHeight)
+                    continue;
+
+                Cell cell;
+                cell.Height   = merged[i].Max;
+                cell.Ceiling  = ceiling;
+                cell.Polygon  = InvalidPolygon;
+                cell.Distance = ~0u;
+                m_Cells.push_back(cell);
+            }
+
+            column.clear();
+            column.shrink_to_fit();
+        }
+        m_ColumnOffsets.push_back(uint32_t(m_Cells.size()));
+
+        // Connect cells an agent can step between
+        for(int z = 0; z < m_Depth; z++)
+        {
+            for(int x = 0; x < m_Width; x++)
+            {
+                uint32_t column = ColumnIndex(x, z);
+                for(uint32_t i = m_ColumnOffsets[column]; i < m_ColumnOffsets[column + 1]; i++)
+                {
+                    Cell& cell = m_Cells[i];
+                    for(int d = 0; d < 4; d++)
+                    {
+                        cell.Neighbours[d] = InvalidPolygon;
+
+                        int nx = x + NeighbourX[d];
+                        int nz = z + NeighbourZ[d];
+                        if(nx < 0 || nz < 0 || nx >= m_Width || nz >= m_Depth)
+                            continue;
+
+                        uint32_t neighbourColumn = ColumnIndex(nx, nz);
+                        for(uint32_t j = m_ColumnOffsets[neighbourColumn]; j < m_ColumnOffsets[neighbourColumn + 1]; j++)
+                        {
+                            const Cell& other = m_Cells[j];
+                            float gap         = Maths::Min(cell.Ceiling, other.Ceiling) - Maths::Max(cell.Height, other.Height);
+                            if(fabsf(other.Height - cell.Height) <= settings.MaxClimb && gap >= settings.AgentHeight)
+                            {
+                                cell.Neighbours[d] = j;
+                                break;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        // Erode by the agent radius, breadth first out from cells on an edge
+        {
+            LUMOS_PROFILE_SCOPE("NavMesh Erode");
+            std::vector<uint32_t> queue;
+            for(uint32_t i = 0; i < uint32_t(m_Cells.size()); i++)
+            {
+                Cell& cell = m_Cells[i];
+                for(int d = 0; d < 4; d++)
+                {
+                    if(cell.Neighbours[d] == InvalidPolygon)
+                    {
+                        cell.Distance = 0;
+                        queue.push_back(i);
+                        break;
+                    }
+                }
+            }
+
+            for(size_t head = 0; head < queue.size(); head++)
+            {
+                const Cell& cell = m_Cells[queue[head]];
+                for(int d = 0; d < 4; d++)
+                {
+                    uint32_t neighbour = cell.Neighbours[d];
+                    if(neighbour != InvalidPolygon && m_Cells[neighbour].Distance > cell.Distance + 1)
+                    {
+                        m_Cells[neighbour].Distance = cell.Distance + 1;
+                        queue.push_back(neighbour);
+                    }
+                }
+            }
+
+            uint32_t radius = uint32_t(ceilf(settings.AgentRadius / cellSize));
+            for(auto& cell : m_Cells)
+            {
+                for(int d = 0; d < 4; d++)
+                {
+                    uint32_t neighbour = cell.Neighbours[d];
+                    if(cell.Distance < radius || (neighbour != InvalidPolygon && m_Cells[neighbour].Distance < radius))
+                        cell.Neighbours[d] = InvalidPolygon;
+                }
+            }
+
+            // Eroded cells stay in their columns but never get a polygon
+            for(auto& cell : m_Cells)
+            {
+                if(cell.Distance < radius)
+                    cell.Polygon = ErodedCell;
+            }
+        }
+
+        // Greedily merge cells into rectangles, growing along +x then adding whole rows along +z
+        struct Rect
+        {
+            int X;
+            int Z;
+            int Width;
+            int Depth;
+        };
+
+        std::vector<Rect> rects;
+        std::vector<uint32_t> rectCells;
+        std::vector<uint32_t> row;
+        const uint32_t maxCells = Maths::Max(settings.MaxPolygonCells, 1u);
+        auto isFree             = [this](uint32_t index)
+        { return index != InvalidPolygon && m_Cells[index].Polygon == InvalidPolygon; };
+
+        {
+            LUMOS_PROFILE_SCOPE("NavMesh Polygons");
+            for(int z = 0; z < m_Depth; z++)
+            {
+                for(int x = 0; x < m_Width; x++)
+                {
+                    uint32_t column = ColumnIndex(x, z);
+                    for(uint32_t i = m_ColumnOffsets[column]; i < m_ColumnOffsets[column + 1]; i++)
+                    {
+                        if(!isFree(i))
+                            continue;
+
+                        rectCells.clear();
+                        rectCells.push_back(i);
+                        while(rectCells.size() < maxCells && isFree(m_Cells[rectCells.back()].Neighbours[2]))
+                            rectCells.push_back(m_Cells[rectCells.back()].Neighbours[2]);
+
+                        const uint32_t width = uint32_t(rectCells.size());
+                        uint32_t depth       = 1;
+                        while(depth < maxCells)
+                        {
+                            // The next row must be free and connected along +x the same way
+                            row.clear();
+                            for(uint32_t w = 0; w < width; w++)
+                            {
+                                uint32_t above = m_Cells[rectCells[(depth - 1) * width + w]].Neighbours[1];
+                                if(!isFree(above) || (w > 0 && m_Cells[row.back()].Neighbours[2] != above))
+                                    break;
+                                row.push_back(above);
+                            }
+
+                            if(row.size() != width)
+                                break;
+
+                            rectCells.insert(rectCells.end(), row.begin(), row.end());
+                            depth++;
+                        }
+
+                        uint32_t polygonIndex = uint32_t(m_Polygons.size());
+                        for(auto cell : rectCells)
+                            m_Cells[cell].Polygon = polygonIndex;
+
+                        float x0 = m_Origin.x + x * cellSize;
+                        float x1 = m_Origin.x + (x + width) * cellSize;
+                        float z0 = m_Origin.z + z * cellSize;
+                        float z1 = m_Origin.z + (z + depth) * cellSize;
+
+                        NavMeshPolygon polygon;
+                        polygon.Vertices[0] = glm::vec3(x0, m_Cells[rectCells[0]].Height, z0);
+                        polygon.Vertices[1] = glm::vec3(x0, m_Cells[rectCells[(depth - 1) * width]].Height, z1);
+                        polygon.Vertices[2] = glm::vec3(x1, m_Cells[rectCells.back()].Height, z1);
+                        polygon.Vertices[3] = glm::vec3(x1, m_Cells[rectCells[width - 1]].Height, z0);
+                        polygon.Centre      = (polygon.Vertices[0] + polygon.Vertices[1] + polygon.Vertices[2] + polygon.Vertices[3]) * 0.25f;
+                        m_Polygons.push_back(polygon);
+                        rects.push_back({ x, z, int(width), int(depth) });
+                    }
+                }
+            }
+        }
+
+        // Portals are the runs of edge cells whose neighbour belongs to another polygon
+        struct Edge
+        {
+            uint32_t Polygon;
+            int Side;
+            int Min;
+            int Max;
+            float MinHeight;
+            float MaxHeight;
+        };
+
+        std::vector<Edge> edges;
+        for(uint32_t p = 0; p < uint32_t(m_Polygons.size()); p++)
+        {
+            const Rect& rect = rects[p];
+            edges.clear();
+
+            for(int side = 0; side < 4; side++)
+            {
+                bool alongZ = side == 0 || side == 2;
+                int length  = alongZ ? rect.Depth : rect.Width;
+                for(int t = 0; t < length; t++)
+                {
+                    int x = alongZ ? (side == 0 ? rect.X : rect.X + rect.Width - 1) : rect.X + t;
+                    int z = alongZ ? rect.Z + t : (side == 3 ? rect.Z : rect.Z + rect.Depth - 1);
+
+                    // Find this polygon's cell in the column
+                    uint32_t column = ColumnIndex(x, z);
+                    for(uint32_t i = m_ColumnOffsets[column]; i < m_ColumnOffsets[column + 1]; i++)
+                    {
+                        if(m_Cells[i].Polygon != p)
+                            continue;
+
+                        uint32_t neighbour = m_Cells[i].Neighbours[side];
+                        if(neighbour == InvalidPolygon || m_Cells[neighbour].Polygon >= m_Polygons.size())
+                            break;
+
+                        uint32_t other = m_Cells[neighbour].Polygon;
+                        float height   = (m_Cells[i].Height + m_Cells[neighbour].Height) * 0.5f;
+
+                        auto edge = std::find_if(edges.begin(), edges.end(), [other, side](const Edge& e)
+                                                 { return e.Polygon == other && e.Side == side; });
+                        if(edge == edges.end())
+                        {
+                            edges.push_back({ other, side, t, t, height, height });
+                        }
+                        else
+                        {
+                            edge->Max       = t;
+                            edge->MaxHeight = height;
+                        }
+                        break;
+                    }
+                }
+            }
+
+            NavMeshPolygon& polygon = m_Polygons[p];
+            polygon.FirstLink       = uint32_t(m_Links.size());
+            polygon.LinkCount       = uint32_t(edges.size());
+
+            for(auto& edge : edges)
+            {
+                NavMeshLink link;
+                link.Polygon = edge.Polygon;
+
+                if(edge.Side == 0 || edge.Side == 2)
+                {
+                    float x      = m_Origin.x + (edge.Side == 0 ? rect.X : rect.X + rect.Width) * cellSize;
+                    link.PortalA = glm::vec3(x, edge.MinHeight, m_Origin.z + (rect.Z + edge.Min) * cellSize);
+                    link.PortalB = glm::vec3(x, edge.MaxHeight, m_Origin.z + (rect.Z + edge.Max + 1) * cellSize);
+                }
+                else
+                {
+                    float z      = m_Origin.z + (edge.Side == 3 ? rect.Z : rect.Z + rect.Depth) * cellSize;
+                    link.PortalA = glm::vec3(m_Origin.x + (rect.X + edge.Min) * cellSize, edge.MinHeight, z);
+                    link.PortalB = glm::vec3(m_Origin.x + (rect.X + edge.Max + 1) * cellSize, edge.MaxHeight, z);
+                }
+
+                m_Links.push_back(link);
+            }
+        }
+
+        LUMOS_LOG_INFO("Built NavMesh - {0} cells, {1} polygons, {2} links", m_Cells.size(), m_Polygons.size(), m_Links.size());
+        return !m_Polygons.empty();
+    }
+
+    uint32_t NavMesh::FindNearestPolygon(const glm::vec3& point, glm::vec3& outPoint, uint32_t maxDistance) const
+    {
+        if(m_Polygons.empty())
+            return InvalidPolygon;
+
+        const float cellSize = m_Settings.CellSize;
+        int cx               = int(floorf((point.x - m_Origin.x) / cellSize));
+        int cz               = int(floorf((point.z - m_Origin.z) / cellSize));
+
+        uint32_t bestCell  = InvalidPolygon;
+        int bestX          = 0;
+        int bestZ          = 0;
+        float bestDistance = FLT_MAX;
+
+        // Rings of columns outwards, stopping at the first ring with a walkable cell
+        for(int ring = 0; ring <= int(maxDistance) && bestCell == InvalidPolygon; ring++)
+        {
+            for(int z = cz - ring; z <= cz + ring; z++)
+            {
+                for(int x = cx - ring; x <= cx + ring; x++)
+                {
+                    if(Maths::Max(abs(x - cx), abs(z - cz)) != ring || x < 0 || z < 0 || x >= m_Width || z >= m_Depth)
+                        continue;
+
+                    uint32_t column = ColumnIndex(x, z);
+                    for(uint32_t i = m_ColumnOffsets[column]; i < m_ColumnOffsets[column + 1]; i++)
+                    {
+                        if(m_Cells[i].Polygon >= m_Polygons.size())
+                            continue;
+
+                        float dx       = m_Origin.x + (x + 0.5f) * cellSize - point.x;
+                        float dz       = m_Origin.z + (z + 0.5f) * cellSize - point.z;
+                        float dy       = m_Cells[i].Height - point.y;
+                        float distance = dx * dx + dz * dz + dy * dy;
+                        if(distance < bestDistance)
+                        {
+                            bestDistance = distance;
+                            bestCell     = i;
+                            bestX        = x;
+                            bestZ        = z;
+                        }
+                    }
+                }
+            }
+        }
+
+        if(bestCell == InvalidPolygon)
+            return InvalidPolygon;
+
+        float minX = m_Origin.x + bestX * cellSize;
+        float minZ = m_Origin.z + bestZ * cellSize;
+        outPoint   = glm::vec3(Maths::Clamp(point.x, minX, minX + cellSize), m_Cells[bestCell].Height, Maths::Clamp(point.z, minZ, minZ + cellSize));
+        return m_Cells[bestCell].Polygon;
+    }
+
+    void NavMesh::DebugDraw() const
+    {
+        LUMOS_PROFILE_FUNCTION_LOW();
+        const glm::vec3 offset(0.0f, 0.05f, 0.0f);
+        const glm::vec4 edgeColour(0.2f, 0.6f, 1.0f, 1.0f);
+
+        for(auto& polygon : m_Polygons)
+        {
+            for(int i = 0; i < 4; i++)
+                DebugRenderer::DrawHairLine(polygon.Vertices[i] + offset, polygon.Vertices[(i + 1) % 4] + offset, edgeColour);
+        }
+    }
+
+    bool NavMeshQuery::FindPath(const NavMesh& navMesh, const glm::vec3& start, const glm::vec3& end, std::vector<glm::vec3>& outPath)
+    {
+        LUMOS_PROFILE_FUNCTION_LOW();
+        outPath.clear();
+
+        glm::vec3 startPoint, endPoint;
+        uint32_t startPolygon = navMesh.FindNearestPolygon(start, startPoint);
+        uint32_t endPolygon   = navMesh.FindNearestPolygon(end, endPoint);
+        if(startPolygon == NavMesh::InvalidPolygon || endPolygon == NavMesh::InvalidPolygon)
+            return false;
+
+        const auto& polygons = navMesh.GetPolygons();
+        const auto& links    = navMesh.GetLinks();
+
+        if(m_Nodes.size() != polygons.size())
+        {
+            m_Nodes.assign(polygons.size(), QueueablePathNode(nullptr));
+            m_EntryPoints.resize(polygons.size());
+        }
+
+        m_Search.Begin(m_Nodes);
+        m_EntryPoints[startPolygon] = startPoint;
+
+        QueueablePathNode* endNode = m_Search.Run(&m_Nodes[startPolygon], glm::distance(startPoint, endPoint), &m_Nodes[endPolygon], [&](QueueablePathNode* p)
+                                                  {
+            // Costs are measured between portal midpoints, centre to centre overestimates for long polygons
+            uint32_t index                = uint32_t(p - m_Nodes.data());
+            const NavMeshPolygon& polygon = polygons[index];
+            for(uint32_t l = polygon.FirstLink; l < polygon.FirstLink + polygon.LinkCount; l++)
+            {
+                const NavMeshLink& link = links[l];
+                glm::vec3 entryPoint    = (link.PortalA + link.PortalB) * 0.5f;
+                float cost              = glm::distance(m_EntryPoints[index], entryPoint);
+
+                if(m_Search.Relax(p, &m_Nodes[link.Polygon], cost, [&]() { return glm::distance(entryPoint, endPoint); }))
+                    m_EntryPoints[link.Polygon] = entryPoint;
+            } });
+
+        if(!endNode)
+            return false;
+
+        m_Polygons.clear();
+        for(QueueablePathNode* n = endNode; n; n = n->Parent)
+            m_Polygons.push_back(uint32_t(n - m_Nodes.data()));
+        std::reverse(m_Polygons.begin(), m_Polygons.end());
+
+        StringPull(navMesh, startPoint, endPoint, outPath);
+        return true;
+    }
+
+    void NavMeshQuery::StringPull(const NavMesh& navMesh, const glm::vec3& start, const glm::vec3& end, std::vector<glm::vec3>& outPath)
+    {
+        const auto& polygons = navMesh.GetPolygons();
+        const auto& links    = navMesh.GetLinks();
+
+        m_PortalLeft.clear();
+        m_PortalRight.clear();
+        m_PortalLeft.push_back(start);
+        m_PortalRight.push_back(start);
+
+        for(size_t i = 0; i + 1 < m_Polygons.size(); i++)
+        {
+            const NavMeshPolygon& from = polygons[m_Polygons[i]];
+            for(uint32_t l = from.FirstLink; l < from.FirstLink + from.LinkCount; l++)
+            {
+                if(links[l].Polygon != m_Polygons[i + 1])
+                    continue;
+
+                // Order the portal as seen walking through it
+                const glm::vec3& a = links[l].PortalA;
+                const glm::vec3& b = links[l].PortalB;
+                bool aIsLeft       = Cross2D(from.Centre, (a + b) * 0.5f, a) > 0.0f;
+                m_PortalLeft.push_back(aIsLeft ? a : b);
+                m_PortalRight.push_back(aIsLeft ? b : a);
+                break;
+            }
+        }
+
+        m_PortalLeft.push_back(end);
+        m_PortalRight.push_back(end);
+
+        // Simple stupid funnel algorithm
+        outPath.push_back(start);
+
+        glm::vec3 apex    = start;
+        glm::vec3 left    = m_PortalLeft[0];
+        glm::vec3 right   = m_PortalRight[0];
+        size_t apexIndex  = 0;
+        size_t leftIndex  = 0;
+        size_t rightIndex = 0;
+
+        for(size_t i = 1; i < m_PortalLeft.size(); i++)
+        {
+            const glm::vec3& portalLeft  = m_PortalLeft[i];
+            const glm::vec3& portalRight = m_PortalRight[i];
+
+            // Tighten the right side unless it crosses the left
+            if(Cross2D(apex, right, portalRight) >= 0.0f)
+            {
+                if(NearlyEqual(apex, right) || Cross2D(apex, left, portalRight) < 0.0f)
+                {
+                    right      = portalRight;
+                    rightIndex = i;
+                }
+                else
+                {
+                    // The left side becomes a corner, restart from it
+                    if(!NearlyEqual(outPath.back(), left))
+                        outPath.push_back(left);
+
+                    apex       = left;
+                    apexIndex  = leftIndex;
+                    left       = apex;
+                    right      = apex;
+                    leftIndex  = apexIndex;
+                    rightIndex = apexIndex;
+                    i          = apexIndex;
+                    continue;
+                }
+            }
+
+            // Tighten the left side unless it crosses the right
+            if(Cross2D(apex, left, portalLeft) <= 0.0f)
+            {
+                if(NearlyEqual(apex, left) || Cross2D(apex, right, portalLeft) > 0.0f)
+                {
+                    left      = portalLeft;
+                    leftIndex = i;
+                }
+                else
+                {
+                    if(!NearlyEqual(outPath.back(), right))
+                        outPath.push_back(right);
+
+                    apex       = right;
+                    apexIndex  = rightIndex;
+                    left       = apex;
+                    right      = apex;
+                    leftIndex  = apexIndex;
+                    rightIndex = apexIndex;
+                    i          = apexIndex;
+                    continue;
+                }
+            }
+        }
+
+        if(!NearlyEqual(outPath.back(), end))
+            outPath.push_back(end);
+    }
+}
@@ -0,0 +1,102 @@
+#pragma once
+#include "Core/Core.h"
+#include "QueueablePathNode.h"
+#include "PathSearch.h"
+#include <glm/vec3.hpp>
+#include <vector>
+
+namespace Lumos
+{
+    struct NavMeshSettings
+    {
+        float CellSize           = 0.3f;  // Horizontal voxel size
+        float CellHeight         = 0.2f;  // Vertical voxel size
+        float AgentHeight        = 2.0f;
+        float AgentRadius        = 0.5f;
+        float MaxClimb           = 0.4f;  // Highest step an agent walks up
+        float MaxSlope           = 45.0f; // Degrees
+        uint32_t MaxPolygonCells = 16;    // Longest polygon side in cells, keeps centre to centre costs honest
+    };
+
+    // Walkable quad covering a rectangle of voxel columns
+    struct NavMeshPolygon
+    {
+        glm::vec3 Vertices[4];
+        glm::vec3 Centre;
+        uint32_t FirstLink = 0;
+        uint32_t LinkCount = 0;
+    };
+
+    // Shared edge segment between two polygons
+    struct NavMeshLink
+    {
+        uint32_t Polygon; // Neighbour
+        glm::vec3 PortalA;
+        glm::vec3 PortalB;
+    };
+
+    // Walkable surface built by voxelising triangle soup. Static collision geometry is rasterised into
+    // columns of solid spans, the tops with enough headroom and a gentle enough slope become walkable
+    // cells, the cells near edges are eroded by the agent radius and the rest are merged into rectangles
+    class LUMOS_EXPORT NavMesh
+    {
+    public:
+        static constexpr uint32_t InvalidPolygon = ~0u;
+
+        // triangles holds three world space positions per triangle
+        bool Build(const std::vector<glm::vec3>& triangles, const NavMeshSettings& settings);
+
+        // Polygon under or nearest to point, searching maxDistance cells around it. outPoint is point snapped onto it
+        uint32_t FindNearestPolygon(const glm::vec3& point, glm::vec3& outPoint, uint32_t maxDistance = 4) const;
+
+        const std::vector<NavMeshPolygon>& GetPolygons() const { return m_Polygons; }
+        const std::vector<NavMeshLink>& GetLinks() const { return m_Links; }
+        const NavMeshSettings& GetSettings() const { return m_Settings; }
+
+        void DebugDraw() const;
+
+    private:
+        struct Cell
+        {
+            float Height;
+            float Ceiling;
+            uint32_t Neighbours[4]; // Cell index in the -x, +z, +x, -z columns, InvalidPolygon if blocked
+            uint32_t Polygon;
+            uint32_t Distance; // Steps to the nearest edge
+        };
+
+        static constexpr uint32_t ErodedCell = InvalidPolygon - 1;
+
+        uint32_t ColumnIndex(int x, int z) const { return uint32_t(z * m_Width + x); }
+
+        NavMeshSettings m_Settings;
+        glm::vec3 m_Origin = glm::vec3(0.0f);
+        int m_Width        = 0;
+        int m_Depth        = 0;
+
+        // Cells of column i are [m_ColumnOffsets[i], m_ColumnOffsets[i + 1]), lowest first
+        std::vector<uint32_t> m_ColumnOffsets;
+        std::vector<Cell> m_Cells;
+
+        std::vector<NavMeshPolygon> m_Polygons;
+        std::vector<NavMeshLink> m_Links;
+    };
+
+    // Per thread search state for paths over a NavMesh, consecutive queries reuse the node data without clearing
+    class LUMOS_EXPORT NavMeshQuery
+    {
+    public:
+        // Path from start to end snapped onto the mesh, straightened through the polygon portals
+        bool FindPath(const NavMesh& navMesh, const glm::vec3& start, const glm::vec3& end, std::vector<glm::vec3>& outPath);
+
+    private:
+        void StringPull(const NavMesh& navMesh, const glm::vec3& start, const glm::vec3& end, std::vector<glm::vec3>& outPath);
+
+        std::vector<QueueablePathNode> m_Nodes;
+        std::vector<glm::vec3> m_EntryPoints; // Where the best path so far enters each polygon
+        PathSearch m_Search;
+        std::vector<uint32_t> m_Polygons;
+        std::vector<glm::vec3> m_PortalLeft;
+        std::vector<glm::vec3> m_PortalRight;
+    };
+}
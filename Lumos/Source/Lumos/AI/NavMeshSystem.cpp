@@ -0,0 +1,199 @@
+#include "Precompiled.h"
+#include "NavMeshSystem.h"
+#include "Graphics/Model.h"
+#include "Maths/Transform.h"
+#include "Physics/LumosPhysicsEngine/CollisionShapes/CuboidCollisionShape.h"
+#include "Scene/Component/ModelComponent.h"
+#include "Scene/Component/RigidBody3DComponent.h"
+#include "Scene/Scene.h"
+#include "ImGui/ImGuiUtilities.h"
+#include "Utilities/Timer.h"
+#include <imgui/imgui.h>
+
+namespace Lumos
+{
+    NavMeshSystem::NavMeshSystem()
+    {
+        m_DebugName = "Navigation";
+    }
+
+    NavMeshSystem::~NavMeshSystem()
+    {
+        System::JobSystem::Wait(m_JobContext);
+    }
+
+    void NavMeshSystem::OnInit()
+    {
+    }
+
+    void NavMeshSystem::OnNewScene(Scene* scene)
+    {
+        m_BuildPending = true;
+    }
+
+    void NavMeshSystem::OnUpdate(const TimeStep& dt, Scene* scene)
+    {
+        LUMOS_PROFILE_FUNCTION();
+
+        if(m_BuildPending)
+            Build(scene);
+
+        if(System::JobSystem::IsBusy(m_JobContext))
+            return;
+
+        m_Batch.clear();
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_QueuedCount = uint32_t(m_Requests.size());
+
+            uint32_t count = Maths::Min(m_QueryBudget, uint32_t(m_Requests.size()));
+            m_Batch.insert(m_Batch.end(), m_Requests.begin(), m_Requests.begin() + count);
+            m_Requests.erase(m_Requests.begin(), m_Requests.begin() + count);
+        }
+
+        m_LastBatchSize = uint32_t(m_Batch.size());
+        if(m_Batch.empty())
+            return;
+
+        if(!m_NavMesh)
+        {
+            for(auto& request : m_Batch)
+                request->State = PathRequestState::Failed;
+            m_Batch.clear();
+            return;
+        }
+
+        uint32_t groupCount = System::JobSystem::DispatchGroupCount(uint32_t(m_Batch.size()), m_QueriesPerJob);
+        while(m_Queries.size() < groupCount)
+            m_Queries.push_back(CreateUniquePtr<NavMeshQuery>());
+
+        m_BatchNavMesh = m_NavMesh;
+        System::JobSystem::Dispatch(m_JobContext, uint32_t(m_Batch.size()), m_QueriesPerJob, [this](JobDispatchArgs args)
+                                    {
+            auto& request  = m_Batch[args.jobIndex];
+            bool found     = m_Queries[args.groupID]->FindPath(*m_BatchNavMesh, request->Start, request->End, request->Path);
+            request->State = found ? PathRequestState::Ready : PathRequestState::Failed; });
+    }
+
+    SharedPtr<NavMeshPathRequest> NavMeshSystem::RequestPath(const glm::vec3& start, const glm::vec3& end)
+    {
+        auto request   = CreateSharedPtr<NavMeshPathRequest>();
+        request->Start = start;
+        request->End   = end;
+
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Requests.push_back(request);
+        return request;
+    }
+
+    void NavMeshSystem::SetNavMesh(const SharedPtr<NavMesh>& navMesh)
+    {
+        // The batch in flight keeps its own reference
+        m_NavMesh      = navMesh;
+        m_BuildPending = false;
+    }
+
+    void NavMeshSystem::Build(Scene* scene)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        auto start = Timer::Now();
+
+        std::vector<glm::vec3> triangles;
+        auto& registry = scene->GetRegistry();
+
+        auto models = registry.view<Graphics::ModelComponent, Maths::Transform>();
+        for(auto entity : models)
+        {
+            // Anything that can move is left out of the static geometry
+            auto body = registry.try_get<RigidBody3DComponent>(entity);
+            if(body && !body->GetRigidBody()->GetIsStatic())
+                continue;
+
+            const auto& model = models.get<Graphics::ModelComponent>(entity).ModelRef;
+            if(!model)
+                continue;
+
+            glm::mat4 transform = models.get<Maths::Transform>(entity).GetWorldMatrix();
+            for(auto& mesh : model->GetMeshes())
+            {
+                const auto& vertices = mesh->GetVertices();
+                const auto& indices  = mesh->GetIndices();
+                for(auto index : indices)
+                    triangles.push_back(glm::vec3(transform * glm::vec4(vertices[index].Position, 1.0f)));
+            }
+        }
+
+        // Unit cube faces, scaled by each shape's half dimensions
+        static const int cubeFaces[6][4] = { { 0, 1, 3, 2 }, { 4, 6, 7, 5 }, { 0, 4, 5, 1 }, { 2, 3, 7, 6 }, { 0, 2, 6, 4 }, { 1, 5, 7, 3 } };
+
+        auto bodies = registry.view<RigidBody3DComponent>();
+        for(auto entity : bodies)
+        {
+            RigidBody3D* body = bodies.get<RigidBody3DComponent>(entity).GetRigidBody();
+            if(!body->GetIsStatic() || !body->GetCollisionShape() || body->GetCollisionShape()->GetType() != CollisionCuboid)
+                continue;
+
+            auto shape          = static_cast<CuboidCollisionShape*>(body->GetCollisionShape().get());
+            glm::mat4 transform = body->GetWorldSpaceTransform() * glm::scale(glm::mat4(1.0f), shape->GetHalfDimensions());
+
+            glm::vec3 corners[8];
+            for(int i = 0; i < 8; i++)
+                corners[i] = glm::vec3(transform * glm::vec4(i & 1 ? 1.0f : -1.0f, i & 2 ? 1.0f : -1.0f, i & 4 ? 1.0f : -1.0f, 1.0f));
+
+            for(auto& face : cubeFaces)
+                triangles.insert(triangles.end(), { corners[face[0]], corners[face[1]], corners[face[2]], corners[face[0]], corners[face[2]], corners[face[3]] });
+        }
+
+        auto navMesh = CreateSharedPtr<NavMesh>();
+        if(navMesh->Build(triangles, m_Settings))
+            SetNavMesh(navMesh);
+        else
+            SetNavMesh(nullptr);
+
+        m_BuildTime = Timer::Duration(start, Timer::Now(), 1000.0f);
+    }
+
+    void NavMeshSystem::OnImGui()
+    {
+        LUMOS_PROFILE_FUNCTION();
+        ImGuiUtilities::PushID();
+
+        ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(2, 2));
+        ImGui::Columns(2);
+        ImGui::Separator();
+
+        ImGuiUtilities::Property("Cell Size", m_Settings.CellSize, 0.05f, 2.0f, 0.01f);
+        ImGuiUtilities::Property("Cell Height", m_Settings.CellHeight, 0.05f, 2.0f, 0.01f);
+        ImGuiUtilities::Property("Agent Height", m_Settings.AgentHeight, 0.1f, 10.0f, 0.1f);
+        ImGuiUtilities::Property("Agent Radius", m_Settings.AgentRadius, 0.0f, 5.0f, 0.05f);
+        ImGuiUtilities::Property("Max Climb", m_Settings.MaxClimb, 0.0f, 5.0f, 0.05f);
+        ImGuiUtilities::Property("Max Slope", m_Settings.MaxSlope, 0.0f, 89.0f, 1.0f);
+        ImGuiUtilities::Property("Max Polygon Cells", m_Settings.MaxPolygonCells, 1u, 64u);
+        ImGuiUtilities::Property("Query Budget", m_QueryBudget, 1u, 1024u);
+        ImGuiUtilities::Property("Queries Per Job", m_QueriesPerJob, 1u, 64u);
+        ImGuiUtilities::Property("Debug Draw", m_DebugDraw);
+
+        ImGuiUtilities::PropertyConst("Polygons", std::to_string(m_NavMesh ? m_NavMesh->GetPolygons().size() : 0).c_str());
+        ImGuiUtilities::PropertyConst("Queued Requests", std::to_string(m_QueuedCount).c_str());
+        ImGuiUtilities::PropertyConst("Last Batch", std::to_string(m_LastBatchSize).c_str());
+        ImGuiUtilities::PropertyConst("Build Time (ms)", std::to_string(m_BuildTime).c_str());
+
+        ImGui::Columns(1);
+        ImGui::Separator();
+        ImGui::PopStyleVar();
+
+        if(ImGui::Button("Build"))
+        {
+            if(auto scene = Application::Get().GetCurrentScene())
+                Build(scene);
+        }
+
+        ImGuiUtilities::PopID();
+    }
+
+    void NavMeshSystem::OnDebugDraw()
+    {
+        if(m_DebugDraw && m_NavMesh)
+            m_NavMesh->DebugDraw();
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include "NavMesh.h"
+#include "Scene/ISystem.h"
+#include "Core/JobSystem.h"
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+namespace Lumos
+{
+    enum class PathRequestState : uint8_t
+    {
+        Pending,
+        Ready,
+        Failed
+    };
+
+    // Filled in on a job thread, Path is only safe to read once State is no longer Pending
+    struct NavMeshPathRequest
+    {
+        glm::vec3 Start;
+        glm::vec3 End;
+        std::vector<glm::vec3> Path;
+        std::atomic<PathRequestState> State = PathRequestState::Pending;
+    };
+
+    // Owns the scene's navmesh and answers path requests in batches on the job system.
+    // Each update starts at most QueryBudget queued requests, and only once the previous batch
+    // finished, so the main thread never waits on path finding
+    class LUMOS_EXPORT NavMeshSystem : public ISystem
+    {
+    public:
+        NavMeshSystem();
+        ~NavMeshSystem();
+
+        void OnInit() override;
+        void OnUpdate(const TimeStep& dt, Scene* scene) override;
+        void OnImGui() override;
+        void OnDebugDraw() override;
+
+        // Rebuilds on the next update, unless a navmesh is set first. Loading a scene notifies more than once
+        void OnNewScene(Scene* scene);
+
+        // Voxelises the scene's static geometry: model meshes on entities without a dynamic rigid body,
+        // and the cuboid collision shapes of static rigid bodies
+        void Build(Scene* scene);
+
+        void SetNavMesh(const SharedPtr<NavMesh>& navMesh);
+        const SharedPtr<NavMesh>& GetNavMesh() const { return m_NavMesh; }
+
+        SharedPtr<NavMeshPathRequest> RequestPath(const glm::vec3& start, const glm::vec3& end);
+
+        NavMeshSettings& GetSettings() { return m_Settings; }
+
+        void SetQueryBudget(uint32_t budget) { m_QueryBudget = budget; }
+        uint32_t GetQueryBudget() const { return m_QueryBudget; }
+
+    private:
+        NavMeshSettings m_Settings;
+        SharedPtr<NavMesh> m_NavMesh;
+
+        std::mutex m_Mutex;
+        std::deque<SharedPtr<NavMeshPathRequest>> m_Requests;
+
+        // Owned by the batch in flight
+        System::JobSystem::Context m_JobContext;
+        SharedPtr<NavMesh> m_BatchNavMesh;
+        std::vector<SharedPtr<NavMeshPathRequest>> m_Batch;
+        std::vector<UniquePtr<NavMeshQuery>> m_Queries; // One per job group, groups run their queries serially
+
+        uint32_t m_QueryBudget   = 64;
+        uint32_t m_QueriesPerJob = 8;
+        bool m_DebugDraw         = false;
+        bool m_BuildPending      = true;
+
+        uint32_t m_LastBatchSize = 0;
+        uint32_t m_QueuedCount   = 0;
+        float m_BuildTime        = 0.0f;
+    };
+}
@@ -38,12 +38,32 @@ namespace Lumos
 
     void PathEdge::SetTraversable(bool traversable)
     {
+        if(m_Traversable == traversable)
+            return;
+
         m_Traversable = traversable;
+        for(auto listener : m_Listeners)
+            listener->OnEdgeChanged(this);
     }
 
     void PathEdge::SetWeight(float weight)
     {
+        if(m_Weight == weight)
+            return;
+
         m_Weight = weight;
+        for(auto listener : m_Listeners)
+            listener->OnEdgeChanged(this);
+    }
+
+    void PathEdge::AddListener(PathEdgeListener* listener)
+    {
+        m_Listeners.push_back(listener);
+    }
+
+    void PathEdge::RemoveListener(PathEdgeListener* listener)
+    {
+        m_Listeners.erase(std::remove(m_Listeners.begin(), m_Listeners.end(), listener), m_Listeners.end());
     }
 
     bool PathEdge::operator==(const PathEdge& other) const
@@ -4,6 +4,15 @@
 
 namespace Lumos
 {
+    class PathEdge;
+
+    // Told when an edge's traversability or weight changes, so cached searches can be invalidated
+    class LUMOS_EXPORT PathEdgeListener
+    {
+    public:
+        virtual ~PathEdgeListener() = default;
+        virtual void OnEdgeChanged(PathEdge* edge) = 0;
+    };
 
     class LUMOS_EXPORT PathEdge
     {
@@ -43,6 +52,9 @@ namespace Lumos
         void SetTraversable(bool traversable);
         void SetWeight(float weight);
 
+        void AddListener(PathEdgeListener* listener);
+        void RemoveListener(PathEdgeListener* listener);
+
         bool IsOnPath(const std::vector<PathNode*>& path) const
         {
             auto aIt = std::find(path.begin(), path.end(), m_NodeA);
@@ -56,6 +68,7 @@ namespace Lumos
     private:
         PathNode* m_NodeA;
         PathNode* m_NodeB;
+        std::vector<PathEdgeListener*> m_Listeners;
 
     protected:
         bool m_Traversable;
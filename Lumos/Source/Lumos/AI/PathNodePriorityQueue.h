@@ -4,45 +4,111 @@
 namespace Lumos
 {
 
-    class PathNodePriorityQueue : public std::vector<QueueablePathNode*>
+    // Binary min-heap on fScore. Every node stores its own position in the heap, so a node whose
+    // score went down is sifted up in place and membership is checked without searching
+    class PathNodePriorityQueue
     {
     public:
-        PathNodePriorityQueue()
-            : std::vector<QueueablePathNode*>()
-        //, m_comp()
+        bool Empty() const
         {
-            // std::make_heap(begin(), end(), m_comp);
+            return m_Heap.empty();
+        }
+
+        size_t Size() const
+        {
+            return m_Heap.size();
+        }
+
+        void Clear()
+        {
+            m_Heap.clear();
         }
 
         void Push(QueueablePathNode* item)
         {
-            push_back(item);
-            // std::push_heap(begin(), end(), m_comp);
+            item->HeapIndex = uint32_t(m_Heap.size());
+            m_Heap.push_back(item);
+            SiftUp(item->HeapIndex);
         }
 
         void Pop()
         {
-            // std::pop_heap(begin(), end(), m_comp);
-            pop_back();
+            Swap(0, uint32_t(m_Heap.size() - 1));
+            m_Heap.back()->HeapIndex = InvalidIndex;
+            m_Heap.pop_back();
+
+            if(!m_Heap.empty())
+                SiftDown(0);
         }
 
         QueueablePathNode* Top() const
         {
-            return front();
+            return m_Heap.front();
+        }
+
+        bool Contains(const QueueablePathNode* item) const
+        {
+            return item->HeapIndex < m_Heap.size() && m_Heap[item->HeapIndex] == item;
         }
 
-        std::vector<QueueablePathNode*>::const_iterator Find(QueueablePathNode* item) const
+        // Call after lowering the fScore of a node that is already queued
+        void DecreaseKey(QueueablePathNode* item)
         {
-            return std::find(cbegin(), cend(), item);
+            SiftUp(item->HeapIndex);
         }
 
-        void Update()
+        // Heap order, only the first node is sorted
+        const std::vector<QueueablePathNode*>& Nodes() const
         {
-            // std::make_heap(begin(), end(), m_comp);
+            return m_Heap;
         }
 
+        static constexpr uint32_t InvalidIndex = ~0u;
+
     private:
-        // greater_ptr<QueueablePathNode> m_comp;
+        void SiftUp(uint32_t index)
+        {
+            while(index > 0)
+            {
+                uint32_t parent = (index - 1) / 2;
+                if(*m_Heap[parent] <= *m_Heap[index])
+                    break;
+
+                Swap(index, parent);
+                index = parent;
+            }
+        }
+
+        void SiftDown(uint32_t index)
+        {
+            uint32_t size = uint32_t(m_Heap.size());
+            while(true)
+            {
+                uint32_t smallest = index;
+                uint32_t left     = index * 2 + 1;
+                uint32_t right    = left + 1;
+
+                if(left < size && *m_Heap[left] < *m_Heap[smallest])
+                    smallest = left;
+                if(right < size && *m_Heap[right] < *m_Heap[smallest])
+                    smallest = right;
+
+                if(smallest == index)
+                    break;
+
+                Swap(index, smallest);
+                index = smallest;
+            }
+        }
+
+        void Swap(uint32_t a, uint32_t b)
+        {
+            std::swap(m_Heap[a], m_Heap[b]);
+            m_Heap[a]->HeapIndex = a;
+            m_Heap[b]->HeapIndex = b;
+        }
+
+        std::vector<QueueablePathNode*> m_Heap;
     };
 
-}
\ No newline at end of file
+}
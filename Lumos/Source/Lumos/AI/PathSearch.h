@@ -0,0 +1,103 @@
+#pragma once
+#include "PathNodePriorityQueue.h"
+#include "QueueablePathNode.h"
+#include <vector>
+
+namespace Lumos
+{
+
+    // The A* loop shared by AStar, HierarchicalAStar and NavMeshQuery. Node scores are stamped with the
+    // search generation, so a search only resets the nodes it reaches. Each graph supplies its own
+    // neighbours: Run calls expand for every node it closes, and expand calls Relax once per neighbour.
+    // Closed nodes are never reopened, so the heuristic must be consistent
+    class PathSearch
+    {
+    public:
+        // Constant time, node data only needs a full clear when the generation wraps
+        void Begin(std::vector<QueueablePathNode>& nodes)
+        {
+            m_OpenList.Clear();
+            if(++m_Generation == 0)
+            {
+                for(auto& node : nodes)
+                    node.Generation = 0;
+                m_Generation = 1;
+            }
+        }
+
+        // Returns goal once it is closed, or nullptr when it is unreachable.
+        // A null goal closes every node reachable from start
+        template <typename Expand>
+        QueueablePathNode* Run(QueueablePathNode* start, float heuristic, const QueueablePathNode* goal, Expand&& expand)
+        {
+            Visit(start);
+            start->gScore = 0.0f;
+            start->fScore = heuristic;
+            m_OpenList.Push(start);
+
+            while(!m_OpenList.Empty())
+            {
+                QueueablePathNode* p = m_OpenList.Top();
+                m_OpenList.Pop();
+                if(p->Closed)
+                    continue;
+
+                p->Closed = true;
+                if(p == goal)
+                    return p;
+
+                expand(p);
+            }
+
+            return nullptr;
+        }
+
+        // Reaches q through p, heuristic is only evaluated when this is the best path to q so far.
+        // Returns false when q is closed or already has a path at least as cheap
+        template <typename Heuristic>
+        bool Relax(QueueablePathNode* p, QueueablePathNode* q, float cost, Heuristic&& heuristic)
+        {
+            float gScore = p->gScore + cost;
+            if(q->Generation != m_Generation)
+                Visit(q);
+            else if(q->Closed || q->gScore <= gScore)
+                return false;
+
+            q->Parent = p;
+            q->gScore = gScore;
+            q->fScore = gScore + heuristic();
+
+            if(m_OpenList.Contains(q))
+                m_OpenList.DecreaseKey(q);
+            else
+                m_OpenList.Push(q);
+
+            return true;
+        }
+
+        // Whether node's scores belong to the last search
+        bool Reached(const QueueablePathNode& node) const
+        {
+            return node.Generation == m_Generation;
+        }
+
+        const PathNodePriorityQueue& OpenList() const
+        {
+            return m_OpenList;
+        }
+
+    private:
+        void Visit(QueueablePathNode* node)
+        {
+            node->Parent     = nullptr;
+            node->fScore     = std::numeric_limits<float>::max();
+            node->gScore     = std::numeric_limits<float>::max();
+            node->Generation = m_Generation;
+            node->Closed     = false;
+        }
+
+        PathNodePriorityQueue m_OpenList;
+        uint32_t m_Generation = 0;
+    };
+
+}
@@ -16,6 +16,9 @@ namespace Lumos
             , Parent(nullptr)
             , fScore(std::numeric_limits<float>::max())
             , gScore(std::numeric_limits<float>::max())
+            , HeapIndex(~0u)
+            , Generation(0)
+            , Closed(false)
         {
         }
 
@@ -55,6 +58,9 @@ namespace Lumos
         QueueablePathNode* Parent; //!< Parent Node in path
         float fScore;              //!< F score of wrapped node
         float gScore;              //!< G score of wrapped node
+        uint32_t HeapIndex;        //!< Position in the open list heap
+        uint32_t Generation;       //!< Search the scores belong to, older values count as unvisited
+        bool Closed;               //!< On the closed list of search Generation
     };
 
 }
\ No newline at end of file
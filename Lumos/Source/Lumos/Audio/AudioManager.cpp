@@ -1,8 +1,11 @@
 #include "Precompiled.h"
 #include "AudioManager.h"
+#include "AudioStream.h"
 #include "Core/Application.h"
 #include "Scene/Scene.h"
 #include "Scene/Component/SoundComponent.h"
+#include "Software/SoftwareAudioManager.h"
+#include "Software/AudioSink.h"
 
 #ifdef LUMOS_OPENAL
 #include "Platform/OpenAL/ALManager.h"
@@ -10,13 +13,37 @@
 
 namespace Lumos
 {
+#ifdef LUMOS_OPENAL
+    AudioBackend AudioManager::s_Backend = AudioBackend::OpenAL;
+#else
+    AudioBackend AudioManager::s_Backend = AudioBackend::Software;
+#endif
+    std::string AudioManager::s_OutputPath;
+
     AudioManager* AudioManager::Create()
     {
 #ifdef LUMOS_OPENAL
-        return new Audio::ALManager();
-#else
-        return nullptr;
+        if(s_Backend == AudioBackend::OpenAL)
+            return new Audio::ALManager();
+#endif
+
+        if(s_OutputPath.empty())
+            return new Audio::SoftwareAudioManager(CreateUniquePtr<NullAudioSink>());
+
+        return new Audio::SoftwareAudioManager(CreateUniquePtr<WavAudioSink>(s_OutputPath));
+    }
+
+    void AudioManager::SetBackend(AudioBackend backend, const std::string& outputPath)
+    {
+#ifndef LUMOS_OPENAL
+        backend = AudioBackend::Software;
 #endif
+        s_Backend    = backend;
+        s_OutputPath = outputPath;
+    }
+
+    AudioManager::~AudioManager()
+    {
     }
 
     void AudioManager::SetPaused(bool paused)
@@ -7,6 +7,13 @@ namespace Lumos
 {
     class Camera;
     class SoundNode;
+    class AudioStreamThread;
+
+    enum class AudioBackend
+    {
+        OpenAL,
+        Software
+    };
 
     struct Listener
     {
@@ -30,7 +37,12 @@ namespace Lumos
     public:
         static AudioManager* Create();
 
-        virtual ~AudioManager()                                          = default;
+        // Picks what Create, Sound::Create and SoundNode::Create make, set it before the application is created.
+        // The software mixer writes to outputPath as a wav file, or discards its output when empty
+        static void SetBackend(AudioBackend backend, const std::string& outputPath = "");
+        static AudioBackend GetBackend() { return s_Backend; }
+
+        virtual ~AudioManager();
         virtual void OnInit() override                                   = 0;
         virtual void OnUpdate(const TimeStep& dt, Scene* scene) override = 0;
         virtual void UpdateListener(Scene* scene) {};
@@ -49,8 +61,15 @@ namespace Lumos
         bool GetPaused() const { return m_Paused; }
         void SetPaused(bool paused);
 
+        // nullptr until the manager is initialised, streaming sources decode on the calling thread until then
+        AudioStreamThread* GetStreamThread() const { return m_StreamThread.get(); }
+
     protected:
         std::vector<SoundNode*> m_SoundNodes;
         bool m_Paused;
+        UniquePtr<AudioStreamThread> m_StreamThread;
+
+        static AudioBackend s_Backend;
+        static std::string s_OutputPath;
     };
 }
@@ -0,0 +1,158 @@
+#include "Precompiled.h"
+#include "AudioStream.h"
+#include "OggLoader.h"
+#include "WavLoader.h"
+
+namespace Lumos
+{
+    UniquePtr<AudioDecoder> AudioDecoder::Create(const std::string& fileName, const std::string& extension)
+    {
+        UniquePtr<AudioDecoder> decoder;
+        if(extension == "ogg")
+            decoder = CreateUniquePtr<OggDecoder>(fileName);
+        else if(extension == "wav")
+            decoder = CreateUniquePtr<WavDecoder>(fileName);
+
+        if(decoder && decoder->GetInfo().Size == 0)
+            decoder.reset();
+
+        return decoder;
+    }
+
+    AudioStream::AudioStream(UniquePtr<AudioDecoder>&& decoder, bool looping)
+        : m_Decoder(std::move(decoder))
+        , m_Looping(looping)
+    {
+    }
+
+    AudioStream::~AudioStream()
+    {
+    }
+
+    bool AudioStream::Decode()
+    {
+        LUMOS_PROFILE_FUNCTION_LOW();
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        if(m_EndOfFile || m_Chunks.size() >= ChunkCount)
+            return false;
+
+        std::vector<uint8_t> chunk;
+        if(!m_FreeChunks.empty())
+        {
+            chunk = std::move(m_FreeChunks.back());
+            m_FreeChunks.pop_back();
+        }
+        chunk.resize(ChunkSize);
+
+        uint32_t size = 0;
+        bool rewound  = false;
+        while(size < ChunkSize)
+        {
+            uint32_t read = m_Decoder->Read(chunk.data() + size, ChunkSize - size);
+            size += read;
+
+            if(read > 0)
+            {
+                rewound = false;
+                continue;
+            }
+
+            // Rewinding twice in a row without reading anything means the file is empty
+            if(m_Looping && !rewound && m_Decoder->Seek(0.0))
+            {
+                rewound = true;
+                continue;
+            }
+
+            m_EndOfFile = true;
+            break;
+        }
+
+        chunk.resize(size);
+        if(size > 0)
+            m_Chunks.push_back(std::move(chunk));
+
+        m_Finished = m_EndOfFile && m_Chunks.empty();
+        return true;
+    }
+
+    bool AudioStream::PopChunk(std::vector<uint8_t>& chunk)
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex, std::try_to_lock);
+        if(!lock.owns_lock() || m_Chunks.empty())
+            return false;
+
+        std::swap(chunk, m_Chunks.front());
+        m_FreeChunks.push_back(std::move(m_Chunks.front()));
+        m_Chunks.pop_front();
+        m_Finished = m_EndOfFile && m_Chunks.empty();
+        return true;
+    }
+
+    AudioStreamThread::AudioStreamThread()
+    {
+        m_Thread = std::thread([this]
+                               {
+            LUMOS_PROFILE_SETTHREADNAME("Audio Decode");
+            Run(); });
+    }
+
+    AudioStreamThread::~AudioStreamThread()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Running = false;
+        }
+
+        m_Condition.notify_one();
+        m_Thread.join();
+    }
+
+    void AudioStreamThread::AddStream(const SharedPtr<AudioStream>& stream)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_Streams.push_back(stream);
+        }
+
+        // Fill the new stream straight away so playback can start next update
+        m_Condition.notify_one();
+    }
+
+    uint32_t AudioStreamThread::GetStreamCount()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return uint32_t(m_Streams.size());
+    }
+
+    void AudioStreamThread::Run()
+    {
+        std::vector<SharedPtr<AudioStream>> streams;
+
+        while(true)
+        {
+            {
+                // Sources consume a chunk every few hundred milliseconds, so polling is plenty
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_Condition.wait_for(lock, std::chrono::milliseconds(10));
+
+                if(!m_Running)
+                    break;
+
+                m_Streams.erase(std::remove_if(m_Streams.begin(), m_Streams.end(), [](const SharedPtr<AudioStream>& stream)
+                                               { return stream->IsReleased(); }),
+                                m_Streams.end());
+                streams = m_Streams;
+            }
+
+            LUMOS_PROFILE_SCOPE("Audio Decode");
+            for(auto& stream : streams)
+            {
+                while(!stream->IsReleased() && stream->Decode())
+                    ;
+            }
+
+            streams.clear();
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include "AudioData.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace Lumos
+{
+    // Incremental PCM decoder for one playing instance of a sound. Info describes the decoded
+    // output, Data is always nullptr and Size is the full decoded size in bytes
+    class LUMOS_EXPORT AudioDecoder
+    {
+    public:
+        static UniquePtr<AudioDecoder> Create(const std::string& fileName, const std::string& extension);
+
+        virtual ~AudioDecoder() = default;
+
+        // Returns the number of bytes written, 0 at the end of the file
+        virtual uint32_t Read(uint8_t* output, uint32_t size) = 0;
+        virtual bool Seek(double milliseconds)                = 0;
+
+        const AudioData& GetInfo() const { return m_Info; }
+
+    protected:
+        AudioData m_Info;
+    };
+
+    // Ring of decoded chunks between the decode thread and a streaming source.
+    // Decode runs on the decode thread, PopChunk on the thread that feeds the audio API
+    class LUMOS_EXPORT AudioStream
+    {
+    public:
+        static constexpr uint32_t ChunkSize  = 32 * 1024;
+        static constexpr uint32_t ChunkCount = 4;
+
+        AudioStream(UniquePtr<AudioDecoder>&& decoder, bool looping);
+        ~AudioStream();
+
+        NONCOPYABLE(AudioStream);
+
+        // Decodes one chunk if there is room. Returns false when there was nothing to do
+        bool Decode();
+
+        // Swaps the oldest decoded chunk into chunk, the previous contents of chunk are reused for decoding.
+        // Never blocks, returns false when no chunk is ready or the decode thread is busy with this stream
+        bool PopChunk(std::vector<uint8_t>& chunk);
+
+        void SetLooping(bool looping) { m_Looping = looping; }
+
+        // True once the decoder reached the end and every chunk was taken. Lock free, so it
+        // never waits for a chunk being decoded
+        bool IsFinished() const { return m_Finished; }
+
+        // Tells the decode thread to drop the stream
+        void Release() { m_Released = true; }
+        bool IsReleased() const { return m_Released; }
+
+        const AudioData& GetInfo() const { return m_Decoder->GetInfo(); }
+
+    private:
+        UniquePtr<AudioDecoder> m_Decoder;
+        std::mutex m_Mutex;
+        std::deque<std::vector<uint8_t>> m_Chunks;
+        std::vector<std::vector<uint8_t>> m_FreeChunks;
+        std::atomic<bool> m_Looping;
+        std::atomic<bool> m_Released = false;
+        std::atomic<bool> m_Finished = false;
+        bool m_EndOfFile             = false;
+    };
+
+    // Background thread keeping every registered stream's chunk ring full
+    class LUMOS_EXPORT AudioStreamThread
+    {
+    public:
+        AudioStreamThread();
+        ~AudioStreamThread();
+
+        NONCOPYABLE(AudioStreamThread);
+
+        void AddStream(const SharedPtr<AudioStream>& stream);
+
+        uint32_t GetStreamCount();
+
+    private:
+        void Run();
+
+        std::thread m_Thread;
+        std::mutex m_Mutex;
+        std::condition_variable m_Condition;
+        std::vector<SharedPtr<AudioStream>> m_Streams;
+        bool m_Running = true;
+    };
+}
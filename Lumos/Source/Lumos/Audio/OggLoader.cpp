@@ -10,47 +10,76 @@ namespace Lumos
 {
     AudioData LoadOgg(const std::string& fileName)
     {
-        AudioData data = AudioData();
+        OggDecoder decoder(fileName);
+        AudioData data = decoder.GetInfo();
+        if(data.Size == 0)
+            return data;
 
-        std::string physicalPath;
-        if(!Lumos::VFS::Get().ResolvePhysicalPath(fileName, physicalPath))
-        {
-            LUMOS_LOG_INFO("Failed to load Ogg file : File Not Found");
-        }
+        data.Data = new unsigned char[data.Size];
+        data.Size = decoder.Read(data.Data, data.Size);
 
-        const auto m_FileHandle = fopen(physicalPath.c_str(), "rb");
+        return data;
+    }
 
-        if(!m_FileHandle)
+    OggDecoder::OggDecoder(const std::string& fileName)
+    {
+        // Streams straight from the pack or a mapping of the file
+        if(!Lumos::VFS::Get().MapFile(fileName, m_File))
         {
-            LUMOS_LOG_CRITICAL("Failed to load OGG file '{0}'!", physicalPath);
+            LUMOS_LOG_INFO("Failed to load Ogg file : File Not Found");
+            return;
         }
-        int error;
-        auto m_StreamHandle = stb_vorbis_open_filename(physicalPath.c_str(), &error, nullptr);
 
-        if(!m_StreamHandle)
+        int error = 0;
+        m_Handle  = stb_vorbis_open_memory(m_File.Data, int(m_File.Size), &error, nullptr);
+
+        if(!m_Handle)
         {
-            LUMOS_LOG_CRITICAL("Failed to load OGG file '{0}'! , Error {1}", physicalPath, error);
-            return data;
+            LUMOS_LOG_CRITICAL("Failed to load OGG file '{0}'! , Error {1}", fileName, error);
+            return;
         }
 
         // Get file info
-        const stb_vorbis_info m_VorbisInfo = stb_vorbis_get_info(m_StreamHandle);
-        data.Channels                      = m_VorbisInfo.channels;
-        data.BitRate                       = 16;
-        data.FreqRate                      = static_cast<float>(m_VorbisInfo.sample_rate);
-        data.Size                          = stb_vorbis_stream_length_in_samples(m_StreamHandle) * m_VorbisInfo.channels * sizeof(int16_t);
-        data.Data                          = new unsigned char[data.Size];
+        const stb_vorbis_info vorbisInfo = stb_vorbis_get_info(m_Handle);
+        m_SourceChannels                 = vorbisInfo.channels;
+        m_Info.Channels                  = 1;
+        m_Info.BitRate                   = 16;
+        m_Info.FreqRate                  = static_cast<float>(vorbisInfo.sample_rate);
+        m_Info.Size                      = stb_vorbis_stream_length_in_samples(m_Handle) * sizeof(int16_t);
+        m_Info.Length                    = stb_vorbis_stream_length_in_seconds(m_Handle) * 1000.0f; // Milliseconds
+    }
 
-        stb_vorbis_get_samples_short_interleaved(m_StreamHandle, m_VorbisInfo.channels, reinterpret_cast<short*>(data.Data), data.Size);
+    OggDecoder::~OggDecoder()
+    {
+        if(m_Handle)
+            stb_vorbis_close(m_Handle);
+    }
 
-        Sound::ConvertToMono(data.Data, data.Size, data.Data, data.Channels, data.BitRate);
-        data.Channels = 1;
-        data.Length   = stb_vorbis_stream_length_in_seconds(m_StreamHandle) * 1000.0f; // Milliseconds
+    uint32_t OggDecoder::Read(uint8_t* output, uint32_t size)
+    {
+        LUMOS_PROFILE_FUNCTION_LOW();
+        if(!m_Handle)
+            return 0;
 
-        stb_vorbis_close(m_StreamHandle);
+        uint32_t frames = size / sizeof(int16_t);
+        m_Interleaved.resize(size_t(frames) * m_SourceChannels);
 
-        fclose(m_FileHandle);
+        int framesRead = stb_vorbis_get_samples_short_interleaved(m_Handle, m_SourceChannels, m_Interleaved.data(), int(m_Interleaved.size()));
+        if(framesRead <= 0)
+            return 0;
 
-        return data;
+        Sound::ConvertToMono(reinterpret_cast<const uint8_t*>(m_Interleaved.data()), framesRead * m_SourceChannels * sizeof(int16_t), output, m_SourceChannels, 16);
+        return framesRead * sizeof(int16_t);
+    }
+
+    bool OggDecoder::Seek(double milliseconds)
+    {
+        if(!m_Handle)
+            return false;
+
+        if(milliseconds <= 0.0)
+            return stb_vorbis_seek_start(m_Handle) != 0;
+
+        return stb_vorbis_seek(m_Handle, uint32_t(milliseconds * 0.001 * m_Info.FreqRate)) != 0;
     }
 }
@@ -1,7 +1,28 @@
 #pragma once
 #include "AudioData.h"
+#include "AudioStream.h"
+#include "Core/VFS.h"
+
+struct stb_vorbis;
 
 namespace Lumos
 {
     AudioData LoadOgg(const std::string& fileName);
-}
\ No newline at end of file
+
+    // Decodes to 16 bit mono, the same as LoadOgg
+    class OggDecoder : public AudioDecoder
+    {
+    public:
+        OggDecoder(const std::string& fileName);
+        ~OggDecoder();
+
+        uint32_t Read(uint8_t* output, uint32_t size) override;
+        bool Seek(double milliseconds) override;
+
+    private:
+        VFSFile m_File;
+        stb_vorbis* m_Handle      = nullptr;
+        uint32_t m_SourceChannels = 0;
+        std::vector<int16_t> m_Interleaved;
+    };
+}
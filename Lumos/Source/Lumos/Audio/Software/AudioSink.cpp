@@ -0,0 +1,84 @@
+#include "Precompiled.h"
+#include "AudioSink.h"
+#include "Maths/MathsUtilities.h"
+
+namespace Lumos
+{
+    WavAudioSink::WavAudioSink(const std::string& filePath)
+        : m_FilePath(filePath)
+    {
+    }
+
+    WavAudioSink::~WavAudioSink()
+    {
+        Close();
+    }
+
+    bool WavAudioSink::Open(uint32_t sampleRate, uint32_t channels)
+    {
+        m_File.open(m_FilePath, std::ios::binary | std::ios::trunc);
+        if(!m_File.is_open())
+        {
+            LUMOS_LOG_WARN("Failed to open audio output {0}", m_FilePath);
+            return false;
+        }
+
+        m_SampleRate = sampleRate;
+        m_Channels   = channels;
+        m_DataSize   = 0;
+
+        // Placeholder sizes until the length is known
+        WriteHeader(0);
+        return true;
+    }
+
+    void WavAudioSink::Write(const float* samples, uint32_t frameCount)
+    {
+        if(!m_File.is_open())
+            return;
+
+        uint32_t sampleCount = frameCount * m_Channels;
+        m_Samples.resize(sampleCount);
+        for(uint32_t i = 0; i < sampleCount; i++)
+            m_Samples[i] = int16_t(Maths::Clamp(samples[i], -1.0f, 1.0f) * 32767.0f);
+
+        m_File.write(reinterpret_cast<const char*>(m_Samples.data()), sampleCount * sizeof(int16_t));
+        m_DataSize += sampleCount * sizeof(int16_t);
+    }
+
+    void WavAudioSink::Close()
+    {
+        if(!m_File.is_open())
+            return;
+
+        m_File.seekp(0);
+        WriteHeader(m_DataSize);
+        m_File.close();
+    }
+
+    void WavAudioSink::WriteHeader(uint32_t dataSize)
+    {
+        auto write32 = [this](uint32_t value)
+        { m_File.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+        auto write16 = [this](uint16_t value)
+        { m_File.write(reinterpret_cast<const char*>(&value), sizeof(value)); };
+
+        uint16_t blockAlign = uint16_t(m_Channels * sizeof(int16_t));
+
+        m_File.write("RIFF", 4);
+        write32(36 + dataSize);
+        m_File.write("WAVE", 4);
+
+        m_File.write("fmt ", 4);
+        write32(16);
+        write16(1); // PCM
+        write16(uint16_t(m_Channels));
+        write32(m_SampleRate);
+        write32(m_SampleRate * blockAlign);
+        write16(blockAlign);
+        write16(16);
+
+        m_File.write("data", 4);
+        write32(dataSize);
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "Core/Core.h"
+#include <fstream>
+
+namespace Lumos
+{
+    // Destination for the software mixer's output. Write is called from the mixer thread
+    // with interleaved float frames in [-1, 1]
+    class LUMOS_EXPORT AudioSink
+    {
+    public:
+        virtual ~AudioSink() = default;
+
+        virtual bool Open(uint32_t sampleRate, uint32_t channels)     = 0;
+        virtual void Write(const float* samples, uint32_t frameCount) = 0;
+        virtual void Close() { }
+    };
+
+    // Discards everything, for running scenes headless
+    class LUMOS_EXPORT NullAudioSink : public AudioSink
+    {
+    public:
+        bool Open(uint32_t sampleRate, uint32_t channels) override { return true; }
+        void Write(const float* samples, uint32_t frameCount) override { }
+    };
+
+    // Writes 16 bit PCM to a wav file, the header sizes are filled in on Close
+    class LUMOS_EXPORT WavAudioSink : public AudioSink
+    {
+    public:
+        WavAudioSink(const std::string& filePath);
+        ~WavAudioSink();
+
+        bool Open(uint32_t sampleRate, uint32_t channels) override;
+        void Write(const float* samples, uint32_t frameCount) override;
+        void Close() override;
+
+    private:
+        void WriteHeader(uint32_t dataSize);
+
+        std::string m_FilePath;
+        std::ofstream m_File;
+        std::vector<int16_t> m_Samples;
+        uint32_t m_SampleRate = 0;
+        uint32_t m_Channels   = 0;
+        uint32_t m_DataSize   = 0;
+    };
+}
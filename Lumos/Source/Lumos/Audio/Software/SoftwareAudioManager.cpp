@@ -0,0 +1,406 @@
+#include "Precompiled.h"
+#include "SoftwareAudioManager.h"
+#include "SoftwareSound.h"
+#include "SoftwareSoundNode.h"
+#include "AudioSink.h"
+#include "Maths/Maths.h"
+#include "Maths/MathsUtilities.h"
+#include "Maths/Transform.h"
+#include "Audio/AudioStream.h"
+#include "Utilities/TimeStep.h"
+#include "Utilities/Timer.h"
+#include "Scene/Component/SoundComponent.h"
+#include "Scene/Scene.h"
+#include <imgui/imgui.h>
+
+namespace Lumos
+{
+    namespace Audio
+    {
+        SoftwareAudioManager::SoftwareAudioManager(UniquePtr<AudioSink>&& sink, uint32_t sampleRate, uint32_t blockSize)
+            : m_Sink(std::move(sink))
+            , m_SampleRate(sampleRate)
+            , m_BlockSize(Maths::Max((blockSize + 3) & ~3u, 4u))
+        {
+            m_DebugName = "Software Audio";
+        }
+
+        SoftwareAudioManager::~SoftwareAudioManager()
+        {
+            if(m_Running)
+            {
+                m_Running = false;
+                m_Thread.join();
+            }
+
+            m_Sink->Close();
+
+            for(auto& voice : m_Voices)
+            {
+                if(voice.Owner)
+                    voice.Owner->OnManagerDestroyed();
+            }
+        }
+
+        void SoftwareAudioManager::OnInit()
+        {
+            LUMOS_PROFILE_FUNCTION();
+            if(!m_Sink->Open(m_SampleRate, 2))
+                LUMOS_LOG_INFO("Failed to open audio output, mixing to nowhere");
+
+            // Planar so four frames of each channel are mixed at once
+            m_Left.resize(m_BlockSize / 4);
+            m_Right.resize(m_BlockSize / 4);
+            m_Output.resize(m_BlockSize * 2);
+
+            m_StreamThread = CreateUniquePtr<AudioStreamThread>();
+
+            m_Running = true;
+            m_Thread  = std::thread([this]
+                                   {
+                LUMOS_PROFILE_SETTHREADNAME("Audio Mixer");
+                Run(); });
+
+            LUMOS_LOG_INFO("Initialised AudioManager - Software Mixer {0}Hz, {1} frame blocks", m_SampleRate, m_BlockSize);
+        }
+
+        void SoftwareAudioManager::OnUpdate(const TimeStep& dt, Scene* scene)
+        {
+            LUMOS_PROFILE_FUNCTION();
+            UpdateListener(scene);
+
+            auto& registry  = scene->GetRegistry();
+            auto soundsView = registry.view<SoundComponent, Maths::Transform>();
+
+            for(auto entity : soundsView)
+            {
+                auto soundNode = static_cast<SoftwareSoundNode*>(soundsView.get<SoundComponent>(entity).GetSoundNode());
+                soundNode->SetPosition(soundsView.get<Maths::Transform>(entity).GetWorldPosition());
+
+                float gain = soundNode->GetAttenuation(m_ListenerPosition) * soundNode->GetVolume();
+                float pan  = 0.0f;
+                if(!soundNode->GetIsGlobal())
+                {
+                    glm::vec3 direction = soundNode->GetPosition() - m_ListenerPosition;
+                    float distance      = glm::length(direction);
+                    if(distance > Maths::M_EPSILON)
+                        pan = glm::dot(direction / distance, m_ListenerRight);
+                }
+
+                // Equal power, so a sound moving across the listener keeps the same loudness
+                float angle = (pan + 1.0f) * 0.25f * Maths::M_PI;
+                soundNode->Sync(*this, gain * cosf(angle), gain * sinf(angle));
+            }
+        }
+
+        void SoftwareAudioManager::UpdateListener(Scene* scene)
+        {
+            auto& registry    = scene->GetRegistry();
+            auto listenerView = registry.view<Listener, Maths::Transform>();
+            if(listenerView.size_hint() > 0)
+            {
+                auto& listenerTransform = registry.get<Maths::Transform>(listenerView.front());
+                UpdateListener(listenerTransform);
+            }
+        }
+
+        void SoftwareAudioManager::UpdateListener(Maths::Transform& listenerTransform)
+        {
+            m_ListenerPosition = listenerTransform.GetWorldPosition();
+            m_ListenerRight    = listenerTransform.GetWorldOrientation() * glm::vec3(1.0f, 0.0f, 0.0f);
+        }
+
+        uint32_t SoftwareAudioManager::AddVoice(SoftwareSoundNode* node)
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            uint32_t index;
+            if(!m_FreeVoices.empty())
+            {
+                index = m_FreeVoices.back();
+                m_FreeVoices.pop_back();
+            }
+            else
+            {
+                index = uint32_t(m_Voices.size());
+                m_Voices.emplace_back();
+            }
+
+            // Keep counting generations so a block mixed for the slot's previous owner is never written back
+            Voice& voice        = m_Voices[index];
+            uint32_t generation = voice.Generation + 1;
+            voice               = Voice();
+            voice.Owner         = node;
+            voice.Index         = index;
+            voice.Generation    = generation;
+            return index;
+        }
+
+        void SoftwareAudioManager::RemoveVoice(uint32_t index)
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            Voice& voice  = m_Voices[index];
+            voice.Owner   = nullptr;
+            voice.Sound   = nullptr;
+            voice.Playing = false;
+            voice.Generation++;
+            m_FreeVoices.push_back(index);
+        }
+
+        bool SoftwareAudioManager::SetVoice(uint32_t index, const SharedPtr<SoftwareSound>& sound, bool playing, bool looping, float pitch, float leftGain, float rightGain, bool restart, double& outPosition)
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            Voice& voice   = m_Voices[index];
+            bool finished  = voice.Finished;
+            voice.Finished = false;
+
+            // A sound that played to the end starts over if played again
+            if(restart || finished || voice.Sound.get() != sound.get())
+            {
+                voice.Position = 0.0;
+                voice.Generation++;
+            }
+
+            voice.Sound     = sound;
+            voice.Playing   = playing && !finished;
+            voice.Looping   = looping;
+            voice.Pitch     = pitch;
+            voice.LeftGain  = leftGain;
+            voice.RightGain = rightGain;
+
+            outPosition = voice.Position;
+            return finished;
+        }
+
+        SoftwareMixerStats SoftwareAudioManager::GetStats()
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            return m_Stats;
+        }
+
+        void SoftwareAudioManager::Run()
+        {
+            auto start              = Timer::Now();
+            uint64_t framesRendered = 0;
+            bool realTime           = true;
+
+            while(m_Running)
+            {
+                if(m_RealTime)
+                {
+                    // Restart the clock after benchmarking, otherwise the mixer would idle until it caught up
+                    if(!realTime)
+                    {
+                        start          = Timer::Now();
+                        framesRendered = 0;
+                        realTime       = true;
+                    }
+
+                    // Stay two blocks ahead of the clock, like a device buffer would
+                    uint64_t target = uint64_t(Timer::Duration(start, Timer::Now()) * m_SampleRate) + m_BlockSize * 2;
+                    if(framesRendered >= target)
+                    {
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                        continue;
+                    }
+
+                    // After a long stall skip ahead rather than rendering the backlog in a burst
+                    if(target - framesRendered > m_SampleRate / 10)
+                        framesRendered = target - m_BlockSize;
+                }
+                else
+                {
+                    realTime = false;
+                }
+
+                MixBlock();
+                framesRendered += m_BlockSize;
+            }
+        }
+
+        void SoftwareAudioManager::MixBlock()
+        {
+            LUMOS_PROFILE_FUNCTION_LOW();
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_MixVoices.clear();
+                for(auto& voice : m_Voices)
+                {
+                    if(voice.Owner && voice.Playing && voice.Sound)
+                        m_MixVoices.push_back(voice);
+                }
+            }
+
+            auto start = Timer::Now();
+
+            std::fill(m_Left.begin(), m_Left.end(), glm::vec4(0.0f));
+            std::fill(m_Right.begin(), m_Right.end(), glm::vec4(0.0f));
+
+            for(auto& voice : m_MixVoices)
+                MixVoice(voice);
+
+            for(uint32_t frame = 0; frame < m_BlockSize; frame++)
+            {
+                m_Output[frame * 2]     = m_Left[frame / 4][frame % 4];
+                m_Output[frame * 2 + 1] = m_Right[frame / 4][frame % 4];
+            }
+
+            float mixTime = Timer::Duration(start, Timer::Now(), 1000.0f);
+
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                for(auto& mixed : m_MixVoices)
+                {
+                    // Skip voices the main thread restarted or gave away while this block was mixing
+                    Voice& voice = m_Voices[mixed.Index];
+                    if(voice.Generation != mixed.Generation)
+                        continue;
+
+                    voice.Position     = mixed.Position;
+                    voice.MixLeftGain  = mixed.LeftGain;
+                    voice.MixRightGain = mixed.RightGain;
+                    if(mixed.Finished)
+                    {
+                        voice.Playing  = false;
+                        voice.Finished = true;
+                    }
+                }
+
+                m_Stats.MixTime     = Maths::Lerp(m_Stats.MixTime, mixTime, 0.05f);
+                m_Stats.VoicesMixed = uint32_t(m_MixVoices.size());
+                if(!m_MixVoices.empty())
+                    m_Stats.MixTimePerVoice = Maths::Lerp(m_Stats.MixTimePerVoice, mixTime * 1000.0f / float(m_MixVoices.size()), 0.05f);
+                m_Stats.FramesRendered += m_BlockSize;
+            }
+
+            m_Sink->Write(m_Output.data(), m_BlockSize);
+        }
+
+        void SoftwareAudioManager::MixVoice(Voice& voice)
+        {
+            const std::vector<float>& samples = voice.Sound->GetSamples();
+            const size_t count                = samples.size();
+            if(count == 0)
+            {
+                voice.Playing  = false;
+                voice.Finished = true;
+                return;
+            }
+
+            // Source samples to step per output frame
+            const double step = double(voice.Sound->GetFrequency()) / double(m_SampleRate) * double(Maths::Max(voice.Pitch, 0.0f));
+
+            // Gains ramp over the block so moving sounds don't zipper
+            const float leftStep  = (voice.LeftGain - voice.MixLeftGain) / float(m_BlockSize);
+            const float rightStep = (voice.RightGain - voice.MixRightGain) / float(m_BlockSize);
+            const glm::vec4 lanes(0.0f, 1.0f, 2.0f, 3.0f);
+
+            for(uint32_t i = 0; i < m_BlockSize / 4; i++)
+            {
+                // Positions are fetched per lane, the interpolation and gains run four frames at a time
+                glm::vec4 current(0.0f);
+                glm::vec4 next(0.0f);
+                glm::vec4 fraction(0.0f);
+
+                for(int lane = 0; lane < 4; lane++)
+                {
+                    if(voice.Position >= double(count))
+                    {
+                        if(voice.Looping)
+                        {
+                            voice.Position = fmod(voice.Position, double(count));
+                        }
+                        else
+                        {
+                            voice.Playing  = false;
+                            voice.Finished = true;
+                        }
+                    }
+
+                    if(!voice.Playing)
+                        break;
+
+                    size_t index     = size_t(voice.Position);
+                    size_t nextIndex = index + 1 < count ? index + 1 : (voice.Looping ? 0 : index);
+                    current[lane]    = samples[index];
+                    next[lane]       = samples[nextIndex];
+                    fraction[lane]   = float(voice.Position - double(index));
+                    voice.Position += step;
+                }
+
+                glm::vec4 sample = current + (next - current) * fraction;
+                glm::vec4 frame  = glm::vec4(float(i * 4)) + lanes;
+                m_Left[i] += sample * (voice.MixLeftGain + frame * leftStep);
+                m_Right[i] += sample * (voice.MixRightGain + frame * rightStep);
+
+                if(!voice.Playing)
+                    break;
+            }
+        }
+
+        void SoftwareAudioManager::OnImGui()
+        {
+            LUMOS_PROFILE_FUNCTION();
+            ImGui::TextUnformatted("Software Audio");
+
+            SoftwareMixerStats stats = GetStats();
+            bool realTime            = m_RealTime;
+
+            ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2(2, 2));
+            ImGui::Columns(2);
+            ImGui::Separator();
+
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextUnformatted("Number Of Audio Sources");
+            ImGui::NextColumn();
+            ImGui::PushItemWidth(-1);
+            ImGui::Text("%5.2lu", m_SoundNodes.size());
+            ImGui::PopItemWidth();
+            ImGui::NextColumn();
+
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextUnformatted("Voices Mixed");
+            ImGui::NextColumn();
+            ImGui::PushItemWidth(-1);
+            ImGui::Text("%5.2u", stats.VoicesMixed);
+            ImGui::PopItemWidth();
+            ImGui::NextColumn();
+
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextUnformatted("Block Mix Time (ms)");
+            ImGui::NextColumn();
+            ImGui::PushItemWidth(-1);
+            ImGui::Text("%.3f", stats.MixTime);
+            ImGui::PopItemWidth();
+            ImGui::NextColumn();
+
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextUnformatted("Mix Time Per Voice (us)");
+            ImGui::NextColumn();
+            ImGui::PushItemWidth(-1);
+            ImGui::Text("%.3f", stats.MixTimePerVoice);
+            ImGui::PopItemWidth();
+            ImGui::NextColumn();
+
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextUnformatted("Seconds Rendered");
+            ImGui::NextColumn();
+            ImGui::PushItemWidth(-1);
+            ImGui::Text("%.1f", double(stats.FramesRendered) / double(m_SampleRate));
+            ImGui::PopItemWidth();
+            ImGui::NextColumn();
+
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextUnformatted("Real Time");
+            ImGui::NextColumn();
+            ImGui::PushItemWidth(-1);
+            if(ImGui::Checkbox("##RealTime", &realTime))
+                m_RealTime = realTime;
+            ImGui::PopItemWidth();
+            ImGui::NextColumn();
+
+            ImGui::Columns(1);
+            ImGui::Separator();
+            ImGui::PopStyleVar();
+        }
+    }
+}
@@ -0,0 +1,106 @@
+#pragma once
+#include "Audio/AudioManager.h"
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+namespace Lumos
+{
+    class AudioSink;
+    class SoftwareSound;
+    class SoftwareSoundNode;
+
+    namespace Maths
+    {
+        class Transform;
+    }
+
+    namespace Audio
+    {
+        struct SoftwareMixerStats
+        {
+            float MixTime           = 0.0f; // Milliseconds per block, averaged
+            float MixTimePerVoice   = 0.0f; // Microseconds per voice per block, averaged
+            uint32_t VoicesMixed    = 0;    // Last block
+            uint64_t FramesRendered = 0;
+        };
+
+        // Pure C++ mixer rendering fixed size stereo blocks on its own thread into an AudioSink.
+        // Needs no audio device, so audio heavy scenes run and can be profiled on headless machines
+        class SoftwareAudioManager : public AudioManager
+        {
+        public:
+            SoftwareAudioManager(UniquePtr<AudioSink>&& sink, uint32_t sampleRate = 48000, uint32_t blockSize = 512);
+            ~SoftwareAudioManager();
+
+            void OnInit() override;
+            void OnUpdate(const TimeStep& dt, Scene* scene) override;
+            void UpdateListener(Scene* scene) override;
+            void UpdateListener(Maths::Transform& listenerTransform);
+            void OnImGui() override;
+
+            // Off renders blocks as fast as possible instead of keeping pace with the clock, for benchmarking
+            void SetRealTime(bool realTime) { m_RealTime = realTime; }
+            bool GetRealTime() const { return m_RealTime; }
+
+            uint32_t GetSampleRate() const { return m_SampleRate; }
+            SoftwareMixerStats GetStats();
+
+            // Called by SoftwareSoundNode
+            uint32_t AddVoice(SoftwareSoundNode* node);
+            void RemoveVoice(uint32_t index);
+
+            // Updates a voice's settings and reads back its position in source samples.
+            // Returns true once when a non looping voice played to the end
+            bool SetVoice(uint32_t index, const SharedPtr<SoftwareSound>& sound, bool playing, bool looping, float pitch, float leftGain, float rightGain, bool restart, double& outPosition);
+
+        private:
+            struct Voice
+            {
+                SoftwareSoundNode* Owner = nullptr;
+                SharedPtr<SoftwareSound> Sound;
+                double Position     = 0.0; // Source samples
+                float Pitch         = 1.0f;
+                float LeftGain      = 0.0f;
+                float RightGain     = 0.0f;
+                float MixLeftGain   = 0.0f; // Gains the last block ended on, new gains ramp from these over a block
+                float MixRightGain  = 0.0f;
+                uint32_t Generation = 0; // Bumped whenever the main thread moves Position
+                uint32_t Index      = 0;
+                bool Playing        = false;
+                bool Looping        = false;
+                bool Finished       = false;
+            };
+
+            void Run();
+            void MixBlock();
+            void MixVoice(Voice& voice);
+
+            UniquePtr<AudioSink> m_Sink;
+            uint32_t m_SampleRate;
+            uint32_t m_BlockSize;
+
+            std::thread m_Thread;
+            std::atomic<bool> m_Running  = false;
+            std::atomic<bool> m_RealTime = true;
+
+            // Guards m_Voices, m_FreeVoices and m_Stats. The mixer copies the voices it needs out
+            // under the lock and mixes without it
+            std::mutex m_Mutex;
+            std::vector<Voice> m_Voices;
+            std::vector<uint32_t> m_FreeVoices;
+            SoftwareMixerStats m_Stats;
+
+            // Mixer thread only
+            std::vector<Voice> m_MixVoices;
+            std::vector<glm::vec4> m_Left;
+            std::vector<glm::vec4> m_Right;
+            std::vector<float> m_Output;
+
+            glm::vec3 m_ListenerPosition = glm::vec3(0.0f);
+            glm::vec3 m_ListenerRight    = glm::vec3(1.0f, 0.0f, 0.0f);
+        };
+    }
+}
@@ -0,0 +1,49 @@
+#include "Precompiled.h"
+#include "SoftwareSound.h"
+#include "Maths/MathsUtilities.h"
+
+namespace Lumos
+{
+    SoftwareSound::SoftwareSound(const std::string& fileName, const std::string& format)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        m_FilePath  = fileName;
+        m_Extension = format;
+
+        auto decoder = CreateDecoder();
+        if(!decoder)
+            return;
+
+        m_Data = decoder->GetInfo();
+
+        std::vector<uint8_t> pcm(m_Data.Size);
+        uint32_t size = 0;
+        while(size < m_Data.Size)
+        {
+            uint32_t read = decoder->Read(pcm.data() + size, m_Data.Size - size);
+            if(read == 0)
+                break;
+            size += read;
+        }
+
+        uint32_t bytesPerSample = Maths::Max(m_Data.BitRate / 8, 1u);
+        uint32_t channels       = Maths::Max(m_Data.Channels, 1u);
+        uint32_t frameCount     = size / (bytesPerSample * channels);
+
+        std::vector<uint8_t> mono(size / channels);
+        ConvertToMono(pcm.data(), frameCount * bytesPerSample * channels, mono.data(), channels, m_Data.BitRate);
+
+        m_Samples.resize(frameCount);
+        for(uint32_t i = 0; i < frameCount; i++)
+        {
+            if(bytesPerSample == 1)
+                m_Samples[i] = (float(mono[i]) - 128.0f) / 128.0f;
+            else
+                m_Samples[i] = float(reinterpret_cast<const int16_t*>(mono.data())[i]) / 32768.0f;
+        }
+    }
+
+    SoftwareSound::~SoftwareSound()
+    {
+    }
+}
@@ -0,0 +1,18 @@
+#pragma once
+#include "Audio/Sound.h"
+
+namespace Lumos
+{
+    // Whole sound decoded to mono float samples for the software mixer, which pans every voice itself
+    class SoftwareSound : public Sound
+    {
+    public:
+        SoftwareSound(const std::string& fileName, const std::string& format);
+        ~SoftwareSound();
+
+        const std::vector<float>& GetSamples() const { return m_Samples; }
+
+    private:
+        std::vector<float> m_Samples;
+    };
+}
@@ -0,0 +1,63 @@
+#include "Precompiled.h"
+#include "SoftwareSoundNode.h"
+#include "SoftwareAudioManager.h"
+#include "SoftwareSound.h"
+#include "Maths/MathsUtilities.h"
+
+namespace Lumos
+{
+    SoftwareSoundNode::SoftwareSoundNode()
+    {
+    }
+
+    SoftwareSoundNode::~SoftwareSoundNode()
+    {
+        if(m_Manager)
+            m_Manager->RemoveVoice(m_VoiceIndex);
+    }
+
+    void SoftwareSoundNode::Sync(Audio::SoftwareAudioManager& manager, float leftGain, float rightGain)
+    {
+        if(!m_Manager)
+        {
+            m_Manager    = &manager;
+            m_VoiceIndex = manager.AddVoice(this);
+        }
+
+        SharedPtr<SoftwareSound> sound = m_Sound.As<SoftwareSound>();
+
+        double position = 0.0;
+        bool finished   = manager.SetVoice(m_VoiceIndex, sound, m_Playing, m_IsLooping, m_Pitch, leftGain, rightGain, m_Restart, position);
+        m_Restart       = false;
+
+        if(finished)
+            m_Playing = false;
+
+        if(sound && sound->GetFrequency() > 0.0f)
+            m_TimeLeft = Maths::Max(0.0, m_Sound->GetLength() - position / sound->GetFrequency() * 1000.0);
+        else
+            m_TimeLeft = 0.0;
+    }
+
+    void SoftwareSoundNode::Pause()
+    {
+        m_Playing = false;
+    }
+
+    void SoftwareSoundNode::Resume()
+    {
+        m_Playing = true;
+    }
+
+    void SoftwareSoundNode::Stop()
+    {
+        m_Playing = false;
+        m_Restart = true;
+    }
+
+    void SoftwareSoundNode::SetSound(SharedPtr<Sound> s)
+    {
+        SoundNode::SetSound(s);
+        m_Restart = true;
+    }
+}
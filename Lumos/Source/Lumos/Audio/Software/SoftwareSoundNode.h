@@ -0,0 +1,38 @@
+#pragma once
+#include "Audio/SoundNode.h"
+
+namespace Lumos
+{
+    namespace Audio
+    {
+        class SoftwareAudioManager;
+    }
+
+    // Playback state lives in the SoftwareAudioManager's voice list, the node only pushes its settings
+    // there each update and reads back how far the mixer got
+    class SoftwareSoundNode : public SoundNode
+    {
+    public:
+        SoftwareSoundNode();
+        virtual ~SoftwareSoundNode();
+
+        // Everything happens in Sync, panning needs the listener the manager holds
+        void OnUpdate(float msec) override { }
+        void Pause() override;
+        void Resume() override;
+        void Stop() override;
+        void SetSound(SharedPtr<Sound> s) override;
+
+        // Called by SoftwareAudioManager with this update's per channel gains
+        void Sync(Audio::SoftwareAudioManager& manager, float leftGain, float rightGain);
+        void OnManagerDestroyed() { m_Manager = nullptr; }
+
+        bool IsPlaying() const { return m_Playing; }
+
+    private:
+        Audio::SoftwareAudioManager* m_Manager = nullptr;
+        uint32_t m_VoiceIndex                  = 0;
+        bool m_Playing                         = false;
+        bool m_Restart                         = false;
+    };
+}
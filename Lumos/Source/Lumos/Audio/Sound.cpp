@@ -1,6 +1,8 @@
 #include "Precompiled.h"
 #include "Sound.h"
 #include "Core/VFS.h"
+#include "AudioManager.h"
+#include "Software/SoftwareSound.h"
 
 #ifdef LUMOS_OPENAL
 #include "Platform/OpenAL/ALSound.h"
@@ -8,6 +10,8 @@
 
 namespace Lumos
 {
+    uint32_t Sound::s_StreamingThreshold = 2 * 1024 * 1024;
+
     Sound::Sound()
         : m_Streaming(false)
         , m_Data(AudioData())
@@ -22,10 +26,10 @@ namespace Lumos
     SharedPtr<Sound> Sound::Create(const std::string& name, const std::string& extension)
     {
 #ifdef LUMOS_OPENAL
-        return SharedPtr<ALSound>(new ALSound(name, extension));
-#else
-        return nullptr;
+        if(AudioManager::GetBackend() == AudioBackend::OpenAL)
+            return SharedPtr<ALSound>(new ALSound(name, extension));
 #endif
+        return SharedPtr<SoftwareSound>(new SoftwareSound(name, extension));
     }
 
     double Sound::GetLength() const
@@ -33,6 +37,11 @@ namespace Lumos
         return m_Data.Length;
     }
 
+    UniquePtr<AudioDecoder> Sound::CreateDecoder() const
+    {
+        return AudioDecoder::Create(m_FilePath, m_Extension);
+    }
+
     void Sound::ConvertToMono(const uint8_t* inputData, int dataSize, uint8_t* monoData, int channels, int bitsPerSample)
     {
         LUMOS_ASSERT(channels != 0, "0 Channels in audio file");
@@ -2,6 +2,7 @@
 
 #include "Core/Core.h"
 #include "AudioData.h"
+#include "AudioStream.h"
 
 namespace Lumos
 {
@@ -38,10 +39,13 @@ namespace Lumos
             return m_Streaming;
         }
         double GetLength() const;
-        virtual double StreamData(unsigned int buffer, double timeLeft)
-        {
-            return 0.0f;
-        }
+
+        // Streaming sounds keep no PCM, each playing source decodes its own stream
+        UniquePtr<AudioDecoder> CreateDecoder() const;
+
+        // Sounds decoding to more than this many bytes are streamed instead of loaded whole
+        static void SetStreamingThreshold(uint32_t bytes) { s_StreamingThreshold = bytes; }
+        static uint32_t GetStreamingThreshold() { return s_StreamingThreshold; }
 
         const std::string& GetFilePath() const { return m_FilePath; }
 
@@ -51,7 +55,10 @@ namespace Lumos
         Sound();
         bool m_Streaming;
         std::string m_FilePath;
+        std::string m_Extension;
 
         AudioData m_Data;
+
+        static uint32_t s_StreamingThreshold;
     };
 }
@@ -1,6 +1,8 @@
 #include "Precompiled.h"
 #include "SoundNode.h"
 #include "Maths/MathsUtilities.h"
+#include "AudioManager.h"
+#include "Software/SoftwareSoundNode.h"
 
 #ifdef LUMOS_OPENAL
 #include "Platform/OpenAL/ALSoundNode.h"
@@ -11,10 +13,10 @@ namespace Lumos
     SoundNode* SoundNode::Create()
     {
 #ifdef LUMOS_OPENAL
-        return new ALSoundNode();
-#else
-        return nullptr;
+        if(AudioManager::GetBackend() == AudioBackend::OpenAL)
+            return new ALSoundNode();
 #endif
+        return new SoftwareSoundNode();
     }
 
     SoundNode::SoundNode()
@@ -43,6 +45,7 @@ namespace Lumos
         m_ReferenceDistance = 1.0f;
         m_RollOffFactor     = 1.0f;
         m_Velocity          = glm::vec3(0.0f);
+        m_Priority          = 1.0f;
     }
 
     SoundNode::~SoundNode()
@@ -67,4 +70,29 @@ namespace Lumos
     {
         m_Radius = Maths::Max(0.0f, value);
     }
+
+    void SoundNode::SetPriority(float value)
+    {
+        m_Priority = Maths::Max(0.0f, value);
+    }
+
+    float SoundNode::GetAttenuation(const glm::vec3& listenerPosition) const
+    {
+        float attenuation = 1.0f;
+        if(!m_IsGlobal)
+        {
+            float maxDistance = Maths::Max(m_Radius, m_ReferenceDistance);
+            float distance    = Maths::Clamp(glm::length(m_Position - listenerPosition), m_ReferenceDistance, maxDistance);
+            if(maxDistance > m_ReferenceDistance)
+                attenuation = 1.0f - m_RollOffFactor * (distance - m_ReferenceDistance) / (maxDistance - m_ReferenceDistance);
+            attenuation = Maths::Clamp(attenuation, 0.0f, 1.0f);
+        }
+
+        return attenuation;
+    }
+
+    float SoundNode::GetAudibility(const glm::vec3& listenerPosition) const
+    {
+        return GetAttenuation(listenerPosition) * m_Volume * m_Priority;
+    }
 }
@@ -55,6 +55,16 @@ namespace Lumos
 
         double GetTimeLeft() const { return m_TimeLeft; }
 
+        // Scales audibility when deciding which sounds get a real voice
+        float GetPriority() const { return m_Priority; }
+        void SetPriority(float value);
+
+        // Linear clamped distance attenuation, 1 for global sounds
+        float GetAttenuation(const glm::vec3& listenerPosition) const;
+
+        // Volume after distance attenuation times priority, the same linear clamped model the listener hears
+        float GetAudibility(const glm::vec3& listenerPosition) const;
+
         virtual void OnUpdate(float msec) = 0;
         virtual void Pause()              = 0;
         virtual void Resume()             = 0;
@@ -99,6 +109,7 @@ namespace Lumos
         float m_RollOffFactor;
         bool m_Stationary;
         double m_StreamPos;
+        float m_Priority;
     };
 
 }
@@ -1,46 +1,67 @@
 #include "Precompiled.h"
 #include "WavLoader.h"
+#include "Core/VFS.h"
+#include "Maths/MathsUtilities.h"
 
 namespace Lumos
 {
     AudioData LoadWav(const std::string& fileName)
     {
-        AudioData data = AudioData();
+        WavDecoder decoder(fileName);
+        AudioData data = decoder.GetInfo();
+        if(data.Size == 0)
+            return data;
 
-        std::ifstream file(fileName.c_str(), std::ios::in | std::ios::binary);
+        data.Data = new unsigned char[data.Size];
+        data.Size = decoder.Read(data.Data, data.Size);
 
-        if(!file)
+        return data;
+    }
+
+    void LoadWAVChunkInfo(const VFSFile& file, uint64_t& cursor, std::string& name, unsigned int& size)
+    {
+        name = std::string(reinterpret_cast<const char*>(file.Data + cursor), 4);
+        memcpy(&size, file.Data + cursor + 4, 4);
+        cursor += 8;
+    }
+
+    WavDecoder::WavDecoder(const std::string& fileName)
+    {
+        // Streams straight from the pack or a mapping of the file
+        if(!VFS::Get().MapFile(fileName, m_File))
         {
             LUMOS_LOG_CRITICAL("Failed to load WAV file '{0}'!", fileName);
-            return data;
+            return;
         }
 
+        const uint64_t fileSize = uint64_t(m_File.Size);
         std::string chunkName;
         uint32_t chunkSize = 0;
 
-        while(!file.eof())
+        while(m_Cursor + 8 <= fileSize)
         {
-            LoadWAVChunkInfo(file, chunkName, chunkSize);
+            LoadWAVChunkInfo(m_File, m_Cursor, chunkName, chunkSize);
 
             if(chunkName == "RIFF")
             {
-                file.seekg(4, std::ios_base::cur);
+                m_Cursor += 4;
             }
             else if(chunkName == "fmt ")
             {
                 FMTCHUNK fmt {};
 
-                file.read(reinterpret_cast<char*>(&fmt), sizeof(FMTCHUNK));
+                memcpy(&fmt, m_File.Data + m_Cursor, size_t(Maths::Min(uint64_t(sizeof(FMTCHUNK)), fileSize - m_Cursor)));
+                m_Cursor += sizeof(FMTCHUNK);
 
-                data.BitRate  = static_cast<uint32_t>(fmt.samp);
-                data.FreqRate = static_cast<float>(fmt.srate);
-                data.Channels = static_cast<uint32_t>(fmt.channels);
+                m_Info.BitRate  = static_cast<uint32_t>(fmt.samp);
+                m_Info.FreqRate = static_cast<float>(fmt.srate);
+                m_Info.Channels = static_cast<uint32_t>(fmt.channels);
             }
             else if(chunkName == "data")
             {
-                data.Size = chunkSize;
-                data.Data = new unsigned char[data.Size];
-                file.read(reinterpret_cast<char*>(data.Data), chunkSize);
+                m_Info.Size = uint32_t(Maths::Min(uint64_t(chunkSize), fileSize - m_Cursor));
+                m_DataStart = m_Cursor;
+                m_Remaining = m_Info.Size;
                 break;
                 /*
                                 In release mode, ifstream and / or something else were combining
@@ -52,24 +73,49 @@ namespace Lumos
             }
             else
             {
-                file.seekg(chunkSize, std::ios_base::cur);
+                m_Cursor += chunkSize;
             }
         }
 
+        if(m_Info.Channels == 0 || m_Info.BitRate == 0)
+        {
+            m_Info.Size = 0;
+            m_Remaining = 0;
+            return;
+        }
+
         // Milliseconds
-        data.Length = static_cast<float>(data.Size) / (data.Channels * data.FreqRate * (data.BitRate / 8.0f)) * 1000.0f;
+        m_Info.Length = static_cast<float>(m_Info.Size) / (m_Info.Channels * m_Info.FreqRate * (m_Info.BitRate / 8.0f)) * 1000.0f;
+    }
 
-        file.close();
+    uint32_t WavDecoder::Read(uint8_t* output, uint32_t size)
+    {
+        LUMOS_PROFILE_FUNCTION_LOW();
+        // Whole frames only so channels never swap between chunks
+        uint32_t frameSize = Maths::Max(m_Info.Channels * (m_Info.BitRate / 8), 1u);
+        uint32_t toRead    = Maths::Min(size, m_Remaining);
+        toRead -= toRead % frameSize;
 
-        return data;
+        if(toRead == 0)
+            return 0;
+
+        memcpy(output, m_File.Data + m_Cursor, toRead);
+        m_Cursor += toRead;
+        m_Remaining -= toRead;
+        return toRead;
     }
 
-    void LoadWAVChunkInfo(std::ifstream& file, std::string& name, unsigned int& size)
+    bool WavDecoder::Seek(double milliseconds)
     {
-        char chunk[4];
-        file.read(reinterpret_cast<char*>(&chunk), 4);
-        file.read(reinterpret_cast<char*>(&size), 4);
+        if(!m_File.Data || m_Info.Size == 0)
+            return false;
+
+        uint32_t frameSize = Maths::Max(m_Info.Channels * (m_Info.BitRate / 8), 1u);
+        uint64_t frame     = uint64_t(Maths::Max(milliseconds, 0.0) * 0.001 * m_Info.FreqRate);
+        uint32_t offset    = uint32_t(Maths::Min(frame * frameSize, uint64_t(m_Info.Size)));
 
-        name = std::string(chunk, 4);
+        m_Cursor    = m_DataStart + offset;
+        m_Remaining = m_Info.Size - offset;
+        return true;
     }
 }
@@ -1,5 +1,7 @@
 #pragma once
 #include "AudioData.h"
+#include "AudioStream.h"
+#include "Core/VFS.h"
 
 namespace Lumos
 {
@@ -40,6 +42,21 @@ namespace Lumos
 
     AudioData LoadWav(const std::string& fileName);
 
-    void LoadWAVChunkInfo(std::ifstream& file, std::string& name, unsigned int& size);
+    void LoadWAVChunkInfo(const VFSFile& file, uint64_t& cursor, std::string& name, unsigned int& size);
+
+    class WavDecoder : public AudioDecoder
+    {
+    public:
+        WavDecoder(const std::string& fileName);
+
+        uint32_t Read(uint8_t* output, uint32_t size) override;
+        bool Seek(double milliseconds) override;
+
+    private:
+        VFSFile m_File;
+        uint64_t m_Cursor    = 0;
+        uint64_t m_DataStart = 0;
+        uint32_t m_Remaining = 0;
+    };
 
 }
\ No newline at end of file
@@ -22,6 +22,7 @@
 #include "Core/OS/OS.h"
 #include "Core/Profiler.h"
 #include "Core/VFS.h"
+#include "Core/PackFile.h"
 #include "Core/JobSystem.h"
 #include "Core/StringUtilities.h"
 #include "Core/OS/FileSystem.h"
@@ -33,6 +34,7 @@
 #include "Audio/Sound.h"
 #include "Physics/B2PhysicsEngine/B2PhysicsEngine.h"
 #include "Physics/LumosPhysicsEngine/LumosPhysicsEngine.h"
+#include "AI/NavMeshSystem.h"
 
 #include "Embedded/splash.inl"
 
@@ -96,6 +98,14 @@ namespace Lumos
         LuaManager::Get().OnNewProject(m_ProjectSettings.m_ProjectRoot);
     }
 
+    std::string Application::GetCachePath()
+    {
+        std::string path = m_ProjectSettings.m_ProjectRoot + "Cache/";
+        if(!FileSystem::FolderExists(path))
+            std::filesystem::create_directories(path);
+        return path;
+    }
+
     void Application::OpenNewProject(const std::string& path, const std::string& name)
     {
         LUMOS_PROFILE_FUNCTION();
@@ -179,6 +189,24 @@ namespace Lumos
         VFS::Get().Mount("Assets", m_ProjectSettings.m_ProjectRoot + std::string("Assets"), true);
         VFS::Get().Mount("Prefabs", m_ProjectSettings.m_ProjectRoot + std::string("Assets/Prefabs"), true);
         VFS::Get().Mount("Materials", m_ProjectSettings.m_ProjectRoot + std::string("Assets/Materials"), true);
+
+        // Packed builds ship the Assets folder as a single archive next to the project file
+        const std::string packPath = m_ProjectSettings.m_ProjectRoot + std::string("Assets.lpak");
+        if(FileSystem::FileExists(packPath))
+        {
+            auto pack = CreateSharedPtr<PackFile>();
+            if(pack->Open(packPath))
+            {
+                VFS::Get().MountPack("Meshes", pack, "Meshes/", true);
+                VFS::Get().MountPack("Textures", pack, "Textures/", true);
+                VFS::Get().MountPack("Sounds", pack, "Sounds/", true);
+                VFS::Get().MountPack("Scripts", pack, "Scripts/", true);
+                VFS::Get().MountPack("Scenes", pack, "Scenes/", true);
+                VFS::Get().MountPack("Assets", pack, "", true);
+                VFS::Get().MountPack("Prefabs", pack, "Prefabs/", true);
+                VFS::Get().MountPack("Materials", pack, "Materials/", true);
+            }
+        }
     }
 
     Scene* Application::GetCurrentScene() const
@@ -279,7 +307,8 @@ namespace Lumos
         System::JobSystem::Execute(context, [this](JobDispatchArgs args)
                                    {
                                        m_SystemManager->RegisterSystem<LumosPhysicsEngine>();
-                                       m_SystemManager->RegisterSystem<B2PhysicsEngine>(); });
+                                       m_SystemManager->RegisterSystem<B2PhysicsEngine>();
+                                       m_SystemManager->RegisterSystem<NavMeshSystem>(); });
 
         System::JobSystem::Execute(context, [this](JobDispatchArgs args)
                                    { m_SceneManager->LoadCurrentList(); });
@@ -553,6 +582,9 @@ namespace Lumos
     {
         LUMOS_PROFILE_FUNCTION();
         m_RenderPasses->OnNewScene(scene);
+
+        if(auto navigation = m_SystemManager->GetSystem<NavMeshSystem>())
+            navigation->OnNewScene(scene);
     }
 
     SharedPtr<ShaderLibrary>& Application::GetShaderLibrary()
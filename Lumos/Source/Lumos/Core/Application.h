@@ -292,6 +292,9 @@ namespace Lumos
         };
 
         ProjectSettings& GetProjectSettings() { return m_ProjectSettings; }
+
+        // Project folder for data that is safe to delete, e.g. compiled pipelines. Created on first use
+        std::string GetCachePath();
         RenderConfig& GetRenderConfigSettings() { return m_RenderConfig; }
 
         Arena* GetFrameArena() const { return m_FrameArena; }
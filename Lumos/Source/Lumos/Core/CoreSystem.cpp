@@ -5,6 +5,7 @@
 #include "Scripting/Lua/LuaManager.h"
 #include "Core/Version.h"
 #include "Core/CommandLine.h"
+#include "Audio/AudioManager.h"
 
 #include "Core/OS/MemoryManager.h"
 
@@ -29,6 +30,9 @@ namespace Lumos
             bool oBool          = false;
             bool oPrintHelp     = false;
 
+            std::string audioBackend;
+            std::string audioOutput;
+
             // First configure all possible command line options.
             args.AddArgument({ "-s", "--string" }, &oString, "A string value");
             args.AddArgument({ "-i", "--integer" }, &oInteger, "A integer value");
@@ -40,8 +44,14 @@ namespace Lumos
                              "Print this help. This help message is actually so long "
                              "that it requires a line break!");
 
+            args.AddArgument({ "--audio" }, &audioBackend, "Audio backend, openal or software");
+            args.AddArgument({ "--audio-output" }, &audioOutput, "Wav file the software audio backend writes its mix to");
+
             args.Parse(argc, argv);
 
+            if(audioBackend == "software" || !audioOutput.empty())
+                AudioManager::SetBackend(AudioBackend::Software, audioOutput);
+
             if(oPrintHelp)
             {
                 args.PrintHelp();
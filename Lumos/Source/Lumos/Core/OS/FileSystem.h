@@ -16,6 +16,7 @@ namespace Lumos
         static bool FileExists(const std::string& path);
         static bool FolderExists(const std::string& path);
         static int64_t GetFileSize(const std::string& path);
+        static uint64_t GetLastModifiedTime(const std::string& path);
 
         static uint8_t* ReadFile(const std::string& path);
         static bool ReadFile(const std::string& path, void* buffer, int64_t size = -1);
@@ -24,6 +25,11 @@ namespace Lumos
         static bool WriteFile(const std::string& path, uint8_t* buffer, uint32_t size);
         static bool WriteTextFile(const std::string& path, const std::string& text);
 
+        // Maps a whole file read-only into the address space. Returns nullptr on failure.
+        // The mapping must be released with UnmapFile
+        static uint8_t* MapFile(const std::string& path, int64_t& size);
+        static void UnmapFile(uint8_t* data, int64_t size);
+
         static std::string GetWorkingDirectory();
 
         static bool IsRelativePath(const char* path)
@@ -0,0 +1,238 @@
+#include "Precompiled.h"
+#include "PackFile.h"
+#include "OS/FileSystem.h"
+
+#include <Tracy/common/tracy_lz4.hpp>
+#define MINIZ_NO_ZLIB_COMPATIBLE_NAMES
+#include <OpenFBX/miniz.h>
+
+namespace Lumos
+{
+    PackFile::~PackFile()
+    {
+        Close();
+    }
+
+    bool PackFile::Open(const std::string& physicalPath)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        Close();
+
+        m_Data = FileSystem::MapFile(physicalPath, m_Size);
+        if(!m_Data)
+        {
+            LUMOS_LOG_ERROR("Failed to map pack file {0}", physicalPath);
+            return false;
+        }
+
+        m_Header = reinterpret_cast<const PackHeader*>(m_Data);
+
+        bool valid = m_Size >= int64_t(sizeof(PackHeader)) && memcmp(m_Header->Magic, Magic, sizeof(Magic)) == 0 && m_Header->Version == Version;
+        valid      = valid && m_Header->EntryTableOffset + uint64_t(m_Header->EntryCount) * sizeof(PackEntry) <= uint64_t(m_Size);
+        valid      = valid && m_Header->StringTableOffset + m_Header->StringTableSize <= uint64_t(m_Size);
+
+        if(!valid)
+        {
+            LUMOS_LOG_ERROR("Invalid pack file {0}", physicalPath);
+            Close();
+            return false;
+        }
+
+        m_Entries      = reinterpret_cast<const PackEntry*>(m_Data + m_Header->EntryTableOffset);
+        m_StringTable  = reinterpret_cast<const char*>(m_Data + m_Header->StringTableOffset);
+        m_PhysicalPath = physicalPath;
+
+        LUMOS_LOG_INFO("Opened pack {0} : {1} entries", physicalPath, m_Header->EntryCount);
+        return true;
+    }
+
+    void PackFile::Close()
+    {
+        if(m_Data)
+            FileSystem::UnmapFile(m_Data, m_Size);
+
+        m_Data        = nullptr;
+        m_Size        = 0;
+        m_Header      = nullptr;
+        m_Entries     = nullptr;
+        m_StringTable = nullptr;
+        m_PhysicalPath.clear();
+    }
+
+    uint64_t PackFile::HashPath(std::string_view path)
+    {
+        // FNV-1a
+        uint64_t hash = 14695981039346656037ull;
+        for(char c : path)
+        {
+            hash ^= uint64_t(uint8_t(c));
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    const PackEntry* PackFile::Find(std::string_view path) const
+    {
+        LUMOS_PROFILE_FUNCTION_LOW();
+        if(!m_Entries)
+            return nullptr;
+
+        while(!path.empty() && path.front() == '/')
+            path.remove_prefix(1);
+
+        uint64_t hash = HashPath(path);
+
+        const PackEntry* end = m_Entries + m_Header->EntryCount;
+        const PackEntry* it  = std::lower_bound(m_Entries, end, hash, [](const PackEntry& entry, uint64_t value)
+                                               { return entry.PathHash < value; });
+
+        // Compare the full path to rule out hash collisions
+        for(; it != end && it->PathHash == hash; ++it)
+        {
+            if(GetPath(*it) == path)
+                return it;
+        }
+
+        return nullptr;
+    }
+
+    std::string_view PackFile::GetPath(const PackEntry& entry) const
+    {
+        return std::string_view(m_StringTable + entry.PathOffset, entry.PathLength);
+    }
+
+    const uint8_t* PackFile::GetData(const PackEntry& entry) const
+    {
+        return entry.Compression == PackCompression::None ? m_Data + entry.Offset : nullptr;
+    }
+
+    bool PackFile::Read(const PackEntry& entry, uint8_t* buffer) const
+    {
+        LUMOS_PROFILE_FUNCTION();
+        const uint8_t* source = m_Data + entry.Offset;
+
+        switch(entry.Compression)
+        {
+        case PackCompression::None:
+            memcpy(buffer, source, entry.UncompressedSize);
+            return true;
+        case PackCompression::LZ4:
+        {
+            int result = tracy::LZ4_decompress_safe((const char*)source, (char*)buffer, int(entry.Size), int(entry.UncompressedSize));
+            return result == int(entry.UncompressedSize);
+        }
+        case PackCompression::Deflate:
+        {
+            mz_ulong destLength = mz_ulong(entry.UncompressedSize);
+            int result          = mz_uncompress(buffer, &destLength, source, mz_ulong(entry.Size));
+            return result == MZ_OK && destLength == entry.UncompressedSize;
+        }
+        default:
+            LUMOS_LOG_ERROR("Unknown pack compression {0}", int(entry.Compression));
+            return false;
+        }
+    }
+
+    void PackFileWriter::AddFile(const std::string& path, const uint8_t* data, uint64_t size, PackCompression compression)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        PendingEntry& entry    = m_Entries.emplace_back();
+        entry.Path             = path;
+        entry.UncompressedSize = size;
+        entry.Compression      = PackCompression::None;
+
+        std::replace(entry.Path.begin(), entry.Path.end(), '\\', '/');
+        while(!entry.Path.empty() && entry.Path.front() == '/')
+            entry.Path.erase(0, 1);
+
+        if(compression == PackCompression::LZ4 && size > 0 && size < LZ4_MAX_INPUT_SIZE)
+        {
+            entry.Data.resize(tracy::LZ4_compressBound(int(size)));
+            int compressedSize = tracy::LZ4_compress_default((const char*)data, (char*)entry.Data.data(), int(size), int(entry.Data.size()));
+            entry.Data.resize(compressedSize > 0 ? compressedSize : 0);
+        }
+        else if(compression == PackCompression::Deflate && size > 0)
+        {
+            mz_ulong compressedSize = mz_compressBound(mz_ulong(size));
+            entry.Data.resize(compressedSize);
+            if(mz_compress2(entry.Data.data(), &compressedSize, data, mz_ulong(size), MZ_BEST_COMPRESSION) != MZ_OK)
+                compressedSize = 0;
+            entry.Data.resize(compressedSize);
+        }
+
+        // Not worth decompressing if it saves less than an eighth, and stored entries can be read in place
+        if(!entry.Data.empty() && entry.Data.size() < size - size / 8)
+        {
+            entry.Compression = compression;
+        }
+        else
+        {
+            entry.Data.assign(data, data + size);
+        }
+    }
+
+    bool PackFileWriter::Write(const std::string& physicalPath)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        std::sort(m_Entries.begin(), m_Entries.end(), [](const PendingEntry& a, const PendingEntry& b)
+                  { return PackFile::HashPath(a.Path) < PackFile::HashPath(b.Path); });
+
+        std::vector<PackEntry> entries(m_Entries.size());
+        std::string stringTable;
+
+        uint64_t offset = sizeof(PackHeader);
+        for(size_t i = 0; i < m_Entries.size(); i++)
+        {
+            offset = (offset + PackFile::DataAlignment - 1) & ~(PackFile::DataAlignment - 1);
+
+            PackEntry& entry       = entries[i];
+            entry                  = {};
+            entry.PathHash         = PackFile::HashPath(m_Entries[i].Path);
+            entry.Offset           = offset;
+            entry.Size             = m_Entries[i].Data.size();
+            entry.UncompressedSize = m_Entries[i].UncompressedSize;
+            entry.PathOffset       = uint32_t(stringTable.size());
+            entry.PathLength       = uint32_t(m_Entries[i].Path.size());
+            entry.Compression      = m_Entries[i].Compression;
+
+            stringTable += m_Entries[i].Path;
+            offset += entry.Size;
+        }
+
+        PackHeader header;
+        memcpy(header.Magic, PackFile::Magic, sizeof(header.Magic));
+        header.Version           = PackFile::Version;
+        header.EntryCount        = uint32_t(entries.size());
+        header.EntryTableOffset  = (offset + PackFile::DataAlignment - 1) & ~(PackFile::DataAlignment - 1);
+        header.StringTableOffset = header.EntryTableOffset + entries.size() * sizeof(PackEntry);
+        header.StringTableSize   = uint32_t(stringTable.size());
+
+        std::ofstream file(physicalPath, std::ios::binary | std::ios::trunc);
+        if(!file)
+        {
+            LUMOS_LOG_ERROR("Failed to open {0} for writing", physicalPath);
+            return false;
+        }
+
+        static const char padding[PackFile::DataAlignment] = {};
+        auto writePadding                                  = [&](uint64_t target)
+        {
+            uint64_t position = uint64_t(file.tellp());
+            if(target > position)
+                file.write(padding, target - position);
+        };
+
+        file.write((const char*)&header, sizeof(PackHeader));
+        for(size_t i = 0; i < m_Entries.size(); i++)
+        {
+            writePadding(entries[i].Offset);
+            file.write((const char*)m_Entries[i].Data.data(), m_Entries[i].Data.size());
+        }
+
+        writePadding(header.EntryTableOffset);
+        file.write((const char*)entries.data(), entries.size() * sizeof(PackEntry));
+        file.write(stringTable.data(), stringTable.size());
+
+        return bool(file);
+    }
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include <string_view>
+
+namespace Lumos
+{
+    enum class PackCompression : uint8_t
+    {
+        None    = 0,
+        LZ4     = 1,
+        Deflate = 2
+    };
+
+    struct PackHeader
+    {
+        char Magic[4];
+        uint32_t Version;
+        uint32_t EntryCount;
+        uint32_t StringTableSize;
+        uint64_t EntryTableOffset;
+        uint64_t StringTableOffset;
+    };
+
+    struct PackEntry
+    {
+        uint64_t PathHash;
+        uint64_t Offset;
+        uint64_t Size; // Size stored in the pack
+        uint64_t UncompressedSize;
+        uint32_t PathOffset; // Into the string table
+        uint32_t PathLength;
+        PackCompression Compression;
+        uint8_t Padding[7];
+    };
+
+    // Single indexed archive of many files. The whole file is memory mapped when opened,
+    // entries are sorted by path hash so lookups are a binary search over the mapped table.
+    // All const functions are safe to call from multiple threads
+    class LUMOS_EXPORT PackFile
+    {
+    public:
+        static constexpr char Magic[4]          = { 'L', 'P', 'A', 'K' };
+        static constexpr uint32_t Version       = 1;
+        static constexpr uint64_t DataAlignment = 16;
+
+        PackFile() = default;
+        ~PackFile();
+
+        NONCOPYABLE(PackFile);
+
+        bool Open(const std::string& physicalPath);
+        void Close();
+
+        bool IsOpen() const { return m_Data != nullptr; }
+        const std::string& GetPhysicalPath() const { return m_PhysicalPath; }
+
+        // Paths are relative to the pack root, using '/' separators
+        const PackEntry* Find(std::string_view path) const;
+        std::string_view GetPath(const PackEntry& entry) const;
+
+        uint32_t GetEntryCount() const { return m_Header ? m_Header->EntryCount : 0; }
+        const PackEntry* GetEntries() const { return m_Entries; }
+
+        // Points straight into the mapping, only valid while the pack is open.
+        // Returns nullptr for compressed entries, use Read for those
+        const uint8_t* GetData(const PackEntry& entry) const;
+
+        // Copies or decompresses an entry into buffer, which must hold entry.UncompressedSize bytes
+        bool Read(const PackEntry& entry, uint8_t* buffer) const;
+
+        static uint64_t HashPath(std::string_view path);
+
+    private:
+        std::string m_PhysicalPath;
+        uint8_t* m_Data            = nullptr;
+        int64_t m_Size             = 0;
+        const PackHeader* m_Header = nullptr;
+        const PackEntry* m_Entries = nullptr;
+        const char* m_StringTable  = nullptr;
+    };
+
+    class LUMOS_EXPORT PackFileWriter
+    {
+    public:
+        // Compresses straight away. Falls back to storing the data as is when compression doesn't save enough
+        void AddFile(const std::string& path, const uint8_t* data, uint64_t size, PackCompression compression = PackCompression::LZ4);
+        bool Write(const std::string& physicalPath);
+
+        size_t GetEntryCount() const { return m_Entries.size(); }
+
+    private:
+        struct PendingEntry
+        {
+            std::string Path;
+            std::vector<uint8_t> Data;
+            uint64_t UncompressedSize;
+            PackCompression Compression;
+        };
+
+        std::vector<PendingEntry> m_Entries;
+    };
+}
@@ -16,6 +16,7 @@
 #define LUMOS_PROFILE_LOCK(type, var, name) TracyLockableN(type, var, name)
 #define LUMOS_PROFILE_LOCKMARKER(var) LockMark(var)
 #define LUMOS_PROFILE_SETTHREADNAME(name) tracy::SetThreadName(name)
+#define LUMOS_PROFILE_ZONE_NAME(name, size) ZoneName(name, size)
 
 #if LUMOS_PROFILE_LOW
 #define LUMOS_PROFILE_FUNCTION_LOW() ZoneScoped
@@ -32,6 +33,7 @@
 #define LUMOS_PROFILE_LOCK(type, var, name) type var
 #define LUMOS_PROFILE_LOCKMARKER(var)
 #define LUMOS_PROFILE_SETTHREADNAME(name)
+#define LUMOS_PROFILE_ZONE_NAME(name, size)
 #define LUMOS_PROFILE_FUNCTION_LOW()
 #define LUMOS_PROFILE_SCOPE_LOW(name)
 
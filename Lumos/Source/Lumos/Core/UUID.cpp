@@ -14,9 +14,4 @@ namespace Lumos
         : m_UUID(uuid)
     {
     }
-
-    UUID::UUID(const UUID& other)
-        : m_UUID(other.m_UUID)
-    {
-    }
 }
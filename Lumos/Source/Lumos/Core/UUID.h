@@ -9,7 +9,7 @@ namespace Lumos
     public:
         UUID();
         UUID(uint64_t uuid);
-        UUID(const UUID& other);
+        UUID(const UUID& other) = default;
 
         ~UUID() = default;
         operator uint64_t() { return m_UUID; }
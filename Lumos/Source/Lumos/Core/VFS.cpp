@@ -2,9 +2,25 @@
 #include "VFS.h"
 #include "StringUtilities.h"
 #include "OS/FileSystem.h"
+#include "PackFile.h"
+#include "Application.h"
+#include "JobSystem.h"
+
+#include <filesystem>
 
 namespace Lumos
 {
+    void VFSFile::Release()
+    {
+        if(Mapping)
+            FileSystem::UnmapFile(Mapping, Size);
+
+        Data    = nullptr;
+        Size    = 0;
+        Mapping = nullptr;
+        Storage.clear();
+    }
+
     void VFS::Mount(const std::string& virtualPath, const std::string& physicalPath, bool replace)
     {
         LUMOS_PROFILE_FUNCTION();
@@ -15,10 +31,137 @@ namespace Lumos
         m_MountPoints[virtualPath].push_back(physicalPath);
     }
 
+    void VFS::MountPack(const std::string& virtualPath, const SharedPtr<PackFile>& pack, const std::string& prefix, bool replace)
+    {
+        LUMOS_PROFILE_FUNCTION();
+
+        if(replace)
+            m_PackMountPoints[virtualPath].clear();
+
+        m_PackMountPoints[virtualPath].push_back({ pack, prefix });
+    }
+
     void VFS::Unmount(const std::string& path)
     {
         LUMOS_PROFILE_FUNCTION();
         m_MountPoints[path].clear();
+        m_PackMountPoints[path].clear();
+    }
+
+    const PackEntry* VFS::FindPackEntry(const std::string& path, const PackFile*& outPack)
+    {
+        LUMOS_PROFILE_FUNCTION_LOW();
+        if(m_PackMountPoints.empty() || path.size() < 3 || !(path[0] == '/' && path[1] == '/'))
+            return nullptr;
+
+        auto slash                  = path.find_first_of('/', 2);
+        std::string_view virtualDir = std::string_view(path).substr(2, slash - 2);
+
+        auto it = m_PackMountPoints.find(virtualDir);
+        if(it == m_PackMountPoints.end() || slash == std::string::npos)
+            return nullptr;
+
+        std::string_view remainder = std::string_view(path).substr(slash + 1);
+        std::string packPath;
+        for(const PackMount& mount : it->second)
+        {
+            packPath.assign(mount.Prefix);
+            packPath.append(remainder);
+
+            if(const PackEntry* entry = mount.Pack->Find(packPath))
+            {
+                outPack = mount.Pack.get();
+                return entry;
+            }
+        }
+
+        return nullptr;
+    }
+
+    // Extracted copies are only rewritten when the pack is newer
+    static bool ExtractPackEntry(const PackFile& pack, const PackEntry& entry, const std::string& extractedPath)
+    {
+        if(FileSystem::FileExists(extractedPath) && FileSystem::GetLastModifiedTime(extractedPath) >= FileSystem::GetLastModifiedTime(pack.GetPhysicalPath()))
+            return true;
+
+        std::vector<uint8_t> data(entry.UncompressedSize);
+        std::filesystem::create_directories(std::filesystem::path(extractedPath).parent_path());
+        if(!pack.Read(entry, data.data()) || !FileSystem::WriteFile(extractedPath, data.data(), uint32_t(data.size())))
+        {
+            LUMOS_LOG_ERROR("Failed to extract {0} from pack {1}", extractedPath, pack.GetPhysicalPath());
+            return false;
+        }
+
+        return true;
+    }
+
+    bool VFS::ExtractFromPack(const std::string& path, std::string& outPhysicalPath, bool folder)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        if(m_PackMountPoints.empty() || path.size() < 3 || !(path[0] == '/' && path[1] == '/'))
+            return false;
+
+        const std::string extractedPath = Application::Get().GetCachePath() + "Packs/" + path.substr(2);
+        if(!folder)
+        {
+            const PackFile* pack;
+            const PackEntry* entry = FindPackEntry(path, pack);
+            if(!entry || !ExtractPackEntry(*pack, *entry, extractedPath))
+                return false;
+
+            outPhysicalPath = extractedPath;
+            return true;
+        }
+
+        auto slash                  = path.find_first_of('/', 2);
+        std::string_view virtualDir = std::string_view(path).substr(2, slash - 2);
+
+        auto it = m_PackMountPoints.find(virtualDir);
+        if(it == m_PackMountPoints.end())
+            return false;
+
+        std::string remainder = slash == std::string::npos ? "" : path.substr(slash + 1);
+        if(!remainder.empty() && remainder.back() != '/')
+            remainder += '/';
+
+        std::string extractedFolder = extractedPath;
+        if(extractedFolder.back() != '/')
+            extractedFolder += '/';
+
+        bool found = false;
+        for(const PackMount& mount : it->second)
+        {
+            const std::string packFolder = mount.Prefix + remainder;
+            const PackEntry* entries     = mount.Pack->GetEntries();
+            for(uint32_t i = 0; i < mount.Pack->GetEntryCount(); i++)
+            {
+                std::string_view entryPath = mount.Pack->GetPath(entries[i]);
+                if(entryPath.size() <= packFolder.size() || entryPath.compare(0, packFolder.size(), packFolder) != 0)
+                    continue;
+
+                found |= ExtractPackEntry(*mount.Pack, entries[i], extractedFolder + std::string(entryPath.substr(packFolder.size())));
+            }
+        }
+
+        if(found)
+            outPhysicalPath = extractedPath;
+
+        return found;
+    }
+
+    bool VFS::FileExists(const std::string& path)
+    {
+        if(IsPacked(path))
+            return true;
+
+        std::string physicalPath;
+        return ResolvePhysicalPath(path, physicalPath);
+    }
+
+    bool VFS::IsPacked(const std::string& path)
+    {
+        const PackFile* pack;
+        return FindPackEntry(path, pack) != nullptr;
     }
 
     bool VFS::ResolvePhysicalPath(const std::string& path, std::string& outPhysicalPath, bool folder)
@@ -58,9 +201,30 @@ namespace Lumos
         return false;
     }
 
+    bool VFS::ExtractPhysicalPath(const std::string& path, std::string& outPhysicalPath, bool folder)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        if(ResolvePhysicalPath(path, outPhysicalPath, folder))
+            return true;
+
+        return ExtractFromPack(path, outPhysicalPath, folder);
+    }
+
     uint8_t* VFS::ReadFile(const std::string& path)
     {
         LUMOS_PROFILE_FUNCTION();
+        const PackFile* pack;
+        if(const PackEntry* entry = FindPackEntry(path, pack))
+        {
+            uint8_t* buffer = new uint8_t[entry->UncompressedSize];
+            if(pack->Read(*entry, buffer))
+                return buffer;
+
+            LUMOS_LOG_ERROR("Failed to read {0} from pack {1}", path, pack->GetPhysicalPath());
+            delete[] buffer;
+            return nullptr;
+        }
+
         std::string physicalPath;
         return ResolvePhysicalPath(path, physicalPath) ? FileSystem::ReadFile(physicalPath) : nullptr;
     }
@@ -68,10 +232,98 @@ namespace Lumos
     std::string VFS::ReadTextFile(const std::string& path)
     {
         LUMOS_PROFILE_FUNCTION();
+        const PackFile* pack;
+        if(const PackEntry* entry = FindPackEntry(path, pack))
+        {
+            if(const uint8_t* data = pack->GetData(*entry))
+                return std::string((const char*)data, entry->UncompressedSize);
+
+            std::string text(entry->UncompressedSize, '\0');
+            return pack->Read(*entry, (uint8_t*)text.data()) ? text : "";
+        }
+
         std::string physicalPath;
         return ResolvePhysicalPath(path, physicalPath) ? FileSystem::ReadTextFile(physicalPath) : "";
     }
 
+    bool VFS::ReadFile(const std::string& path, VFSFile& outFile)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        outFile.Release();
+
+        const PackFile* pack;
+        if(const PackEntry* entry = FindPackEntry(path, pack))
+        {
+            outFile.Size = int64_t(entry->UncompressedSize);
+            outFile.Data = pack->GetData(*entry);
+            if(outFile.Data)
+                return true;
+
+            outFile.Storage.resize(entry->UncompressedSize);
+            if(!pack->Read(*entry, outFile.Storage.data()))
+            {
+                LUMOS_LOG_ERROR("Failed to read {0} from pack {1}", path, pack->GetPhysicalPath());
+                outFile.Storage.clear();
+                outFile.Size = 0;
+                return false;
+            }
+
+            outFile.Data = outFile.Storage.data();
+            return true;
+        }
+
+        std::string physicalPath;
+        if(!ResolvePhysicalPath(path, physicalPath))
+            return false;
+
+        int64_t size = FileSystem::GetFileSize(physicalPath);
+        if(size < 0)
+            return false;
+
+        outFile.Storage.resize(size);
+        if(size > 0 && !FileSystem::ReadFile(physicalPath, outFile.Storage.data(), size))
+        {
+            outFile.Storage.clear();
+            return false;
+        }
+
+        outFile.Data = outFile.Storage.data();
+        outFile.Size = size;
+        return true;
+    }
+
+    bool VFS::MapFile(const std::string& path, VFSFile& outFile)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        if(IsPacked(path))
+            return ReadFile(path, outFile);
+
+        outFile.Release();
+
+        std::string physicalPath;
+        if(!ResolvePhysicalPath(path, physicalPath))
+            return false;
+
+        int64_t size    = 0;
+        outFile.Mapping = FileSystem::MapFile(physicalPath, size);
+        if(!outFile.Mapping)
+            return false;
+
+        outFile.Data = outFile.Mapping;
+        outFile.Size = size;
+        return true;
+    }
+
+    void VFS::ReadFileAsync(const std::string& path, const std::function<void(bool, VFSFile&)>& onComplete)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        System::JobSystem::Execute(m_AsyncContext, [this, path, onComplete](JobDispatchArgs args)
+                                   {
+                                       VFSFile file;
+                                       bool result = ReadFile(path, file);
+                                       onComplete(result, file); });
+    }
+
     bool VFS::WriteFile(const std::string& path, uint8_t* buffer, uint32_t size)
     {
         LUMOS_PROFILE_FUNCTION();
@@ -1,17 +1,49 @@
 #pragma once
 #include "Utilities/TSingleton.h"
+#include "Core/JobSystem.h"
 #include <map>
 
 namespace Lumos
 {
+    class PackFile;
+    struct PackEntry;
+
+    // Read only view of a file's contents. Points straight into a mounted pack for entries stored
+    // without compression or into a mapping of a loose file, otherwise Storage owns the data
+    struct LUMOS_EXPORT VFSFile
+    {
+        VFSFile() = default;
+        ~VFSFile() { Release(); }
+
+        NONCOPYABLE(VFSFile);
+
+        void Release();
+
+        const uint8_t* Data = nullptr;
+        int64_t Size        = 0;
+        std::vector<uint8_t> Storage;
+        uint8_t* Mapping = nullptr;
+    };
+
     class LUMOS_EXPORT VFS : public ThreadSafeSingleton<VFS>
     {
         friend class ThreadSafeSingleton<VFS>;
 
     public:
         void Mount(const std::string& virtualPath, const std::string& physicalPath, bool replace = false);
+
+        // Packs are searched before physical directories mounted at the same virtual path.
+        // prefix selects a folder inside the pack, e.g. "Meshes/"
+        void MountPack(const std::string& virtualPath, const SharedPtr<PackFile>& pack, const std::string& prefix = "", bool replace = false);
         void Unmount(const std::string& path);
+
         bool ResolvePhysicalPath(const std::string& path, std::string& outPhysicalPath, bool folder = false);
+
+        // Same as ResolvePhysicalPath, but packed entries are extracted into Cache/Packs/ first.
+        // Only for loaders that hand a path to a library which opens its own files, currently the model
+        // importers and Lua scripts (require searches package.path). Everything else reads through ReadFile.
+        // Extracting a folder extracts everything under it, so files referenced relative to each other resolve too
+        bool ExtractPhysicalPath(const std::string& path, std::string& outPhysicalPath, bool folder = false);
         bool AbsoulePathToVFS(const std::string& path, std::string& outVFSPath, bool folder = false);
         inline std::string AbsoulePathToVFS(const std::string& path, bool folder = false)
         {
@@ -20,13 +52,36 @@ namespace Lumos
             return returnString;
         }
 
+        bool FileExists(const std::string& path);
+        bool IsPacked(const std::string& path);
+
         uint8_t* ReadFile(const std::string& path);
         std::string ReadTextFile(const std::string& path);
 
+        // Zero copy for uncompressed pack entries, the view is valid while the pack stays mounted
+        bool ReadFile(const std::string& path, VFSFile& outFile);
+
+        // Same as ReadFile, but loose files are memory mapped instead of copied
+        bool MapFile(const std::string& path, VFSFile& outFile);
+
+        // Reads on a job thread and calls onComplete there
+        void ReadFileAsync(const std::string& path, const std::function<void(bool, VFSFile&)>& onComplete);
+
         bool WriteFile(const std::string& path, uint8_t* buffer, uint32_t size);
         bool WriteTextFile(const std::string& path, const std::string& text);
 
     private:
+        struct PackMount
+        {
+            SharedPtr<PackFile> Pack;
+            std::string Prefix;
+        };
+
+        const PackEntry* FindPackEntry(const std::string& path, const PackFile*& outPack);
+        bool ExtractFromPack(const std::string& path, std::string& outPhysicalPath, bool folder);
+
         std::map<std::string, std::vector<std::string>, std::less<void>> m_MountPoints;
+        std::map<std::string, std::vector<PackMount>, std::less<void>> m_PackMountPoints;
+        System::JobSystem::Context m_AsyncContext;
     };
 }
@@ -26,4 +26,17 @@ namespace Lumos
             return;
         }
     }
+
+    Animation::Animation(const std::string& filename, const std::string& animationName, SharedPtr<Skeleton> skeleton, const SharedPtr<ozz::animation::Animation>& animation)
+        : m_Skeleton(skeleton)
+        , m_FilePath(filename)
+        , m_AnimationName(animationName)
+        , m_Animation(animation)
+    {
+        if(!m_Animation || !skeleton.get() || !skeleton->IsValid())
+        {
+            LUMOS_LOG_ERROR("Invalid animation {0} in file '{1}'", animationName, m_FilePath);
+            SetFlag(AssetFlag::Invalid);
+        }
+    }
 }
@@ -22,6 +22,7 @@ namespace Lumos
     {
     public:
         Animation(const std::string& filename, const std::string& animationName, SharedPtr<Skeleton> skeleton);
+        Animation(const std::string& filename, const std::string& animationName, SharedPtr<Skeleton> skeleton, const SharedPtr<ozz::animation::Animation>& animation);
 
         virtual ~Animation() = default;
 
@@ -42,6 +43,6 @@ namespace Lumos
         SharedPtr<Skeleton> m_Skeleton;
         std::string m_FilePath;
         std::string m_AnimationName;
-        ozz::unique_ptr<ozz::animation::Animation> m_Animation;
+        SharedPtr<ozz::animation::Animation> m_Animation;
     };
 }
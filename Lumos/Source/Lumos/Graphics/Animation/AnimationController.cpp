@@ -9,6 +9,7 @@
 #include <ozz/animation/runtime/local_to_model_job.h>
 #include <ozz/animation/runtime/sampling_job.h>
 #include <ozz/base/span.h>
+#include <ozz/base/maths/soa_float4x4.h>
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/quaternion.hpp>
@@ -24,7 +25,11 @@ namespace Lumos
         : LocalTranslations(other.LocalTranslations)
         , LocalScales(other.LocalScales)
         , LocalRotations(other.LocalRotations)
+        , ModelMatrices(other.ModelMatrices)
         , m_LocalSpaceSoaTransforms(other.m_LocalSpaceSoaTransforms)
+        , m_ModelSpaceTransforms(other.m_ModelSpaceTransforms)
+        , m_LeafLocalTransforms(other.m_LeafLocalTransforms)
+        , m_LeafLocalsValid(other.m_LeafLocalsValid)
     {
         m_Context.Resize(other.m_Context.max_tracks());
     }
@@ -34,7 +39,11 @@ namespace Lumos
         LocalTranslations         = other.LocalTranslations;
         LocalScales               = other.LocalScales;
         LocalRotations            = other.LocalRotations;
+        ModelMatrices             = other.ModelMatrices;
         m_LocalSpaceSoaTransforms = other.m_LocalSpaceSoaTransforms;
+        m_ModelSpaceTransforms    = other.m_ModelSpaceTransforms;
+        m_LeafLocalTransforms     = other.m_LeafLocalTransforms;
+        m_LeafLocalsValid         = other.m_LeafLocalsValid;
 
         m_Context.Resize(other.m_Context.max_tracks());
         return *this;
@@ -49,6 +58,10 @@ namespace Lumos
             LocalTranslations.resize(size);
             LocalScales.resize(size);
             LocalRotations.resize(size);
+            ModelMatrices.resize(size);
+            m_ModelSpaceTransforms.resize(size);
+            m_LeafLocalTransforms.resize(size);
+            m_LeafLocalsValid = false;
         }
     }
 
@@ -80,9 +93,130 @@ namespace Lumos
             updateSampling(ratio, context);
         }
     }
+    float AnimationController::GetDuration(size_t stateIndex) const
+    {
+        if(stateIndex >= m_AnimationStates.size())
+            return 0.0f;
+
+        return m_AnimationStates[stateIndex]->GetAnimation().duration();
+    }
+
+    void AnimationController::UpdateModelSpace(size_t stateIndex, float& animationTime, SamplingContext& context, bool skipLeafJoints) const
+    {
+        LUMOS_PROFILE_FUNCTION_LOW();
+        if(stateIndex >= m_AnimationStates.size() || !m_Skeleton.get() || !m_Skeleton->IsValid())
+            return;
+
+        const ozz::animation::Animation& animation = m_AnimationStates[stateIndex]->GetAnimation();
+        const ozz::animation::Skeleton& skeleton   = m_Skeleton->GetSkeleton();
+
+        float ratio = animationTime / animation.duration();
+        if(ratio >= 1.0f)
+        {
+            animationTime = 0.0f;
+            ratio         = 0.0f;
+        }
+
+        context.resize(skeleton.num_joints());
+        context.resizeSao(skeleton.num_soa_joints());
+
+        ozz::animation::SamplingJob samplingJob;
+        samplingJob.animation = &animation;
+        samplingJob.context   = &context.m_Context;
+        samplingJob.ratio     = ratio;
+        samplingJob.output    = ozz::make_span(context.m_LocalSpaceSoaTransforms);
+        if(!samplingJob.Run())
+        {
+            LUMOS_LOG_ERROR("ozz animation sampling job failed!");
+            return;
+        }
+
+        if(skipLeafJoints && m_LeafJoints.size() == size_t(skeleton.num_joints()))
+        {
+            localToModelSkippingLeaves(context);
+        }
+        else
+        {
+            ozz::animation::LocalToModelJob localToModelJob;
+            localToModelJob.skeleton = &skeleton;
+            localToModelJob.input    = ozz::make_span(context.m_LocalSpaceSoaTransforms);
+            localToModelJob.output   = ozz::make_span(context.m_ModelSpaceTransforms);
+            if(!localToModelJob.Run())
+            {
+                LUMOS_LOG_ERROR("ozz local to model job failed!");
+                return;
+            }
+
+            // Leaves pick up the current pose the next time the instance drops to a reduced update
+            context.m_LeafLocalsValid = false;
+        }
+
+        for(size_t i = 0; i < context.m_ModelSpaceTransforms.size(); i++)
+        {
+            const ozz::math::Float4x4& transform = context.m_ModelSpaceTransforms[i];
+            for(int column = 0; column < 4; column++)
+                ozz::math::StorePtrU(transform.cols[column], glm::value_ptr(context.ModelMatrices[i][column]));
+        }
+    }
+
+    void AnimationController::localToModelSkippingLeaves(SamplingContext& context) const
+    {
+        LUMOS_PROFILE_FUNCTION_LOW();
+        // Same as LocalToModelJob over the whole skeleton, except leaf joints reuse a cached local matrix
+        const auto parents     = m_Skeleton->GetSkeleton().joint_parents();
+        const int jointCount   = int(parents.size());
+        const bool cacheLeaves = !context.m_LeafLocalsValid;
+
+        for(int first = 0; first < jointCount; first += 4)
+        {
+            const int last = std::min(first + 4, jointCount);
+
+            bool needsLocals = cacheLeaves;
+            for(int joint = first; joint < last && !needsLocals; joint++)
+                needsLocals = !m_LeafJoints[joint];
+
+            ozz::math::Float4x4 localMatrices[4];
+            if(needsLocals)
+            {
+                const ozz::math::SoaTransform& transform = context.m_LocalSpaceSoaTransforms[first / 4];
+                const ozz::math::SoaFloat4x4 soaMatrices = ozz::math::SoaFloat4x4::FromAffine(transform.translation, transform.rotation, transform.scale);
+                ozz::math::Transpose16x16(&soaMatrices.cols[0].x, localMatrices->cols);
+            }
+
+            for(int joint = first; joint < last; joint++)
+            {
+                const ozz::math::Float4x4* local = &localMatrices[joint & 3];
+                if(m_LeafJoints[joint])
+                {
+                    if(cacheLeaves)
+                        context.m_LeafLocalTransforms[joint] = *local;
+                    local = &context.m_LeafLocalTransforms[joint];
+                }
+
+                const int parent                      = parents[joint];
+                context.m_ModelSpaceTransforms[joint] = parent == ozz::animation::Skeleton::kNoParent ? *local : context.m_ModelSpaceTransforms[parent] * *local;
+            }
+        }
+
+        context.m_LeafLocalsValid = true;
+    }
+
     void AnimationController::SetSkeleton(const SharedPtr<Skeleton>& skeleton)
     {
         m_Skeleton = skeleton;
+
+        // A joint is a leaf when nothing lists it as a parent
+        m_LeafJoints.clear();
+        if(m_Skeleton && m_Skeleton->IsValid())
+        {
+            const auto parents = m_Skeleton->GetSkeleton().joint_parents();
+            m_LeafJoints.assign(parents.size(), true);
+            for(int16_t parent : parents)
+            {
+                if(parent != ozz::animation::Skeleton::kNoParent)
+                    m_LeafJoints[parent] = false;
+            }
+        }
     }
     void AnimationController::SetCurrentState(const std::string& name)
     {
@@ -28,6 +28,9 @@ namespace Lumos
         std::vector<glm::vec3> LocalScales;
         std::vector<glm::quat> LocalRotations;
 
+        // Joint transforms relative to the skeleton root, filled by AnimationController::UpdateModelSpace
+        std::vector<glm::mat4> ModelMatrices;
+
     private:
         void resize(uint32_t size);
         void resizeSao(uint32_t size);
@@ -35,6 +38,9 @@ namespace Lumos
     private:
         ozz::animation::SamplingJob::Context m_Context;
         ozz::vector<ozz::math::SoaTransform> m_LocalSpaceSoaTransforms;
+        ozz::vector<ozz::math::Float4x4> m_ModelSpaceTransforms;
+        ozz::vector<ozz::math::Float4x4> m_LeafLocalTransforms;
+        bool m_LeafLocalsValid = false;
 
         uint32_t m_SaoSize = 0;
         uint32_t m_Size    = 0;
@@ -50,6 +56,14 @@ namespace Lumos
 
         void Update(float& animationTime, SamplingContext& context);
 
+        // Samples stateIndex and runs the local to model job, skipping the local space conversion.
+        // Only touches context so many instances can share the controller and update on job threads.
+        // With skipLeafJoints, joints without children keep the local transform from the first reduced update
+        // and follow their parent, and soa groups made up only of leaves are not converted at all
+        void UpdateModelSpace(size_t stateIndex, float& animationTime, SamplingContext& context, bool skipLeafJoints = false) const;
+
+        float GetDuration(size_t stateIndex) const;
+
         void SetSkeleton(const SharedPtr<Skeleton>& skeleton);
         void SetCurrentState(size_t index) { m_StateIndex = index; };
         void SetCurrentState(const std::string& name);
@@ -67,9 +81,11 @@ namespace Lumos
 
     private:
         void updateSampling(float ratio, SamplingContext& context);
+        void localToModelSkippingLeaves(SamplingContext& context) const;
 
     private:
         SharedPtr<Skeleton> m_Skeleton;
+        std::vector<bool> m_LeafJoints;
         std::vector<SharedPtr<Animation>> m_AnimationStates;
         std::vector<std::string> m_AnimationNames;
 
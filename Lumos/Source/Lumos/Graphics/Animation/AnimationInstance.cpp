@@ -0,0 +1,336 @@
+#include "Precompiled.h"
+#include "AnimationInstance.h"
+#include "Graphics/Model.h"
+#include "Graphics/RHI/Renderer.h"
+#include "Graphics/RHI/SwapChain.h"
+#include "Graphics/Renderers/GPUSkinning.h"
+#include "Maths/BoundingBox.h"
+
+namespace Lumos
+{
+    AnimationLODSettings AnimationInstance::s_LODSettings;
+    AnimationLODStats AnimationInstance::s_LODStats;
+    bool AnimationInstance::s_CPUSkinning = false;
+
+    void AnimationPoseCache::Clear()
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Poses.clear();
+    }
+
+    SharedPtr<AnimationInstance> AnimationPoseCache::FindOrAdd(const Key& key, const SharedPtr<AnimationInstance>& instance)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        return m_Poses.emplace(key, instance).first->second;
+    }
+
+    AnimationInstance::AnimationInstance(const SharedPtr<Graphics::Model>& model)
+        : m_Model(model)
+    {
+        const auto& meshes = m_Model->GetMeshes();
+        m_SkinnedMeshes.resize(meshes.size());
+
+        size_t jointCount = m_Model->GetInverseBindPoses().size();
+
+        for(size_t i = 0; i < meshes.size(); i++)
+        {
+            if(!meshes[i]->IsSkinned() || jointCount == 0)
+                continue;
+
+            SkinnedMesh& skinnedMesh = m_SkinnedMeshes[i];
+            skinnedMesh.Skinned      = true;
+            skinnedMesh.BoundingBox  = CreateSharedPtr<Maths::BoundingBox>(*meshes[i]->GetBoundingBox());
+
+            std::vector<bool> used(jointCount, false);
+            for(const auto& influences : meshes[i]->GetSkin())
+            {
+                for(int j = 0; j < 4; j++)
+                {
+                    if(influences.Weights[j] > 0.0f)
+                        used[Maths::Min(size_t(influences.Joints[j]), jointCount - 1)] = true;
+                }
+            }
+
+            for(size_t joint = 0; joint < jointCount; joint++)
+            {
+                if(used[joint])
+                    skinnedMesh.Joints.push_back(uint32_t(joint));
+            }
+        }
+
+        m_JointMatrices.resize(jointCount, glm::mat4(1.0f));
+
+        // Spread the reduced rate updates of instances created together over different frames
+        static std::atomic<uint32_t> s_InstanceCount = 0;
+        m_Phase                                      = s_InstanceCount++;
+    }
+
+    AnimationInstance::~AnimationInstance()
+    {
+    }
+
+    void AnimationInstance::Update(float dt, AnimationPoseCache& poseCache, const SharedPtr<AnimationInstance>& self)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        const auto& controller = m_Model->GetAnimationController();
+        bool wasSharing        = bool(m_PoseSource);
+        m_PoseSource           = nullptr;
+
+        if(!controller || !Playing || m_JointMatrices.empty())
+            return;
+
+        m_Time += dt * Speed;
+        float duration = controller->GetDuration(m_State);
+        if(duration > 0.0f && m_Time >= duration)
+            m_Time = fmodf(m_Time, duration);
+
+        const AnimationLODSettings& settings = s_LODSettings;
+        bool skipLeafJoints                  = false;
+        bool sharePose                       = false;
+        m_Interval                           = 1;
+        m_Interpolate                        = false;
+
+        if(settings.Enabled)
+        {
+            if(m_ScreenSize <= 0.0f)
+            {
+                m_Interval     = settings.OffscreenInterval;
+                sharePose      = true;
+                skipLeafJoints = true;
+            }
+            else if(m_ScreenSize < settings.ReducedRatePixels)
+            {
+                m_Interval     = settings.DistantInterval;
+                sharePose      = true;
+                skipLeafJoints = true;
+            }
+            else if(m_ScreenSize < settings.FullRatePixels)
+            {
+                m_Interval     = settings.ReducedInterval;
+                m_Interpolate  = true;
+                skipLeafJoints = true;
+            }
+        }
+
+        if(!m_Interpolate)
+            m_HasTarget = false;
+
+        m_Interval       = Maths::Max(m_Interval, 1u);
+        uint32_t step    = (m_UpdateCount++ + m_Phase) % m_Interval;
+        bool updateDue   = step == 0 || !m_HasPose;
+        float sampleTime = m_Time;
+
+        if(sharePose)
+        {
+            // Keep following while a shared pose exists so the instance never falls back to its own stale vertices
+            if(!updateDue && !wasSharing)
+            {
+                s_LODStats.Skipped++;
+                return;
+            }
+
+            int64_t poseIndex = int64_t(m_Time * settings.SharedPoseRate);
+            auto owner        = poseCache.FindOrAdd({ m_Model.get(), m_State, poseIndex }, self);
+            if(owner.get() != this)
+            {
+                m_PoseSource = owner;
+                s_LODStats.Shared++;
+                return;
+            }
+
+            sampleTime = float(poseIndex) / settings.SharedPoseRate;
+        }
+        else if(!updateDue)
+        {
+            if(m_Interpolate && m_HasTarget)
+            {
+                BlendJointMatrices(float(step + 1) / float(m_Interval));
+                OnPoseChanged();
+                s_LODStats.Interpolated++;
+            }
+            else
+            {
+                s_LODStats.Skipped++;
+            }
+            return;
+        }
+
+        controller->UpdateModelSpace(m_State, sampleTime, m_SamplingContext, skipLeafJoints);
+        if(m_SamplingContext.ModelMatrices.empty())
+            return;
+
+        s_LODStats.Sampled++;
+
+        if(m_Interpolate && m_HasPose)
+        {
+            m_PreviousJointMatrices = m_JointMatrices;
+            BuildJointMatrices(m_TargetJointMatrices);
+            BlendJointMatrices(1.0f / float(m_Interval));
+            m_HasTarget = true;
+        }
+        else
+        {
+            BuildJointMatrices(m_JointMatrices);
+            m_HasTarget = false;
+        }
+
+        m_HasPose = true;
+        OnPoseChanged();
+    }
+
+    void AnimationInstance::BuildJointMatrices(std::vector<glm::mat4>& output) const
+    {
+        const auto& modelMatrices   = m_SamplingContext.ModelMatrices;
+        const auto& inverseBindPose = m_Model->GetInverseBindPoses();
+        const auto& jointRemaps     = m_Model->GetJointRemaps();
+
+        output.resize(inverseBindPose.size());
+        for(size_t i = 0; i < output.size(); i++)
+        {
+            uint32_t joint = Maths::Min(uint32_t(jointRemaps[i]), uint32_t(modelMatrices.size() - 1));
+            output[i]      = modelMatrices[joint] * inverseBindPose[i];
+        }
+    }
+
+    void AnimationInstance::BlendJointMatrices(float factor)
+    {
+        // Componentwise, close enough for the small steps between reduced rate updates
+        for(size_t i = 0; i < m_JointMatrices.size(); i++)
+            m_JointMatrices[i] = m_PreviousJointMatrices[i] + (m_TargetJointMatrices[i] - m_PreviousJointMatrices[i]) * factor;
+    }
+
+    void AnimationInstance::OnPoseChanged()
+    {
+        // Every skinned vertex is a weighted blend of its bind pose position moved by each of its joints, so it
+        // stays inside the bind pose bounds moved by every joint the mesh uses
+        const auto& meshes = m_Model->GetMeshes();
+        for(size_t i = 0; i < m_SkinnedMeshes.size() && i < meshes.size(); i++)
+        {
+            SkinnedMesh& skinnedMesh = m_SkinnedMeshes[i];
+            if(!skinnedMesh.Skinned)
+                continue;
+
+            if(s_CPUSkinning)
+            {
+                SkinMesh(*meshes[i], skinnedMesh);
+                continue;
+            }
+
+            const Maths::BoundingBox& bindBounds = *meshes[i]->GetBoundingBox();
+            Maths::BoundingBox bounds;
+            for(uint32_t joint : skinnedMesh.Joints)
+                bounds.Merge(bindBounds, m_JointMatrices[joint]);
+
+            *skinnedMesh.BoundingBox = bounds;
+        }
+
+        m_Generation++;
+    }
+
+    void AnimationInstance::SkinMesh(const Graphics::Mesh& source, SkinnedMesh& output)
+    {
+        LUMOS_PROFILE_FUNCTION_LOW();
+        const auto& bindVertices = source.GetVertices();
+        const auto& skin         = source.GetSkin();
+        const glm::uvec4 maxJoint(uint32_t(m_JointMatrices.size() - 1));
+
+        // Colours and uvs are never skinned, so they are only copied the first time
+        if(output.Vertices.size() != bindVertices.size())
+            output.Vertices = bindVertices;
+
+        Maths::BoundingBox bounds;
+
+        for(size_t v = 0; v < bindVertices.size(); v++)
+        {
+            const Graphics::Vertex& bindVertex     = bindVertices[v];
+            const Graphics::VertexSkin& influences = skin[v];
+            glm::uvec4 joints                      = glm::min(influences.Joints, maxJoint);
+
+            glm::mat4 skinMatrix = m_JointMatrices[joints.x] * influences.Weights.x;
+            skinMatrix += m_JointMatrices[joints.y] * influences.Weights.y;
+            skinMatrix += m_JointMatrices[joints.z] * influences.Weights.z;
+            skinMatrix += m_JointMatrices[joints.w] * influences.Weights.w;
+
+            // Joint transforms are rigid or uniformly scaled, so the upper 3x3 is good enough for normals
+            glm::mat3 normalMatrix = glm::mat3(skinMatrix);
+
+            Graphics::Vertex& vertex = output.Vertices[v];
+            vertex.Position          = glm::vec3(skinMatrix * glm::vec4(bindVertex.Position, 1.0f));
+            vertex.Normal            = glm::normalize(normalMatrix * bindVertex.Normal);
+            vertex.Tangent           = glm::normalize(normalMatrix * bindVertex.Tangent);
+            vertex.Bitangent         = glm::normalize(normalMatrix * bindVertex.Bitangent);
+
+            bounds.Merge(vertex.Position);
+        }
+
+        *output.BoundingBox = bounds;
+    }
+
+    void AnimationInstance::Skin(Graphics::GPUSkinning& skinning)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        if(m_PoseSource)
+        {
+            m_PoseSource->Skin(skinning);
+            return;
+        }
+
+        auto swapChain = Graphics::Renderer::GetMainSwapChain();
+        m_FrameIndex   = swapChain->GetCurrentBufferIndex();
+
+        const auto& meshes   = m_Model->GetMeshes();
+        uint32_t jointCount  = uint32_t(m_JointMatrices.size());
+        uint32_t jointOffset = ~0u;
+
+        for(size_t i = 0; i < m_SkinnedMeshes.size(); i++)
+        {
+            SkinnedMesh& skinnedMesh = m_SkinnedMeshes[i];
+            if(!skinnedMesh.Skinned)
+                continue;
+
+            uint32_t vertexCount = uint32_t(meshes[i]->GetVertices().size());
+            if(skinnedMesh.FrameViews.empty())
+            {
+                for(size_t frame = 0; frame < swapChain->GetSwapChainBufferCount(); frame++)
+                {
+                    auto vertexBuffer = SharedPtr<Graphics::VertexBuffer>(Graphics::VertexBuffer::Create(Graphics::BufferUsage::DYNAMIC));
+                    vertexBuffer->Resize(vertexCount * sizeof(Graphics::Vertex));
+                    skinnedMesh.FrameViews.push_back(meshes[i]->CreateInstanceView(vertexBuffer, skinnedMesh.BoundingBox));
+                }
+                skinnedMesh.FrameGenerations.resize(skinnedMesh.FrameViews.size(), ~0ull);
+            }
+
+            // Each buffer is only written once the frame that last used it has finished, and only when the pose changed
+            if(skinnedMesh.FrameGenerations[m_FrameIndex] == m_Generation)
+                continue;
+
+            skinnedMesh.FrameGenerations[m_FrameIndex] = m_Generation;
+
+            auto& vertexBuffer = skinnedMesh.FrameViews[m_FrameIndex]->GetVertexBuffer();
+            if(s_CPUSkinning)
+            {
+                // Nothing to upload until the next Update has skinned the vertices
+                if(!skinnedMesh.Vertices.empty())
+                    vertexBuffer->SetData(uint32_t(skinnedMesh.Vertices.size() * sizeof(Graphics::Vertex)), skinnedMesh.Vertices.data());
+                continue;
+            }
+
+            // Instances sharing this pose queue it again, the generation check above stops the second copy
+            if(jointOffset == ~0u)
+                jointOffset = skinning.AddPalette(m_JointMatrices);
+
+            skinning.AddMesh(meshes[i].get(), vertexBuffer.get(), jointOffset, jointCount);
+        }
+    }
+
+    Graphics::Mesh* AnimationInstance::GetSkinnedMesh(uint32_t meshIndex) const
+    {
+        if(m_PoseSource)
+            return m_PoseSource->GetSkinnedMesh(meshIndex);
+
+        if(meshIndex >= m_SkinnedMeshes.size() || m_SkinnedMeshes[meshIndex].FrameViews.empty())
+            return nullptr;
+
+        return m_SkinnedMeshes[meshIndex].FrameViews[m_FrameIndex].get();
+    }
+}
@@ -0,0 +1,159 @@
+#pragma once
+#include "AnimationController.h"
+#include "Graphics/Mesh.h"
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace Lumos
+{
+    namespace Graphics
+    {
+        class Model;
+        class GPUSkinning;
+    }
+
+    class AnimationInstance;
+
+    // Screen sizes are the projected size of the instance's bounds in pixels, as measured by the renderer last frame
+    struct AnimationLODSettings
+    {
+        bool Enabled               = true;
+        float FullRatePixels       = 300.0f; // Above this every frame, every joint
+        float ReducedRatePixels    = 80.0f;  // Above this every ReducedInterval frames, interpolated, leaf joints frozen
+        uint32_t ReducedInterval   = 2;
+        uint32_t DistantInterval   = 4; // Below ReducedRatePixels. Poses are shared between instances
+        uint32_t OffscreenInterval = 8;
+        float SharedPoseRate       = 15.0f; // Poses per second shared poses are quantised to
+    };
+
+    struct AnimationLODStats
+    {
+        std::atomic<uint32_t> Sampled      = 0;
+        std::atomic<uint32_t> Interpolated = 0;
+        std::atomic<uint32_t> Shared       = 0;
+        std::atomic<uint32_t> Skipped      = 0;
+
+        void Reset()
+        {
+            Sampled      = 0;
+            Interpolated = 0;
+            Shared       = 0;
+            Skipped      = 0;
+        }
+    };
+
+    // Poses sampled this frame by distant instances. Instances of the same model playing the same state
+    // at the same quantised time draw the first one's skinned vertices instead of sampling their own
+    class AnimationPoseCache
+    {
+    public:
+        using Key = std::tuple<const Graphics::Model*, size_t, int64_t>;
+
+        void Clear();
+
+        // Returns the instance that owns the pose for key, which is instance when nobody sampled it yet
+        SharedPtr<AnimationInstance> FindOrAdd(const Key& key, const SharedPtr<AnimationInstance>& instance);
+
+    private:
+        std::mutex m_Mutex;
+        std::map<Key, SharedPtr<AnimationInstance>> m_Poses;
+    };
+
+    // Per entity playback state and skinned vertices for a model with a skeleton.
+    // Update samples the pose and builds the joint palette, and can run for many instances in parallel on the job
+    // system. Skin queues the palette and this frame's vertex buffers on the GPU skinning pass, so every pass that
+    // draws the instance (depth, forward and each shadow cascade) reuses the same skinned vertices.
+    // Without GPU skinning Update also skins the vertices on the CPU and Skin uploads them
+    class LUMOS_EXPORT AnimationInstance
+    {
+    public:
+        AnimationInstance(const SharedPtr<Graphics::Model>& model);
+        ~AnimationInstance();
+
+        NONCOPYABLE(AnimationInstance);
+
+        // self must own this instance, it is what other instances keep when they share its pose
+        void Update(float dt, AnimationPoseCache& poseCache, const SharedPtr<AnimationInstance>& self);
+
+        // Render thread only. Skinning is skipped when the frame's buffers already hold the current pose
+        void Skin(Graphics::GPUSkinning& skinning);
+
+        // Set by the renderer when the skinning compute pass is unavailable
+        static void SetCPUSkinning(bool cpuSkinning) { s_CPUSkinning = cpuSkinning; }
+        static bool GetCPUSkinning() { return s_CPUSkinning; }
+
+        // View of mesh meshIndex drawing from the current frame's skinned vertices. nullptr for meshes without a skin
+        Graphics::Mesh* GetSkinnedMesh(uint32_t meshIndex) const;
+
+        // Set by the renderer each frame, 0 when culled. Picks the update rate for the next Update
+        void SetScreenSize(float pixels) { m_ScreenSize = pixels; }
+        float GetScreenSize() const { return m_ScreenSize; }
+
+        // Joint model matrices multiplied by the inverse bind poses, one per palette entry
+        const std::vector<glm::mat4>& GetJointMatrices() const { return m_JointMatrices; }
+        const SamplingContext& GetSamplingContext() const { return m_SamplingContext; }
+
+        const Graphics::Model* GetModel() const { return m_Model.get(); }
+
+        void SetState(size_t state)
+        {
+            m_State = state;
+            m_Time  = 0.0f;
+        }
+        size_t GetState() const { return m_State; }
+
+        static AnimationLODSettings& GetLODSettings() { return s_LODSettings; }
+        static AnimationLODStats& GetLODStats() { return s_LODStats; }
+
+        float Speed  = 1.0f;
+        bool Playing = true;
+
+    private:
+        struct SkinnedMesh
+        {
+            bool Skinned = false;
+            std::vector<uint32_t> Joints;           // Palette entries with weight in the mesh, for refitting the bounds
+            std::vector<Graphics::Vertex> Vertices; // CPU skinning only
+            SharedPtr<Maths::BoundingBox> BoundingBox;
+            std::vector<SharedPtr<Graphics::Mesh>> FrameViews; // One per swapchain image so in flight frames are never overwritten
+            std::vector<uint64_t> FrameGenerations;            // Pose each frame's buffer holds
+        };
+
+        void BuildJointMatrices(std::vector<glm::mat4>& output) const;
+        void BlendJointMatrices(float factor);
+
+        // Called whenever the joint matrices change
+        void OnPoseChanged();
+        void SkinMesh(const Graphics::Mesh& source, SkinnedMesh& output);
+
+        SharedPtr<Graphics::Model> m_Model;
+        SamplingContext m_SamplingContext;
+        std::vector<glm::mat4> m_JointMatrices;
+        std::vector<SkinnedMesh> m_SkinnedMeshes;
+
+        // Reduced rate updates blend from the pose shown at the last update to the newly sampled one
+        std::vector<glm::mat4> m_PreviousJointMatrices;
+        std::vector<glm::mat4> m_TargetJointMatrices;
+        uint32_t m_Interval = 1;
+        bool m_Interpolate  = false;
+        bool m_HasTarget    = false;
+
+        // Instance whose skinned vertices are drawn instead of this one's, reset every update
+        SharedPtr<AnimationInstance> m_PoseSource;
+
+        size_t m_State         = 0;
+        float m_Time           = 0.0f;
+        float m_ScreenSize     = FLT_MAX;
+        uint32_t m_UpdateCount = 0;
+        uint32_t m_Phase       = 0;
+        bool m_HasPose         = false;
+        uint32_t m_FrameIndex  = 0;
+        uint64_t m_Generation  = 0;
+
+        static AnimationLODSettings s_LODSettings;
+        static AnimationLODStats s_LODStats;
+        static bool s_CPUSkinning;
+    };
+}
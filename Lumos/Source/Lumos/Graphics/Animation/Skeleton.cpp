@@ -19,4 +19,12 @@ namespace Lumos
         ozz::animation::offline::RawSkeleton rawSkeleton;
     }
 
+    Skeleton::Skeleton(const std::string& filename, const SharedPtr<ozz::animation::Skeleton>& skeleton)
+        : m_FilePath(filename)
+        , m_Skeleton(skeleton)
+    {
+        if(!m_Skeleton)
+            SetFlag(AssetFlag::Invalid);
+    }
+
 }
\ No newline at end of file
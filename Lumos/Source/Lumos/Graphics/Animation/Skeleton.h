@@ -23,6 +23,9 @@ namespace Lumos
     public:
         Skeleton(const std::string& filename);
 
+        // Wraps a skeleton that was already built, e.g. imported with a glTF model
+        Skeleton(const std::string& filename, const SharedPtr<ozz::animation::Skeleton>& skeleton);
+
         virtual ~Skeleton() = default;
 
         const std::string& GetFilePath() const { return m_FilePath; }
@@ -38,6 +41,6 @@ namespace Lumos
 
     private:
         std::string m_FilePath;
-        ozz::unique_ptr<ozz::animation::Skeleton> m_Skeleton;
+        SharedPtr<ozz::animation::Skeleton> m_Skeleton;
     };
 }
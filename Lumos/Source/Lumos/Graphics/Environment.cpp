@@ -81,8 +81,7 @@ namespace Lumos
                         if(currHeight < 1 || currWidth < 1)
                             break;
 
-                        std::string newPath;
-                        if(!VFS::Get().ResolvePhysicalPath(envFiles[i], newPath))
+                        if(!VFS::Get().FileExists(envFiles[i]))
                         {
                             LUMOS_LOG_ERROR("Failed to load {0}", envFiles[i]);
                             failed = true;
@@ -105,8 +104,7 @@ namespace Lumos
                         if(currHeight < 1 || currWidth < 1)
                             break;
 
-                        std::string newPath;
-                        if(!VFS::Get().ResolvePhysicalPath(irrFiles[i], newPath))
+                        if(!VFS::Get().FileExists(irrFiles[i]))
                         {
                             LUMOS_LOG_ERROR("Failed to load {0}", irrFiles[i]);
                             failed = true;
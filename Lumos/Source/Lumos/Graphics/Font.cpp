@@ -210,6 +210,9 @@ namespace Lumos
 
             // Load fonts
             bool anyCodepointsAvailable = false;
+
+            // FreeType reads packed fonts from memory, so the file has to outlive the FontHolder below
+            VFSFile packedFont;
             class FontHolder
             {
                 msdfgen::FreetypeHandle* ft;
@@ -269,7 +272,16 @@ namespace Lumos
                 }
             } font;
 
-            if(m_FontDataSize == 0)
+            if(m_FontDataSize == 0 && VFS::Get().IsPacked(m_FilePath))
+            {
+                FONT_LOG("Font: Loading Font {0}", m_FilePath);
+                if(!VFS::Get().ReadFile(m_FilePath, packedFont) || !font.load((uint8_t*)packedFont.Data, uint32_t(packedFont.Size)))
+                {
+                    FONT_LOG("Font: Failed to load font! - {0}", m_FilePath);
+                    return;
+                }
+            }
+            else if(m_FontDataSize == 0)
             {
                 std::string outPath;
                 if(!VFS::Get().ResolvePhysicalPath(m_FilePath, outPath))
@@ -6,6 +6,9 @@
 #include "Graphics/RHI/Pipeline.h"
 #include "Graphics/RHI/UniformBuffer.h"
 #include "Graphics/RHI/GraphicsContext.h"
+#include "Graphics/RHI/Renderer.h"
+#include "Graphics/RHI/SwapChain.h"
+#include "Graphics/MaterialParameterBuffer.h"
 #include "Core/OS/FileSystem.h"
 #include "Core/VFS.h"
 #include "Core/Application.h"
@@ -17,7 +20,8 @@
 namespace Lumos::Graphics
 {
 
-    SharedPtr<Graphics::Texture2D> Material::s_DefaultTexture = nullptr;
+    SharedPtr<Graphics::Texture2D> Material::s_DefaultTexture                = nullptr;
+    UniquePtr<Graphics::MaterialParameterBuffer> Material::s_ParameterBuffer = nullptr;
 
     Material::Material(SharedPtr<Graphics::Shader>& shader, const MaterialProperties& properties, const PBRMataterialTextures& textures)
         : m_PBRMaterialTextures(textures)
@@ -54,6 +58,9 @@ namespace Lumos::Graphics
         LUMOS_PROFILE_FUNCTION();
         delete m_DescriptorSet;
         delete m_MaterialProperties;
+
+        if(m_ParameterSlot != ~0u && s_ParameterBuffer)
+            s_ParameterBuffer->Free(m_ParameterSlot);
     }
 
     void Material::SetTextures(const PBRMataterialTextures& textures)
@@ -70,11 +77,7 @@ namespace Lumos::Graphics
     bool FileExists(const std::string& path)
     {
         LUMOS_PROFILE_FUNCTION();
-
-        std::string physicalPath;
-
-        VFS::Get().ResolvePhysicalPath(path, physicalPath);
-        return FileSystem::FileExists(physicalPath);
+        return VFS::Get().FileExists(path);
     }
 
     void Material::LoadPBRMaterial(const std::string& name, const std::string& path, const std::string& extension)
@@ -132,11 +135,23 @@ namespace Lumos::Graphics
 
     void Material::UpdateMaterialPropertiesData()
     {
-        if(!m_DescriptorSet)
-            return;
+        auto parameterBuffer = GetParameterBuffer();
+        if(m_ParameterSlot == ~0u)
+            m_ParameterSlot = parameterBuffer->Allocate();
 
-        m_DescriptorSet->SetUniformBufferData("UniformMaterialData", *&m_MaterialProperties);
-        m_DescriptorSet->Update();
+        // Only uploaded if the properties changed
+        parameterBuffer->Write(m_ParameterSlot, m_MaterialProperties);
+    }
+
+    void Material::BindParameterBuffer()
+    {
+        auto parameterBuffer = GetParameterBuffer();
+        if(m_ParameterSlot == ~0u)
+            m_ParameterSlot = parameterBuffer->Allocate();
+
+        m_DescriptorSet->SetBuffer("UniformMaterialData", parameterBuffer->GetBuffers(), parameterBuffer->GetOffset(m_ParameterSlot), parameterBuffer->GetSlotSize());
+        m_ParameterGeneration      = parameterBuffer->GetGeneration();
+        m_PendingDescriptorUpdates = ~0u;
     }
 
     void Material::SetMaterialProperites(const MaterialProperties& properties)
@@ -240,6 +255,7 @@ namespace Lumos::Graphics
 
         m_DescriptorSet = Graphics::DescriptorSet::Create(descriptorDesc);
 
+        BindParameterBuffer();
         UpdateDescriptorSet();
     }
 
@@ -252,10 +268,19 @@ namespace Lumos::Graphics
             CreateDescriptorSet(1);
             SetTexturesUpdated(false);
         }
+        else if(m_ParameterGeneration != GetParameterBuffer()->GetGeneration())
+        {
+            // The shared buffer grew since this set was written
+            BindParameterBuffer();
+        }
 
-        m_DescriptorSet->Update();
-
-        // UpdateDescriptorSet();
+        // Parameters live in the shared buffer, so the set only needs writing after its textures or buffer changed
+        uint32_t frameBit = 1u << Renderer::GetMainSwapChain()->GetCurrentBufferIndex();
+        if(m_PendingDescriptorUpdates & frameBit)
+        {
+            m_DescriptorSet->Update();
+            m_PendingDescriptorUpdates &= ~frameBit;
+        }
     }
 
     void Material::SetShader(const std::string& filePath)
@@ -276,6 +301,21 @@ namespace Lumos::Graphics
         LUMOS_PROFILE_FUNCTION();
 
         s_DefaultTexture.reset();
+        s_ParameterBuffer.reset();
+    }
+
+    MaterialParameterBuffer* Material::GetParameterBuffer()
+    {
+        if(!s_ParameterBuffer)
+            s_ParameterBuffer = CreateUniquePtr<MaterialParameterBuffer>(uint32_t(sizeof(MaterialProperties)));
+
+        return s_ParameterBuffer.get();
+    }
+
+    void Material::UploadParameterBuffer()
+    {
+        if(s_ParameterBuffer)
+            s_ParameterBuffer->Upload();
     }
 
     void Material::SetAlbedoTexture(const std::string& path)
@@ -11,6 +11,7 @@ namespace Lumos
     namespace Graphics
     {
         class DescriptorSet;
+        class MaterialParameterBuffer;
 
         const float PBR_WORKFLOW_SEPARATE_TEXTURES  = 0.0f;
         const float PBR_WORKFLOW_METALLIC_ROUGHNESS = 1.0f;
@@ -56,7 +57,8 @@ namespace Lumos
                 DEFERREDRENDER = BIT(3),
                 NOSHADOW       = BIT(4),
                 TWOSIDED       = BIT(5),
-                ALPHABLEND     = BIT(6)
+                ALPHABLEND     = BIT(6),
+                OCCLUDER       = BIT(7)
             };
 
         public:
@@ -104,6 +106,10 @@ namespace Lumos
             static void InitDefaultTexture();
             static void ReleaseDefaultTexture();
 
+            // Material properties are read from a buffer shared by every material, uploaded once a frame
+            static MaterialParameterBuffer* GetParameterBuffer();
+            static void UploadParameterBuffer();
+
             template <typename Archive>
             void save(Archive& archive) const
             {
@@ -246,8 +252,13 @@ namespace Lumos
             void SetMaterialPath(const std::string& path) { m_MaterialPath = path; }
 
         private:
+            void BindParameterBuffer();
+
             PBRMataterialTextures m_PBRMaterialTextures;
             SharedPtr<Shader> m_Shader;
+
+            // Still one set per material for the texture bindings. There is no bindless texture array or
+            // material index in ForwardPBR yet, only the uniform block reads from the shared parameter buffer
             DescriptorSet* m_DescriptorSet;
             MaterialProperties* m_MaterialProperties;
             uint32_t m_MaterialBufferSize;
@@ -257,7 +268,12 @@ namespace Lumos
 
             std::string m_MaterialPath;
 
+            uint32_t m_ParameterSlot            = ~0u;
+            uint32_t m_ParameterGeneration      = 0;
+            uint32_t m_PendingDescriptorUpdates = 0; // One bit per frame in flight
+
             static SharedPtr<Texture2D> s_DefaultTexture;
+            static UniquePtr<MaterialParameterBuffer> s_ParameterBuffer;
         };
     }
 }
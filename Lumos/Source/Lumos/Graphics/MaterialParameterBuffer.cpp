@@ -0,0 +1,123 @@
+#include "Precompiled.h"
+#include "MaterialParameterBuffer.h"
+#include "RHI/UniformBuffer.h"
+#include "RHI/Renderer.h"
+#include "RHI/SwapChain.h"
+#include "RHI/GraphicsContext.h"
+#include "Maths/MathsUtilities.h"
+
+namespace Lumos
+{
+    namespace Graphics
+    {
+        MaterialParameterBuffer::MaterialParameterBuffer(uint32_t slotSize, uint32_t capacity)
+            : m_SlotSize(slotSize)
+            , m_Capacity(capacity)
+        {
+            LUMOS_PROFILE_FUNCTION();
+
+            // Every slot is bound at its own offset
+            uint32_t alignment = uint32_t(Renderer::GetGraphicsContext()->GetMinUniformBufferOffsetAlignment());
+            m_Stride           = (slotSize + alignment - 1) & ~(alignment - 1);
+
+            m_Data.Allocate(m_Stride * m_Capacity);
+            m_Data.InitialiseEmpty();
+
+            m_DirtyRanges.resize(Renderer::GetMainSwapChain()->GetSwapChainBufferCount());
+            CreateBuffers();
+        }
+
+        MaterialParameterBuffer::~MaterialParameterBuffer()
+        {
+            m_Data.Release();
+        }
+
+        void MaterialParameterBuffer::CreateBuffers()
+        {
+            // Sets still reading the previous buffers keep them alive until they are rebound
+            m_Buffers.clear();
+            for(size_t frame = 0; frame < m_DirtyRanges.size(); frame++)
+            {
+                auto buffer = SharedPtr<UniformBuffer>(UniformBuffer::Create());
+                buffer->Init(m_Stride * m_Capacity, nullptr);
+                m_Buffers.push_back(buffer);
+            }
+
+            // New buffers start undefined, fill them from the CPU copy
+            MarkDirty(0, m_Stride * m_Capacity);
+            m_Generation++;
+        }
+
+        void MaterialParameterBuffer::MarkDirty(uint32_t begin, uint32_t end)
+        {
+            for(auto& range : m_DirtyRanges)
+            {
+                range.Begin = Maths::Min(range.Begin, begin);
+                range.End   = Maths::Max(range.End, end);
+            }
+        }
+
+        uint32_t MaterialParameterBuffer::Allocate()
+        {
+            LUMOS_PROFILE_FUNCTION();
+            std::lock_guard<std::mutex> lock(m_Mutex);
+
+            if(!m_FreeSlots.empty())
+            {
+                uint32_t slot = m_FreeSlots.back();
+                m_FreeSlots.pop_back();
+                return slot;
+            }
+
+            if(m_SlotCount == m_Capacity)
+            {
+                Buffer data;
+                data.Allocate(m_Stride * m_Capacity * 2);
+                data.InitialiseEmpty();
+                memcpy(data.Data, m_Data.Data, m_Stride * m_Capacity);
+
+                m_Data.Release();
+                m_Data = data;
+                m_Capacity *= 2;
+                CreateBuffers();
+            }
+
+            return m_SlotCount++;
+        }
+
+        void MaterialParameterBuffer::Free(uint32_t slot)
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_FreeSlots.push_back(slot);
+        }
+
+        void MaterialParameterBuffer::Write(uint32_t slot, const void* data)
+        {
+            LUMOS_PROFILE_FUNCTION_LOW();
+            std::lock_guard<std::mutex> lock(m_Mutex);
+
+            LUMOS_ASSERT(slot < m_SlotCount, "Material parameter slot out of range");
+            uint32_t offset = GetOffset(slot);
+
+            if(memcmp(m_Data.Data + offset, data, m_SlotSize) == 0)
+                return;
+
+            memcpy(m_Data.Data + offset, data, m_SlotSize);
+            MarkDirty(offset, offset + m_SlotSize);
+        }
+
+        void MaterialParameterBuffer::Upload()
+        {
+            LUMOS_PROFILE_FUNCTION();
+            std::lock_guard<std::mutex> lock(m_Mutex);
+
+            uint32_t frame    = Renderer::GetMainSwapChain()->GetCurrentBufferIndex();
+            DirtyRange& range = m_DirtyRanges[frame];
+
+            if(range.Begin < range.End)
+                m_Buffers[frame]->SetSubData(range.Begin, range.End - range.Begin, m_Data.Data + range.Begin);
+
+            range = DirtyRange();
+        }
+    }
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include "Core/Buffer.h"
+#include <mutex>
+
+namespace Lumos
+{
+    namespace Graphics
+    {
+        class UniformBuffer;
+
+        // Parameters of every material packed into one uniform buffer per frame in flight. Each material owns a slot
+        // and its descriptor set reads that slot's range, so materials no longer allocate uniform buffers of their own.
+        // Writes go to a CPU copy and each frame's buffer only receives the slots written since it was last uploaded.
+        // Slots are bound by offset into a uniform buffer, not indexed by material ID from a storage buffer,
+        // because ForwardPBR has no indexed variant. Textures therefore stay in each material's own set
+        class LUMOS_EXPORT MaterialParameterBuffer
+        {
+        public:
+            MaterialParameterBuffer(uint32_t slotSize, uint32_t capacity = 1024);
+            ~MaterialParameterBuffer();
+
+            uint32_t Allocate();
+            void Free(uint32_t slot);
+            void Write(uint32_t slot, const void* data);
+
+            // Uploads to the current frame's buffer, once a frame after materials are bound
+            void Upload();
+
+            const SharedPtr<UniformBuffer>* GetBuffers() const { return m_Buffers.data(); }
+            uint32_t GetOffset(uint32_t slot) const { return slot * m_Stride; }
+            uint32_t GetSlotSize() const { return m_SlotSize; }
+
+            // Changes when growing replaces the buffers, sets reading the old ones have to be pointed at the new ones
+            uint32_t GetGeneration() const { return m_Generation; }
+
+        private:
+            struct DirtyRange
+            {
+                uint32_t Begin = ~0u;
+                uint32_t End   = 0;
+            };
+
+            void CreateBuffers();
+            void MarkDirty(uint32_t begin, uint32_t end);
+
+            std::vector<SharedPtr<UniformBuffer>> m_Buffers;
+            std::vector<DirtyRange> m_DirtyRanges; // Per frame in flight
+            std::vector<uint32_t> m_FreeSlots;
+            Buffer m_Data;
+
+            uint32_t m_SlotSize   = 0;
+            uint32_t m_Stride     = 0;
+            uint32_t m_Capacity   = 0;
+            uint32_t m_SlotCount  = 0;
+            uint32_t m_Generation = 0;
+
+            std::mutex m_Mutex;
+        };
+    }
+}
@@ -25,6 +25,9 @@ namespace Lumos
             , m_Material(mesh.m_Material)
             , m_Indices(mesh.m_Indices)
             , m_Vertices(mesh.m_Vertices)
+            , m_Skin(mesh.m_Skin)
+            , m_LODs(mesh.m_LODs)
+            , m_LODError(mesh.m_LODError)
         {
         }
 
@@ -33,28 +36,122 @@ namespace Lumos
             m_Indices  = indices;
             m_Vertices = vertices;
 
+            Optimise(m_Indices, m_Vertices, optimiseThreshold);
+            CreateBuffers();
+
+            std::vector<MeshLOD> lods;
+            GenerateLODs(m_Indices, m_Vertices, lods);
+            SetLODs(lods);
+        }
+
+        Mesh::Mesh(std::vector<uint32_t>&& indices, std::vector<Vertex>&& vertices, bool optimise)
+        {
+            m_Indices  = std::move(indices);
+            m_Vertices = std::move(vertices);
+
+            if(optimise)
+                Optimise(m_Indices, m_Vertices);
+            CreateBuffers();
+
+            if(optimise)
+            {
+                std::vector<MeshLOD> lods;
+                GenerateLODs(m_Indices, m_Vertices, lods);
+                SetLODs(lods);
+            }
+        }
+
+        void Mesh::Optimise(std::vector<uint32_t>& indices, std::vector<Vertex>& vertices, float optimiseThreshold)
+        {
+            LUMOS_PROFILE_FUNCTION();
+            if(indices.empty() || vertices.empty())
+                return;
+
             // int lod = 2;
             // float threshold = powf(0.7f, float(lod));
 
-            size_t indexCount         = indices.size();
             size_t target_index_count = size_t(indices.size() * optimiseThreshold);
 
             float target_error = 1e-3f;
             float* resultError = nullptr;
 
-            auto newIndexCount = meshopt_simplify(m_Indices.data(), m_Indices.data(), m_Indices.size(), (const float*)(&m_Vertices[0]), m_Vertices.size(), sizeof(Graphics::Vertex), target_index_count, target_error, resultError);
+            auto newIndexCount = meshopt_simplify(indices.data(), indices.data(), indices.size(), (const float*)(&vertices[0]), vertices.size(), sizeof(Graphics::Vertex), target_index_count, target_error, resultError);
 
             auto newVertexCount = meshopt_optimizeVertexFetch( // return vertices (not vertex attribute values)
-                (m_Vertices.data()),
-                (unsigned int*)(m_Indices.data()),
+                (vertices.data()),
+                (unsigned int*)(indices.data()),
                 newIndexCount, // total new indices (not faces)
-                (m_Vertices.data()),
-                (size_t)m_Vertices.size(), // total vertices (not vertex attribute values)
-                sizeof(Graphics::Vertex)   // vertex stride
+                (vertices.data()),
+                (size_t)vertices.size(), // total vertices (not vertex attribute values)
+                sizeof(Graphics::Vertex) // vertex stride
             );
 
             // LUMOS_LOG_INFO("Mesh Optimizer - Before : {0} indices {1} vertices , After : {2} indices , {3} vertices", indexCount, m_Vertices.size(), newIndexCount, newVertexCount);
 
+            indices.resize(newIndexCount);
+            vertices.resize(newVertexCount);
+        }
+
+        void Mesh::GenerateLODs(const std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices, std::vector<MeshLOD>& lods, uint32_t maxLODCount)
+        {
+            LUMOS_PROFILE_FUNCTION();
+            lods.clear();
+
+            if(indices.size() < MinLODIndexCount || vertices.empty())
+                return;
+
+            const float* positions = (const float*)(&vertices[0]);
+            float errorScale       = meshopt_simplifyScale(positions, vertices.size(), sizeof(Graphics::Vertex));
+
+            size_t previousIndexCount = indices.size();
+
+            for(uint32_t lod = 1; lod < maxLODCount; lod++)
+            {
+                // Halve the triangle count each level. Always simplify from the base level so errors stay comparable
+                size_t targetIndexCount = (indices.size() >> lod) / 3 * 3;
+                float targetError       = 0.02f * float(1 << lod);
+                float resultError       = 0.0f;
+
+                MeshLOD lodData;
+                lodData.Indices.resize(indices.size());
+                size_t indexCount = meshopt_simplify(lodData.Indices.data(), indices.data(), indices.size(), positions, vertices.size(), sizeof(Graphics::Vertex), targetIndexCount, targetError, &resultError);
+
+                // Not worth an extra level if it barely removes any triangles
+                if(indexCount == 0 || float(indexCount) > float(previousIndexCount) * 0.8f)
+                    break;
+
+                lodData.Indices.resize(indexCount);
+                meshopt_optimizeVertexCache(lodData.Indices.data(), lodData.Indices.data(), indexCount, vertices.size());
+
+                lodData.Error      = resultError * errorScale;
+                previousIndexCount = indexCount;
+                lods.push_back(std::move(lodData));
+            }
+        }
+
+        void Mesh::SetLODs(std::vector<MeshLOD>& lods)
+        {
+            LUMOS_PROFILE_FUNCTION();
+            m_LODs.clear();
+
+            for(auto& lodData : lods)
+            {
+                auto lod            = CreateSharedPtr<Mesh>();
+                lod->m_Name         = m_Name;
+                lod->m_Material     = m_Material;
+                lod->m_BoundingBox  = m_BoundingBox;
+                lod->m_VertexBuffer = m_VertexBuffer;
+                lod->m_LODError     = lodData.Error;
+                lod->m_Indices      = std::move(lodData.Indices);
+                lod->m_IndexBuffer  = SharedPtr<Graphics::IndexBuffer>(Graphics::IndexBuffer::Create(lod->m_Indices.data(), (uint32_t)lod->m_Indices.size()));
+
+                m_LODs.push_back(lod);
+            }
+        }
+
+        void Mesh::CreateBuffers()
+        {
+            LUMOS_PROFILE_FUNCTION();
             m_BoundingBox = CreateSharedPtr<Maths::BoundingBox>();
 
             for(auto& vertex : m_Vertices)
@@ -62,16 +159,65 @@ namespace Lumos
                 m_BoundingBox->Merge(vertex.Position);
             }
 
-            m_IndexBuffer = SharedPtr<Graphics::IndexBuffer>(Graphics::IndexBuffer::Create(m_Indices.data(), (uint32_t)newIndexCount));
+            m_IndexBuffer = SharedPtr<Graphics::IndexBuffer>(Graphics::IndexBuffer::Create(m_Indices.data(), (uint32_t)m_Indices.size()));
 
             m_VertexBuffer = SharedPtr<VertexBuffer>(VertexBuffer::Create(BufferUsage::STATIC));
-            m_VertexBuffer->SetData((uint32_t)(sizeof(Graphics::Vertex) * newVertexCount), m_Vertices.data());
+            m_VertexBuffer->SetData((uint32_t)(sizeof(Graphics::Vertex) * m_Vertices.size()), m_Vertices.data());
         }
 
         Mesh::~Mesh()
         {
         }
 
+        SharedPtr<Mesh> Mesh::CreateInstanceView(const SharedPtr<VertexBuffer>& vertexBuffer, const SharedPtr<Maths::BoundingBox>& boundingBox) const
+        {
+            SharedPtr<Mesh> view = CreateSharedPtr<Mesh>();
+            view->m_VertexBuffer = vertexBuffer;
+            view->m_IndexBuffer  = m_IndexBuffer;
+            view->m_Material     = m_Material;
+            view->m_BoundingBox  = boundingBox;
+            view->m_Name         = m_Name;
+            view->m_Active       = m_Active;
+            return view;
+        }
+
+        StorageBuffer* Mesh::GetBindPoseBuffer()
+        {
+            if(!m_BindPoseBuffer)
+                m_BindPoseBuffer = SharedPtr<StorageBuffer>(StorageBuffer::Create(uint32_t(m_Vertices.size() * sizeof(Vertex)), m_Vertices.data()));
+
+            return m_BindPoseBuffer.get();
+        }
+
+        StorageBuffer* Mesh::GetSkinBuffer()
+        {
+            if(!m_SkinBuffer)
+                m_SkinBuffer = SharedPtr<StorageBuffer>(StorageBuffer::Create(uint32_t(m_Skin.size() * sizeof(VertexSkin)), m_Skin.data()));
+
+            return m_SkinBuffer.get();
+        }
+
+        void Mesh::GetMemoryUsage(uint64_t& cpuBytes, uint64_t& gpuBytes) const
+        {
+            cpuBytes = m_Vertices.size() * sizeof(Vertex) + m_Indices.size() * sizeof(uint32_t) + m_Skin.size() * sizeof(VertexSkin);
+            gpuBytes = 0;
+
+            if(m_VertexBuffer)
+                gpuBytes += m_Vertices.size() * sizeof(Vertex);
+            if(m_IndexBuffer)
+                gpuBytes += uint64_t(m_IndexBuffer->GetCount()) * sizeof(uint32_t);
+            if(m_BindPoseBuffer)
+                gpuBytes += m_BindPoseBuffer->GetSize();
+            if(m_SkinBuffer)
+                gpuBytes += m_SkinBuffer->GetSize();
+
+            for(auto& lod : m_LODs)
+            {
+                cpuBytes += lod->m_Indices.size() * sizeof(uint32_t);
+                gpuBytes += uint64_t(lod->m_IndexBuffer->GetCount()) * sizeof(uint32_t);
+            }
+        }
+
         void Mesh::GenerateNormals(Vertex* vertices, uint32_t vertexCount, uint32_t* indices, uint32_t indexCount)
         {
             glm::vec3* normals = new glm::vec3[vertexCount];
@@ -2,6 +2,7 @@
 
 #include "RHI/IndexBuffer.h"
 #include "RHI/VertexBuffer.h"
+#include "RHI/StorageBuffer.h"
 #include "Graphics/RHI/CommandBuffer.h"
 #include "Graphics/RHI/DescriptorSet.h"
 #include "Maths/Maths.h"
@@ -48,6 +49,13 @@ namespace Lumos
             }
         };
 
+        // Up to four joint influences, indexing the owning model's joint palette
+        struct LUMOS_EXPORT VertexSkin
+        {
+            glm::uvec4 Joints = glm::uvec4(0);
+            glm::vec4 Weights = glm::vec4(0.0f);
+        };
+
         struct Triangle
         {
             Triangle(const Vertex& v0, const Vertex& v1, const Vertex& v2)
@@ -70,20 +78,42 @@ namespace Lumos
             float OptimiseThreshold;
         };
 
+        // Simplified index list for one level of a mesh LOD chain. Indices reference the base level vertices
+        struct MeshLOD
+        {
+            std::vector<uint32_t> Indices;
+            float Error = 0.0f; // Geometric deviation from the base level, in mesh units
+        };
+
         class LUMOS_EXPORT Mesh
         {
         public:
             Mesh();
             Mesh(const Mesh& mesh);
             Mesh(const std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices, float optimiseThreshold = 0.95f);
+
+            // Takes ownership of the vertex data. Pass optimise = false for data already run through Optimise,
+            // so importers can do the CPU work on job threads and only create GPU buffers here
+            Mesh(std::vector<uint32_t>&& indices, std::vector<Vertex>&& vertices, bool optimise);
             virtual ~Mesh();
 
+            static constexpr uint32_t MaxLODCount      = 4;
+            static constexpr uint32_t MinLODIndexCount = 768;
+
             const SharedPtr<VertexBuffer>& GetVertexBuffer() const { return m_VertexBuffer; }
             const SharedPtr<IndexBuffer>& GetIndexBuffer() const { return m_IndexBuffer; }
             const SharedPtr<Material>& GetMaterial() const { return m_Material; }
             const SharedPtr<Maths::BoundingBox>& GetBoundingBox() const { return m_BoundingBox; }
 
-            void SetMaterial(const SharedPtr<Material>& material) { m_Material = material; }
+            void SetMaterial(const SharedPtr<Material>& material)
+            {
+                m_Material = material;
+                for(auto& lod : m_LODs)
+                    lod->m_Material = material;
+            }
+
+            // CPU copies of the vertex data and GPU buffers, including the LOD chain
+            void GetMemoryUsage(uint64_t& cpuBytes, uint64_t& gpuBytes) const;
 
             bool& GetActive() { return m_Active; }
             void SetName(const std::string& name) { m_Name = name; }
@@ -92,6 +122,43 @@ namespace Lumos
             static void GenerateNormals(Vertex* vertices, uint32_t vertexCount, uint32_t* indices, uint32_t indexCount);
             static void GenerateTangentsAndBitangents(Vertex* vertices, uint32_t vertexCount, uint32_t* indices, uint32_t indexCount);
 
+            // Simplifies and reorders the data with meshoptimizer. Only touches CPU data so it is safe to call from job threads
+            static void Optimise(std::vector<uint32_t>& indices, std::vector<Vertex>& vertices, float optimiseThreshold = 0.95f);
+
+            // Builds levels 1..maxLODCount - 1 of the LOD chain, stopping early once simplification stops paying off.
+            // Also CPU only, call after Optimise so the indices match the final vertex order
+            static void GenerateLODs(const std::vector<uint32_t>& indices, const std::vector<Vertex>& vertices, std::vector<MeshLOD>& lods, uint32_t maxLODCount = MaxLODCount);
+
+            // Creates index buffers for the chain. LOD meshes share this mesh's vertex buffer, material and bounds
+            void SetLODs(std::vector<MeshLOD>& lods);
+
+            // Influences per vertex for the skinning pass. They must line up with the vertices, so skinned data is
+            // not run through Optimise
+            void SetSkin(std::vector<VertexSkin>&& skin) { m_Skin = std::move(skin); }
+            bool IsSkinned() const { return !m_Skin.empty(); }
+            const std::vector<VertexSkin>& GetSkin() const { return m_Skin; }
+            const std::vector<Vertex>& GetVertices() const { return m_Vertices; }
+            const std::vector<uint32_t>& GetIndices() const { return m_Indices; }
+
+            // Bind pose vertices and influences read by the skinning compute pass. Created on first use, render thread only
+            StorageBuffer* GetBindPoseBuffer();
+            StorageBuffer* GetSkinBuffer();
+
+            // Draws this mesh's indices and material from another vertex buffer with the same layout, e.g. per instance
+            // skinned vertices. The bounds are shared with the caller so it can refit them as the vertices change
+            SharedPtr<Mesh> CreateInstanceView(const SharedPtr<VertexBuffer>& vertexBuffer, const SharedPtr<Maths::BoundingBox>& boundingBox) const;
+
+            uint32_t GetLODCount() const { return uint32_t(m_LODs.size()) + 1; }
+            float GetLODError() const { return m_LODError; }
+
+            Mesh* GetLOD(uint32_t lod)
+            {
+                if(lod == 0 || m_LODs.empty())
+                    return this;
+
+                return m_LODs[std::min(lod, uint32_t(m_LODs.size())) - 1].get();
+            }
+
             void CalculateTriangles();
 
             const std::vector<Triangle>& GetTriangles()
@@ -120,6 +187,8 @@ namespace Lumos
             static glm::vec3* GenerateNormals(uint32_t numVertices, glm::vec3* vertices, uint32_t* indices, uint32_t numIndices);
             static glm::vec3* GenerateTangents(uint32_t numVertices, glm::vec3* vertices, uint32_t* indices, uint32_t numIndices, glm::vec2* texCoords);
 
+            void CreateBuffers();
+
             SharedPtr<VertexBuffer> m_VertexBuffer;
             SharedPtr<IndexBuffer> m_IndexBuffer;
             SharedPtr<Material> m_Material;
@@ -130,6 +199,12 @@ namespace Lumos
             bool m_Active = true;
             std::vector<uint32_t> m_Indices;
             std::vector<Vertex> m_Vertices;
+            std::vector<VertexSkin> m_Skin;
+            SharedPtr<StorageBuffer> m_BindPoseBuffer;
+            SharedPtr<StorageBuffer> m_SkinBuffer;
+
+            std::vector<SharedPtr<Mesh>> m_LODs;
+            float m_LODError = 0.0f;
 
             // Only calculated on request
             std::vector<Triangle> m_Triangles;
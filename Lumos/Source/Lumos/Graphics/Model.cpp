@@ -30,8 +30,13 @@ namespace Lumos::Graphics
     void Model::LoadModel(const std::string& path)
     {
         LUMOS_PROFILE_FUNCTION();
+
+        // Importers open referenced buffers and textures themselves, so a packed model needs its whole folder extracted
         std::string physicalPath;
-        if(!Lumos::VFS::Get().ResolvePhysicalPath(path, physicalPath))
+        if(Lumos::VFS::Get().IsPacked(path))
+            Lumos::VFS::Get().ExtractPhysicalPath(StringUtilities::GetFileLocation(path), physicalPath, true);
+
+        if(!Lumos::VFS::Get().ExtractPhysicalPath(path, physicalPath))
         {
             LUMOS_LOG_INFO("Failed to load Model - {0}", path);
             return;
@@ -4,6 +4,7 @@
 #include "Material.h"
 #include "Core/VFS.h"
 #include "Core/Asset.h"
+#include "Graphics/Animation/AnimationController.h"
 #include <cereal/cereal.hpp>
 
 #include <ozz/animation/runtime/animation.h>
@@ -72,6 +73,12 @@ namespace Lumos
 
             SharedPtr<ozz::animation::Skeleton> GetSkeleton() const { return m_Skeleton; }
             const std::vector<SharedPtr<ozz::animation::Animation>>& GetAnimations() const { return m_Animation; }
+            const SharedPtr<AnimationController>& GetAnimationController() const { return m_AnimationController; }
+
+            // Skinning palette covering every skin in the model. Entry i is skinned by skeleton joint
+            // GetJointRemaps()[i] multiplied by GetInverseBindPoses()[i]
+            const std::vector<glm::mat4>& GetInverseBindPoses() const { return m_InverseBindPoses; }
+            const std::vector<uint16_t>& GetJointRemaps() const { return m_JointRemaps; }
 
             const std::string& GetFilePath() const { return m_FilePath; }
             PrimitiveType GetPrimitiveType() { return m_PrimitiveType; }
@@ -88,6 +95,9 @@ namespace Lumos
 
             SharedPtr<ozz::animation::Skeleton> m_Skeleton;
             std::vector<SharedPtr<ozz::animation::Animation>> m_Animation;
+            SharedPtr<AnimationController> m_AnimationController;
+            std::vector<glm::mat4> m_InverseBindPoses;
+            std::vector<uint16_t> m_JointRemaps;
 
             void LoadOBJ(const std::string& path);
             void LoadGLTF(const std::string& path);
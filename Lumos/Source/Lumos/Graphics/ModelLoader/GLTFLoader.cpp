@@ -15,6 +15,7 @@
 #include "Core/Application.h"
 #include "Core/StringUtilities.h"
 #include "Utilities/AssetManager.h"
+#include "Core/JobSystem.h"
 
 #include <ozz/animation/offline/animation_builder.h>
 #include <ozz/animation/runtime/skeleton.h>
@@ -265,176 +266,265 @@ namespace Lumos::Graphics
         return loadedMaterials;
     }
 
-    std::vector<Graphics::Mesh*> LoadMesh(tinygltf::Model& model, tinygltf::Mesh& mesh, std::vector<SharedPtr<Material>>& materials, Maths::Transform& parentTransform)
+    // Encoded image bytes captured while parsing, decoded later on the job system.
+    // Images stored in buffer views are decoded straight from the model buffers, so nothing is copied for them
+    struct GLTFEncodedImage
     {
-        std::vector<Graphics::Mesh*> meshes;
+        std::vector<uint8_t> Data;
+        int RequestedWidth  = 0;
+        int RequestedHeight = 0;
+    };
+
+    static bool DeferImageLoad(tinygltf::Image* image, const int imageIndex, std::string* err, std::string* warn, int reqWidth, int reqHeight, const unsigned char* bytes, int size, void* userData)
+    {
+        auto encodedImages = static_cast<std::vector<GLTFEncodedImage>*>(userData);
+        if(imageIndex >= (int)encodedImages->size())
+            encodedImages->resize(imageIndex + 1);
+
+        auto& encoded           = (*encodedImages)[imageIndex];
+        encoded.RequestedWidth  = reqWidth;
+        encoded.RequestedHeight = reqHeight;
+
+        // The bytes for uri images only live for the duration of this callback
+        if(image->bufferView == -1)
+            encoded.Data.assign(bytes, bytes + size);
+
+        return true;
+    }
+
+    static void DecodeImage(tinygltf::Model& model, int imageIndex, const GLTFEncodedImage& encoded)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        tinygltf::Image& image = model.images[imageIndex];
 
-        for(auto& primitive : mesh.primitives)
+        const unsigned char* bytes = encoded.Data.data();
+        int size                   = (int)encoded.Data.size();
+
+        if(image.bufferView != -1)
         {
-            const tinygltf::Accessor& indicesAccessor = model.accessors[primitive.indices];
+            const tinygltf::BufferView& bufferView = model.bufferViews[image.bufferView];
+            bytes                                  = &model.buffers[bufferView.buffer].data[bufferView.byteOffset];
+            size                                   = (int)bufferView.byteLength;
+        }
+
+        if(!bytes || size == 0)
+            return;
+
+        std::string err, warn;
+        tinygltf::LoadImageDataOption option;
+        if(!tinygltf::LoadImageData(&image, imageIndex, &err, &warn, encoded.RequestedWidth, encoded.RequestedHeight, bytes, size, &option))
+            LUMOS_LOG_ERROR("Failed to decode glTF image {0} : {1}", imageIndex, err);
+    }
 
-            std::vector<uint32_t> indices;
-            std::vector<Graphics::Vertex> vertices;
+    // One glTF primitive, gathered from the node hierarchy and converted to engine vertex data on a job thread
+    struct GLTFPrimitive
+    {
+        int MeshIndex;
+        int PrimitiveIndex;
+        glm::mat4 Transform;
+        int SkinIndex        = -1;
+        uint32_t JointOffset = 0; // Start of the skin's joints in the model's joint palette
+
+        std::vector<uint32_t> Indices;
+        std::vector<Graphics::Vertex> Vertices;
+        std::vector<Graphics::VertexSkin> Skin;
+        std::vector<Graphics::MeshLOD> LODs;
+    };
+
+    static const uint8_t* GetAccessorData(const tinygltf::Model& model, const tinygltf::Accessor& accessor, size_t& stride)
+    {
+        const tinygltf::BufferView& bufferView = model.bufferViews.at(accessor.bufferView);
+        const tinygltf::Buffer& buffer         = model.buffers.at(bufferView.buffer);
+
+        int byteStride = accessor.ByteStride(bufferView);
+        stride         = byteStride > 0 ? size_t(byteStride) : size_t(GLTF_COMPONENT_LENGTH_LOOKUP.at(accessor.type) * GLTF_COMPONENT_BYTE_SIZE_LOOKUP.at(accessor.componentType));
+
+        return buffer.data.data() + bufferView.byteOffset + accessor.byteOffset;
+    }
+
+    static void ConvertPrimitive(const tinygltf::Model& model, GLTFPrimitive& output)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        const tinygltf::Primitive& primitive = model.meshes[output.MeshIndex].primitives[output.PrimitiveIndex];
+
+        auto positionAttribute = primitive.attributes.find("POSITION");
+        uint32_t vertexCount   = (uint32_t)(positionAttribute == primitive.attributes.end() ? 0 : model.accessors.at(positionAttribute->second).count);
+
+        auto& vertices = output.Vertices;
+        auto& indices  = output.Indices;
+        vertices.resize(vertexCount);
 
-            uint32_t vertexCount = (uint32_t)(primitive.attributes.empty() ? 0 : model.accessors.at(primitive.attributes["POSITION"]).count);
+        const glm::mat4& transform   = output.Transform;
+        const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(transform)));
 
-            indices.resize(indicesAccessor.count);
-            vertices.resize(vertexCount);
+        bool hasTangents   = false;
+        bool hasBitangents = false;
 
-            bool hasTangents   = false;
-            bool hasBitangents = false;
+        for(auto& attribute : primitive.attributes)
+        {
+            const tinygltf::Accessor& accessor = model.accessors.at(attribute.second);
+            size_t stride;
+            const uint8_t* data = GetAccessorData(model, accessor, stride);
+            size_t count        = Maths::Min(size_t(accessor.count), size_t(vertexCount));
+
+            // -------- Position attribute -----------
 
-            for(auto& attribute : primitive.attributes)
+            if(attribute.first == "POSITION")
             {
-                // Get accessor info
-                auto& accessor            = model.accessors.at(attribute.second);
-                auto& bufferView          = model.bufferViews.at(accessor.bufferView);
-                auto& buffer              = model.buffers.at(bufferView.buffer);
-                int componentLength       = GLTF_COMPONENT_LENGTH_LOOKUP.at(accessor.type);
-                int componentTypeByteSize = GLTF_COMPONENT_BYTE_SIZE_LOOKUP.at(accessor.componentType);
-
-                // Extra vertex data from buffer
-                size_t bufferOffset       = bufferView.byteOffset + accessor.byteOffset;
-                int bufferLength          = static_cast<int>(accessor.count) * componentLength * componentTypeByteSize;
-                auto first                = buffer.data.begin() + bufferOffset;
-                auto last                 = buffer.data.begin() + bufferOffset + bufferLength;
-                std::vector<uint8_t> data = std::vector<uint8_t>(first, last);
-
-                // -------- Position attribute -----------
-
-                if(attribute.first == "POSITION")
+                for(size_t p = 0; p < count; ++p)
                 {
-                    size_t positionCount            = accessor.count;
-                    Maths::Vector3Simple* positions = reinterpret_cast<Maths::Vector3Simple*>(data.data());
-                    for(auto p = 0; p < positionCount; ++p)
-                    {
-                        vertices[p].Position = parentTransform.GetWorldMatrix() * Maths::ToVector4(positions[p]);
-                    }
+                    auto position        = reinterpret_cast<const Maths::Vector3Simple*>(data + p * stride);
+                    vertices[p].Position = transform * Maths::ToVector4(*position);
                 }
+            }
 
-                // -------- Normal attribute -----------
+            // -------- Normal attribute -----------
 
-                else if(attribute.first == "NORMAL")
+            else if(attribute.first == "NORMAL")
+            {
+                for(size_t p = 0; p < count; ++p)
                 {
-                    size_t normalCount            = accessor.count;
-                    Maths::Vector3Simple* normals = reinterpret_cast<Maths::Vector3Simple*>(data.data());
-                    for(auto p = 0; p < normalCount; ++p)
-                    {
-                        //vertices[p].Normal = (parentTransform.GetWorldMatrix() * Maths::ToVector4(normals[p]));
-                        vertices[p].Normal = glm::transpose(glm::inverse(glm::mat3(parentTransform.GetWorldMatrix()))) * (glm::vec3(Maths::ToVector4(normals[p])));
-                        vertices[p].Normal = glm::normalize(vertices[p].Normal);
-                    }
+                    auto normal        = reinterpret_cast<const Maths::Vector3Simple*>(data + p * stride);
+                    vertices[p].Normal = glm::normalize(normalMatrix * Maths::ToVector(*normal));
                 }
+            }
 
-                // -------- Texcoord attribute -----------
+            // -------- Texcoord attribute -----------
 
-                else if(attribute.first == "TEXCOORD_0")
+            else if(attribute.first == "TEXCOORD_0")
+            {
+                for(size_t p = 0; p < count; ++p)
                 {
-                    size_t uvCount            = accessor.count;
-                    Maths::Vector2Simple* uvs = reinterpret_cast<Maths::Vector2Simple*>(data.data());
-                    for(auto p = 0; p < uvCount; ++p)
-                    {
-                        vertices[p].TexCoords = ToVector(uvs[p]);
-                    }
+                    auto uv               = reinterpret_cast<const Maths::Vector2Simple*>(data + p * stride);
+                    vertices[p].TexCoords = ToVector(*uv);
                 }
+            }
 
-                // -------- Colour attribute -----------
+            // -------- Colour attribute -----------
 
-                else if(attribute.first == "COLOR_0")
+            else if(attribute.first == "COLOR_0")
+            {
+                for(size_t p = 0; p < count; ++p)
                 {
-                    size_t uvCount                = accessor.count;
-                    Maths::Vector4Simple* colours = reinterpret_cast<Maths::Vector4Simple*>(data.data());
-                    for(auto p = 0; p < uvCount; ++p)
-                    {
-                        vertices[p].Colours = ToVector(colours[p]);
-                    }
+                    auto colour         = reinterpret_cast<const Maths::Vector4Simple*>(data + p * stride);
+                    vertices[p].Colours = ToVector(*colour);
                 }
+            }
 
-                // -------- Tangent attribute -----------
+            // -------- Tangent attribute -----------
 
-                else if(attribute.first == "TANGENT")
+            else if(attribute.first == "TANGENT")
+            {
+                hasTangents = true;
+                for(size_t p = 0; p < count; ++p)
                 {
-                    hasTangents               = true;
-                    size_t uvCount            = accessor.count;
-                    Maths::Vector3Simple* uvs = reinterpret_cast<Maths::Vector3Simple*>(data.data());
-                    for(auto p = 0; p < uvCount; ++p)
-                    {
-                        vertices[p].Tangent = glm::normalize(parentTransform.GetWorldMatrix() * ToVector4(uvs[p]));
-                    }
+                    auto tangent        = reinterpret_cast<const Maths::Vector3Simple*>(data + p * stride);
+                    vertices[p].Tangent = glm::normalize(glm::mat3(transform) * Maths::ToVector(*tangent));
                 }
+            }
 
-                else if(attribute.first == "BINORMAL")
+            else if(attribute.first == "BINORMAL")
+            {
+                hasBitangents = true;
+                for(size_t p = 0; p < count; ++p)
                 {
-                    hasBitangents             = true;
-                    size_t uvCount            = accessor.count;
-                    Maths::Vector3Simple* uvs = reinterpret_cast<Maths::Vector3Simple*>(data.data());
-                    for(auto p = 0; p < uvCount; ++p)
-                    {
-                        vertices[p].Bitangent = glm::normalize(parentTransform.GetWorldMatrix() * ToVector4(uvs[p]));
-                    }
+                    auto bitangent        = reinterpret_cast<const Maths::Vector3Simple*>(data + p * stride);
+                    vertices[p].Bitangent = glm::normalize(glm::mat3(transform) * Maths::ToVector(*bitangent));
                 }
             }
 
-            // -------- Indices ----------
+            // -------- Skin attributes -----------
+
+            else if(attribute.first == "JOINTS_0" && output.SkinIndex >= 0)
             {
-                // Get accessor info
-                auto indexAccessor   = model.accessors.at(primitive.indices);
-                auto indexBufferView = model.bufferViews.at(indexAccessor.bufferView);
-                auto indexBuffer     = model.buffers.at(indexBufferView.buffer);
-
-                int componentLength       = GLTF_COMPONENT_LENGTH_LOOKUP.at(indexAccessor.type);
-                int componentTypeByteSize = GLTF_COMPONENT_BYTE_SIZE_LOOKUP.at(indexAccessor.componentType);
-
-                // Extra index data
-                size_t bufferOffset       = indexBufferView.byteOffset + indexAccessor.byteOffset;
-                int bufferLength          = static_cast<int>(indexAccessor.count) * componentLength * componentTypeByteSize;
-                auto first                = indexBuffer.data.begin() + bufferOffset;
-                auto last                 = indexBuffer.data.begin() + bufferOffset + bufferLength;
-                std::vector<uint8_t> data = std::vector<uint8_t>(first, last);
-
-                size_t indicesCount = indexAccessor.count;
-                if(componentTypeByteSize == 1)
+                output.Skin.resize(vertexCount);
+                for(size_t p = 0; p < count; ++p)
                 {
-                    uint8_t* in = reinterpret_cast<uint8_t*>(data.data());
-                    for(auto iCount = 0; iCount < indicesCount; iCount++)
+                    const uint8_t* element = data + p * stride;
+                    for(int c = 0; c < 4; c++)
                     {
-                        indices[iCount] = (uint32_t)in[iCount];
+                        uint32_t joint           = accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE ? element[c] : reinterpret_cast<const uint16_t*>(element)[c];
+                        output.Skin[p].Joints[c] = joint + output.JointOffset;
                     }
                 }
-                else if(componentTypeByteSize == 2)
-                {
-                    uint16_t* in = reinterpret_cast<uint16_t*>(data.data());
-                    for(auto iCount = 0; iCount < indicesCount; iCount++)
-                    {
-                        indices[iCount] = (uint32_t)in[iCount];
-                    }
-                }
-                else if(componentTypeByteSize == 4)
+            }
+
+            else if(attribute.first == "WEIGHTS_0" && output.SkinIndex >= 0)
+            {
+                output.Skin.resize(vertexCount);
+                for(size_t p = 0; p < count; ++p)
                 {
-                    auto in = reinterpret_cast<uint32_t*>(data.data());
-                    for(auto iCount = 0; iCount < indicesCount; iCount++)
+                    const uint8_t* element = data + p * stride;
+                    for(int c = 0; c < 4; c++)
                     {
-                        indices[iCount] = in[iCount];
+                        if(accessor.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT)
+                            output.Skin[p].Weights[c] = reinterpret_cast<const float*>(element)[c];
+                        else if(accessor.componentType == TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE)
+                            output.Skin[p].Weights[c] = element[c] / 255.0f;
+                        else
+                            output.Skin[p].Weights[c] = reinterpret_cast<const uint16_t*>(element)[c] / 65535.0f;
                     }
                 }
-                else
-                {
-                    LUMOS_LOG_WARN("Unsupported indices data type - {0}", componentTypeByteSize);
-                }
             }
+        }
+
+        for(auto& skin : output.Skin)
+        {
+            float totalWeight = skin.Weights.x + skin.Weights.y + skin.Weights.z + skin.Weights.w;
+            if(totalWeight > 0.0f)
+                skin.Weights /= totalWeight;
+        }
 
-            if(!hasTangents || !hasBitangents)
-                Graphics::Mesh::GenerateTangentsAndBitangents(vertices.data(), uint32_t(vertices.size()), indices.data(), uint32_t(indices.size()));
+        // -------- Indices ----------
+        if(primitive.indices >= 0)
+        {
+            const tinygltf::Accessor& indexAccessor = model.accessors.at(primitive.indices);
+            size_t stride;
+            const uint8_t* data       = GetAccessorData(model, indexAccessor, stride);
+            int componentTypeByteSize = GLTF_COMPONENT_BYTE_SIZE_LOOKUP.at(indexAccessor.componentType);
 
-            auto lMesh = new Graphics::Mesh(indices, vertices);
+            size_t indicesCount = indexAccessor.count;
+            indices.resize(indicesCount);
 
-            meshes.emplace_back(lMesh);
+            if(componentTypeByteSize == 1)
+            {
+                for(size_t iCount = 0; iCount < indicesCount; iCount++)
+                    indices[iCount] = (uint32_t)data[iCount * stride];
+            }
+            else if(componentTypeByteSize == 2)
+            {
+                for(size_t iCount = 0; iCount < indicesCount; iCount++)
+                    indices[iCount] = (uint32_t)*reinterpret_cast<const uint16_t*>(data + iCount * stride);
+            }
+            else if(componentTypeByteSize == 4)
+            {
+                for(size_t iCount = 0; iCount < indicesCount; iCount++)
+                    indices[iCount] = *reinterpret_cast<const uint32_t*>(data + iCount * stride);
+            }
+            else
+            {
+                LUMOS_LOG_WARN("Unsupported indices data type - {0}", componentTypeByteSize);
+            }
+        }
+        else
+        {
+            indices.resize(vertexCount);
+            for(uint32_t i = 0; i < vertexCount; i++)
+                indices[i] = i;
         }
 
-        return meshes;
+        if(!hasTangents || !hasBitangents)
+            Graphics::Mesh::GenerateTangentsAndBitangents(vertices.data(), uint32_t(vertices.size()), indices.data(), uint32_t(indices.size()));
+
+        // Optimise reorders and drops vertices, which would leave skinned vertices out of step with their influences
+        if(output.Skin.empty())
+        {
+            Graphics::Mesh::Optimise(indices, vertices);
+            Graphics::Mesh::GenerateLODs(indices, vertices, output.LODs);
+        }
     }
 
-    void LoadNode(Model* mainModel, int nodeIndex, const glm::mat4& parentTransform, tinygltf::Model& model, std::vector<SharedPtr<Material>>& materials, std::vector<std::vector<Graphics::Mesh*>>& meshes)
+    void LoadNode(int nodeIndex, const glm::mat4& parentTransform, tinygltf::Model& model, std::vector<GLTFPrimitive>& primitives)
     {
         LUMOS_PROFILE_FUNCTION();
         if(nodeIndex < 0)
@@ -496,27 +586,20 @@ namespace Lumos::Graphics
 
         if(node.mesh >= 0)
         {
-            int subIndex = 0;
-
-            auto meshes = LoadMesh(model, model.meshes[node.mesh], materials, transform);
-
-            for(auto& mesh : meshes)
+            auto& mesh = model.meshes[node.mesh];
+            for(int i = 0; i < (int)mesh.primitives.size(); i++)
             {
-                auto subname = model.meshes[node.mesh].name;
-                auto lMesh   = SharedPtr<Graphics::Mesh>(mesh);
-                lMesh->SetName(subname);
-
-                int materialIndex = model.meshes[node.mesh].primitives[subIndex].material;
-                if(materialIndex >= 0)
-                    lMesh->SetMaterial(materials[materialIndex]);
-
-                mainModel->AddMesh(lMesh);
+                GLTFPrimitive& primitive = primitives.emplace_back();
+                primitive.MeshIndex      = node.mesh;
+                primitive.PrimitiveIndex = i;
+                primitive.Transform      = transform.GetWorldMatrix();
 
-                /*if (node.skin >= 0)
+                // Skinned meshes are placed by their joints, glTF says to ignore the node transform
+                if(node.skin >= 0)
                 {
-                }*/
-
-                subIndex++;
+                    primitive.Transform = glm::mat4(1.0f);
+                    primitive.SkinIndex = node.skin;
+                }
             }
         }
 
@@ -524,7 +607,7 @@ namespace Lumos::Graphics
         {
             for(int child : node.children)
             {
-                LoadNode(mainModel, child, transform.GetLocalMatrix(), model, materials, meshes);
+                LoadNode(child, transform.GetLocalMatrix(), model, primitives);
             }
         }
     }
@@ -539,7 +622,9 @@ namespace Lumos::Graphics
 
         std::string ext = StringUtilities::GetFilePathExtension(path);
 
-        // loader.SetImageLoader(tinygltf::LoadImageData, nullptr);
+        // Image decoding is deferred so it can run on the job system with the mesh conversion
+        std::vector<GLTFEncodedImage> encodedImages;
+        loader.SetImageLoader(DeferImageLoad, &encodedImages);
         // loader.SetImageWriter(tinygltf::WriteImageData, nullptr);
 
         bool ret;
@@ -547,12 +632,12 @@ namespace Lumos::Graphics
         if(ext == "glb") // assume binary glTF.
         {
             LUMOS_PROFILE_SCOPE(".glb binary loading");
-            ret = tinygltf::TinyGLTF().LoadBinaryFromFile(&model, &err, &warn, path);
+            ret = loader.LoadBinaryFromFile(&model, &err, &warn, path);
         }
         else // assume ascii glTF.
         {
             LUMOS_PROFILE_SCOPE(".gltf loading");
-            ret = tinygltf::TinyGLTF().LoadASCIIFromFile(&model, &err, &warn, path);
+            ret = loader.LoadASCIIFromFile(&model, &err, &warn, path);
         }
 
         if(!err.empty())
@@ -572,15 +657,68 @@ namespace Lumos::Graphics
         {
             LUMOS_PROFILE_SCOPE("Parse GLTF Model");
 
-            auto LoadedMaterials = LoadMaterials(model);
-
             std::string name = path.substr(path.find_last_of('/') + 1);
 
-            auto meshes                      = std::vector<std::vector<Graphics::Mesh*>>();
-            const tinygltf::Scene& gltfScene = model.scenes[Lumos::Maths::Max(0, model.defaultScene)];
-            for(size_t i = 0; i < gltfScene.nodes.size(); i++)
+            // Gather every primitive in the scene before doing any conversion work
+            std::vector<GLTFPrimitive> primitives;
+            if(!model.scenes.empty())
             {
-                LoadNode(this, gltfScene.nodes[i], glm::mat4(1.0f), model, LoadedMaterials, meshes);
+                const tinygltf::Scene& gltfScene = model.scenes[Lumos::Maths::Max(0, model.defaultScene)];
+                for(size_t i = 0; i < gltfScene.nodes.size(); i++)
+                {
+                    LoadNode(gltfScene.nodes[i], glm::mat4(1.0f), model, primitives);
+                }
+            }
+
+            encodedImages.resize(model.images.size());
+
+            // Every skin's joints go into one palette per model
+            std::vector<uint32_t> skinJointOffsets(model.skins.size());
+            uint32_t jointCount = 0;
+            for(size_t i = 0; i < model.skins.size(); i++)
+            {
+                skinJointOffsets[i] = jointCount;
+                jointCount += uint32_t(model.skins[i].joints.size());
+            }
+
+            for(auto& primitive : primitives)
+            {
+                if(primitive.SkinIndex >= 0)
+                    primitive.JointOffset = skinJointOffsets[primitive.SkinIndex];
+            }
+
+            {
+                LUMOS_PROFILE_SCOPE("Decode images and convert primitives");
+                System::JobSystem::Context ctx;
+
+                System::JobSystem::Dispatch(ctx, static_cast<uint32_t>(encodedImages.size()), 1, [&](JobDispatchArgs args)
+                    { DecodeImage(model, args.jobIndex, encodedImages[args.jobIndex]); });
+
+                System::JobSystem::Dispatch(ctx, static_cast<uint32_t>(primitives.size()), 1, [&](JobDispatchArgs args)
+                    { ConvertPrimitive(model, primitives[args.jobIndex]); });
+
+                System::JobSystem::Wait(ctx);
+            }
+
+            // GPU objects are created together on the calling thread once all CPU work is done
+            {
+                LUMOS_PROFILE_SCOPE("Create GPU resources");
+                auto LoadedMaterials = LoadMaterials(model);
+
+                for(auto& primitive : primitives)
+                {
+                    auto lMesh = CreateSharedPtr<Graphics::Mesh>(std::move(primitive.Indices), std::move(primitive.Vertices), false);
+                    lMesh->SetName(model.meshes[primitive.MeshIndex].name);
+
+                    int materialIndex = model.meshes[primitive.MeshIndex].primitives[primitive.PrimitiveIndex].material;
+                    if(materialIndex >= 0)
+                        lMesh->SetMaterial(LoadedMaterials[materialIndex]);
+
+                    lMesh->SetLODs(primitive.LODs);
+                    if(!primitive.Skin.empty())
+                        lMesh->SetSkin(std::move(primitive.Skin));
+                    AddMesh(lMesh);
+                }
             }
 
             auto skins = model.skins;
@@ -610,6 +748,49 @@ namespace Lumos::Graphics
                     m_Animation.push_back(SharedPtr<ozz::animation::Animation>(animBuilder(*rawAnimation).release()));
                     LUMOS_LOG_INFO("Loaded Anim : {0}", animName);
                 }
+
+                // Map the palette to skeleton joints. The importer names joints after their nodes, naming unnamed ones node_<index>
+                auto jointNames = m_Skeleton->joint_names();
+                m_InverseBindPoses.resize(jointCount, glm::mat4(1.0f));
+                m_JointRemaps.resize(jointCount, 0);
+
+                for(size_t skinIndex = 0; skinIndex < skins.size(); skinIndex++)
+                {
+                    const tinygltf::Skin& skin = skins[skinIndex];
+                    uint32_t offset            = skinJointOffsets[skinIndex];
+
+                    if(skin.inverseBindMatrices >= 0)
+                    {
+                        const tinygltf::Accessor& accessor = model.accessors.at(skin.inverseBindMatrices);
+                        size_t stride;
+                        const uint8_t* data = GetAccessorData(model, accessor, stride);
+                        size_t count        = Maths::Min(size_t(accessor.count), skin.joints.size());
+
+                        for(size_t i = 0; i < count; i++)
+                            m_InverseBindPoses[offset + i] = glm::make_mat4(reinterpret_cast<const float*>(data + i * stride));
+                    }
+
+                    for(size_t i = 0; i < skin.joints.size(); i++)
+                    {
+                        std::string nodeName = model.nodes[skin.joints[i]].name;
+                        if(nodeName.empty())
+                            nodeName = "node_" + std::to_string(skin.joints[i]);
+
+                        auto found = std::find_if(jointNames.begin(), jointNames.end(), [&nodeName](const char* name)
+                                                  { return nodeName == name; });
+                        if(found != jointNames.end())
+                            m_JointRemaps[offset + i] = uint16_t(found - jointNames.begin());
+                        else
+                            LUMOS_LOG_WARN("Skin joint {0} not found in skeleton", nodeName);
+                    }
+                }
+
+                auto skeleton         = CreateSharedPtr<Skeleton>(path, m_Skeleton);
+                m_AnimationController = CreateSharedPtr<AnimationController>();
+                m_AnimationController->SetSkeleton(skeleton);
+
+                for(size_t i = 0; i < m_Animation.size(); i++)
+                    m_AnimationController->AddState(animationNames[i].c_str(), CreateSharedPtr<Animation>(path, animationNames[i].c_str(), skeleton, m_Animation[i]));
             }
         }
     }
@@ -13,6 +13,8 @@ namespace Lumos
         class Pipeline;
         class Shader;
         class UniformBuffer;
+        class StorageBuffer;
+        class VertexBuffer;
         class Framebuffer;
         class RenderPass;
         class GraphicsContext;
@@ -127,7 +129,8 @@ namespace Lumos
             UNIFORM_BUFFER,
             UNIFORM_BUFFER_DYNAMIC,
             IMAGE_SAMPLER,
-            IMAGE_STORAGE
+            IMAGE_STORAGE,
+            STORAGE_BUFFER
         };
 
         enum class ShaderDataType
@@ -187,6 +190,12 @@ namespace Lumos
             Texture_MipViews             = BIT(6)
         };
 
+        enum class TextureAccess
+        {
+            SAMPLED = 0,
+            STORAGE
+        };
+
         enum RendererBufferType
         {
             RENDERER_BUFFER_COLOUR  = BIT(0),
@@ -308,6 +317,8 @@ namespace Lumos
             Texture** textures;
             Texture* texture;
             UniformBuffer* buffer;
+            StorageBuffer* storageBuffer = nullptr;
+            VertexBuffer* vertexBuffer   = nullptr;
 
             uint32_t offset;
             uint32_t size;
@@ -13,5 +13,17 @@ namespace Lumos
 
             return CreateFunc(desc);
         }
+
+        void DescriptorSet::SetUniform(const std::string& bufferName, const std::string& uniformName, void* data)
+        {
+            LUMOS_PROFILE_FUNCTION();
+            SetUniform(GetUniformHandle(bufferName, uniformName), data);
+        }
+
+        void DescriptorSet::SetUniform(const std::string& bufferName, const std::string& uniformName, void* data, uint32_t size)
+        {
+            LUMOS_PROFILE_FUNCTION();
+            SetUniform(GetUniformHandle(bufferName, uniformName), data, size);
+        }
     }
 }
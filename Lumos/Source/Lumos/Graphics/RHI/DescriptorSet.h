@@ -11,6 +11,18 @@ namespace Lumos
             std::vector<Descriptor> descriptors;
         };
 
+        // A uniform buffer member located once from shader reflection, so writes through it skip the name lookups.
+        // Buffer indexes the set's uniform buffers in layout order, so a handle is valid for every descriptor set
+        // created from the same shader and layout index
+        struct UniformHandle
+        {
+            uint32_t Buffer = ~0u;
+            uint32_t Offset = 0;
+            uint32_t Size   = 0;
+
+            bool IsValid() const { return Buffer != ~0u; }
+        };
+
         class DescriptorSet
         {
         public:
@@ -23,12 +35,23 @@ namespace Lumos
             virtual void SetTexture(const std::string& name, Texture** texture, uint32_t textureCount, TextureType textureType = TextureType(0)) = 0;
             virtual void SetTexture(const std::string& name, Texture* texture, uint32_t mipIndex = 0, TextureType textureType = TextureType(0))  = 0;
             virtual void SetBuffer(const std::string& name, UniformBuffer* buffer)                                                               = 0;
+            // Points the named uniform block at a range of buffers owned elsewhere, one per frame in
+            // flight, in place of the set's own storage. The set's uniform writes to that block are then ignored
+            virtual void SetBuffer(const std::string& name, const SharedPtr<UniformBuffer>* buffers, uint32_t offset, uint32_t size)             = 0;
             virtual Graphics::UniformBuffer* GetUnifromBuffer(const std::string& name)                                                           = 0;
-            virtual void SetUniform(const std::string& bufferName, const std::string& uniformName, void* data)                                   = 0;
-            virtual void SetUniform(const std::string& bufferName, const std::string& uniformName, void* data, uint32_t size)                    = 0;
+            virtual UniformHandle GetUniformHandle(const std::string& bufferName, const std::string& uniformName)                                = 0;
+            virtual void SetUniform(const UniformHandle& handle, const void* data)                                                               = 0;
+            virtual void SetUniform(const UniformHandle& handle, const void* data, uint32_t size)                                                = 0;
             virtual void SetUniformBufferData(const std::string& bufferName, void* data)                                                         = 0;
             virtual void TransitionImages(CommandBuffer* commandBuffer = nullptr) { }
             virtual void SetUniformDynamic(const std::string& bufferName, uint32_t size) { }
+            virtual void SetStorageBuffer(const std::string& name, StorageBuffer* buffer) { }
+            // Binds a vertex buffer as the named storage buffer, for compute passes that write vertices
+            virtual void SetStorageBuffer(const std::string& name, VertexBuffer* buffer) { }
+
+            // Looks the uniform up by name on every call, resolve a UniformHandle for anything set per frame or per draw
+            void SetUniform(const std::string& bufferName, const std::string& uniformName, void* data);
+            void SetUniform(const std::string& bufferName, const std::string& uniformName, void* data, uint32_t size);
 
         protected:
             static DescriptorSet* (*CreateFunc)(const DescriptorDesc&);
@@ -6,6 +6,7 @@
 #include "Renderer.h"
 
 #include "Utilities/CombineHash.h"
+#include "Maths/MathsUtilities.h"
 #include "Graphics/RHI/GraphicsContext.h"
 
 #ifdef LUMOS_RENDER_API_VULKAN
@@ -23,10 +24,16 @@ namespace Lumos
         struct PipelineAsset
         {
             SharedPtr<Pipeline> pipeline;
-            float timeSinceLastAccessed;
+            uint64_t lastAccessedFrame;
+            uint32_t framesUsed;
         };
         static std::unordered_map<uint64_t, PipelineAsset> m_PipelineCache;
-        static const float m_CacheLifeTime = 0.1f;
+        static uint64_t m_CacheFrame = 0;
+
+        // An unused pipeline is kept for as many frames as it has been used, within these bounds,
+        // so pipelines used every frame survive a pause in use while one-offs go quickly
+        static const uint32_t m_MinCacheFrames = 60;
+        static const uint32_t m_MaxCacheFrames = 3600;
 
         Pipeline* (*Pipeline::CreateFunc)(const PipelineDesc&) = nullptr;
 
@@ -69,26 +76,24 @@ namespace Lumos
             HashCombine(hash, pipelineDesc.cubeMapIndex);
             HashCombine(hash, pipelineDesc.cubeMapTarget);
             HashCombine(hash, pipelineDesc.mipIndex);
+            HashCombine(hash, pipelineDesc.asyncCompile);
 
-            if(pipelineDesc.swapchainTarget)
-            {
-                // Add one swapchain image to hash
-                auto texture = Renderer::GetMainSwapChain()->GetCurrentImage();
-                if(texture)
-                {
-                    HashCombine(hash, texture->GetUUID());
-                }
-            }
-
+            // The swapchain images are not hashed, a pipeline holds framebuffers for all of them and binds the
+            // current one. Other targets are, but only to pick framebuffers, the compiled pipeline underneath is
+            // shared by every target with the same formats, so a resize does not recompile anything
             auto found = m_PipelineCache.find(hash);
             if(found != m_PipelineCache.end() && found->second.pipeline)
             {
-                found->second.timeSinceLastAccessed = (float)Engine::GetTimeStep().GetElapsedSeconds();
+                if(found->second.lastAccessedFrame != m_CacheFrame)
+                {
+                    found->second.lastAccessedFrame = m_CacheFrame;
+                    found->second.framesUsed++;
+                }
                 return found->second.pipeline;
             }
 
             SharedPtr<Pipeline> pipeline = SharedPtr<Pipeline>(Create(pipelineDesc));
-            m_PipelineCache[hash]        = { pipeline, (float)Engine::GetTimeStep().GetElapsedSeconds() };
+            m_PipelineCache[hash]        = { pipeline, m_CacheFrame, 1 };
             return pipeline;
         }
 
@@ -103,10 +108,12 @@ namespace Lumos
 
             static std::size_t keysToDelete[256];
             std::size_t keysToDeleteCount = 0;
+            m_CacheFrame++;
 
             for(auto&& [key, value] : m_PipelineCache)
             {
-                if(value.pipeline && value.pipeline.GetCounter()->GetReferenceCount() == 1 && (Engine::GetTimeStep().GetElapsedSeconds() - value.timeSinceLastAccessed) > m_CacheLifeTime)
+                uint64_t lifeTime = Maths::Clamp(value.framesUsed, m_MinCacheFrames, m_MaxCacheFrames);
+                if(value.pipeline && value.pipeline.GetCounter()->GetReferenceCount() == 1 && m_CacheFrame - value.lastAccessedFrame > lifeTime)
                 {
                     keysToDelete[keysToDeleteCount] = key;
                     keysToDeleteCount++;
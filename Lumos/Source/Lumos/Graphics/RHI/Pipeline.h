@@ -21,6 +21,9 @@ namespace Lumos
             bool swapchainTarget     = false;
             bool clearTargets        = false;
 
+            // Compile on a worker thread instead of stalling Get. Callers must skip draws until IsReady()
+            bool asyncCompile = false;
+
             std::array<Texture*, MAX_RENDER_TARGETS> colourTargets = {};
 
             Texture* cubeMapTarget        = nullptr;
@@ -51,6 +54,9 @@ namespace Lumos
             virtual void ClearRenderTargets(CommandBuffer* commandBuffer) { }
             virtual Shader* GetShader() const = 0;
 
+            // False while an asyncCompile pipeline is still compiling
+            virtual bool IsReady() const { return true; }
+
             uint32_t GetWidth();
             uint32_t GetHeight();
 
@@ -105,7 +105,22 @@ namespace Lumos
                 shaderLibrary->AddResource("ToneMapping", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromEmbeddedArray(spirv_ScreenPassvertspv.data(), spirv_ScreenPassvertspv_size, spirv_ToneMappingfragspv.data(), spirv_ToneMappingfragspv_size)));
                 shaderLibrary->AddResource("Bloom", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromEmbeddedArray(spirv_ScreenPassvertspv.data(), spirv_ScreenPassvertspv_size, spirv_Bloomfragspv.data(), spirv_Bloomfragspv_size)));
                 if(Renderer::GetCapabilities().SupportCompute)
+                {
                     shaderLibrary->AddResource("BloomComp", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateCompFromEmbeddedArray(spirv_Bloomcompspv.data(), spirv_Bloomcompspv_size)));
+
+                    // Not embedded yet
+                    shaderLibrary->AddResource("DepthPyramid", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/DepthPyramid.shader")));
+                    shaderLibrary->AddResource("GPUCulling", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/GPUCulling.shader")));
+                    shaderLibrary->AddResource("Skinning", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/Skinning.shader")));
+                    shaderLibrary->AddResource("SSAOComp", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/SSAOComp.shader")));
+                    shaderLibrary->AddResource("SSAOUpsample", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/SSAOUpsample.shader")));
+                    shaderLibrary->AddResource("BloomDownsample", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/BloomDownsample.shader")));
+                    shaderLibrary->AddResource("BloomUpsample", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/BloomUpsample.shader")));
+                }
+
+                // Not embedded yet
+                shaderLibrary->AddResource("MotionVectors", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/MotionVectors.shader")));
+                shaderLibrary->AddResource("TemporalUpscale", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/TemporalUpscale.shader")));
                 shaderLibrary->AddResource("BRDFLUT", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromEmbeddedArray(spirv_ScreenPassvertspv.data(), spirv_ScreenPassvertspv_size, spirv_BRDFLUTfragspv.data(), spirv_BRDFLUTfragspv_size)));
                 shaderLibrary->AddResource("Text", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromEmbeddedArray(spirv_Textvertspv.data(), spirv_Textvertspv_size, spirv_Textfragspv.data(), spirv_Textfragspv_size)));
                 shaderLibrary->AddResource("DepthOfField", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromEmbeddedArray(spirv_ScreenPassvertspv.data(), spirv_ScreenPassvertspv_size, spirv_DepthOfFieldfragspv.data(), spirv_DepthOfFieldfragspv_size)));
@@ -141,7 +156,16 @@ namespace Lumos
                 shaderLibrary->AddResource("ToneMapping", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/ToneMapping.shader")));
                 shaderLibrary->AddResource("Bloom", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/Bloom.shader")));
                 if(Renderer::GetCapabilities().SupportCompute)
+                {
                     shaderLibrary->AddResource("BloomComp", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/BloomComp.shader")));
+                    shaderLibrary->AddResource("DepthPyramid", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/DepthPyramid.shader")));
+                    shaderLibrary->AddResource("GPUCulling", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/GPUCulling.shader")));
+                    shaderLibrary->AddResource("Skinning", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/Skinning.shader")));
+                    shaderLibrary->AddResource("SSAOComp", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/SSAOComp.shader")));
+                    shaderLibrary->AddResource("SSAOUpsample", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/SSAOUpsample.shader")));
+                    shaderLibrary->AddResource("BloomDownsample", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/BloomDownsample.shader")));
+                    shaderLibrary->AddResource("BloomUpsample", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/BloomUpsample.shader")));
+                }
                 shaderLibrary->AddResource("DepthOfField", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/DepthOfField.shader")));
 
                 shaderLibrary->AddResource("BRDFLUT", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/BRDFLUT.shader")));
@@ -149,6 +173,8 @@ namespace Lumos
                 shaderLibrary->AddResource("SSAO", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/SSAO.shader")));
                 shaderLibrary->AddResource("SSAOBlur", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/SSAOBlur.shader")));
                 shaderLibrary->AddResource("Sharpen", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/Sharpen.shader")));
+                shaderLibrary->AddResource("MotionVectors", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/MotionVectors.shader")));
+                shaderLibrary->AddResource("TemporalUpscale", SharedPtr<Graphics::Shader>(Graphics::Shader::CreateFromFile("//CoreShaders/TemporalUpscale.shader")));
             }
         }
 
@@ -163,5 +189,14 @@ namespace Lumos
             mesh->GetVertexBuffer()->Unbind();
             mesh->GetIndexBuffer()->Unbind();
         }
+
+        void Renderer::DrawMeshIndirect(CommandBuffer* commandBuffer, Graphics::Pipeline* pipeline, Graphics::Mesh* mesh, StorageBuffer* commands, uint32_t offset)
+        {
+            mesh->GetVertexBuffer()->Bind(commandBuffer, pipeline);
+            mesh->GetIndexBuffer()->Bind(commandBuffer);
+            s_Instance->DrawIndexedIndirect(commandBuffer, commands, offset, 1, 0);
+            mesh->GetVertexBuffer()->Unbind();
+            mesh->GetIndexBuffer()->Unbind();
+        }
     }
 }
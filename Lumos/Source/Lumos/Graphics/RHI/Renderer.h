@@ -38,6 +38,7 @@ namespace Lumos
             virtual void Begin()                                   = 0;
             virtual void OnResize(uint32_t width, uint32_t height) = 0;
             virtual void ClearRenderTarget(Graphics::Texture* texture, Graphics::CommandBuffer* commandBuffer, glm::vec4 clearColour = glm::vec4(0.1f, 0.1f, 0.1f, 1.0f)) { }
+            virtual void TransitionTexture(Graphics::Texture* texture, TextureAccess access, Graphics::CommandBuffer* commandBuffer) { }
             inline static Renderer* GetRenderer()
             {
                 return s_Instance;
@@ -51,6 +52,18 @@ namespace Lumos
             virtual void DrawIndexedInternal(CommandBuffer* commandBuffer, DrawType type, uint32_t count, uint32_t start) const             = 0;
             virtual void DrawInternal(CommandBuffer* commandBuffer, DrawType type, uint32_t count, DataType datayType, void* indices) const = 0;
             virtual void Dispatch(CommandBuffer* commandBuffer, uint32_t workGroupSizeX, uint32_t workGroupSizeY, uint32_t workGroupSizeZ) { }
+            virtual void DrawIndexedIndirect(CommandBuffer* commandBuffer, StorageBuffer* commands, uint32_t offset, uint32_t drawCount, uint32_t stride) { }
+
+            // Makes compute shader writes visible to later shader reads, vertex fetches, indirect draws and the host
+            virtual void ComputeBarrier(CommandBuffer* commandBuffer) { }
+
+            // Times the GPU work recorded between the two calls, outside render passes. Each timer is used at most once
+            // per frame, timer 0 times the whole frame and the others single passes. GetGPUTime returns the last
+            // completed measurement in milliseconds, or 0 without timer support
+            static const uint32_t MaxGPUTimers = 8;
+            virtual void BeginGPUTimer(CommandBuffer* commandBuffer, uint32_t timer = 0) { }
+            virtual void EndGPUTimer(CommandBuffer* commandBuffer, uint32_t timer = 0) { }
+            virtual float GetGPUTime(uint32_t timer = 0) const { return 0.0f; }
             virtual void DrawSplashScreen(Texture* texture) { }
             virtual uint32_t GetGPUCount() const { return 1; }
             virtual bool SupportsCompute() { return false; }
@@ -91,6 +104,9 @@ namespace Lumos
             static SwapChain* GetMainSwapChain();
             static void DrawMesh(CommandBuffer* commandBuffer, Graphics::Pipeline* pipeline, Graphics::Mesh* mesh);
 
+            // Draws the mesh with the indexed indirect command at offset, written by the GPU
+            static void DrawMeshIndirect(CommandBuffer* commandBuffer, Graphics::Pipeline* pipeline, Graphics::Mesh* mesh, StorageBuffer* commands, uint32_t offset);
+
         protected:
             static Renderer* (*CreateFunc)();
 
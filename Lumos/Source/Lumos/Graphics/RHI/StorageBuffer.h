@@ -0,0 +1,26 @@
+#pragma once
+
+namespace Lumos
+{
+    namespace Graphics
+    {
+        // Buffer read and written by shaders, also usable as the argument buffer of indirect draws
+        class StorageBuffer
+        {
+        public:
+            virtual ~StorageBuffer() = default;
+            static StorageBuffer* Create(uint32_t size, const void* data = nullptr);
+
+            virtual void SetData(uint32_t size, const void* data)                     = 0;
+            virtual void SetSubData(uint32_t offset, uint32_t size, const void* data) = 0;
+
+            // Reads back what the GPU wrote, only valid once the work writing it has completed
+            virtual void GetData(uint32_t offset, uint32_t size, void* data) = 0;
+
+            virtual uint32_t GetSize() const = 0;
+
+        protected:
+            static StorageBuffer* (*CreateFunc)(uint32_t, const void*);
+        };
+    }
+}
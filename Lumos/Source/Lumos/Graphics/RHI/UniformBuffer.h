@@ -15,6 +15,7 @@ namespace Lumos
             virtual void SetData(const void* data)                                          = 0;
             virtual void SetData(uint32_t size, const void* data)                           = 0;
             virtual void SetDynamicData(uint32_t size, uint32_t typeSize, const void* data) = 0;
+            virtual void SetSubData(uint32_t offset, uint32_t size, const void* data)       = 0;
 
             virtual uint8_t* GetBuffer() const = 0;
 
@@ -0,0 +1,52 @@
+#include "Precompiled.h"
+#include "DynamicResolution.h"
+#include "Maths/MathsUtilities.h"
+
+namespace Lumos
+{
+    namespace Graphics
+    {
+        bool DynamicResolution::Update(float gpuTime)
+        {
+            m_FramesSinceChange++;
+
+            if(gpuTime <= 0.0f)
+                return false;
+
+            m_SmoothedTime = m_SmoothedTime > 0.0f ? Maths::Lerp(m_SmoothedTime, gpuTime, 0.1f) : gpuTime;
+
+            if(m_FramesSinceChange < m_Settings.Cooldown)
+                return false;
+
+            // GPU time roughly follows the pixel count, the square of the scale
+            float budget = m_Settings.TargetFrameTime * m_Settings.Headroom;
+            float ideal  = m_Scale * sqrtf(budget / m_SmoothedTime);
+            float scale  = m_Scale;
+
+            if(m_SmoothedTime > m_Settings.TargetFrameTime)
+                scale = ideal;
+            else if(ideal >= m_Scale + m_Settings.Step)
+                scale = m_Scale + m_Settings.Step;
+
+            // Rounding down keeps the new scale inside the budget
+            scale = floorf(scale / m_Settings.Step + 0.001f) * m_Settings.Step;
+            scale = Maths::Clamp(scale, m_Settings.MinScale, m_Settings.MaxScale);
+
+            if(fabsf(scale - m_Scale) < m_Settings.Step * 0.5f)
+                return false;
+
+            // Measurements still in flight were taken at the old scale, estimate the new time until they drain
+            m_SmoothedTime *= (scale * scale) / (m_Scale * m_Scale);
+            m_Scale             = scale;
+            m_FramesSinceChange = 0;
+            return true;
+        }
+
+        void DynamicResolution::Reset(float scale)
+        {
+            m_Scale             = scale;
+            m_SmoothedTime      = 0.0f;
+            m_FramesSinceChange = 0;
+        }
+    }
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+namespace Lumos
+{
+    namespace Graphics
+    {
+        // Picks the fraction of the display resolution to render at from measured GPU frame times. The scale drops
+        // as soon as frames go over the target and rises a step at a time once there is headroom. Scales snap to
+        // steps so the render targets are only resized on a real change
+        class LUMOS_EXPORT DynamicResolution
+        {
+        public:
+            struct Settings
+            {
+                float TargetFrameTime = 16.6f; // Milliseconds
+                float Headroom        = 0.85f; // Fraction of the target to settle at
+                float MinScale        = 0.5f;
+                float MaxScale        = 1.0f;
+                float Step            = 0.05f;
+                uint32_t Cooldown     = 10; // Frames between changes, measurements lag behind by the frames in flight
+            };
+
+            // gpuTime in milliseconds, 0 when there is no measurement. Returns true if the scale changed
+            bool Update(float gpuTime);
+            void Reset(float scale = 1.0f);
+
+            float GetScale() const { return m_Scale; }
+            float GetSmoothedTime() const { return m_SmoothedTime; }
+            Settings& GetSettings() { return m_Settings; }
+
+        private:
+            Settings m_Settings;
+            float m_Scale                = 1.0f;
+            float m_SmoothedTime         = 0.0f;
+            uint32_t m_FramesSinceChange = 0;
+        };
+    }
+}
@@ -0,0 +1,234 @@
+#include "Precompiled.h"
+#include "GPUCulling.h"
+#include "Graphics/RHI/Renderer.h"
+#include "Graphics/RHI/Shader.h"
+#include "Graphics/RHI/Texture.h"
+#include "Graphics/RHI/StorageBuffer.h"
+#include "Graphics/RHI/DescriptorSet.h"
+#include "Graphics/RHI/Pipeline.h"
+#include "Graphics/RHI/SwapChain.h"
+#include "Graphics/Mesh.h"
+#include "Graphics/Material.h"
+#include "Core/Application.h"
+#include "Graphics/RHI/GPUProfile.h"
+#include "Utilities/AssetManager.h"
+#include "Maths/BoundingBox.h"
+#include "Maths/Frustum.h"
+#include "Maths/MathsUtilities.h"
+
+namespace Lumos
+{
+    namespace Graphics
+    {
+        // Matches VkDrawIndexedIndirectCommand
+        static const uint32_t IndirectCommandSize = sizeof(uint32_t) * 5;
+
+        GPUCuller::GPUCuller()
+        {
+            LUMOS_PROFILE_FUNCTION();
+
+            memset(&m_Uniforms, 0, sizeof(CullingUniforms));
+            memset(m_VisibleCounts, 0, sizeof(m_VisibleCounts));
+
+            // Only loaded when compute is supported
+            if(Renderer::GetCapabilities().SupportCompute)
+            {
+                m_CullingShader = Application::Get().GetShaderLibrary()->GetResource("GPUCulling");
+                m_PyramidShader = Application::Get().GetShaderLibrary()->GetResource("DepthPyramid");
+            }
+
+            if(!IsSupported())
+            {
+                if(Renderer::GetCapabilities().SupportCompute)
+                    LUMOS_LOG_WARN("GPU culling shaders unavailable (GPUCulling, DepthPyramid), using CPU culling");
+                return;
+            }
+
+            Graphics::DescriptorDesc descriptorDesc {};
+            descriptorDesc.layoutIndex = 0;
+            descriptorDesc.shader      = m_CullingShader.get();
+            m_CullingDescriptorSet     = SharedPtr<Graphics::DescriptorSet>(Graphics::DescriptorSet::Create(descriptorDesc));
+
+            m_Frames.resize(Renderer::GetMainSwapChain()->GetSwapChainBufferCount());
+        }
+
+        GPUCuller::~GPUCuller()
+        {
+        }
+
+        bool GPUCuller::IsSupported() const
+        {
+            return m_CullingShader && m_CullingShader->IsCompiled() && m_PyramidShader && m_PyramidShader->IsCompiled();
+        }
+
+        void GPUCuller::Begin()
+        {
+            m_Draws.clear();
+
+            for(auto& plane : m_Uniforms.FrustumPlanes)
+                plane = glm::vec4(0.0f);
+        }
+
+        void GPUCuller::SetView(uint32_t view, const Maths::Frustum& frustum)
+        {
+            LUMOS_ASSERT(view < MaxViews, "Culling view out of range");
+
+            for(int i = 0; i < 6; i++)
+            {
+                const auto& plane                      = frustum.GetPlane(i);
+                m_Uniforms.FrustumPlanes[view * 6 + i] = glm::vec4(plane.Normal(), plane.Distance());
+            }
+        }
+
+        uint32_t GPUCuller::AddDraw(const Maths::BoundingBox& worldBounds, uint32_t indexCount, uint32_t view)
+        {
+            CullingDraw draw;
+            draw.Center     = glm::vec4(worldBounds.Center(), 0.0f);
+            draw.Extents    = glm::vec4(worldBounds.Size() * 0.5f, 0.0f);
+            draw.IndexCount = indexCount;
+            draw.View       = view;
+            draw.Padding[0] = 0;
+            draw.Padding[1] = 0;
+
+            m_Draws.push_back(draw);
+            return uint32_t(m_Draws.size() - 1);
+        }
+
+        void GPUCuller::BuildDepthPyramid(Texture* depth, Texture2D* pyramid, CommandBuffer* commandBuffer)
+        {
+            LUMOS_PROFILE_FUNCTION();
+            LUMOS_PROFILE_GPU("Depth Pyramid");
+
+            uint32_t levels = pyramid->GetMipMapLevels();
+            if(m_PyramidDescriptorSets.size() != levels)
+            {
+                m_PyramidDescriptorSets.clear();
+
+                Graphics::DescriptorDesc descriptorDesc {};
+                descriptorDesc.layoutIndex = 0;
+                descriptorDesc.shader      = m_PyramidShader.get();
+
+                for(uint32_t i = 0; i < levels; i++)
+                    m_PyramidDescriptorSets.push_back(SharedPtr<Graphics::DescriptorSet>(Graphics::DescriptorSet::Create(descriptorDesc)));
+            }
+
+            Graphics::PipelineDesc pipelineDesc {};
+            pipelineDesc.shader    = m_PyramidShader;
+            pipelineDesc.DebugName = "Depth Pyramid";
+
+            auto pipeline = Graphics::Pipeline::Get(pipelineDesc);
+            pipeline->Bind(commandBuffer);
+
+            struct PyramidPushConstants
+            {
+                glm::vec4 Size;
+                glm::vec4 Params;
+            } pyramidPushConstants;
+
+            auto& pushConstants    = m_PyramidShader->GetPushConstants();
+            uint32_t workGroupSize = 8;
+
+            for(uint32_t level = 0; level < levels; level++)
+            {
+                // Level 0 reduces the depth buffer, the source image is then unused but still has to be valid
+                auto set = m_PyramidDescriptorSets[level].get();
+                set->SetTexture("o_Depth", pyramid, level);
+                set->SetTexture("i_Source", pyramid, level > 0 ? level - 1 : 0);
+                set->SetTexture("u_Depth", depth, 0, TextureType::DEPTH);
+                set->TransitionImages(commandBuffer);
+                set->Update(commandBuffer);
+
+                pyramidPushConstants.Size.x   = (float)pyramid->GetWidth(level);
+                pyramidPushConstants.Size.y   = (float)pyramid->GetHeight(level);
+                pyramidPushConstants.Size.z   = (float)(level > 0 ? pyramid->GetWidth(level - 1) : depth->GetWidth());
+                pyramidPushConstants.Size.w   = (float)(level > 0 ? pyramid->GetHeight(level - 1) : depth->GetHeight());
+                pyramidPushConstants.Params.x = (float)level;
+
+                memcpy(pushConstants[0].data, &pyramidPushConstants, sizeof(PyramidPushConstants));
+                m_PyramidShader->BindPushConstants(commandBuffer, pipeline.get());
+
+                Renderer::BindDescriptorSets(pipeline.get(), commandBuffer, 0, &set, 1);
+
+                uint32_t workGroupsX = (pyramid->GetWidth(level) + workGroupSize - 1) / workGroupSize;
+                uint32_t workGroupsY = (pyramid->GetHeight(level) + workGroupSize - 1) / workGroupSize;
+                Renderer::GetRenderer()->Dispatch(commandBuffer, workGroupsX, workGroupsY, 1);
+
+                // The next level reads this one
+                Renderer::GetRenderer()->ComputeBarrier(commandBuffer);
+            }
+
+            pipeline->End(commandBuffer);
+        }
+
+        void GPUCuller::Cull(Texture2D* pyramid, const glm::mat4& previousViewProj, CommandBuffer* commandBuffer)
+        {
+            LUMOS_PROFILE_FUNCTION();
+            LUMOS_PROFILE_GPU("GPU Culling");
+
+            FrameBuffers& frame = m_Frames[Renderer::GetMainSwapChain()->GetCurrentBufferIndex()];
+
+            // This frame's buffers were last used frames in flight ago and that frame has completed
+            if(frame.Submitted)
+                frame.Counts->GetData(0, sizeof(m_VisibleCounts), m_VisibleCounts);
+            else
+                memset(m_VisibleCounts, 0, sizeof(m_VisibleCounts));
+
+            frame.Submitted = false;
+
+            uint32_t drawCount = uint32_t(m_Draws.size());
+            if(drawCount == 0)
+                return;
+
+            if(drawCount > frame.Capacity)
+            {
+                // Buffers still read by frames in flight are released through the deletion queue
+                frame.Capacity = Maths::Max(drawCount, frame.Capacity * 2);
+                frame.Draws    = UniquePtr<StorageBuffer>(StorageBuffer::Create(frame.Capacity * sizeof(CullingDraw)));
+                frame.Commands = UniquePtr<StorageBuffer>(StorageBuffer::Create(frame.Capacity * IndirectCommandSize));
+                frame.Counts   = UniquePtr<StorageBuffer>(StorageBuffer::Create(sizeof(m_VisibleCounts)));
+            }
+
+            uint32_t zeroCounts[MaxViews] = {};
+            frame.Draws->SetSubData(0, drawCount * sizeof(CullingDraw), m_Draws.data());
+            frame.Counts->SetData(sizeof(zeroCounts), zeroCounts);
+
+            m_Uniforms.PreviousViewProj = previousViewProj;
+            m_Uniforms.DrawCount[0]     = drawCount;
+            if(pyramid)
+                m_Uniforms.PyramidSize = glm::vec4((float)pyramid->GetWidth(), (float)pyramid->GetHeight(), (float)pyramid->GetMipMapLevels(), 1.0f);
+            else
+                m_Uniforms.PyramidSize = glm::vec4(1.0f, 1.0f, 1.0f, 0.0f);
+
+            m_CullingDescriptorSet->SetStorageBuffer("Draws", frame.Draws.get());
+            m_CullingDescriptorSet->SetStorageBuffer("Commands", frame.Commands.get());
+            m_CullingDescriptorSet->SetStorageBuffer("Counts", frame.Counts.get());
+            m_CullingDescriptorSet->SetTexture("u_DepthPyramid", pyramid ? (Texture*)pyramid : Graphics::Material::GetDefaultTexture().get());
+            m_CullingDescriptorSet->SetUniformBufferData("UniformBuffer", &m_Uniforms);
+            m_CullingDescriptorSet->Update(commandBuffer);
+
+            Graphics::PipelineDesc pipelineDesc {};
+            pipelineDesc.shader    = m_CullingShader;
+            pipelineDesc.DebugName = "GPU Culling";
+
+            auto pipeline = Graphics::Pipeline::Get(pipelineDesc);
+            pipeline->Bind(commandBuffer);
+
+            auto set = m_CullingDescriptorSet.get();
+            Renderer::BindDescriptorSets(pipeline.get(), commandBuffer, 0, &set, 1);
+
+            uint32_t workGroupSize = 64;
+            Renderer::GetRenderer()->Dispatch(commandBuffer, (drawCount + workGroupSize - 1) / workGroupSize, 1, 1);
+            pipeline->End(commandBuffer);
+
+            // Commands are consumed by the indirect draws of this frame and the counts read back on the host
+            Renderer::GetRenderer()->ComputeBarrier(commandBuffer);
+            frame.Submitted = true;
+        }
+
+        void GPUCuller::Draw(CommandBuffer* commandBuffer, Pipeline* pipeline, Mesh* mesh, uint32_t drawIndex)
+        {
+            FrameBuffers& frame = m_Frames[Renderer::GetMainSwapChain()->GetCurrentBufferIndex()];
+            Renderer::DrawMeshIndirect(commandBuffer, pipeline, mesh, frame.Commands.get(), drawIndex * IndirectCommandSize);
+        }
+    }
+}
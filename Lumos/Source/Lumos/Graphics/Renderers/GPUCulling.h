@@ -0,0 +1,94 @@
+#pragma once
+#include "Graphics/RHI/Definitions.h"
+#include <glm/mat4x4.hpp>
+
+namespace Lumos
+{
+    namespace Maths
+    {
+        class BoundingBox;
+        class Frustum;
+    }
+
+    namespace Graphics
+    {
+        class Shader;
+        class Texture;
+        class Texture2D;
+        class StorageBuffer;
+        class DescriptorSet;
+        class CommandBuffer;
+        class Pipeline;
+        class Mesh;
+
+        // Culls draws on the GPU. Draws are registered with their world bounds while the command queues are built,
+        // a compute pass then tests each against the frustum of its view and, for the camera, against a depth
+        // pyramid built from the previous frame's depth. It writes one indexed indirect command per draw, culled
+        // draws keep their command with an instance count of 0 so the passes can still submit them in their own order
+        class LUMOS_EXPORT GPUCuller
+        {
+        public:
+            // The camera and the shadow cascades
+            static const uint32_t MaxViews = 1 + SHADOWMAP_MAX;
+
+            GPUCuller();
+            ~GPUCuller();
+
+            bool IsSupported() const;
+
+            void Begin();
+            void SetView(uint32_t view, const Maths::Frustum& frustum);
+            uint32_t AddDraw(const Maths::BoundingBox& worldBounds, uint32_t indexCount, uint32_t view);
+
+            // Call with the depth from the previous frame, before it is cleared
+            void BuildDepthPyramid(Texture* depth, Texture2D* pyramid, CommandBuffer* commandBuffer);
+
+            // pyramid can be null to skip occlusion
+            void Cull(Texture2D* pyramid, const glm::mat4& previousViewProj, CommandBuffer* commandBuffer);
+
+            void Draw(CommandBuffer* commandBuffer, Pipeline* pipeline, Mesh* mesh, uint32_t drawIndex);
+
+            uint32_t GetDrawCount() const { return uint32_t(m_Draws.size()); }
+
+            // Read back from the frame that last used this frame's buffers
+            uint32_t GetVisibleCount(uint32_t view) const { return m_VisibleCounts[view]; }
+
+        private:
+            struct CullingDraw
+            {
+                glm::vec4 Center;
+                glm::vec4 Extents;
+                uint32_t IndexCount;
+                uint32_t View;
+                uint32_t Padding[2];
+            };
+
+            struct CullingUniforms
+            {
+                glm::vec4 FrustumPlanes[MaxViews * 6];
+                glm::mat4 PreviousViewProj;
+                glm::vec4 PyramidSize;
+                uint32_t DrawCount[4];
+            };
+
+            struct FrameBuffers
+            {
+                UniquePtr<StorageBuffer> Draws;
+                UniquePtr<StorageBuffer> Commands;
+                UniquePtr<StorageBuffer> Counts;
+                uint32_t Capacity = 0;
+                bool Submitted    = false;
+            };
+
+            SharedPtr<Shader> m_CullingShader;
+            SharedPtr<Shader> m_PyramidShader;
+            SharedPtr<DescriptorSet> m_CullingDescriptorSet;
+            std::vector<SharedPtr<DescriptorSet>> m_PyramidDescriptorSets;
+
+            std::vector<FrameBuffers> m_Frames;
+            std::vector<CullingDraw> m_Draws;
+            CullingUniforms m_Uniforms;
+            uint32_t m_VisibleCounts[MaxViews];
+        };
+    }
+}
@@ -0,0 +1,134 @@
+#include "Precompiled.h"
+#include "GPUSkinning.h"
+#include "Graphics/RHI/Renderer.h"
+#include "Graphics/RHI/Shader.h"
+#include "Graphics/RHI/StorageBuffer.h"
+#include "Graphics/RHI/VertexBuffer.h"
+#include "Graphics/RHI/DescriptorSet.h"
+#include "Graphics/RHI/Pipeline.h"
+#include "Graphics/RHI/SwapChain.h"
+#include "Graphics/Mesh.h"
+#include "Core/Application.h"
+#include "Graphics/RHI/GPUProfile.h"
+#include "Utilities/AssetManager.h"
+#include "Maths/MathsUtilities.h"
+
+namespace Lumos
+{
+    namespace Graphics
+    {
+        GPUSkinning::GPUSkinning()
+        {
+            LUMOS_PROFILE_FUNCTION();
+
+            // Only loaded when compute is supported
+            if(Renderer::GetCapabilities().SupportCompute)
+                m_SkinningShader = Application::Get().GetShaderLibrary()->GetResource("Skinning");
+
+            if(!IsSupported())
+            {
+                LUMOS_LOG_WARN("Skinning compute shader unavailable, skinning on the CPU");
+                return;
+            }
+
+            m_Frames.resize(Renderer::GetMainSwapChain()->GetSwapChainBufferCount());
+        }
+
+        GPUSkinning::~GPUSkinning()
+        {
+        }
+
+        bool GPUSkinning::IsSupported() const
+        {
+            return m_SkinningShader && m_SkinningShader->IsCompiled();
+        }
+
+        void GPUSkinning::Begin()
+        {
+            m_Joints.clear();
+            m_Meshes.clear();
+        }
+
+        uint32_t GPUSkinning::AddPalette(const std::vector<glm::mat4>& jointMatrices)
+        {
+            uint32_t offset = uint32_t(m_Joints.size());
+            m_Joints.insert(m_Joints.end(), jointMatrices.begin(), jointMatrices.end());
+            return offset;
+        }
+
+        void GPUSkinning::AddMesh(Mesh* source, VertexBuffer* output, uint32_t jointOffset, uint32_t jointCount)
+        {
+            SkinningMesh mesh;
+            mesh.Source      = source;
+            mesh.Output      = output;
+            mesh.VertexCount = uint32_t(source->GetVertices().size());
+            mesh.JointOffset = jointOffset;
+            mesh.JointCount  = jointCount;
+
+            m_Meshes.push_back(mesh);
+        }
+
+        void GPUSkinning::Dispatch(CommandBuffer* commandBuffer)
+        {
+            LUMOS_PROFILE_FUNCTION();
+
+            if(m_Meshes.empty())
+                return;
+
+            LUMOS_PROFILE_GPU("Skinning");
+
+            FrameBuffers& frame = m_Frames[Renderer::GetMainSwapChain()->GetCurrentBufferIndex()];
+
+            uint32_t jointCount = uint32_t(m_Joints.size());
+            if(jointCount > frame.Capacity)
+            {
+                // Buffers still read by frames in flight are released through the deletion queue
+                frame.Capacity = Maths::Max(jointCount, frame.Capacity * 2);
+                frame.Joints   = UniquePtr<StorageBuffer>(StorageBuffer::Create(frame.Capacity * sizeof(glm::mat4)));
+            }
+
+            frame.Joints->SetSubData(0, jointCount * sizeof(glm::mat4), m_Joints.data());
+
+            Graphics::DescriptorDesc descriptorDesc {};
+            descriptorDesc.layoutIndex = 0;
+            descriptorDesc.shader      = m_SkinningShader.get();
+
+            while(m_DescriptorSets.size() < m_Meshes.size())
+                m_DescriptorSets.push_back(SharedPtr<Graphics::DescriptorSet>(Graphics::DescriptorSet::Create(descriptorDesc)));
+
+            Graphics::PipelineDesc pipelineDesc {};
+            pipelineDesc.shader    = m_SkinningShader;
+            pipelineDesc.DebugName = "Skinning";
+
+            auto pipeline = Graphics::Pipeline::Get(pipelineDesc);
+            pipeline->Bind(commandBuffer);
+
+            auto& pushConstants    = m_SkinningShader->GetPushConstants();
+            uint32_t workGroupSize = 64;
+
+            for(size_t i = 0; i < m_Meshes.size(); i++)
+            {
+                const SkinningMesh& mesh = m_Meshes[i];
+
+                auto set = m_DescriptorSets[i].get();
+                set->SetStorageBuffer("BindPose", mesh.Source->GetBindPoseBuffer());
+                set->SetStorageBuffer("Skin", mesh.Source->GetSkinBuffer());
+                set->SetStorageBuffer("Joints", frame.Joints.get());
+                set->SetStorageBuffer("Vertices", mesh.Output);
+                set->Update(commandBuffer);
+
+                uint32_t params[4] = { mesh.VertexCount, mesh.JointOffset, mesh.JointCount, 0 };
+                memcpy(pushConstants[0].data, params, sizeof(params));
+                m_SkinningShader->BindPushConstants(commandBuffer, pipeline.get());
+
+                Renderer::BindDescriptorSets(pipeline.get(), commandBuffer, 0, &set, 1);
+                Renderer::GetRenderer()->Dispatch(commandBuffer, (mesh.VertexCount + workGroupSize - 1) / workGroupSize, 1, 1);
+            }
+
+            pipeline->End(commandBuffer);
+
+            // The skinned vertices are read as vertex input by the passes after this one
+            Renderer::GetRenderer()->ComputeBarrier(commandBuffer);
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#pragma once
+#include "Graphics/RHI/Definitions.h"
+#include <glm/mat4x4.hpp>
+
+namespace Lumos
+{
+    namespace Graphics
+    {
+        class Shader;
+        class StorageBuffer;
+        class VertexBuffer;
+        class DescriptorSet;
+        class CommandBuffer;
+        class Mesh;
+
+        // Skins meshes on the GPU. Animation instances add their joint matrices to one palette per frame and queue
+        // each skinned mesh against the vertex buffer it should be written to, a compute pass then skins every queued
+        // mesh before the depth, shadow and forward passes draw the results
+        class LUMOS_EXPORT GPUSkinning
+        {
+        public:
+            GPUSkinning();
+            ~GPUSkinning();
+
+            bool IsSupported() const;
+
+            void Begin();
+
+            // Returns the offset of the first matrix in the frame's palette
+            uint32_t AddPalette(const std::vector<glm::mat4>& jointMatrices);
+            void AddMesh(Mesh* source, VertexBuffer* output, uint32_t jointOffset, uint32_t jointCount);
+
+            void Dispatch(CommandBuffer* commandBuffer);
+
+            uint32_t GetMeshCount() const { return uint32_t(m_Meshes.size()); }
+            uint32_t GetJointCount() const { return uint32_t(m_Joints.size()); }
+
+        private:
+            struct SkinningMesh
+            {
+                Mesh* Source;
+                VertexBuffer* Output;
+                uint32_t VertexCount;
+                uint32_t JointOffset;
+                uint32_t JointCount;
+            };
+
+            struct FrameBuffers
+            {
+                UniquePtr<StorageBuffer> Joints;
+                uint32_t Capacity = 0;
+            };
+
+            SharedPtr<Shader> m_SkinningShader;
+
+            // One per mesh skinned in a frame, each set is buffered per frame in flight
+            std::vector<SharedPtr<DescriptorSet>> m_DescriptorSets;
+
+            std::vector<FrameBuffers> m_Frames;
+            std::vector<glm::mat4> m_Joints;
+            std::vector<SkinningMesh> m_Meshes;
+        };
+    }
+}
@@ -90,6 +90,9 @@ namespace Lumos
             descriptorDesc.shader      = m_Shader.get();
             m_DescriptorSet.resize(1);
             m_DescriptorSet[0] = SharedPtr<Graphics::DescriptorSet>(Graphics::DescriptorSet::Create(descriptorDesc));
+            m_MVPUniform       = m_DescriptorSet[0]->GetUniformHandle("UBO", "u_MVP");
+            m_ViewUniform      = m_DescriptorSet[0]->GetUniformHandle("UBO", "view");
+            m_ProjUniform      = m_DescriptorSet[0]->GetUniformHandle("UBO", "proj");
             UpdateUniformBuffer();
 
             m_CurrentDescriptorSets.resize(1);
@@ -135,9 +138,9 @@ namespace Lumos
             test.maxDistance = m_MaxDistance;
 
             auto invViewProj = proj * view;
-            m_DescriptorSet[0]->SetUniform("UBO", "u_MVP", &invViewProj);
-            m_DescriptorSet[0]->SetUniform("UBO", "view", &view);
-            m_DescriptorSet[0]->SetUniform("UBO", "proj", &proj);
+            m_DescriptorSet[0]->SetUniform(m_MVPUniform, &invViewProj);
+            m_DescriptorSet[0]->SetUniform(m_ViewUniform, &view);
+            m_DescriptorSet[0]->SetUniform(m_ProjUniform, &proj);
 
             m_DescriptorSet[0]->SetUniformBufferData("UniformBuffer", &test);
             m_DescriptorSet[0]->Update();
@@ -183,6 +186,8 @@ namespace Lumos
             pipelineDesc.transparencyEnabled = true;
             pipelineDesc.blendMode           = BlendMode::SrcAlphaOneMinusSrcAlpha;
 
+            // The scene's depth is smaller than the target while rendering at a reduced resolution
+            if(!m_RenderTexture || (m_DepthTexture && m_DepthTexture->GetWidth() == m_RenderTexture->GetWidth() && m_DepthTexture->GetHeight() == m_RenderTexture->GetHeight()))
             {
                 pipelineDesc.depthTarget = reinterpret_cast<Texture*>(m_DepthTexture); // reinterpret_cast<Texture*>(Application::Get().GetRenderPasses()->GetDepthTexture());
             }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "IRenderer.h"
+#include "Graphics/RHI/DescriptorSet.h"
 
 namespace Lumos
 {
@@ -48,6 +49,10 @@ namespace Lumos
             uint32_t m_CurrentBufferID = 0;
             Mesh* m_Quad;
 
+            UniformHandle m_MVPUniform;
+            UniformHandle m_ViewUniform;
+            UniformHandle m_ProjUniform;
+
             float m_GridRes     = 1.0f;
             float m_GridSize    = 1.0f;
             float m_MaxDistance = 10000.0f;
@@ -0,0 +1,325 @@
+#include "Precompiled.h"
+#include "OcclusionCuller.h"
+#include "Graphics/Mesh.h"
+#include "Core/JobSystem.h"
+#include "Maths/BoundingBox.h"
+#include "Maths/MathsUtilities.h"
+
+#include <glm/vec4.hpp>
+#include <cmath>
+
+namespace Lumos
+{
+    namespace Graphics
+    {
+        OcclusionCuller::OcclusionCuller(uint32_t width, uint32_t height)
+            : m_Width(width)
+            , m_Height(height)
+            , m_ViewProj(1.0f)
+        {
+            LUMOS_ASSERT((width & (width - 1)) == 0 && (height & (height - 1)) == 0, "Occlusion buffer size must be a power of two");
+
+            uint32_t levelWidth  = width;
+            uint32_t levelHeight = height;
+            while(true)
+            {
+                m_Levels.emplace_back(levelWidth * levelHeight, 1.0f);
+                if(levelWidth == 1 && levelHeight == 1)
+                    break;
+
+                levelWidth  = Maths::Max(levelWidth / 2, 1u);
+                levelHeight = Maths::Max(levelHeight / 2, 1u);
+            }
+        }
+
+        OcclusionCuller::~OcclusionCuller()
+        {
+        }
+
+        void OcclusionCuller::Begin(const glm::mat4& viewProj)
+        {
+            m_ViewProj = viewProj;
+            m_Occluders.clear();
+            m_Triangles.clear();
+            m_Empty = true;
+        }
+
+        void OcclusionCuller::AddOccluder(const Vertex* vertices, const uint32_t* indices, uint32_t indexCount, const glm::mat4& transform)
+        {
+            Occluder occluder;
+            occluder.Vertices      = vertices;
+            occluder.Indices       = indices;
+            occluder.IndexCount    = indexCount - indexCount % 3;
+            occluder.FirstTriangle = 0;
+            occluder.Transform     = m_ViewProj * transform;
+            m_Occluders.push_back(occluder);
+        }
+
+        void OcclusionCuller::Rasterise()
+        {
+            LUMOS_PROFILE_FUNCTION();
+
+            std::fill(m_Levels[0].begin(), m_Levels[0].end(), 1.0f);
+
+            uint32_t triangleCount = 0;
+            for(auto& occluder : m_Occluders)
+            {
+                occluder.FirstTriangle = triangleCount;
+                triangleCount += occluder.IndexCount / 3;
+            }
+
+            m_Triangles.resize(triangleCount);
+            m_Empty = triangleCount == 0;
+            if(m_Empty)
+                return;
+
+            // Each occluder writes its own range of triangles, then each band of rows is only written by one job
+            {
+                System::JobSystem::Context ctx;
+                System::JobSystem::Dispatch(ctx, uint32_t(m_Occluders.size()), 1, [this](JobDispatchArgs args)
+                                            { SetupTriangles(m_Occluders[args.jobIndex]); });
+                System::JobSystem::Wait(ctx);
+            }
+
+            {
+                uint32_t bandCount = (m_Height + m_BandHeight - 1) / m_BandHeight;
+
+                System::JobSystem::Context ctx;
+                System::JobSystem::Dispatch(ctx, bandCount, 1, [this](JobDispatchArgs args)
+                                            { RasteriseBand(args.jobIndex); });
+                System::JobSystem::Wait(ctx);
+            }
+
+            BuildPyramid();
+        }
+
+        void OcclusionCuller::SetupTriangles(const Occluder& occluder)
+        {
+            LUMOS_PROFILE_FUNCTION_LOW();
+
+            glm::vec2 screenSize = glm::vec2(float(m_Width), float(m_Height));
+
+            for(uint32_t i = 0; i < occluder.IndexCount; i += 3)
+            {
+                ScreenTriangle& triangle = m_Triangles[occluder.FirstTriangle + i / 3];
+                triangle.Valid           = false;
+
+                bool clipped = false;
+                for(uint32_t corner = 0; corner < 3; corner++)
+                {
+                    glm::vec4 clip = occluder.Transform * glm::vec4(occluder.Vertices[occluder.Indices[i + corner]].Position, 1.0f);
+
+                    // Triangles crossing the near or far plane are left out rather than clipped, they only stop being occluders
+                    if(clip.w <= 1e-5f || clip.z < 0.0f || clip.z > clip.w)
+                    {
+                        clipped = true;
+                        break;
+                    }
+
+                    glm::vec3 ndc              = glm::vec3(clip) / clip.w;
+                    triangle.Positions[corner] = glm::vec3((glm::vec2(ndc) * 0.5f + 0.5f) * screenSize, ndc.z);
+                }
+
+                if(clipped)
+                    continue;
+
+                const glm::vec3& a = triangle.Positions[0];
+                const glm::vec3& b = triangle.Positions[1];
+                const glm::vec3& c = triangle.Positions[2];
+
+                float minX = Maths::Min(a.x, Maths::Min(b.x, c.x));
+                float maxX = Maths::Max(a.x, Maths::Max(b.x, c.x));
+                float minY = Maths::Min(a.y, Maths::Min(b.y, c.y));
+                float maxY = Maths::Max(a.y, Maths::Max(b.y, c.y));
+
+                if(maxX < 0.0f || maxY < 0.0f || minX >= screenSize.x || minY >= screenSize.y)
+                    continue;
+
+                float area = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+                if(std::abs(area) < 1e-6f)
+                    continue;
+
+                // Both windings occlude, store counter clockwise so inside is where every edge function is positive
+                if(area < 0.0f)
+                    std::swap(triangle.Positions[1], triangle.Positions[2]);
+
+                triangle.MinY  = Maths::Max(int32_t(std::floor(minY)), 0);
+                triangle.MaxY  = Maths::Min(int32_t(std::floor(maxY)), int32_t(m_Height) - 1);
+                triangle.Valid = true;
+            }
+        }
+
+        void OcclusionCuller::RasteriseBand(uint32_t band)
+        {
+            LUMOS_PROFILE_FUNCTION_LOW();
+
+            int32_t bandMinY = int32_t(band * m_BandHeight);
+            int32_t bandMaxY = Maths::Min(bandMinY + int32_t(m_BandHeight), int32_t(m_Height)) - 1;
+
+            for(const auto& triangle : m_Triangles)
+            {
+                if(!triangle.Valid || triangle.MaxY < bandMinY || triangle.MinY > bandMaxY)
+                    continue;
+
+                RasteriseTriangle(triangle, Maths::Max(triangle.MinY, bandMinY), Maths::Min(triangle.MaxY, bandMaxY));
+            }
+        }
+
+        void OcclusionCuller::RasteriseTriangle(const ScreenTriangle& triangle, int32_t minY, int32_t maxY)
+        {
+            const glm::vec3& a = triangle.Positions[0];
+            const glm::vec3& b = triangle.Positions[1];
+            const glm::vec3& c = triangle.Positions[2];
+
+            float area    = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+            float invArea = 1.0f / area;
+
+            // Edge functions, each positive inside and zero on the edge opposite one vertex
+            glm::vec3 stepX = glm::vec3(b.y - c.y, c.y - a.y, a.y - b.y);
+            glm::vec3 stepY = glm::vec3(c.x - b.x, a.x - c.x, b.x - a.x);
+
+            // A pixel is only covered when all of it is inside, which moves each edge in by half the pixel's extent along it
+            glm::vec3 inset = (glm::abs(stepX) + glm::abs(stepY)) * 0.5f;
+
+            // Depth is linear in screen space. The farthest depth over the pixel is stored so the occluder never claims
+            // to be in front of something it is not
+            glm::vec3 depths   = glm::vec3(a.z, b.z, c.z) * invArea;
+            float depthStepX   = glm::dot(stepX, depths);
+            float depthStepY   = glm::dot(stepY, depths);
+            float depthPadding = (std::abs(depthStepX) + std::abs(depthStepY)) * 0.5f;
+
+            float minXf  = Maths::Min(a.x, Maths::Min(b.x, c.x));
+            float maxXf  = Maths::Max(a.x, Maths::Max(b.x, c.x));
+            int32_t minX = Maths::Max(int32_t(std::floor(minXf)), 0);
+            int32_t maxX = Maths::Min(int32_t(std::floor(maxXf)), int32_t(m_Width) - 1);
+
+            const glm::vec4 laneOffsets = glm::vec4(0.0f, 1.0f, 2.0f, 3.0f);
+            float* depthBuffer          = m_Levels[0].data();
+
+            for(int32_t y = minY; y <= maxY; y++)
+            {
+                glm::vec2 p = glm::vec2(float(minX) + 0.5f, float(y) + 0.5f);
+
+                // Edge values at the first pixel of the row
+                float e0 = (c.x - b.x) * (p.y - b.y) - (c.y - b.y) * (p.x - b.x) - inset.x;
+                float e1 = (a.x - c.x) * (p.y - c.y) - (a.y - c.y) * (p.x - c.x) - inset.y;
+                float e2 = (b.x - a.x) * (p.y - a.y) - (b.y - a.y) * (p.x - a.x) - inset.z;
+
+                float* row = depthBuffer + y * m_Width;
+
+                // Four pixels at a time, plain vector maths the compiler can map to SIMD on any target
+                for(int32_t x = minX; x <= maxX; x += 4)
+                {
+                    glm::vec4 offsets = laneOffsets + float(x - minX);
+                    glm::vec4 w0      = e0 + offsets * stepX.x;
+                    glm::vec4 w1      = e1 + offsets * stepX.y;
+                    glm::vec4 w2      = e2 + offsets * stepX.z;
+
+                    glm::bvec4 inside = glm::greaterThanEqual(glm::min(w0, glm::min(w1, w2)), glm::vec4(0.0f));
+                    if(!glm::any(inside))
+                        continue;
+
+                    // Barycentric weights use the edge values before the inset
+                    glm::vec4 depth = (w0 + inset.x) * depths.x + (w1 + inset.y) * depths.y + (w2 + inset.z) * depths.z + depthPadding;
+
+                    for(int32_t lane = 0; lane < 4 && x + lane <= maxX; lane++)
+                    {
+                        if(inside[lane])
+                            row[x + lane] = Maths::Min(row[x + lane], depth[lane]);
+                    }
+                }
+            }
+        }
+
+        void OcclusionCuller::BuildPyramid()
+        {
+            LUMOS_PROFILE_FUNCTION_LOW();
+
+            uint32_t srcWidth  = m_Width;
+            uint32_t srcHeight = m_Height;
+
+            for(size_t level = 1; level < m_Levels.size(); level++)
+            {
+                uint32_t dstWidth  = Maths::Max(srcWidth / 2, 1u);
+                uint32_t dstHeight = Maths::Max(srcHeight / 2, 1u);
+
+                const float* src = m_Levels[level - 1].data();
+                float* dst       = m_Levels[level].data();
+
+                for(uint32_t y = 0; y < dstHeight; y++)
+                {
+                    uint32_t y0 = Maths::Min(y * 2, srcHeight - 1);
+                    uint32_t y1 = Maths::Min(y * 2 + 1, srcHeight - 1);
+
+                    for(uint32_t x = 0; x < dstWidth; x++)
+                    {
+                        uint32_t x0 = Maths::Min(x * 2, srcWidth - 1);
+                        uint32_t x1 = Maths::Min(x * 2 + 1, srcWidth - 1);
+
+                        dst[y * dstWidth + x] = Maths::Max(Maths::Max(src[y0 * srcWidth + x0], src[y0 * srcWidth + x1]), Maths::Max(src[y1 * srcWidth + x0], src[y1 * srcWidth + x1]));
+                    }
+                }
+
+                srcWidth  = dstWidth;
+                srcHeight = dstHeight;
+            }
+        }
+
+        bool OcclusionCuller::IsVisible(const Maths::BoundingBox& worldBounds) const
+        {
+            if(m_Empty)
+                return true;
+
+            glm::vec3 boundsMin = worldBounds.Min();
+            glm::vec3 boundsMax = worldBounds.Max();
+
+            glm::vec2 screenMin = glm::vec2(std::numeric_limits<float>::max());
+            glm::vec2 screenMax = glm::vec2(std::numeric_limits<float>::lowest());
+            float nearestDepth  = std::numeric_limits<float>::max();
+
+            for(int i = 0; i < 8; i++)
+            {
+                glm::vec3 corner = glm::vec3(i & 1 ? boundsMax.x : boundsMin.x, i & 2 ? boundsMax.y : boundsMin.y, i & 4 ? boundsMax.z : boundsMin.z);
+                glm::vec4 clip   = m_ViewProj * glm::vec4(corner, 1.0f);
+
+                // Crossing the near plane, the projection is unbounded
+                if(clip.w <= 1e-5f || clip.z < 0.0f)
+                    return true;
+
+                glm::vec3 ndc = glm::vec3(clip) / clip.w;
+                glm::vec2 uv  = glm::vec2(ndc) * 0.5f + 0.5f;
+                screenMin     = glm::min(screenMin, uv);
+                screenMax     = glm::max(screenMax, uv);
+                nearestDepth  = Maths::Min(nearestDepth, ndc.z);
+            }
+
+            // Off screen boxes are left to frustum culling
+            if(screenMax.x < 0.0f || screenMax.y < 0.0f || screenMin.x > 1.0f || screenMin.y > 1.0f)
+                return true;
+
+            int32_t x0 = Maths::Max(int32_t(std::floor(screenMin.x * m_Width)), 0);
+            int32_t y0 = Maths::Max(int32_t(std::floor(screenMin.y * m_Height)), 0);
+            int32_t x1 = Maths::Min(int32_t(std::floor(screenMax.x * m_Width)), int32_t(m_Width) - 1);
+            int32_t y1 = Maths::Min(int32_t(std::floor(screenMax.y * m_Height)), int32_t(m_Height) - 1);
+
+            // The finest level where the box covers at most four texels a side
+            uint32_t level = 0;
+            while(level + 1 < m_Levels.size() && ((x1 >> level) - (x0 >> level) >= 4 || (y1 >> level) - (y0 >> level) >= 4))
+                level++;
+
+            uint32_t levelWidth = Maths::Max(m_Width >> level, 1u);
+            const float* depth  = m_Levels[level].data();
+
+            for(int32_t y = y0 >> level; y <= (y1 >> level); y++)
+            {
+                for(int32_t x = x0 >> level; x <= (x1 >> level); x++)
+                {
+                    if(depth[y * levelWidth + x] >= nearestDepth)
+                        return true;
+                }
+            }
+
+            return false;
+        }
+    }
+}
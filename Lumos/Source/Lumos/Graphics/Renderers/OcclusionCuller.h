@@ -0,0 +1,81 @@
+#pragma once
+#include <glm/mat4x4.hpp>
+
+namespace Lumos
+{
+    namespace Maths
+    {
+        class BoundingBox;
+    }
+
+    namespace Graphics
+    {
+        struct Vertex;
+
+        // Software occlusion culling for one view. Occluders are rasterised into a small depth buffer on job threads,
+        // then reduced into a pyramid keeping the farthest depth of each block. A box is hidden when its nearest point
+        // is behind every texel of the pyramid it covers. Occluders only cover pixels they fully contain and store
+        // their farthest depth over the pixel, so a visible box is never reported hidden.
+        // Only depends on the maths and job system so it can run without a renderer
+        class LUMOS_EXPORT OcclusionCuller
+        {
+        public:
+            // Sizes must be powers of two
+            OcclusionCuller(uint32_t width = 256, uint32_t height = 128);
+            ~OcclusionCuller();
+
+            // Drops last frame's occluders. Depth is expected in 0..1
+            void Begin(const glm::mat4& viewProj);
+
+            // The data is read in Rasterise and must live until then. Indices are read as triangle lists
+            void AddOccluder(const Vertex* vertices, const uint32_t* indices, uint32_t indexCount, const glm::mat4& transform);
+
+            void Rasterise();
+
+            bool IsVisible(const Maths::BoundingBox& worldBounds) const;
+
+            uint32_t GetWidth() const { return m_Width; }
+            uint32_t GetHeight() const { return m_Height; }
+            uint32_t GetOccluderCount() const { return uint32_t(m_Occluders.size()); }
+            uint32_t GetTriangleCount() const { return uint32_t(m_Triangles.size()); }
+
+            // Level 0 is the rasterised depth, rows from the bottom of the view
+            const float* GetDepth(uint32_t level = 0) const { return m_Levels[level].data(); }
+            uint32_t GetLevelCount() const { return uint32_t(m_Levels.size()); }
+
+        private:
+            struct Occluder
+            {
+                const Vertex* Vertices;
+                const uint32_t* Indices;
+                uint32_t IndexCount;
+                uint32_t FirstTriangle;
+                glm::mat4 Transform;
+            };
+
+            // Screen space in pixels, z is depth
+            struct ScreenTriangle
+            {
+                glm::vec3 Positions[3];
+                int32_t MinY;
+                int32_t MaxY;
+                bool Valid;
+            };
+
+            void SetupTriangles(const Occluder& occluder);
+            void RasteriseBand(uint32_t band);
+            void RasteriseTriangle(const ScreenTriangle& triangle, int32_t minY, int32_t maxY);
+            void BuildPyramid();
+
+            uint32_t m_Width      = 0;
+            uint32_t m_Height     = 0;
+            uint32_t m_BandHeight = 16;
+
+            glm::mat4 m_ViewProj;
+            std::vector<Occluder> m_Occluders;
+            std::vector<ScreenTriangle> m_Triangles;
+            std::vector<std::vector<float>> m_Levels;
+            bool m_Empty = true;
+        };
+    }
+}
@@ -19,6 +19,9 @@ namespace Lumos
             glm::mat4 transform;
             glm::mat4 textureMatrix;
             bool animated = false;
+
+            // Draw written by the GPU culling pass, ~0u when drawn directly
+            uint32_t indirectIndex = ~0u;
         };
     }
 }
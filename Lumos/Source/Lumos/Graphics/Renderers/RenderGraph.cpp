@@ -0,0 +1,279 @@
+#include "Precompiled.h"
+#include "RenderGraph.h"
+#include "Graphics/RHI/Texture.h"
+#include "Graphics/RHI/Renderer.h"
+#include "Maths/MathsUtilities.h"
+#include "ImGui/ImGuiUtilities.h"
+#include <imgui/imgui.h>
+
+namespace Lumos
+{
+    namespace Graphics
+    {
+        RenderGraph::PassBuilder& RenderGraph::PassBuilder::Read(RenderGraphResource resource)
+        {
+            if(m_Graph && resource != RenderGraphNullResource)
+                m_Graph->m_Passes[m_Pass].Reads.push_back(resource);
+            return *this;
+        }
+
+        RenderGraph::PassBuilder& RenderGraph::PassBuilder::Write(RenderGraphResource resource)
+        {
+            if(m_Graph && resource != RenderGraphNullResource)
+                m_Graph->m_Passes[m_Pass].Writes.push_back(resource);
+            return *this;
+        }
+
+        RenderGraph::PassBuilder& RenderGraph::PassBuilder::WriteStorage(RenderGraphResource resource)
+        {
+            if(m_Graph && resource != RenderGraphNullResource)
+                m_Graph->m_Passes[m_Pass].StorageWrites.push_back(resource);
+            return *this;
+        }
+
+        RenderGraph::PassBuilder& RenderGraph::PassBuilder::SideEffect()
+        {
+            if(m_Graph)
+                m_Graph->m_Passes[m_Pass].SideEffect = true;
+            return *this;
+        }
+
+        RenderGraph::RenderGraph(uint32_t retainFrames)
+            : m_RetainFrames(retainFrames)
+        {
+        }
+
+        RenderGraph::~RenderGraph()
+        {
+            for(auto& pooled : m_Pool)
+                delete pooled.Texture;
+        }
+
+        RenderGraphResource RenderGraph::Import(const char* name, Texture* texture)
+        {
+            Resource resource;
+            resource.Name     = name;
+            resource.Imported = texture;
+            m_Resources.push_back(resource);
+            return RenderGraphResource(m_Resources.size() - 1);
+        }
+
+        RenderGraphResource RenderGraph::Create(const char* name, const RenderGraphTextureDesc& desc)
+        {
+            Resource resource;
+            resource.Name      = name;
+            resource.Desc      = desc;
+            resource.Transient = true;
+            m_Resources.push_back(resource);
+            return RenderGraphResource(m_Resources.size() - 1);
+        }
+
+        RenderGraph::PassBuilder RenderGraph::AddPass(const char* name, const std::function<void()>& execute)
+        {
+            Pass pass;
+            pass.Name    = name;
+            pass.Execute = execute;
+            m_Passes.push_back(pass);
+            return PassBuilder(this, uint32_t(m_Passes.size() - 1));
+        }
+
+        void RenderGraph::MarkOutput(RenderGraphResource resource)
+        {
+            m_Resources[resource].Output = true;
+        }
+
+        bool RenderGraph::WritesResource(const Pass& pass, RenderGraphResource resource) const
+        {
+            return std::find(pass.Writes.begin(), pass.Writes.end(), resource) != pass.Writes.end()
+                || std::find(pass.StorageWrites.begin(), pass.StorageWrites.end(), resource) != pass.StorageWrites.end();
+        }
+
+        void RenderGraph::Compile()
+        {
+            LUMOS_PROFILE_FUNCTION();
+
+            // Walk back from the outputs. A pass is needed if it writes something still to be read, its reads are
+            // then needed in turn. A pass overwriting a resource without reading it ends the need for earlier writes
+            std::vector<bool> live(m_Resources.size(), false);
+            for(size_t i = 0; i < m_Resources.size(); i++)
+                live[i] = m_Resources[i].Output;
+
+            m_CulledPasses = 0;
+            for(size_t i = m_Passes.size(); i-- > 0;)
+            {
+                Pass& pass = m_Passes[i];
+
+                bool needed = pass.SideEffect;
+                for(size_t r = 0; r < live.size() && !needed; r++)
+                    needed = live[r] && WritesResource(pass, RenderGraphResource(r));
+
+                pass.Culled = !needed;
+                if(pass.Culled)
+                {
+                    m_CulledPasses++;
+                    continue;
+                }
+
+                for(auto resource : pass.Writes)
+                    live[resource] = false;
+                for(auto resource : pass.StorageWrites)
+                    live[resource] = false;
+                for(auto resource : pass.Reads)
+                    live[resource] = true;
+            }
+
+            // Lifetimes of transients over the passes that survived
+            for(uint32_t i = 0; i < uint32_t(m_Passes.size()); i++)
+            {
+                const Pass& pass = m_Passes[i];
+                if(pass.Culled)
+                    continue;
+
+                auto use = [&](RenderGraphResource resource)
+                {
+                    Resource& res = m_Resources[resource];
+                    res.FirstPass = Maths::Min(res.FirstPass, i);
+                    res.LastPass  = Maths::Max(res.LastPass, i);
+                };
+
+                for(auto resource : pass.Reads)
+                    use(resource);
+                for(auto resource : pass.Writes)
+                    use(resource);
+                for(auto resource : pass.StorageWrites)
+                    use(resource);
+            }
+
+            // Assign pooled textures in pass order, a texture is handed back once its last user has run so later
+            // transients with the same description alias it
+            m_LiveTransients = 0;
+            for(uint32_t i = 0; i < uint32_t(m_Passes.size()); i++)
+            {
+                if(m_Passes[i].Culled)
+                    continue;
+
+                for(auto& resource : m_Resources)
+                {
+                    if(resource.Transient && resource.FirstPass == i)
+                    {
+                        resource.Physical = AcquireTexture(resource.Desc);
+                        m_LiveTransients++;
+                    }
+                }
+
+                for(auto& resource : m_Resources)
+                {
+                    if(resource.Transient && resource.Physical >= 0 && resource.LastPass == i)
+                        m_Pool[resource.Physical].InUse = false;
+                }
+            }
+
+            m_Compiled = true;
+        }
+
+        int32_t RenderGraph::AcquireTexture(const RenderGraphTextureDesc& desc)
+        {
+            for(size_t i = 0; i < m_Pool.size(); i++)
+            {
+                PooledTexture& pooled = m_Pool[i];
+                if(!pooled.InUse && pooled.Desc == desc)
+                {
+                    pooled.InUse         = true;
+                    pooled.LastUsedFrame = m_Frame;
+                    return int32_t(i);
+                }
+            }
+
+            TextureDesc textureDesc;
+            textureDesc.format          = desc.Format;
+            textureDesc.flags           = uint16_t(desc.Flags);
+            textureDesc.minFilter       = desc.Filter;
+            textureDesc.magFilter       = desc.Filter;
+            textureDesc.wrap            = desc.Wrap;
+            textureDesc.generateMipMaps = false;
+
+            PooledTexture pooled;
+            pooled.Desc          = desc;
+            pooled.Texture       = Texture2D::Create(textureDesc, desc.Width, desc.Height);
+            pooled.LastUsedFrame = m_Frame;
+            pooled.InUse         = true;
+            m_Pool.push_back(pooled);
+
+            return int32_t(m_Pool.size() - 1);
+        }
+
+        void RenderGraph::Execute(CommandBuffer* commandBuffer)
+        {
+            LUMOS_PROFILE_FUNCTION();
+
+            if(!m_Compiled)
+                Compile();
+
+            for(auto& pass : m_Passes)
+            {
+                if(pass.Culled)
+                    continue;
+
+                // Attachments are transitioned when their render pass begins, only sampled and storage use is handled here
+                for(auto resource : pass.Reads)
+                {
+                    Texture* texture = GetTexture(resource);
+                    if(texture && !WritesResource(pass, resource))
+                        Renderer::GetRenderer()->TransitionTexture(texture, TextureAccess::SAMPLED, commandBuffer);
+                }
+
+                for(auto resource : pass.StorageWrites)
+                {
+                    if(Texture* texture = GetTexture(resource))
+                        Renderer::GetRenderer()->TransitionTexture(texture, TextureAccess::STORAGE, commandBuffer);
+                }
+
+                pass.Execute();
+            }
+
+            Reset();
+        }
+
+        Texture* RenderGraph::GetTexture(RenderGraphResource resource) const
+        {
+            if(resource == RenderGraphNullResource)
+                return nullptr;
+
+            const Resource& res = m_Resources[resource];
+            if(!res.Transient)
+                return res.Imported;
+
+            return res.Physical >= 0 ? m_Pool[res.Physical].Texture : nullptr;
+        }
+
+        void RenderGraph::Reset()
+        {
+            m_Resources.clear();
+            m_Passes.clear();
+            m_Compiled = false;
+
+            // Textures for disabled effects or an old resolution are released once they have gone unused for a while
+            for(size_t i = 0; i < m_Pool.size();)
+            {
+                if(m_Frame - m_Pool[i].LastUsedFrame > m_RetainFrames)
+                {
+                    delete m_Pool[i].Texture;
+                    m_Pool.erase(m_Pool.begin() + i);
+                }
+                else
+                    i++;
+            }
+
+            m_Frame++;
+        }
+
+        void RenderGraph::OnImGui()
+        {
+            ImGuiUtilities::Property("Culled Passes", (int&)m_CulledPasses, ImGuiUtilities::PropertyFlag::ReadOnly);
+            ImGuiUtilities::Property("Transient Textures", (int&)m_LiveTransients, ImGuiUtilities::PropertyFlag::ReadOnly);
+
+            int pooled = int(m_Pool.size());
+            ImGuiUtilities::Property("Pooled Textures", pooled, ImGuiUtilities::PropertyFlag::ReadOnly);
+        }
+    }
+}
@@ -0,0 +1,133 @@
+#pragma once
+#include "Graphics/RHI/Definitions.h"
+#include <functional>
+
+namespace Lumos
+{
+    namespace Graphics
+    {
+        class Texture;
+        class Texture2D;
+        class CommandBuffer;
+
+        typedef uint32_t RenderGraphResource;
+        static const RenderGraphResource RenderGraphNullResource = ~0u;
+
+        struct RenderGraphTextureDesc
+        {
+            uint32_t Width       = 0;
+            uint32_t Height      = 0;
+            RHIFormat Format     = RHIFormat::R8G8B8A8_Unorm;
+            uint32_t Flags       = TextureFlags::Texture_RenderTarget;
+            TextureFilter Filter = TextureFilter::LINEAR;
+            TextureWrap Wrap     = TextureWrap::CLAMP_TO_EDGE;
+
+            bool operator==(const RenderGraphTextureDesc& other) const
+            {
+                return Width == other.Width && Height == other.Height && Format == other.Format && Flags == other.Flags && Filter == other.Filter && Wrap == other.Wrap;
+            }
+        };
+
+        // Rebuilt every frame. Passes declare the textures they read and write, passes whose writes nothing reads
+        // are culled and transient textures only exist between their first and last use. Transients come from a
+        // pool that outlives the graph, so a texture freed by one pass is reused by a later one with the same
+        // description and textures nothing asked for in a while are released. Before each pass the textures it
+        // reads are transitioned for sampling and its storage writes for compute
+        class LUMOS_EXPORT RenderGraph
+        {
+        public:
+            // A builder without a graph ignores everything, for passes that were not added
+            class PassBuilder
+            {
+            public:
+                PassBuilder(RenderGraph* graph, uint32_t pass)
+                    : m_Graph(graph)
+                    , m_Pass(pass)
+                {
+                }
+
+                // A pass drawing over existing contents reads and writes the same resource
+                PassBuilder& Read(RenderGraphResource resource);
+                PassBuilder& Write(RenderGraphResource resource);
+                PassBuilder& WriteStorage(RenderGraphResource resource);
+
+                // Never culled, for passes with effects outside the graph
+                PassBuilder& SideEffect();
+
+            private:
+                RenderGraph* m_Graph;
+                uint32_t m_Pass;
+            };
+
+            RenderGraph(uint32_t retainFrames = 8);
+            ~RenderGraph();
+
+            RenderGraphResource Import(const char* name, Texture* texture);
+            RenderGraphResource Create(const char* name, const RenderGraphTextureDesc& desc);
+            PassBuilder AddPass(const char* name, const std::function<void()>& execute);
+
+            // Keeps the passes writing this resource alive, for textures read outside the graph
+            void MarkOutput(RenderGraphResource resource);
+
+            void Compile();
+            void Execute(CommandBuffer* commandBuffer);
+
+            // Only valid while executing, null for resources no live pass uses
+            Texture* GetTexture(RenderGraphResource resource) const;
+
+            template <typename T>
+            T* GetTexture(RenderGraphResource resource) const
+            {
+                return static_cast<T*>(GetTexture(resource));
+            }
+
+            void OnImGui();
+
+        private:
+            struct Resource
+            {
+                const char* Name = nullptr;
+                RenderGraphTextureDesc Desc;
+                Texture* Imported  = nullptr;
+                int32_t Physical   = -1;
+                uint32_t FirstPass = ~0u;
+                uint32_t LastPass  = 0;
+                bool Transient     = false;
+                bool Output        = false;
+            };
+
+            struct Pass
+            {
+                const char* Name = nullptr;
+                std::function<void()> Execute;
+                std::vector<RenderGraphResource> Reads;
+                std::vector<RenderGraphResource> Writes;
+                std::vector<RenderGraphResource> StorageWrites;
+                bool SideEffect = false;
+                bool Culled     = false;
+            };
+
+            struct PooledTexture
+            {
+                RenderGraphTextureDesc Desc;
+                Texture2D* Texture     = nullptr;
+                uint64_t LastUsedFrame = 0;
+                bool InUse             = false;
+            };
+
+            bool WritesResource(const Pass& pass, RenderGraphResource resource) const;
+            int32_t AcquireTexture(const RenderGraphTextureDesc& desc);
+            void Reset();
+
+            std::vector<Resource> m_Resources;
+            std::vector<Pass> m_Passes;
+            std::vector<PooledTexture> m_Pool;
+
+            uint64_t m_Frame          = 0;
+            uint32_t m_RetainFrames   = 8;
+            uint32_t m_CulledPasses   = 0;
+            uint32_t m_LiveTransients = 0;
+            bool m_Compiled           = false;
+        };
+    }
+}
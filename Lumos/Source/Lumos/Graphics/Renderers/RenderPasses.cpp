@@ -48,6 +48,53 @@ static const uint32_t RENDERER_LINE_BUFFER_SIZE = RENDERER_LINE_SIZE * MaxLineVe
 
 namespace Lumos::Graphics
 {
+    // Low discrepancy sequence in 0..1, used for the sub pixel jitter
+    static float Halton(uint32_t index, uint32_t base)
+    {
+        float result   = 0.0f;
+        float fraction = 1.0f;
+        while(index > 0)
+        {
+            fraction /= float(base);
+            result += fraction * float(index % base);
+            index /= base;
+        }
+        return result;
+    }
+
+    // Hemisphere kernel of the SSAO passes, with samples closer to the origin at the start
+    static glm::vec4* SSAOKernel()
+    {
+        static glm::vec4 samples[64];
+        static bool init = false;
+
+        if(!init)
+        {
+            for(uint32_t i = 0; i < 64; ++i)
+            {
+                glm::vec3 sample(Random32::Rand(-0.9f, 0.9f), Random32::Rand(-0.9f, 0.9f), Random32::Rand(0.0f, 1.0f));
+                sample = glm::normalize(sample);      // Snap to surface of hemisphere
+                sample *= Random32::Rand(0.0f, 1.0f); // Space out linearly
+                float scale = (float)i / (float)64;
+                scale       = Maths::Lerp(0.1f, 1.0f, scale * scale); // Bring distribution of samples closer to origin
+                samples[i]  = glm::vec4(sample * scale, 0.0f);
+            }
+            init = true;
+        }
+
+        return samples;
+    }
+
+    // Render resolution divisor and sample count of each SSAO quality
+    struct SSAOPreset
+    {
+        uint32_t Divisor;
+        int32_t SampleCount;
+    };
+
+    static const SSAOPreset SSAOPresets[]     = { { 4, 16 }, { 2, 32 }, { 2, 64 } };
+    static const uint32_t BloomPresetLevels[] = { 4, 5, 6 };
+
     RenderPasses::RenderPasses(uint32_t width, uint32_t height)
     {
         LUMOS_PROFILE_FUNCTION();
@@ -62,8 +109,26 @@ namespace Lumos::Graphics
         mainRenderTargetDesc.minFilter       = TextureFilter::LINEAR;
         mainRenderTargetDesc.magFilter       = TextureFilter::LINEAR;
         mainRenderTargetDesc.generateMipMaps = false;
-        m_MainTexture                        = Graphics::Texture2D::Create(mainRenderTargetDesc, width, height);
-        m_PostProcessTexture1                = Graphics::Texture2D::Create(mainRenderTargetDesc, width, height);
+        m_SceneTexture                       = Graphics::Texture2D::Create(mainRenderTargetDesc, width, height);
+        m_MainTexture                        = m_SceneTexture;
+        m_DisplayWidth                       = width;
+        m_DisplayHeight                      = height;
+
+        // Upscaled output, this frame's is the next frame's history
+        for(auto& history : m_TemporalHistory)
+            history = Graphics::Texture2D::Create(mainRenderTargetDesc, width, height);
+
+        // Post processing, bloom and SSAO targets are transients of the render graph
+        m_RenderGraph = CreateUniquePtr<RenderGraph>();
+
+        m_GPUCuller   = CreateUniquePtr<GPUCuller>();
+        m_GPUSkinning = CreateUniquePtr<GPUSkinning>();
+        AnimationInstance::SetCPUSkinning(!m_GPUSkinning->IsSupported());
+
+        // Camera then one per cascade, cascades are square
+        m_OcclusionCullers.push_back(CreateUniquePtr<OcclusionCuller>(256, 128));
+        for(uint32_t i = 0; i < SHADOWMAP_MAX; i++)
+            m_OcclusionCullers.push_back(CreateUniquePtr<OcclusionCuller>(128, 128));
 
         // Setup shadow pass data
         m_ShadowData.m_ShadowTex             = nullptr;
@@ -125,15 +190,6 @@ namespace Lumos::Graphics
         noiseTextureDesc.anisotropicFiltering = false;
         noiseTextureDesc.flags                = 0;
         m_NoiseTexture                        = Graphics::Texture2D::CreateFromSource(SSAO_NOISE_DIM, SSAO_NOISE_DIM, (void*)noiseData.data(), noiseTextureDesc);
-        noiseTextureDesc.flags                = TextureFlags::Texture_RenderTarget;
-        noiseTextureDesc.wrap                 = TextureWrap::CLAMP_TO_EDGE;
-
-        noiseTextureDesc.minFilter = TextureFilter::LINEAR;
-        noiseTextureDesc.magFilter = TextureFilter::LINEAR;
-        m_NormalTexture            = Graphics::Texture2D::Create(noiseTextureDesc, width, height);
-
-        m_SSAOTexture  = Graphics::Texture2D::Create(noiseTextureDesc, width / 2, height / 2);
-        m_SSAOTexture1 = Graphics::Texture2D::Create(noiseTextureDesc, width / 2, height / 2);
 
         switch(Graphics::GraphicsContext::GetRenderAPI())
         {
@@ -187,6 +243,30 @@ namespace Lumos::Graphics
         descriptorDesc.layoutIndex       = 2;
         m_ForwardData.m_DescriptorSet[2] = SharedPtr<Graphics::DescriptorSet>(Graphics::DescriptorSet::Create(descriptorDesc));
 
+        {
+            auto lightSet                 = m_ForwardData.m_DescriptorSet[2].get();
+            auto& lightUniforms           = m_ForwardData.m_LightUniforms;
+            lightUniforms.Lights          = lightSet->GetUniformHandle("UBOLight", "lights");
+            lightUniforms.CameraPosition  = lightSet->GetUniformHandle("UBOLight", "cameraPosition");
+            lightUniforms.ViewMatrix      = lightSet->GetUniformHandle("UBOLight", "ViewMatrix");
+            lightUniforms.LightView       = lightSet->GetUniformHandle("UBOLight", "LightView");
+            lightUniforms.ShadowTransform = lightSet->GetUniformHandle("UBOLight", "ShadowTransform");
+            lightUniforms.SplitDepths     = lightSet->GetUniformHandle("UBOLight", "SplitDepths");
+            lightUniforms.BiasMatrix      = lightSet->GetUniformHandle("UBOLight", "BiasMatrix");
+            lightUniforms.LightSize       = lightSet->GetUniformHandle("UBOLight", "LightSize");
+            lightUniforms.ShadowFade      = lightSet->GetUniformHandle("UBOLight", "ShadowFade");
+            lightUniforms.CascadeFade     = lightSet->GetUniformHandle("UBOLight", "CascadeFade");
+            lightUniforms.MaxShadowDist   = lightSet->GetUniformHandle("UBOLight", "MaxShadowDist");
+            lightUniforms.InitialBias     = lightSet->GetUniformHandle("UBOLight", "InitialBias");
+            lightUniforms.Width           = lightSet->GetUniformHandle("UBOLight", "Width");
+            lightUniforms.Height          = lightSet->GetUniformHandle("UBOLight", "Height");
+            lightUniforms.ShadowEnabled   = lightSet->GetUniformHandle("UBOLight", "shadowEnabled");
+            lightUniforms.LightCount      = lightSet->GetUniformHandle("UBOLight", "LightCount");
+            lightUniforms.ShadowCount     = lightSet->GetUniformHandle("UBOLight", "ShadowCount");
+            lightUniforms.Mode            = lightSet->GetUniformHandle("UBOLight", "Mode");
+            lightUniforms.EnvMipCount     = lightSet->GetUniformHandle("UBOLight", "EnvMipCount");
+        }
+
         // m_ForwardData.m_DescriptorSet[0]->SetUniformDynamic("TransformData", static_cast<uint32_t>(MAX_OBJECTS * m_ForwardData.m_DynamicAlignment));
 
         m_ForwardData.m_DefaultMaterial  = new Material(m_ForwardData.m_Shader);
@@ -237,6 +317,19 @@ namespace Lumos::Graphics
         descriptorDesc.shader      = m_SharpenShader.get();
         m_SharpenPassDescriptorSet = SharedPtr<Graphics::DescriptorSet>(Graphics::DescriptorSet::Create(descriptorDesc));
 
+        m_MotionVectorShader    = Application::Get().GetShaderLibrary()->GetResource("MotionVectors");
+        m_TemporalUpscaleShader = Application::Get().GetShaderLibrary()->GetResource("TemporalUpscale");
+        if(m_MotionVectorShader && m_MotionVectorShader->IsCompiled() && m_TemporalUpscaleShader && m_TemporalUpscaleShader->IsCompiled())
+        {
+            descriptorDesc.layoutIndex     = 0;
+            descriptorDesc.shader          = m_MotionVectorShader.get();
+            m_MotionVectorDescriptorSet    = SharedPtr<Graphics::DescriptorSet>(Graphics::DescriptorSet::Create(descriptorDesc));
+            descriptorDesc.shader          = m_TemporalUpscaleShader.get();
+            m_TemporalUpscaleDescriptorSet = SharedPtr<Graphics::DescriptorSet>(Graphics::DescriptorSet::Create(descriptorDesc));
+        }
+        else
+            LUMOS_LOG_WARN("Temporal upscale shaders unavailable (MotionVectors, TemporalUpscale), rendering at no less than display resolution");
+
         m_BloomPassShader          = Application::Get().GetShaderLibrary()->GetResource(m_SupportCompute ? "BloomComp" : "Bloom");
         descriptorDesc.layoutIndex = 0;
         descriptorDesc.shader      = m_BloomPassShader.get();
@@ -247,11 +340,6 @@ namespace Lumos::Graphics
                 m_BloomDescriptorSets.push_back(SharedPtr<Graphics::DescriptorSet>(Graphics::DescriptorSet::Create(descriptorDesc)));
         }
 
-        mainRenderTargetDesc.flags = TextureFlags::Texture_RenderTarget | TextureFlags::Texture_CreateMips | TextureFlags::Texture_MipViews;
-        m_BloomTexture             = Texture2D::Create(mainRenderTargetDesc, width, height);
-        m_BloomTexture1            = Texture2D::Create(mainRenderTargetDesc, width, height);
-        m_BloomTexture2            = Texture2D::Create(mainRenderTargetDesc, width, height);
-
         m_FXAAShader               = Application::Get().GetShaderLibrary()->GetResource(m_SupportCompute ? "FXAAComp" : "FXAA");
         descriptorDesc.layoutIndex = 0;
         descriptorDesc.shader      = m_FXAAShader.get();
@@ -293,6 +381,42 @@ namespace Lumos::Graphics
             m_SSAOBlurPassDescriptorSet2 = SharedPtr<Graphics::DescriptorSet>(Graphics::DescriptorSet::Create(descriptorDesc));
         }
 
+        // Only loaded when compute is supported
+        if(m_SupportCompute)
+        {
+            m_SSAOComputeShader     = Application::Get().GetShaderLibrary()->GetResource("SSAOComp");
+            m_SSAOUpsampleShader    = Application::Get().GetShaderLibrary()->GetResource("SSAOUpsample");
+            m_BloomDownsampleShader = Application::Get().GetShaderLibrary()->GetResource("BloomDownsample");
+            m_BloomUpsampleShader   = Application::Get().GetShaderLibrary()->GetResource("BloomUpsample");
+        }
+
+        m_SSAOCompute  = m_SSAOComputeShader && m_SSAOComputeShader->IsCompiled() && m_SSAOUpsampleShader && m_SSAOUpsampleShader->IsCompiled();
+        m_BloomCompute = m_BloomDownsampleShader && m_BloomDownsampleShader->IsCompiled() && m_BloomUpsampleShader && m_BloomUpsampleShader->IsCompiled();
+
+        // The SPIR-V comes from the CompileShaders scripts, missing output silently turned these effects off before
+        if(m_SupportCompute && !m_SSAOCompute)
+            LUMOS_LOG_WARN("SSAO compute shaders unavailable (SSAOComp, SSAOUpsample), using the full resolution SSAO passes");
+        if(m_SupportCompute && !m_BloomCompute)
+            LUMOS_LOG_WARN("Bloom compute shaders unavailable (BloomDownsample, BloomUpsample), using the per level bloom passes");
+
+        if(m_SSAOCompute)
+        {
+            descriptorDesc.layoutIndex  = 0;
+            descriptorDesc.shader       = m_SSAOComputeShader.get();
+            m_SSAOComputeDescriptorSet  = SharedPtr<Graphics::DescriptorSet>(Graphics::DescriptorSet::Create(descriptorDesc));
+            descriptorDesc.shader       = m_SSAOUpsampleShader.get();
+            m_SSAOUpsampleDescriptorSet = SharedPtr<Graphics::DescriptorSet>(Graphics::DescriptorSet::Create(descriptorDesc));
+        }
+
+        if(m_BloomCompute)
+        {
+            descriptorDesc.layoutIndex     = 0;
+            descriptorDesc.shader          = m_BloomDownsampleShader.get();
+            m_BloomDownsampleDescriptorSet = SharedPtr<Graphics::DescriptorSet>(Graphics::DescriptorSet::Create(descriptorDesc));
+            descriptorDesc.shader          = m_BloomUpsampleShader.get();
+            m_BloomUpsampleDescriptorSet   = SharedPtr<Graphics::DescriptorSet>(Graphics::DescriptorSet::Create(descriptorDesc));
+        }
+
         // m_OutlineShader = Application::Get().GetShaderLibrary()->GetResource("Outline");
         //         descriptorDesc.layoutIndex = 0;
         //         descriptorDesc.shader      = m_OutlineShader.get();
@@ -582,20 +706,80 @@ namespace Lumos::Graphics
         delete[] indices;
 
         m_DebugTextRendererData.m_CurrentDescriptorSets.resize(2);
+
+        ResolvePassUniforms();
+    }
+
+    void RenderPasses::ResolvePassUniforms()
+    {
+        // Sets are not created for shaders that failed to compile, their handles stay invalid
+        auto resolve = [](const SharedPtr<DescriptorSet>& set, const char* bufferName, const char* uniformName)
+        {
+            return set ? set->GetUniformHandle(bufferName, uniformName) : UniformHandle();
+        };
+
+        auto& uniforms               = m_PassUniforms;
+        uniforms.ForwardProjView     = resolve(m_ForwardData.m_DescriptorSet[0], "UBO", "projView");
+        uniforms.ShadowLightMatrices = resolve(m_ShadowData.m_DescriptorSet[0], "ShadowData", "LightMatrices");
+
+        uniforms.SkyboxInvProjection = resolve(m_SkyboxDescriptorSet, "UBO", "invProjection");
+        uniforms.SkyboxInvView       = resolve(m_SkyboxDescriptorSet, "UBO", "invView");
+        uniforms.SkyboxMode          = resolve(m_SkyboxDescriptorSet, "UniformBuffer", "Mode");
+        uniforms.SkyboxExposure      = resolve(m_SkyboxDescriptorSet, "UniformBuffer", "Exposure");
+        uniforms.SkyboxBlurLevel     = resolve(m_SkyboxDescriptorSet, "UniformBuffer", "BlurLevel");
+
+        uniforms.SSAOInvProj         = resolve(m_SSAOPassDescriptorSet, "UniformBuffer", "invProj");
+        uniforms.SSAOProjection      = resolve(m_SSAOPassDescriptorSet, "UniformBuffer", "projection");
+        uniforms.SSAOView            = resolve(m_SSAOPassDescriptorSet, "UniformBuffer", "view");
+        uniforms.SSAOSamples         = resolve(m_SSAOPassDescriptorSet, "UniformBuffer", "samples");
+        uniforms.SSAORadius          = resolve(m_SSAOPassDescriptorSet, "UniformBuffer", "ssaoRadius");
+        uniforms.SSAONear            = resolve(m_SSAOPassDescriptorSet, "UniformBuffer", "near");
+        uniforms.SSAOFar             = resolve(m_SSAOPassDescriptorSet, "UniformBuffer", "far");
+        uniforms.SSAOStrength        = resolve(m_SSAOPassDescriptorSet, "UniformBuffer", "strength");
+        uniforms.SSAOBlurTexelOffset = resolve(m_SSAOBlurPassDescriptorSet, "UniformBuffer", "ssaoTexelOffset");
+        uniforms.SSAOBlurRadius      = resolve(m_SSAOBlurPassDescriptorSet, "UniformBuffer", "ssaoBlurRadius");
+
+        uniforms.SSAOComputeProjection  = resolve(m_SSAOComputeDescriptorSet, "UniformBuffer", "projection");
+        uniforms.SSAOComputeInvProj     = resolve(m_SSAOComputeDescriptorSet, "UniformBuffer", "invProj");
+        uniforms.SSAOComputeView        = resolve(m_SSAOComputeDescriptorSet, "UniformBuffer", "view");
+        uniforms.SSAOComputeSamples     = resolve(m_SSAOComputeDescriptorSet, "UniformBuffer", "samples");
+        uniforms.SSAOComputeRadius      = resolve(m_SSAOComputeDescriptorSet, "UniformBuffer", "ssaoRadius");
+        uniforms.SSAOComputeStrength    = resolve(m_SSAOComputeDescriptorSet, "UniformBuffer", "strength");
+        uniforms.SSAOComputeSampleCount = resolve(m_SSAOComputeDescriptorSet, "UniformBuffer", "sampleCount");
+        uniforms.SSAOComputeScale       = resolve(m_SSAOComputeDescriptorSet, "UniformBuffer", "scale");
+
+        uniforms.DOFParams          = resolve(m_DepthOfFieldPassDescriptorSet, "UniformBuffer", "DOFParams");
+        uniforms.DOFDepthConsts     = resolve(m_DepthOfFieldPassDescriptorSet, "UniformBuffer", "DepthConsts");
+        uniforms.MotionInvViewProj  = resolve(m_MotionVectorDescriptorSet, "UniformBuffer", "InvViewProj");
+        uniforms.MotionViewProj     = resolve(m_MotionVectorDescriptorSet, "UniformBuffer", "ViewProj");
+        uniforms.MotionPrevViewProj = resolve(m_MotionVectorDescriptorSet, "UniformBuffer", "PrevViewProj");
+        uniforms.TemporalJitter     = resolve(m_TemporalUpscaleDescriptorSet, "UniformBuffer", "Jitter");
+        uniforms.TemporalSize       = resolve(m_TemporalUpscaleDescriptorSet, "UniformBuffer", "Size");
+
+        uniforms.ToneMapBloomIntensity = resolve(m_ToneMappingPassDescriptorSet, "UniformBuffer", "BloomIntensity");
+        uniforms.ToneMapIndex          = resolve(m_ToneMappingPassDescriptorSet, "UniformBuffer", "ToneMapIndex");
+        uniforms.ToneMapBrightness     = resolve(m_ToneMappingPassDescriptorSet, "UniformBuffer", "Brightness");
+        uniforms.ToneMapContrast       = resolve(m_ToneMappingPassDescriptorSet, "UniformBuffer", "Contrast");
+        uniforms.ToneMapSaturation     = resolve(m_ToneMappingPassDescriptorSet, "UniformBuffer", "Saturation");
+        uniforms.ChromaticIntensity    = resolve(m_ChromaticAberationPassDescriptorSet, "UniformBuffer", "chromaticAberrationIntensity");
+        uniforms.ChromaticAperture     = resolve(m_ChromaticAberationPassDescriptorSet, "UniformBuffer", "cameraAperture");
+
+        uniforms.DebugLineProjView  = resolve(m_DebugDrawData.m_LineDescriptorSet[0], "UBO", "projView");
+        uniforms.DebugPointProjView = resolve(m_DebugDrawData.m_PointDescriptorSet[0], "UBO", "projView");
+
+        m_Renderer2DData.m_ProjViewUniform                 = resolve(m_Renderer2DData.m_DescriptorSet[0][0], "UBO", "projView");
+        m_TextRendererData.m_ProjViewUniform               = resolve(m_TextRendererData.m_DescriptorSet[0][0], "UBO", "projView");
+        m_DebugDrawData.m_Renderer2DData.m_ProjViewUniform = resolve(m_DebugDrawData.m_Renderer2DData.m_DescriptorSet[0][0], "UBO", "projView");
+        m_DebugTextRendererData.m_ProjViewUniform          = resolve(m_DebugTextRendererData.m_DescriptorSet[0][0], "UBO", "projView");
     }
 
     RenderPasses::~RenderPasses()
     {
         delete m_ForwardData.m_DepthTexture;
-        delete m_MainTexture;
-        delete m_PostProcessTexture1;
-        delete m_SSAOTexture;
-        delete m_SSAOTexture1;
+        delete m_SceneTexture;
+        delete m_TemporalHistory[0];
+        delete m_TemporalHistory[1];
         delete m_NoiseTexture;
-        delete m_BloomTexture;
-        delete m_BloomTexture1;
-        delete m_BloomTexture2;
-        delete m_NormalTexture;
 
         delete m_ShadowData.m_ShadowTex;
         delete m_ForwardData.m_DefaultMaterial;
@@ -667,16 +851,42 @@ namespace Lumos::Graphics
         width -= (width % 2 != 0) ? 1 : 0;
         height -= (height % 2 != 0) ? 1 : 0;
 
+        m_DisplayWidth  = width;
+        m_DisplayHeight = height;
+
+        for(auto history : m_TemporalHistory)
+            history->Resize(width, height);
+        m_HistoryValid = false;
+
+        UpdateRenderResolution();
+    }
+
+    float RenderPasses::GetRenderScale() const
+    {
+        float scale = m_DynamicResolutionEnabled ? m_DynamicResolution.GetScale() : m_RenderScale;
+        if(!m_TemporalUpscaleDescriptorSet)
+            scale = Maths::Max(scale, 1.0f);
+
+        return scale;
+    }
+
+    void RenderPasses::UpdateRenderResolution()
+    {
+        float scale = GetRenderScale();
+
+        uint32_t width  = Maths::Max(uint32_t(float(m_DisplayWidth) * scale), 2u);
+        uint32_t height = Maths::Max(uint32_t(float(m_DisplayHeight) * scale), 2u);
+        width -= width % 2;
+        height -= height % 2;
+
+        if(width == m_SceneTexture->GetWidth() && height == m_SceneTexture->GetHeight())
+            return;
+
         m_ForwardData.m_DepthTexture->Resize(width, height);
-        m_MainTexture->Resize(width, height);
-        m_PostProcessTexture1->Resize(width, height);
-        m_SSAOTexture->Resize(width / 2, height / 2);
-        m_SSAOTexture1->Resize(width / 2, height / 2);
-        m_BloomTexture->Resize(width, height);
-        m_BloomTexture1->Resize(width, height);
-        m_BloomTexture2->Resize(width, height);
-
-        m_NormalTexture->Resize(width, height);
+        m_SceneTexture->Resize(width, height);
+
+        // The resized depth holds nothing to test occlusion against
+        m_HasPreviousDepth = false;
     }
 
     void RenderPasses::EnableDebugRenderer(bool enable)
@@ -699,6 +909,12 @@ namespace Lumos::Graphics
         m_Stats.NumRenderedObjects = 0;
         m_Stats.NumShadowObjects   = 0;
         m_Stats.UpdatesPerSecond   = 0;
+        m_Stats.NumLODSwitches     = 0;
+        m_Stats.NumOccluders       = 0;
+        m_Stats.NumOcclusionCulled = 0;
+        m_GPUCullingActive         = false;
+        m_CPUOcclusionActive       = false;
+        auto& lightUniforms        = m_ForwardData.m_LightUniforms;
 
         m_Renderer2DData.m_BatchDrawCallIndex        = 0;
         m_TextRendererData.m_BatchDrawCallIndex      = 0;
@@ -725,13 +941,39 @@ namespace Lumos::Graphics
         m_Exposure     = m_Camera->GetExposure();
         m_ToneMapIndex = scene->GetSettings().RenderSettings.m_ToneMapIndex;
 
+        // GPU times arrive a few frames late, the controller accounts for it
+        if(m_DynamicResolutionEnabled)
+            m_DynamicResolution.Update(Renderer::GetRenderer()->GetGPUTime(GPUTimer_Frame));
+        UpdateRenderResolution();
+
+        m_TemporalActive = m_TemporalUpscaling && !m_DisablePostProcess && m_TemporalUpscaleDescriptorSet;
+        if(!m_TemporalActive)
+            m_HistoryValid = false;
+
         auto view     = glm::inverse(m_CameraTransform->GetWorldMatrix());
         auto proj     = m_Camera->GetProjectionMatrix();
         auto projView = proj * view;
 
+        // Occlusion is tested against last frame's depth, so with last frame's matrices
+        m_PrevProjView = m_ProjView;
+        m_ProjView     = projView;
+
+        // Sub pixel offsets the upscale pass gathers back over frames. Only the scene is jittered, culling and
+        // motion vectors use the plain matrices
+        m_Jitter = glm::vec2(0.0f);
+        if(m_TemporalActive)
+        {
+            m_TemporalFrame++;
+            uint32_t index = m_TemporalFrame % 16 + 1;
+            m_Jitter       = (glm::vec2(Halton(index, 2), Halton(index, 3)) - 0.5f) * 2.0f / glm::vec2(m_SceneTexture->GetWidth(), m_SceneTexture->GetHeight());
+        }
+
+        auto jitteredProj     = glm::translate(glm::mat4(1.0f), glm::vec3(m_Jitter, 0.0f)) * proj;
+        auto jitteredProjView = jitteredProj * view;
+
         if(m_DebugRenderEnabled)
         {
-            DebugRenderer::GetInstance()->SetDimensions(m_MainTexture->GetWidth(), m_MainTexture->GetHeight());
+            DebugRenderer::GetInstance()->SetDimensions(m_SceneTexture->GetWidth(), m_SceneTexture->GetHeight());
             DebugRenderer::GetInstance()->SetProjView(projView);
         }
 
@@ -739,7 +981,7 @@ namespace Lumos::Graphics
 
         if(renderSettings.Renderer3DEnabled)
         {
-            m_ForwardData.m_DescriptorSet[0]->SetUniform("UBO", "projView", &projView);
+            m_ForwardData.m_DescriptorSet[0]->SetUniform(m_PassUniforms.ForwardProjView, &jitteredProjView);
             m_ForwardData.m_DescriptorSet[0]->Update();
         }
 
@@ -786,11 +1028,11 @@ namespace Lumos::Graphics
                 }
             }
 
-            auto invProj = glm::inverse(proj);
+            auto invProj = glm::inverse(jitteredProj);
             auto invView = glm::inverse(view);
 
-            m_SkyboxDescriptorSet->SetUniform("UBO", "invProjection", &invProj);
-            m_SkyboxDescriptorSet->SetUniform("UBO", "invView", &invView);
+            m_SkyboxDescriptorSet->SetUniform(m_PassUniforms.SkyboxInvProjection, &invProj);
+            m_SkyboxDescriptorSet->SetUniform(m_PassUniforms.SkyboxInvView, &invView);
         }
 
         Light* directionaLight = nullptr;
@@ -836,10 +1078,10 @@ namespace Lumos::Graphics
                 }
             }
 
-            m_ForwardData.m_DescriptorSet[2]->SetUniform("UBOLight", "lights", lights, sizeof(Graphics::Light) * numLights);
+            m_ForwardData.m_DescriptorSet[2]->SetUniform(lightUniforms.Lights, lights, sizeof(Graphics::Light) * numLights);
 
             glm::vec4 cameraPos = glm::vec4(m_CameraTransform->GetWorldPosition(), 1.0f);
-            m_ForwardData.m_DescriptorSet[2]->SetUniform("UBOLight", "cameraPosition", &cameraPos);
+            m_ForwardData.m_DescriptorSet[2]->SetUniform(lightUniforms.CameraPosition, &cameraPos);
         }
 
         if(renderSettings.ShadowsEnabled)
@@ -861,6 +1103,7 @@ namespace Lumos::Graphics
         }
 
         m_ForwardData.m_CommandQueue.clear();
+        m_GPUSkinning->Begin();
 
         auto& shadowData            = GetShadowData();
         glm::mat4* shadowTransforms = shadowData.m_ShadowProjView;
@@ -871,36 +1114,35 @@ namespace Lumos::Graphics
         float LightSize             = (float)shadowData.m_ShadowMapSize;
         float transitionFade        = shadowData.m_CascadeFade;
         float ShadowFade            = shadowData.m_ShadowFade;
-        float width                 = (float)m_MainTexture->GetWidth();
-        float height                = (float)m_MainTexture->GetHeight();
+        float width                 = (float)m_SceneTexture->GetWidth();
+        float height                = (float)m_SceneTexture->GetHeight();
 
         int shadowEnabled = renderSettings.ShadowsEnabled ? 1 : 0;
         if(renderSettings.Renderer3DEnabled)
         {
-            m_ForwardData.m_DescriptorSet[2]->SetUniform("UBOLight", "ViewMatrix", &view);
-            m_ForwardData.m_DescriptorSet[2]->SetUniform("UBOLight", "LightView", &LightView);
-            m_ForwardData.m_DescriptorSet[2]->SetUniform("UBOLight", "ShadowTransform", shadowTransforms);
-            m_ForwardData.m_DescriptorSet[2]->SetUniform("UBOLight", "SplitDepths", uSplitDepth);
-            m_ForwardData.m_DescriptorSet[2]->SetUniform("UBOLight", "BiasMatrix", &m_ForwardData.m_BiasMatrix);
-            m_ForwardData.m_DescriptorSet[2]->SetUniform("UBOLight", "LightSize", &LightSize);
-            m_ForwardData.m_DescriptorSet[2]->SetUniform("UBOLight", "ShadowFade", &ShadowFade);
-            m_ForwardData.m_DescriptorSet[2]->SetUniform("UBOLight", "CascadeFade", &transitionFade);
-            m_ForwardData.m_DescriptorSet[2]->SetUniform("UBOLight", "MaxShadowDist", &MaxShadowDist);
-            m_ForwardData.m_DescriptorSet[2]->SetUniform("UBOLight", "InitialBias", &bias);
-            m_ForwardData.m_DescriptorSet[2]->SetUniform("UBOLight", "Width", &width);
-            m_ForwardData.m_DescriptorSet[2]->SetUniform("UBOLight", "Height", &height);
-            m_ForwardData.m_DescriptorSet[2]->SetUniform("UBOLight", "shadowEnabled", &shadowEnabled);
+            m_ForwardData.m_DescriptorSet[2]->SetUniform(lightUniforms.ViewMatrix, &view);
+            m_ForwardData.m_DescriptorSet[2]->SetUniform(lightUniforms.LightView, &LightView);
+            m_ForwardData.m_DescriptorSet[2]->SetUniform(lightUniforms.ShadowTransform, shadowTransforms);
+            m_ForwardData.m_DescriptorSet[2]->SetUniform(lightUniforms.SplitDepths, uSplitDepth);
+            m_ForwardData.m_DescriptorSet[2]->SetUniform(lightUniforms.BiasMatrix, &m_ForwardData.m_BiasMatrix);
+            m_ForwardData.m_DescriptorSet[2]->SetUniform(lightUniforms.LightSize, &LightSize);
+            m_ForwardData.m_DescriptorSet[2]->SetUniform(lightUniforms.ShadowFade, &ShadowFade);
+            m_ForwardData.m_DescriptorSet[2]->SetUniform(lightUniforms.CascadeFade, &transitionFade);
+            m_ForwardData.m_DescriptorSet[2]->SetUniform(lightUniforms.MaxShadowDist, &MaxShadowDist);
+            m_ForwardData.m_DescriptorSet[2]->SetUniform(lightUniforms.InitialBias, &bias);
+            m_ForwardData.m_DescriptorSet[2]->SetUniform(lightUniforms.Width, &width);
+            m_ForwardData.m_DescriptorSet[2]->SetUniform(lightUniforms.Height, &height);
+            m_ForwardData.m_DescriptorSet[2]->SetUniform(lightUniforms.ShadowEnabled, &shadowEnabled);
 
             m_ForwardData.m_DescriptorSet[2]->SetTexture("uShadowMap", reinterpret_cast<Texture*>(shadowData.m_ShadowTex), 0, TextureType::DEPTHARRAY);
 
             int numShadows   = shadowData.m_ShadowMapNum;
             auto EnvMipCount = m_ForwardData.m_EnvironmentMap ? m_ForwardData.m_EnvironmentMap->GetMipMapLevels() : 0;
-            m_ForwardData.m_DescriptorSet[2]->SetUniform("UBOLight", "LightCount", &numLights);
-            m_ForwardData.m_DescriptorSet[2]->SetUniform("UBOLight", "ShadowCount", &numShadows);
-            m_ForwardData.m_DescriptorSet[2]->SetUniform("UBOLight", "Mode", &m_ForwardData.m_RenderMode);
-            m_ForwardData.m_DescriptorSet[2]->SetUniform("UBOLight", "EnvMipCount", &EnvMipCount);
+            m_ForwardData.m_DescriptorSet[2]->SetUniform(lightUniforms.LightCount, &numLights);
+            m_ForwardData.m_DescriptorSet[2]->SetUniform(lightUniforms.ShadowCount, &numShadows);
+            m_ForwardData.m_DescriptorSet[2]->SetUniform(lightUniforms.Mode, &m_ForwardData.m_RenderMode);
+            m_ForwardData.m_DescriptorSet[2]->SetUniform(lightUniforms.EnvMipCount, &EnvMipCount);
             m_ForwardData.m_DescriptorSet[2]->SetTexture("uBRDFLUT", m_ForwardData.m_BRDFLUT.get());
-            m_ForwardData.m_DescriptorSet[2]->SetTexture("uSSAOMap", Application::Get().GetCurrentScene()->GetSettings().RenderSettings.SSAOEnabled ? m_SSAOTexture : Material::GetDefaultTexture().get());
             m_ForwardData.m_DescriptorSet[2]->SetTexture("uEnvMap", m_ForwardData.m_EnvironmentMap, 0, TextureType::CUBE);
             m_ForwardData.m_DescriptorSet[2]->SetTexture("uIrrMap", m_ForwardData.m_IrradianceMap, 0, TextureType::CUBE);
 
@@ -912,6 +1154,34 @@ namespace Lumos::Graphics
             pipelineDesc.blendMode              = BlendMode::SrcAlphaOneMinusSrcAlpha;
             pipelineDesc.clearTargets           = false;
             pipelineDesc.swapchainTarget        = false;
+            pipelineDesc.asyncCompile           = true;
+
+            // Pixels covered by one world unit at unit distance from the camera, or at any distance when orthographic.
+            // Cascades are orthographic so their scale only depends on the shadow map resolution and cascade extents
+            glm::vec3 cameraPosition  = m_CameraTransform->GetWorldPosition();
+            float cameraPixelsPerUnit = proj[1][1] * 0.5f * height;
+            bool cameraOrthographic   = m_Camera->IsOrthographic();
+            float cascadePixelsPerUnit[SHADOWMAP_MAX];
+            for(uint32_t i = 0; i < m_ShadowData.m_ShadowMapNum; i++)
+            {
+                const glm::mat4& cascadeProjView = m_ShadowData.m_ShadowProjView[i];
+                cascadePixelsPerUnit[i]          = glm::length(glm::vec3(cascadeProjView[0][0], cascadeProjView[1][0], cascadeProjView[2][0])) * 0.5f * LightSize;
+            }
+
+            // The culling pass takes over the frustum tests below, every mesh is queued with its own indirect command
+            m_GPUCullingActive = m_GPUCullingEnabled && m_GPUCuller->IsSupported();
+            if(m_GPUCullingActive)
+            {
+                m_GPUCuller->Begin();
+                m_GPUCuller->SetView(0, m_ForwardData.m_Frustum);
+                for(uint32_t i = 0; i < m_ShadowData.m_ShadowMapNum; i++)
+                    m_GPUCuller->SetView(i + 1, m_ShadowData.m_CascadeFrustums[i]);
+            }
+
+            // Without it occluders are rasterised on the CPU and hidden draws are dropped before they are queued
+            m_CPUOcclusionActive = !m_GPUCullingActive && m_CPUOcclusionEnabled;
+            if(m_CPUOcclusionActive)
+                RenderOccluders(scene, cameraPosition, cameraPixelsPerUnit, cameraOrthographic, directionaLight && m_CPUOcclusionShadows);
 
             for(auto entity : group)
             {
@@ -925,27 +1195,57 @@ namespace Lumos::Graphics
 
                 const auto& meshes = model.ModelRef->GetMeshes();
 
-                for(auto mesh : meshes)
+                // Meshes can change when the model is swapped, SelectLOD clamps levels that are out of range
+                constexpr uint32_t LODViewCount = SHADOWMAP_MAX + 1;
+                model.LODState.resize(meshes.size() * LODViewCount);
+
+                // Skinned once, by the skinning pass or on the CPU, and shared by the depth, forward and shadow passes
+                AnimationInstance* animation = model.Animation.get();
+                if(animation)
+                    animation->Skin(*m_GPUSkinning);
+
+                auto& worldTransform = trans.GetWorldMatrix();
+                float worldScale     = Maths::Max(glm::length(glm::vec3(worldTransform[0])), Maths::Max(glm::length(glm::vec3(worldTransform[1])), glm::length(glm::vec3(worldTransform[2]))));
+
+                // Largest on screen size of the skinned meshes, drives the animation update rate next frame
+                float animationScreenSize = 0.0f;
+
+                for(uint32_t meshIndex = 0; meshIndex < uint32_t(meshes.size()); meshIndex++)
                 {
+                    auto& mesh = meshes[meshIndex];
                     if(!mesh->GetActive())
                         continue;
 
-                    auto& worldTransform = trans.GetWorldMatrix();
-                    auto bbCopy          = mesh->GetBoundingBox()->Transformed(worldTransform);
+                    Mesh* skinnedMesh = animation ? animation->GetSkinnedMesh(meshIndex) : nullptr;
+                    auto bbCopy       = (skinnedMesh ? skinnedMesh : mesh.get())->GetBoundingBox()->Transformed(worldTransform);
+                    uint8_t* lodState = &model.LODState[meshIndex * LODViewCount];
+                    bool selectLODs   = !skinnedMesh && m_LODEnabled && mesh->GetLODCount() > 1;
 
                     if(directionaLight)
                     {
                         for(uint32_t i = 0; i < m_ShadowData.m_ShadowMapNum; i++)
                         {
-                            auto inside = m_ShadowData.m_CascadeFrustums[i].IsInside(bbCopy);
+                            auto inside = m_GPUCullingActive || m_ShadowData.m_CascadeFrustums[i].IsInside(bbCopy);
 
                             if(!inside)
                                 continue;
 
+                            if(m_CPUOcclusionActive && m_CPUOcclusionShadows && !m_OcclusionCullers[i + 1]->IsVisible(bbCopy))
+                            {
+                                m_Stats.NumOcclusionCulled++;
+                                continue;
+                            }
+
+                            uint32_t lod = selectLODs ? SelectLOD(mesh.get(), cascadePixelsPerUnit[i] * worldScale, lodState[i + 1]) : 0;
+
                             RenderCommand command;
-                            command.mesh      = mesh.get();
+                            command.mesh      = skinnedMesh ? skinnedMesh : mesh->GetLOD(lod);
                             command.transform = worldTransform;
                             command.material  = mesh->GetMaterial() ? mesh->GetMaterial().get() : m_ForwardData.m_DefaultMaterial;
+                            command.animated  = skinnedMesh != nullptr;
+
+                            if(m_GPUCullingActive)
+                                command.indirectIndex = m_GPUCuller->AddDraw(bbCopy, command.mesh->GetIndexBuffer()->GetCount(), i + 1);
 
                             // Bind here in case not bound in the loop below as meshes will be inside
                             // cascade frustum and not the cameras
@@ -956,20 +1256,45 @@ namespace Lumos::Graphics
                     }
 
                     {
-                        auto inside = m_ForwardData.m_Frustum.IsInside(bbCopy);
+                        auto inside = m_GPUCullingActive || m_ForwardData.m_Frustum.IsInside(bbCopy);
 
                         if(!inside)
                             continue;
 
+                        if(m_CPUOcclusionActive && !m_OcclusionCullers[0]->IsVisible(bbCopy))
+                        {
+                            m_Stats.NumOcclusionCulled++;
+                            continue;
+                        }
+
+                        if(skinnedMesh)
+                        {
+                            float size          = glm::length(bbCopy.Size());
+                            float distance      = cameraOrthographic ? 1.0f : Maths::Max(glm::length(bbCopy.Center() - cameraPosition), m_Camera->GetNear());
+                            animationScreenSize = Maths::Max(animationScreenSize, cameraPixelsPerUnit * size / distance);
+                        }
+
+                        uint32_t lod = 0;
+                        if(selectLODs)
+                        {
+                            float distance      = cameraOrthographic ? 1.0f : Maths::Max(glm::length(bbCopy.Center() - cameraPosition) - glm::length(bbCopy.Size()) * 0.5f, m_Camera->GetNear());
+                            float pixelsPerUnit = cameraPixelsPerUnit * worldScale / distance;
+                            lod                 = SelectLOD(mesh.get(), pixelsPerUnit, lodState[0]);
+                        }
+
                         RenderCommand command;
-                        command.mesh      = mesh;
+                        command.mesh      = skinnedMesh ? skinnedMesh : mesh->GetLOD(lod);
                         command.transform = worldTransform;
                         command.material  = mesh->GetMaterial() ? mesh->GetMaterial().get() : m_ForwardData.m_DefaultMaterial;
+                        command.animated  = skinnedMesh != nullptr;
+
+                        if(m_GPUCullingActive)
+                            command.indirectIndex = m_GPUCuller->AddDraw(bbCopy, command.mesh->GetIndexBuffer()->GetCount(), 0);
 
                         // Update material buffers
                         command.material->Bind();
 
-                        pipelineDesc.colourTargets[0]    = m_MainTexture;
+                        pipelineDesc.colourTargets[0]    = m_SceneTexture;
                         pipelineDesc.cullMode            = command.material->GetFlag(Material::RenderFlags::TWOSIDED) ? Graphics::CullMode::NONE : Graphics::CullMode::BACK;
                         pipelineDesc.transparencyEnabled = command.material->GetFlag(Material::RenderFlags::ALPHABLEND);
 
@@ -985,7 +1310,13 @@ namespace Lumos::Graphics
                         m_ForwardData.m_CommandQueue.push_back(command);
                     }
                 }
+
+                if(animation)
+                    animation->SetScreenSize(animationScreenSize);
             }
+
+            // After every visible material has been bound
+            Material::UploadParameterBuffer();
         }
 
         m_Renderer2DData.m_CommandQueue2D.clear();
@@ -1065,78 +1396,508 @@ namespace Lumos::Graphics
         LUMOS_PROFILE_FUNCTION();
         LUMOS_PROFILE_GPU("Render Passes");
 
-        auto& sceneRenderSettings = Application::Get().GetCurrentScene()->GetSettings().RenderSettings;
-        Renderer::GetRenderer()->ClearRenderTarget(m_MainTexture, Renderer::GetMainSwapChain()->GetCurrentCommandBuffer());
+        BuildRenderGraph();
+
+        // Measures the frame for dynamic resolution
+        auto commandBuffer = Renderer::GetMainSwapChain()->GetCurrentCommandBuffer();
+        Renderer::GetRenderer()->BeginGPUTimer(commandBuffer, GPUTimer_Frame);
+
+        m_RenderGraph->Compile();
+        m_RenderGraph->Execute(commandBuffer);
+
+        Renderer::GetRenderer()->EndGPUTimer(commandBuffer, GPUTimer_Frame);
+    }
+
+    void RenderPasses::TimedPass(GPUTimer timer, void (RenderPasses::*pass)())
+    {
+        auto commandBuffer = Renderer::GetMainSwapChain()->GetCurrentCommandBuffer();
+        Renderer::GetRenderer()->BeginGPUTimer(commandBuffer, timer);
 
-        sceneRenderSettings.SSAOEnabled = false;
-        if(sceneRenderSettings.SSAOEnabled)
-            Renderer::GetRenderer()->ClearRenderTarget(m_NormalTexture, Renderer::GetMainSwapChain()->GetCurrentCommandBuffer());
+        (this->*pass)();
+
+        Renderer::GetRenderer()->EndGPUTimer(commandBuffer, timer);
+        m_ActiveGPUTimers |= 1u << timer;
+    }
 
-        // Set to default texture if bloom disabled
-        m_BloomTextureLastRenderered = Graphics::Material::GetDefaultTexture().get();
+    void RenderPasses::DrawCommand(CommandBuffer* commandBuffer, Pipeline* pipeline, const RenderCommand& command)
+    {
+        if(command.indirectIndex != ~0u)
+            m_GPUCuller->Draw(commandBuffer, pipeline, command.mesh, command.indirectIndex);
+        else
+            Renderer::DrawMesh(commandBuffer, pipeline, command.mesh);
+    }
 
-        if(m_ForwardData.m_DepthTest)
+    void RenderPasses::BuildRenderGraph()
+    {
+        LUMOS_PROFILE_FUNCTION();
+
+        auto& sceneRenderSettings = Application::Get().GetCurrentScene()->GetSettings().RenderSettings;
+        RenderGraph& graph        = *m_RenderGraph;
+
+        // The fragment passes are the fallback when the compute SSAO is unavailable
+        bool postProcess  = !m_DisablePostProcess;
+        bool ssao         = sceneRenderSettings.SSAOEnabled && postProcess && (m_SSAOCompute || m_SSAOShader->IsCompiled());
+        bool bloom        = sceneRenderSettings.BloomEnabled && postProcess;
+        m_ActiveGPUTimers = 0;
+
+        // Per frame targets are only valid while the graph executes
+        m_MainTexture                = m_SceneTexture;
+        m_PostProcessTexture1        = nullptr;
+        m_NormalTexture              = nullptr;
+        m_SSAOTexture                = nullptr;
+        m_SSAOTexture1               = nullptr;
+        m_BloomTexture               = nullptr;
+        m_BloomTexture1              = nullptr;
+        m_BloomTexture2              = nullptr;
+        m_BloomTextureLastRenderered = Graphics::Material::GetDefaultTexture().get(); // Set to default texture if bloom disabled
+
+        RenderGraphTextureDesc colourDesc;
+        colourDesc.Width  = m_SceneTexture->GetWidth();
+        colourDesc.Height = m_SceneTexture->GetHeight();
+        colourDesc.Format = RHIFormat::R11G11B10_Float;
+
+        RenderGraphTextureDesc bloomDesc = colourDesc;
+        bloomDesc.Flags                  = TextureFlags::Texture_RenderTarget | TextureFlags::Texture_CreateMips | TextureFlags::Texture_MipViews;
+
+        RenderGraphTextureDesc normalDesc = colourDesc;
+        normalDesc.Format                 = RHIFormat::R32G32B32A32_Float;
+
+        RenderGraphTextureDesc ssaoDesc = normalDesc;
+        ssaoDesc.Width                  = normalDesc.Width / 2;
+        ssaoDesc.Height                 = normalDesc.Height / 2;
+
+        // The compute SSAO keeps its depth next to the occlusion and is upsampled to the render resolution
+        RenderGraphTextureDesc ssaoUpsampleDesc = colourDesc;
+        ssaoUpsampleDesc.Format                 = RHIFormat::R8G8B8A8_Unorm;
+        if(m_SSAOCompute)
+        {
+            uint32_t divisor = SSAOPresets[int(m_Settings.SSAOQuality)].Divisor;
+            ssaoDesc.Width   = Maths::Max(normalDesc.Width / divisor, 1u);
+            ssaoDesc.Height  = Maths::Max(normalDesc.Height / divisor, 1u);
+            ssaoDesc.Format  = RHIFormat::R16G16B16A16_Float;
+            ssaoDesc.Filter  = TextureFilter::NEAREST;
+        }
+
+        // The compute bloom chain starts at half the render resolution
+        RenderGraphTextureDesc bloomChainDesc = colourDesc;
+        bloomChainDesc.Width                  = Maths::Max(colourDesc.Width / 2, 1u);
+        bloomChainDesc.Height                 = Maths::Max(colourDesc.Height / 2, 1u);
+        bloomChainDesc.Format                 = RHIFormat::R16G16B16A16_Float;
+        bloomChainDesc.Flags                  = TextureFlags::Texture_RenderTarget | TextureFlags::Texture_CreateMips | TextureFlags::Texture_MipViews;
+
+        RenderGraphTextureDesc bloomUpsampleDesc = bloomChainDesc;
+        bloomUpsampleDesc.Flags                  = TextureFlags::Texture_RenderTarget;
+
+        // After the temporal upscale post processing runs at the display size
+        bool temporal                      = m_TemporalActive && m_Camera;
+        RenderGraphTextureDesc displayDesc = colourDesc;
+        displayDesc.Width                  = m_DisplayWidth;
+        displayDesc.Height                 = m_DisplayHeight;
+
+        RenderGraphTextureDesc motionDesc = colourDesc;
+        motionDesc.Format                 = RHIFormat::R16G16_Float;
+        motionDesc.Filter                 = TextureFilter::NEAREST;
+
+        RenderGraphResource sceneColour = graph.Import("Scene Colour", m_SceneTexture);
+        RenderGraphResource depth       = graph.Import("Depth", m_ForwardData.m_DepthTexture);
+        RenderGraphResource shadowMap   = graph.Import("Shadow Map", m_ShadowData.m_ShadowTex);
+        RenderGraphResource postColour  = graph.Create("Post Process Colour", colourDesc);
+        RenderGraphResource normals     = ssao ? graph.Create("Normals", normalDesc) : RenderGraphNullResource;
+        RenderGraphResource ssaoTarget  = ssao ? graph.Create("SSAO", ssaoDesc) : RenderGraphNullResource;
+        RenderGraphResource ssaoBlur    = RenderGraphNullResource;
+        if(ssao && m_SSAOCompute)
+            ssaoBlur = graph.Create("SSAO Upsample", ssaoUpsampleDesc);
+        else if(ssao && sceneRenderSettings.SSAOBlur)
+            ssaoBlur = graph.Create("SSAO Blur", ssaoDesc);
+
+        // The forward pass samples the upsampled occlusion, the fragment blur writes back into the SSAO target
+        RenderGraphResource ssaoOutput = m_SSAOCompute ? ssaoBlur : ssaoTarget;
+
+        RenderGraphResource bloomTargets[3] = { RenderGraphNullResource, RenderGraphNullResource, RenderGraphNullResource };
+        if(bloom && m_BloomCompute)
+        {
+            bloomTargets[0] = graph.Create("Bloom", bloomChainDesc);
+            bloomTargets[1] = graph.Create("Bloom Upsample", bloomUpsampleDesc);
+        }
+        else if(bloom)
         {
-            Renderer::GetRenderer()->ClearRenderTarget(reinterpret_cast<Texture*>(m_ForwardData.m_DepthTexture), Renderer::GetMainSwapChain()->GetCurrentCommandBuffer());
+            bloomTargets[0] = graph.Create("Bloom", bloomDesc);
+            bloomTargets[1] = graph.Create("Bloom Upsample 1", bloomDesc);
+            bloomTargets[2] = graph.Create("Bloom Upsample 2", bloomDesc);
         }
 
-        GenerateBRDFLUTPass();
-        DepthPrePass();
+        if(m_GPUSkinning->IsSupported())
+        {
+            // Writes the skinned vertex buffers drawn by the depth, shadow and forward passes
+            graph.AddPass("Skinning",
+                          [this]()
+                          {
+                              auto commandBuffer = Renderer::GetMainSwapChain()->GetCurrentCommandBuffer();
+                              m_GPUSkinning->Dispatch(commandBuffer);
+                          })
+                .SideEffect();
+        }
 
-        if(sceneRenderSettings.SSAOEnabled && !m_DisablePostProcess)
+        if(m_GPUCullingActive)
         {
-            SSAOPass();
+            // Last frame's depth is reduced before the clear below overwrites it
+            RenderGraphResource pyramid = RenderGraphNullResource;
+            if(m_OcclusionCulling && m_HasPreviousDepth && m_ForwardData.m_DepthTest)
+            {
+                RenderGraphTextureDesc pyramidDesc;
+                pyramidDesc.Width  = Maths::Max(m_ForwardData.m_DepthTexture->GetWidth() / 2, 1u);
+                pyramidDesc.Height = Maths::Max(m_ForwardData.m_DepthTexture->GetHeight() / 2, 1u);
+                pyramidDesc.Format = RHIFormat::R32_Float;
+                pyramidDesc.Flags  = TextureFlags::Texture_RenderTarget | TextureFlags::Texture_CreateMips | TextureFlags::Texture_MipViews;
+                pyramidDesc.Filter = TextureFilter::NEAREST;
+                pyramid            = graph.Create("Depth Pyramid", pyramidDesc);
+
+                graph.AddPass("Depth Pyramid",
+                              [this, depth, pyramid]()
+                              {
+                                  auto commandBuffer = Renderer::GetMainSwapChain()->GetCurrentCommandBuffer();
+                                  m_GPUCuller->BuildDepthPyramid(m_RenderGraph->GetTexture(depth), m_RenderGraph->GetTexture<Texture2D>(pyramid), commandBuffer);
+                              })
+                    .Read(depth)
+                    .WriteStorage(pyramid);
+            }
+
+            // Writes the indirect commands read by the depth, shadow and forward passes
+            graph.AddPass("GPU Culling",
+                          [this, pyramid]()
+                          {
+                              auto commandBuffer = Renderer::GetMainSwapChain()->GetCurrentCommandBuffer();
+                              m_GPUCuller->Cull(m_RenderGraph->GetTexture<Texture2D>(pyramid), m_PrevProjView, commandBuffer);
+                          })
+                .Read(pyramid)
+                .SideEffect();
+        }
+
+        graph.AddPass("Clear",
+                      [this, normals]()
+                      {
+                          auto commandBuffer = Renderer::GetMainSwapChain()->GetCurrentCommandBuffer();
+                          Renderer::GetRenderer()->ClearRenderTarget(m_SceneTexture, commandBuffer);
+
+                          if(Texture* normalTexture = m_RenderGraph->GetTexture(normals))
+                              Renderer::GetRenderer()->ClearRenderTarget(normalTexture, commandBuffer);
+
+                          if(m_ForwardData.m_DepthTest)
+                              Renderer::GetRenderer()->ClearRenderTarget(reinterpret_cast<Texture*>(m_ForwardData.m_DepthTexture), commandBuffer);
+                      })
+            .Write(sceneColour)
+            .Write(depth)
+            .Write(normals);
+
+        // The LUT persists across frames
+        graph.AddPass("BRDF LUT",
+                      [this]()
+                      {
+                          GenerateBRDFLUTPass();
+                      })
+            .SideEffect();
+
+        // Without SSAO nothing reads the normals, the pre pass then only writes depth
+        graph.AddPass("Depth Pre Pass",
+                      [this, normals]()
+                      {
+                          m_NormalTexture = m_RenderGraph->GetTexture<Texture2D>(normals);
+                          DepthPrePass();
+                          m_HasPreviousDepth = true;
+                      })
+            .Read(depth)
+            .Write(depth)
+            .Write(normals);
+
+        if(ssao && m_SSAOCompute)
+        {
+            graph.AddPass("SSAO",
+                          [this, normals, ssaoTarget]()
+                          {
+                              m_NormalTexture = m_RenderGraph->GetTexture<Texture2D>(normals);
+                              m_SSAOTexture   = m_RenderGraph->GetTexture<Texture2D>(ssaoTarget);
+                              TimedPass(GPUTimer_SSAO, &RenderPasses::SSAOComputePass);
+                          })
+                .Read(depth)
+                .Read(normals)
+                .WriteStorage(ssaoTarget);
+
+            graph.AddPass("SSAO Upsample",
+                          [this, ssaoTarget, ssaoBlur]()
+                          {
+                              m_SSAOTexture  = m_RenderGraph->GetTexture<Texture2D>(ssaoTarget);
+                              m_SSAOTexture1 = m_RenderGraph->GetTexture<Texture2D>(ssaoBlur);
+                              TimedPass(GPUTimer_SSAOBlur, &RenderPasses::SSAOUpsamplePass);
+                          })
+                .Read(depth)
+                .Read(ssaoTarget)
+                .WriteStorage(ssaoBlur);
+        }
+        else if(ssao)
+        {
+            graph.AddPass("SSAO",
+                          [this, normals, ssaoTarget]()
+                          {
+                              m_NormalTexture = m_RenderGraph->GetTexture<Texture2D>(normals);
+                              m_SSAOTexture   = m_RenderGraph->GetTexture<Texture2D>(ssaoTarget);
+                              TimedPass(GPUTimer_SSAO, &RenderPasses::SSAOPass);
+                          })
+                .Read(depth)
+                .Read(normals)
+                .Write(ssaoTarget);
 
             if(sceneRenderSettings.SSAOBlur)
-                SSAOBlurPass();
+            {
+                graph.AddPass("SSAO Blur",
+                              [this, normals, ssaoTarget, ssaoBlur]()
+                              {
+                                  m_NormalTexture = m_RenderGraph->GetTexture<Texture2D>(normals);
+                                  m_SSAOTexture   = m_RenderGraph->GetTexture<Texture2D>(ssaoTarget);
+                                  m_SSAOTexture1  = m_RenderGraph->GetTexture<Texture2D>(ssaoBlur);
+                                  TimedPass(GPUTimer_SSAOBlur, &RenderPasses::SSAOBlurPass);
+                              })
+                    .Read(depth)
+                    .Read(normals)
+                    .Read(ssaoTarget)
+                    .Write(ssaoTarget)
+                    .Write(ssaoBlur);
+            }
         }
 
         if(m_Settings.ShadowPass && sceneRenderSettings.ShadowsEnabled)
-            ShadowPass();
+        {
+            graph.AddPass("Shadow",
+                          [this]()
+                          {
+                              ShadowPass();
+                          })
+                .Write(shadowMap);
+        }
+
         if(m_Settings.GeomPass && sceneRenderSettings.Renderer3DEnabled)
-            ForwardPass();
+        {
+            graph.AddPass("Forward",
+                          [this, ssaoOutput]()
+                          {
+                              m_SSAOTexture = m_RenderGraph->GetTexture<Texture2D>(ssaoOutput);
+                              ForwardPass();
+                          })
+                .Read(sceneColour)
+                .Write(sceneColour)
+                .Read(depth)
+                .Write(depth)
+                .Read(shadowMap)
+                .Read(ssaoOutput);
+        }
+
         if(m_Settings.SkyboxPass && sceneRenderSettings.SkyboxRenderEnabled)
-            SkyboxPass();
-        if(m_Settings.GeomPass && sceneRenderSettings.Renderer2DEnabled)
-            Render2DPass();
+        {
+            graph.AddPass("Skybox",
+                          [this]()
+                          {
+                              SkyboxPass();
+                          })
+                .Read(sceneColour)
+                .Write(sceneColour)
+                .Read(depth)
+                .Write(depth);
+        }
 
-        TextPass();
+        if(m_Settings.GeomPass && sceneRenderSettings.Renderer2DEnabled)
+        {
+            graph.AddPass("Render 2D",
+                          [this]()
+                          {
+                              Render2DPass();
+                          })
+                .Read(sceneColour)
+                .Write(sceneColour);
+        }
 
-        m_LastRenderTarget = m_MainTexture;
+        graph.AddPass("Text",
+                      [this]()
+                      {
+                          TextPass();
+                          m_LastRenderTarget = m_MainTexture;
+                      })
+            .Read(sceneColour)
+            .Write(sceneColour);
 
         // if (sceneRenderSettings.EyeAdaptation)
         //    EyeAdaptationPass();
 
-        if(sceneRenderSettings.BloomEnabled && !m_DisablePostProcess)
-            BloomPass();
-
-        if(sceneRenderSettings.DepthOfFieldEnabled && !m_DisablePostProcess)
-            DepthOfFieldPass();
-
-        if(sceneRenderSettings.DebandingEnabled && !m_DisablePostProcess)
-            DebandingPass();
+        if(bloom && m_BloomCompute)
+        {
+            graph.AddPass("Bloom Downsample",
+                          [this, bloomTargets]()
+                          {
+                              m_BloomTexture = m_RenderGraph->GetTexture<Texture2D>(bloomTargets[0]);
+                              TimedPass(GPUTimer_Bloom, &RenderPasses::BloomDownsamplePass);
+                          })
+                .Read(sceneColour)
+                .WriteStorage(bloomTargets[0]);
+
+            graph.AddPass("Bloom Upsample",
+                          [this, bloomTargets]()
+                          {
+                              m_BloomTexture  = m_RenderGraph->GetTexture<Texture2D>(bloomTargets[0]);
+                              m_BloomTexture1 = m_RenderGraph->GetTexture<Texture2D>(bloomTargets[1]);
+                              TimedPass(GPUTimer_BloomUpsample, &RenderPasses::BloomUpsamplePass);
+                          })
+                .Read(bloomTargets[0])
+                .WriteStorage(bloomTargets[1]);
+        }
+        else if(bloom)
+        {
+            auto builder = graph.AddPass("Bloom",
+                                         [this, bloomTargets]()
+                                         {
+                                             m_BloomTexture  = m_RenderGraph->GetTexture<Texture2D>(bloomTargets[0]);
+                                             m_BloomTexture1 = m_RenderGraph->GetTexture<Texture2D>(bloomTargets[1]);
+                                             m_BloomTexture2 = m_RenderGraph->GetTexture<Texture2D>(bloomTargets[2]);
+                                             TimedPass(GPUTimer_Bloom, &RenderPasses::BloomPass);
+                                         });
+            builder.Read(sceneColour);
+
+            for(auto target : bloomTargets)
+            {
+                if(m_SupportCompute)
+                    builder.WriteStorage(target);
+                else
+                    builder.Write(target);
+            }
+        }
 
-        ToneMappingPass();
+        // Each effect reads the current colour and writes the other of a pair of targets, the scene texture and the
+        // post process transient until the upscale. The pass functions swap m_MainTexture and m_PostProcessTexture1 to match
+        RenderGraphResource colour      = sceneColour;
+        RenderGraphResource pingPong[2] = { sceneColour, postColour };
+        auto addPostPass                = [&](const char* name, bool enabled, const SharedPtr<Shader>& shader, void (RenderPasses::*pass)())
+        {
+            if(!enabled || !shader || !shader->IsCompiled())
+                return RenderGraph::PassBuilder(nullptr, 0);
+
+            RenderGraphResource input  = colour;
+            RenderGraphResource output = input == pingPong[0] ? pingPong[1] : pingPong[0];
+            colour                     = output;
+
+            return graph.AddPass(name,
+                                 [this, input, output, pass]()
+                                 {
+                                     m_MainTexture         = m_RenderGraph->GetTexture<Texture2D>(input);
+                                     m_PostProcessTexture1 = m_RenderGraph->GetTexture<Texture2D>(output);
+                                     (this->*pass)();
+                                 })
+                .Read(input)
+                .Write(output);
+        };
+
+        addPostPass("Depth Of Field", sceneRenderSettings.DepthOfFieldEnabled && postProcess && m_Camera, m_DepthOfFieldShader, &RenderPasses::DepthOfFieldPass).Read(depth);
+        addPostPass("Debanding", sceneRenderSettings.DebandingEnabled && postProcess, m_DebandingShader, &RenderPasses::DebandingPass);
+        addPostPass("Tone Mapping", true, m_ToneMappingPassShader, &RenderPasses::ToneMappingPass).Read(bloomTargets[1]).Read(bloomTargets[2]);
+
+        // Depth tested, so drawn while the colour still matches the depth size
+        auto addDebugPass = [&]()
+        {
+            if(!m_Settings.DebugPass || !sceneRenderSettings.DebugRenderEnabled)
+                return;
 
-        if(sceneRenderSettings.SharpenEnabled && !m_DisablePostProcess)
-            SharpenPass();
+            graph.AddPass("Debug",
+                          [this, colour]()
+                          {
+                              m_MainTexture = m_RenderGraph->GetTexture<Texture2D>(colour);
+                              DebugPass();
+                          })
+                .Read(colour)
+                .Write(colour)
+                .Read(depth)
+                .Write(depth);
+        };
+
+        if(temporal)
+        {
+            addDebugPass();
 
-        if(sceneRenderSettings.FXAAEnabled && !m_DisablePostProcess)
-            FXAAPass();
+            RenderGraphResource motionVectors   = graph.Create("Motion Vectors", motionDesc);
+            RenderGraphResource history         = graph.Import("Temporal History", m_TemporalHistory[m_TemporalFrame % 2]);
+            RenderGraphResource previousHistory = graph.Import("Previous Temporal History", m_TemporalHistory[(m_TemporalFrame + 1) % 2]);
+            RenderGraphResource input           = colour;
 
-        if(sceneRenderSettings.ChromaticAberationEnabled && !m_DisablePostProcess)
-            ChromaticAberationPass();
+            graph.AddPass("Motion Vectors",
+                          [this, motionVectors]()
+                          {
+                              m_MotionVectorTexture = m_RenderGraph->GetTexture<Texture2D>(motionVectors);
+                              MotionVectorPass();
+                          })
+                .Read(depth)
+                .Write(motionVectors);
+
+            graph.AddPass("Temporal Upscale",
+                          [this, input, history, motionVectors]()
+                          {
+                              m_MainTexture         = m_RenderGraph->GetTexture<Texture2D>(input);
+                              m_PostProcessTexture1 = m_RenderGraph->GetTexture<Texture2D>(history);
+                              m_MotionVectorTexture = m_RenderGraph->GetTexture<Texture2D>(motionVectors);
+                              TemporalUpscalePass();
+                          })
+                .Read(input)
+                .Read(depth)
+                .Read(motionVectors)
+                .Read(previousHistory)
+                .Write(history);
+
+            // The history is kept for next frame, effects after this ping-pong between display sized transients
+            colour      = history;
+            pingPong[0] = graph.Create("Display Colour", displayDesc);
+            pingPong[1] = graph.Create("Display Colour 2", displayDesc);
+        }
 
-        if(sceneRenderSettings.FilmicGrainEnabled && !m_DisablePostProcess)
-            FilmicGrainPass();
+        // The temporal upscale already antialiases
+        addPostPass("Sharpen", sceneRenderSettings.SharpenEnabled && postProcess && m_Camera, m_SharpenShader, &RenderPasses::SharpenPass);
+        addPostPass("FXAA", sceneRenderSettings.FXAAEnabled && postProcess && !temporal, m_FXAAShader, &RenderPasses::FXAAPass);
+        addPostPass("Chromatic Aberation", sceneRenderSettings.ChromaticAberationEnabled && postProcess && m_Camera, m_ChromaticAberationShader, &RenderPasses::ChromaticAberationPass);
+        addPostPass("Filmic Grain", sceneRenderSettings.FilmicGrainEnabled && postProcess, m_FilmicGrainShader, &RenderPasses::FilmicGrainPass);
 
         // if(sceneRenderSettings.OutlineEnabled
         // OutlinePass();
 
-        if(m_Settings.DebugPass && sceneRenderSettings.DebugRenderEnabled)
-            DebugPass();
+        if(!temporal)
+            addDebugPass();
 
-        FinalPass();
+        // The debug views keep the intermediate they show alive
+        RenderGraphResource debugView = RenderGraphNullResource;
+#ifndef LUMOS_DIST
+        switch(sceneRenderSettings.DebugMode)
+        {
+        case 1:
+            debugView = ssaoTarget;
+            break;
+        case 2:
+            debugView = ssaoBlur;
+            break;
+        case 3:
+            debugView = normals;
+            break;
+        case 4:
+            debugView = bloomTargets[0];
+            break;
+        case 6:
+            debugView = colour == sceneColour ? postColour : sceneColour;
+            break;
+        default:
+            break;
+        }
+#endif
+
+        graph.AddPass("Final",
+                      [this, colour]()
+                      {
+                          m_MainTexture = m_RenderGraph->GetTexture<Texture2D>(colour);
+                          FinalPass();
+                      })
+            .Read(colour)
+            .Read(debugView)
+            .SideEffect();
     }
 
     void RenderPasses::OnUpdate(const TimeStep& timeStep, Scene* scene)
@@ -1259,13 +2020,264 @@ namespace Lumos::Graphics
         ImGuiUtilities::Property("Max textures Per draw call", (int&)m_Renderer2DData.m_Limits.MaxTextures, 1, 16);
         ImGuiUtilities::Property("Exposure", m_Exposure);
 
+        ImGui::Columns(1);
+        ImGui::TextUnformatted("Render Graph");
+        ImGui::Columns(2);
+
+        m_RenderGraph->OnImGui();
+
+        ImGui::Columns(1);
+        ImGui::TextUnformatted("Dynamic Resolution");
+        ImGui::Columns(2);
+
+        auto& resolutionSettings = m_DynamicResolution.GetSettings();
+        if(ImGuiUtilities::Property("Dynamic Resolution Enabled", m_DynamicResolutionEnabled))
+            m_DynamicResolution.Reset(m_RenderScale);
+
+        if(m_DynamicResolutionEnabled)
+        {
+            ImGuiUtilities::Property("Target Frame Time (ms)", resolutionSettings.TargetFrameTime, 1.0f, 100.0f, 0.1f);
+            ImGuiUtilities::Property("Min Scale", resolutionSettings.MinScale, 0.25f, 1.0f, 0.05f);
+            ImGuiUtilities::Property("Max Scale", resolutionSettings.MaxScale, 0.25f, 2.0f, 0.05f);
+        }
+        else
+            ImGuiUtilities::Property("Render Scale", m_RenderScale, 0.25f, 2.0f, 0.05f);
+
+        ImGuiUtilities::Property("Temporal Upscaling", m_TemporalUpscaling);
+        ImGuiUtilities::Property("Temporal Blend", m_TemporalBlend, 0.01f, 1.0f, 0.01f);
+
+        float gpuTime = Renderer::GetRenderer()->GetGPUTime(GPUTimer_Frame);
+        float scale   = GetRenderScale();
+        ImGuiUtilities::Property("GPU Time (ms)", gpuTime, 0.0f, 0.0f, 0.0f, ImGuiUtilities::PropertyFlag::ReadOnly);
+        ImGuiUtilities::Property("Scale", scale, 0.0f, 0.0f, 0.0f, ImGuiUtilities::PropertyFlag::ReadOnly);
+        int renderWidth  = int(m_SceneTexture->GetWidth());
+        int renderHeight = int(m_SceneTexture->GetHeight());
+        ImGuiUtilities::Property("Render Width", renderWidth, ImGuiUtilities::PropertyFlag::ReadOnly);
+        ImGuiUtilities::Property("Render Height", renderHeight, ImGuiUtilities::PropertyFlag::ReadOnly);
+
+        ImGui::Columns(1);
+        ImGui::TextUnformatted("SSAO and Bloom");
+        ImGui::Columns(2);
+
+        static const char* qualityNames[] = { "Low", "Medium", "High" };
+        ImGuiUtilities::PropertyDropdown("SSAO Quality", qualityNames, 3, (int32_t*)&m_Settings.SSAOQuality);
+        ImGuiUtilities::PropertyDropdown("Bloom Quality", qualityNames, 3, (int32_t*)&m_Settings.BloomQuality);
+        ImGuiUtilities::Property("SSAO Depth Sharpness", m_SSAODepthSharpness, 0.0f, 100.0f, 0.5f);
+        ImGuiUtilities::Property("Compute SSAO", m_SSAOCompute, ImGuiUtilities::PropertyFlag::ReadOnly);
+        ImGuiUtilities::Property("Compute Bloom", m_BloomCompute, ImGuiUtilities::PropertyFlag::ReadOnly);
+
+        // Only the passes the last graph ran, the compute SSAO upsample also blurs
+        static const char* timerNames[] = { "Frame (ms)", "SSAO (ms)", "SSAO Blur (ms)", "Bloom (ms)", "Bloom Upsample (ms)" };
+        for(uint32_t timer = GPUTimer_SSAO; timer < GPUTimer_Count; timer++)
+        {
+            if(!(m_ActiveGPUTimers & (1u << timer)))
+                continue;
+
+            float passTime = Renderer::GetRenderer()->GetGPUTime(timer);
+            ImGuiUtilities::Property(timerNames[timer], passTime, 0.0f, 0.0f, 0.0f, ImGuiUtilities::PropertyFlag::ReadOnly);
+        }
+
+        ImGui::Columns(1);
+        ImGui::TextUnformatted("GPU Culling");
+        ImGui::Columns(2);
+
+        if(m_GPUCuller->IsSupported())
+        {
+            ImGuiUtilities::Property("GPU Culling Enabled", m_GPUCullingEnabled);
+            ImGuiUtilities::Property("Occlusion Culling", m_OcclusionCulling);
+
+            int testedDraws   = int(m_GPUCuller->GetDrawCount());
+            int visibleCamera = int(m_GPUCuller->GetVisibleCount(0));
+            int visibleShadow = 0;
+            for(uint32_t i = 0; i < m_ShadowData.m_ShadowMapNum; i++)
+                visibleShadow += int(m_GPUCuller->GetVisibleCount(i + 1));
+
+            ImGuiUtilities::Property("Tested Draws", testedDraws, ImGuiUtilities::PropertyFlag::ReadOnly);
+            ImGuiUtilities::Property("Visible Camera Draws", visibleCamera, ImGuiUtilities::PropertyFlag::ReadOnly);
+            ImGuiUtilities::Property("Visible Shadow Draws", visibleShadow, ImGuiUtilities::PropertyFlag::ReadOnly);
+        }
+        else
+            ImGui::TextUnformatted("Unsupported");
+
+        ImGui::Columns(1);
+        ImGui::TextUnformatted("CPU Occlusion");
+        ImGui::Columns(2);
+
+        ImGuiUtilities::Property("CPU Occlusion Enabled", m_CPUOcclusionEnabled);
+        ImGuiUtilities::Property("Cull Shadow Casters", m_CPUOcclusionShadows);
+        ImGuiUtilities::Property("Automatic Occluders", m_AutomaticOccluders);
+        ImGuiUtilities::Property("Occluder Min Size", m_OccluderMinSize, 0.0f, 1.0f, 0.01f);
+        ImGuiUtilities::Property("Max Occluders", (int&)m_MaxOccluders, 0, 512);
+        ImGuiUtilities::Property("Occluders", (int&)m_Stats.NumOccluders, ImGuiUtilities::PropertyFlag::ReadOnly);
+        ImGuiUtilities::Property("Occlusion Culled", (int&)m_Stats.NumOcclusionCulled, ImGuiUtilities::PropertyFlag::ReadOnly);
+
+        int occluderTriangles = m_CPUOcclusionActive ? int(m_OcclusionCullers[0]->GetTriangleCount()) : 0;
+        ImGuiUtilities::Property("Occluder Triangles", occluderTriangles, ImGuiUtilities::PropertyFlag::ReadOnly);
+
+        ImGui::Columns(1);
+        ImGui::TextUnformatted("Mesh LOD");
+        ImGui::Columns(2);
+
+        ImGuiUtilities::Property("LOD Enabled", m_LODEnabled);
+        ImGuiUtilities::Property("LOD Error Threshold (px)", m_LODErrorThreshold, 0.0f, 32.0f, 0.1f);
+        ImGuiUtilities::Property("LOD Hysteresis", m_LODHysteresis, 0.0f, 0.9f, 0.01f);
+        ImGuiUtilities::Property("LOD Switches", (int&)m_Stats.NumLODSwitches, ImGuiUtilities::PropertyFlag::ReadOnly);
+
+        ImGui::Columns(1);
+        ImGui::TextUnformatted("Animation LOD");
+        ImGui::Columns(2);
+
+        auto& animationLOD   = AnimationInstance::GetLODSettings();
+        auto& animationStats = AnimationInstance::GetLODStats();
+        int sampled          = int(animationStats.Sampled.load());
+        int interpolated     = int(animationStats.Interpolated.load());
+        int shared           = int(animationStats.Shared.load());
+        int skipped          = int(animationStats.Skipped.load());
+        int skinnedMeshes    = int(m_GPUSkinning->GetMeshCount());
+        int skinningJoints   = int(m_GPUSkinning->GetJointCount());
+
+        ImGuiUtilities::Property("Animation LOD Enabled", animationLOD.Enabled);
+        ImGuiUtilities::Property("Full Rate Size (px)", animationLOD.FullRatePixels, 0.0f, 2000.0f, 1.0f);
+        ImGuiUtilities::Property("Reduced Rate Size (px)", animationLOD.ReducedRatePixels, 0.0f, 2000.0f, 1.0f);
+        ImGuiUtilities::Property("Reduced Interval", (int&)animationLOD.ReducedInterval, 1, 16);
+        ImGuiUtilities::Property("Distant Interval", (int&)animationLOD.DistantInterval, 1, 16);
+        ImGuiUtilities::Property("Offscreen Interval", (int&)animationLOD.OffscreenInterval, 1, 32);
+        ImGuiUtilities::Property("Shared Pose Rate", animationLOD.SharedPoseRate, 1.0f, 60.0f, 1.0f);
+        ImGuiUtilities::Property("Sampled", sampled, ImGuiUtilities::PropertyFlag::ReadOnly);
+        ImGuiUtilities::Property("Interpolated", interpolated, ImGuiUtilities::PropertyFlag::ReadOnly);
+        ImGuiUtilities::Property("Shared", shared, ImGuiUtilities::PropertyFlag::ReadOnly);
+        ImGuiUtilities::Property("Skipped", skipped, ImGuiUtilities::PropertyFlag::ReadOnly);
+        ImGuiUtilities::Property("Skinned Meshes", skinnedMeshes, ImGuiUtilities::PropertyFlag::ReadOnly);
+        ImGuiUtilities::Property("Palette Joints", skinningJoints, ImGuiUtilities::PropertyFlag::ReadOnly);
+
         ImGui::Columns(1);
         ImGui::Separator();
         ImGui::PopStyleVar();
     }
 
+    uint32_t RenderPasses::SelectLOD(Mesh* mesh, float pixelsPerUnit, uint8_t& currentLOD)
+    {
+        uint32_t lodCount = mesh->GetLODCount();
+        uint32_t lod      = Maths::Min(uint32_t(currentLOD), lodCount - 1);
+
+        // Refine while the current level is visibly wrong, only coarsen once comfortably under the threshold
+        while(lod > 0 && mesh->GetLOD(lod)->GetLODError() * pixelsPerUnit > m_LODErrorThreshold)
+            lod--;
+
+        while(lod + 1 < lodCount && mesh->GetLOD(lod + 1)->GetLODError() * pixelsPerUnit <= m_LODErrorThreshold * (1.0f - m_LODHysteresis))
+            lod++;
+
+        if(lod != currentLOD)
+        {
+            currentLOD = uint8_t(lod);
+            m_Stats.NumLODSwitches++;
+        }
+
+        return lod;
+    }
+
+    void RenderPasses::RenderOccluders(Scene* scene, const glm::vec3& cameraPosition, float cameraPixelsPerUnit, bool cameraOrthographic, bool shadows)
+    {
+        LUMOS_PROFILE_FUNCTION();
+
+        struct OccluderCandidate
+        {
+            Mesh* Source;
+            Mesh* Proxy;
+            const glm::mat4* Transform;
+            float Priority;
+        };
+
+        std::vector<OccluderCandidate> candidates;
+
+        auto& registry     = scene->GetRegistry();
+        auto group         = registry.group<ModelComponent>(entt::get<Maths::Transform>);
+        float screenHeight = (float)m_SceneTexture->GetHeight();
+
+        for(auto entity : group)
+        {
+            if(!Entity(entity, scene).Active())
+                continue;
+
+            const auto& [model, trans] = group.get<ModelComponent, Maths::Transform>(entity);
+
+            if(!model.ModelRef)
+                continue;
+
+            auto& worldTransform = trans.GetWorldMatrix();
+
+            for(auto& mesh : model.ModelRef->GetMeshes())
+            {
+                // Skinned meshes move away from their rest pose vertices
+                if(!mesh->GetActive() || mesh->IsSkinned() || mesh->GetVertices().empty())
+                    continue;
+
+                Material* material = mesh->GetMaterial() ? mesh->GetMaterial().get() : m_ForwardData.m_DefaultMaterial;
+                if(material->GetFlag(Material::RenderFlags::ALPHABLEND) || !material->GetFlag(Material::RenderFlags::DEPTHTEST))
+                    continue;
+
+                bool flagged = material->GetFlag(Material::RenderFlags::OCCLUDER);
+                if(!flagged && !m_AutomaticOccluders)
+                    continue;
+
+                auto bb = mesh->GetBoundingBox()->Transformed(worldTransform);
+
+                bool inside = m_ForwardData.m_Frustum.IsInside(bb);
+                for(uint32_t i = 0; shadows && !inside && i < m_ShadowData.m_ShadowMapNum; i++)
+                    inside = m_ShadowData.m_CascadeFrustums[i].IsInside(bb);
+
+                if(!inside)
+                    continue;
+
+                // Size the mesh would have on screen, used for cascades too as an estimate of how much it hides
+                float distance   = cameraOrthographic ? 1.0f : Maths::Max(glm::length(bb.Center() - cameraPosition), m_Camera->GetNear());
+                float screenSize = cameraPixelsPerUnit * glm::length(bb.Size()) / distance / screenHeight;
+
+                if(!flagged && screenSize < m_OccluderMinSize)
+                    continue;
+
+                // The coarsest LOD is the proxy, LODs index the base mesh's vertices
+                OccluderCandidate candidate;
+                candidate.Source    = mesh.get();
+                candidate.Proxy     = mesh->GetLOD(mesh->GetLODCount() - 1);
+                candidate.Transform = &worldTransform;
+                candidate.Priority  = flagged ? std::numeric_limits<float>::max() : screenSize;
+                candidates.push_back(candidate);
+            }
+        }
+
+        if(candidates.size() > m_MaxOccluders)
+        {
+            std::partial_sort(candidates.begin(), candidates.begin() + m_MaxOccluders, candidates.end(), [](const OccluderCandidate& a, const OccluderCandidate& b)
+                              { return a.Priority > b.Priority; });
+            candidates.resize(m_MaxOccluders);
+        }
+
+        m_Stats.NumOccluders = uint32_t(candidates.size());
+
+        // Culling casters against the same occluders seen from the light is safe, whatever is behind an occluder
+        // there only shadows what the occluder already shadows
+        uint32_t viewCount = 1 + (shadows ? m_ShadowData.m_ShadowMapNum : 0);
+        for(uint32_t view = 0; view < viewCount; view++)
+        {
+            auto& culler = m_OcclusionCullers[view];
+            culler->Begin(view == 0 ? m_ProjView : m_ShadowData.m_ShadowProjView[view - 1]);
+
+            for(auto& candidate : candidates)
+            {
+                const auto& indices = candidate.Proxy->GetIndices();
+                culler->AddOccluder(candidate.Source->GetVertices().data(), indices.data(), uint32_t(indices.size()), *candidate.Transform);
+            }
+
+            culler->Rasterise();
+        }
+    }
+
     void RenderPasses::OnNewScene(Scene* scene)
     {
+        m_HasPreviousDepth = false;
+        m_HistoryValid     = false;
+
         m_ForwardData.m_EnvironmentMap = m_DefaultTextureCube;
         m_ForwardData.m_IrradianceMap  = m_DefaultTextureCube;
 
@@ -1458,7 +2470,7 @@ namespace Lumos::Graphics
         if(empty)
             return;
 
-        m_ShadowData.m_DescriptorSet[0]->SetUniform("ShadowData", "LightMatrices", m_ShadowData.m_ShadowProjView);
+        m_ShadowData.m_DescriptorSet[0]->SetUniform(m_PassUniforms.ShadowLightMatrices, m_ShadowData.m_ShadowProjView);
         m_ShadowData.m_DescriptorSet[0]->Update();
 
         Graphics::PipelineDesc pipelineDesc;
@@ -1491,8 +2503,6 @@ namespace Lumos::Graphics
             {
                 m_Stats.NumShadowObjects++;
 
-                Mesh* mesh = command.mesh;
-
                 auto trans = command.transform;
                 memcpy(pushConstants[0].data, &trans, sizeof(glm::mat4));
 
@@ -1501,7 +2511,7 @@ namespace Lumos::Graphics
 
                 m_ShadowData.m_Shader->BindPushConstants(commandBuffer, pipeline.get());
                 Renderer::BindDescriptorSets(pipeline.get(), commandBuffer, 0, m_ShadowData.m_CurrentDescriptorSets.data(), 2);
-                Renderer::DrawMesh(commandBuffer, pipeline.get(), mesh);
+                DrawCommand(commandBuffer, pipeline.get(), command);
             }
 
             pipeline->End(commandBuffer);
@@ -1534,7 +2544,6 @@ namespace Lumos::Graphics
             if(!command.material->GetFlag(Material::RenderFlags::DEPTHTEST) || command.material->GetFlag(Material::RenderFlags::ALPHABLEND))
                 continue;
 
-            Mesh* mesh           = command.mesh;
             auto& worldTransform = command.transform;
 
             DescriptorSet* sets[2];
@@ -1548,7 +2557,7 @@ namespace Lumos::Graphics
 
             m_DepthPrePassShader->BindPushConstants(commandBuffer, pipeline);
             Renderer::BindDescriptorSets(pipeline, commandBuffer, 0, sets, 2);
-            Renderer::DrawMesh(commandBuffer, pipeline, mesh);
+            DrawCommand(commandBuffer, pipeline, command);
         }
 
         if(commandBuffer)
@@ -1577,35 +2586,18 @@ namespace Lumos::Graphics
         float nearC = m_Camera->GetNear();
         float farC  = m_Camera->GetFar();
 
-        static glm::vec4 samples[64];
-        static bool init = false;
-
-        if(!init)
-        {
-            for(uint32_t i = 0; i < 64; ++i)
-            {
-                glm::vec3 sample(Random32::Rand(-0.9f, 0.9f), Random32::Rand(-0.9f, 0.9f), Random32::Rand(0.0f, 1.0f));
-                sample = glm::normalize(sample);      // Snap to surface of hemisphere
-                sample *= Random32::Rand(0.0f, 1.0f); // Space out linearly
-                float scale = (float)i / (float)64;
-                scale       = Maths::Lerp(0.1f, 1.0f, scale * scale); // Bring distribution of samples closer to origin
-                samples[i]  = glm::vec4(sample * scale, 0.0f);
-            }
-            init = true;
-        }
-
         Scene::SceneRenderSettings& renderSettings = m_CurrentScene->GetSettings().RenderSettings;
 
-        m_SSAOPassDescriptorSet->SetUniform("UniformBuffer", "invProj", &invProj);
-        m_SSAOPassDescriptorSet->SetUniform("UniformBuffer", "projection", &projection);
-        m_SSAOPassDescriptorSet->SetUniform("UniformBuffer", "view", &view);
+        m_SSAOPassDescriptorSet->SetUniform(m_PassUniforms.SSAOInvProj, &invProj);
+        m_SSAOPassDescriptorSet->SetUniform(m_PassUniforms.SSAOProjection, &projection);
+        m_SSAOPassDescriptorSet->SetUniform(m_PassUniforms.SSAOView, &view);
 
-        m_SSAOPassDescriptorSet->SetUniform("UniformBuffer", "samples", &samples);
-        m_SSAOPassDescriptorSet->SetUniform("UniformBuffer", "ssaoRadius", &renderSettings.SSAOSampleRadius);
+        m_SSAOPassDescriptorSet->SetUniform(m_PassUniforms.SSAOSamples, SSAOKernel());
+        m_SSAOPassDescriptorSet->SetUniform(m_PassUniforms.SSAORadius, &renderSettings.SSAOSampleRadius);
 
-        m_SSAOPassDescriptorSet->SetUniform("UniformBuffer", "near", &nearC);
-        m_SSAOPassDescriptorSet->SetUniform("UniformBuffer", "far", &farC);
-        m_SSAOPassDescriptorSet->SetUniform("UniformBuffer", "strength", &renderSettings.SSAOStrength);
+        m_SSAOPassDescriptorSet->SetUniform(m_PassUniforms.SSAONear, &nearC);
+        m_SSAOPassDescriptorSet->SetUniform(m_PassUniforms.SSAOFar, &farC);
+        m_SSAOPassDescriptorSet->SetUniform(m_PassUniforms.SSAOStrength, &renderSettings.SSAOStrength);
 
         m_SSAOPassDescriptorSet->SetTexture("in_Depth", m_ForwardData.m_DepthTexture);
         m_SSAOPassDescriptorSet->SetTexture("in_Noise", m_NoiseTexture);
@@ -1641,8 +2633,8 @@ namespace Lumos::Graphics
 
         Scene::SceneRenderSettings& renderSettings = m_CurrentScene->GetSettings().RenderSettings;
 
-        m_SSAOBlurPassDescriptorSet->SetUniform("UniformBuffer", "ssaoTexelOffset", &ssaoTexelOffset);
-        m_SSAOBlurPassDescriptorSet->SetUniform("UniformBuffer", "ssaoBlurRadius", &renderSettings.SSAOBlurRadius);
+        m_SSAOBlurPassDescriptorSet->SetUniform(m_PassUniforms.SSAOBlurTexelOffset, &ssaoTexelOffset);
+        m_SSAOBlurPassDescriptorSet->SetUniform(m_PassUniforms.SSAOBlurRadius, &renderSettings.SSAOBlurRadius);
 
         m_SSAOBlurPassDescriptorSet->SetTexture("in_Depth", m_ForwardData.m_DepthTexture);
         m_SSAOBlurPassDescriptorSet->SetTexture("in_SSAO", m_SSAOTexture);
@@ -1652,8 +2644,8 @@ namespace Lumos::Graphics
 
         ssaoTexelOffset = glm::vec2(2.0f / m_SSAOTexture->GetWidth(), 0.0f);
 
-        m_SSAOBlurPassDescriptorSet2->SetUniform("UniformBuffer", "ssaoTexelOffset", &ssaoTexelOffset);
-        m_SSAOBlurPassDescriptorSet2->SetUniform("UniformBuffer", "ssaoBlurRadius", &renderSettings.SSAOBlurRadius);
+        m_SSAOBlurPassDescriptorSet2->SetUniform(m_PassUniforms.SSAOBlurTexelOffset, &ssaoTexelOffset);
+        m_SSAOBlurPassDescriptorSet2->SetUniform(m_PassUniforms.SSAOBlurRadius, &renderSettings.SSAOBlurRadius);
 
         m_SSAOBlurPassDescriptorSet2->SetTexture("in_Depth", m_ForwardData.m_DepthTexture);
         m_SSAOBlurPassDescriptorSet2->SetTexture("in_SSAO", m_SSAOTexture1);
@@ -1682,6 +2674,112 @@ namespace Lumos::Graphics
         pipeline->End(commandBuffer);
     }
 
+    void RenderPasses::SSAOComputePass()
+    {
+        LUMOS_PROFILE_FUNCTION();
+        LUMOS_PROFILE_GPU("SSAO Compute Pass");
+
+        if(!m_Camera || !m_SSAOTexture)
+            return;
+
+        auto commandBuffer = Renderer::GetMainSwapChain()->GetCurrentCommandBuffer();
+
+        auto projection = m_Camera->GetProjectionMatrix();
+        auto invProj    = glm::inverse(projection);
+        auto view       = glm::inverse(m_CameraTransform->GetWorldMatrix());
+
+        const SSAOPreset& preset                   = SSAOPresets[int(m_Settings.SSAOQuality)];
+        Scene::SceneRenderSettings& renderSettings = m_CurrentScene->GetSettings().RenderSettings;
+        int32_t sampleCount                        = preset.SampleCount;
+        int32_t scale                              = int32_t(preset.Divisor);
+
+        auto set = m_SSAOComputeDescriptorSet.get();
+        set->SetUniform(m_PassUniforms.SSAOComputeProjection, &projection);
+        set->SetUniform(m_PassUniforms.SSAOComputeInvProj, &invProj);
+        set->SetUniform(m_PassUniforms.SSAOComputeView, &view);
+        set->SetUniform(m_PassUniforms.SSAOComputeSamples, SSAOKernel());
+        set->SetUniform(m_PassUniforms.SSAOComputeRadius, &renderSettings.SSAOSampleRadius);
+        set->SetUniform(m_PassUniforms.SSAOComputeStrength, &renderSettings.SSAOStrength);
+        set->SetUniform(m_PassUniforms.SSAOComputeSampleCount, &sampleCount);
+        set->SetUniform(m_PassUniforms.SSAOComputeScale, &scale);
+
+        set->SetTexture("in_Depth", m_ForwardData.m_DepthTexture);
+        set->SetTexture("in_Normal", m_NormalTexture);
+        set->SetTexture("in_Noise", m_NoiseTexture);
+        set->SetTexture("o_Image", m_SSAOTexture);
+        set->TransitionImages(commandBuffer);
+        set->Update(commandBuffer);
+
+        Graphics::PipelineDesc pipelineDesc {};
+        pipelineDesc.shader    = m_SSAOComputeShader;
+        pipelineDesc.DebugName = "SSAO Compute";
+
+        auto pipeline = Graphics::Pipeline::Get(pipelineDesc);
+        pipeline->Bind(commandBuffer);
+
+        Renderer::BindDescriptorSets(pipeline.get(), commandBuffer, 0, &set, 1);
+
+        uint32_t workGroupSize = 8;
+        uint32_t workGroupsX   = (m_SSAOTexture->GetWidth() + workGroupSize - 1) / workGroupSize;
+        uint32_t workGroupsY   = (m_SSAOTexture->GetHeight() + workGroupSize - 1) / workGroupSize;
+        Renderer::GetRenderer()->Dispatch(commandBuffer, workGroupsX, workGroupsY, 1);
+
+        pipeline->End(commandBuffer);
+    }
+
+    void RenderPasses::SSAOUpsamplePass()
+    {
+        LUMOS_PROFILE_FUNCTION();
+        LUMOS_PROFILE_GPU("SSAO Upsample Pass");
+
+        if(!m_Camera || !m_SSAOTexture || !m_SSAOTexture1)
+            return;
+
+        auto commandBuffer = Renderer::GetMainSwapChain()->GetCurrentCommandBuffer();
+
+        struct SSAOUpsamplePushConstants
+        {
+            glm::vec4 DepthParams;
+            glm::vec4 Params;
+        } ssaoUpsamplePushConstants;
+
+        // View z and w only depend on depth, through these terms of the inverse projection
+        glm::mat4 invProj                     = glm::inverse(m_Camera->GetProjectionMatrix());
+        Scene::SceneRenderSettings& settings  = m_CurrentScene->GetSettings().RenderSettings;
+        ssaoUpsamplePushConstants.DepthParams = glm::vec4(invProj[2][2], invProj[3][2], invProj[2][3], invProj[3][3]);
+        ssaoUpsamplePushConstants.Params.x    = (float)SSAOPresets[int(m_Settings.SSAOQuality)].Divisor;
+        ssaoUpsamplePushConstants.Params.y    = (float)(settings.SSAOBlur ? settings.SSAOBlurRadius : 1);
+        ssaoUpsamplePushConstants.Params.z    = m_SSAODepthSharpness;
+        ssaoUpsamplePushConstants.Params.w    = 0.0f;
+
+        auto set = m_SSAOUpsampleDescriptorSet.get();
+        set->SetTexture("u_SSAO", m_SSAOTexture);
+        set->SetTexture("u_Depth", m_ForwardData.m_DepthTexture);
+        set->SetTexture("o_Image", m_SSAOTexture1);
+        set->TransitionImages(commandBuffer);
+        set->Update(commandBuffer);
+
+        Graphics::PipelineDesc pipelineDesc {};
+        pipelineDesc.shader    = m_SSAOUpsampleShader;
+        pipelineDesc.DebugName = "SSAO Upsample";
+
+        auto pipeline = Graphics::Pipeline::Get(pipelineDesc);
+        pipeline->Bind(commandBuffer);
+
+        auto& pushConstants = m_SSAOUpsampleShader->GetPushConstants();
+        memcpy(pushConstants[0].data, &ssaoUpsamplePushConstants, sizeof(SSAOUpsamplePushConstants));
+        m_SSAOUpsampleShader->BindPushConstants(commandBuffer, pipeline.get());
+
+        Renderer::BindDescriptorSets(pipeline.get(), commandBuffer, 0, &set, 1);
+
+        uint32_t workGroupSize = 16;
+        uint32_t workGroupsX   = (m_SSAOTexture1->GetWidth() + workGroupSize - 1) / workGroupSize;
+        uint32_t workGroupsY   = (m_SSAOTexture1->GetHeight() + workGroupSize - 1) / workGroupSize;
+        Renderer::GetRenderer()->Dispatch(commandBuffer, workGroupsX, workGroupsY, 1);
+
+        pipeline->End(commandBuffer);
+    }
+
     void RenderPasses::ForwardPass()
     {
         LUMOS_PROFILE_FUNCTION();
@@ -1689,6 +2787,7 @@ namespace Lumos::Graphics
 
         if(m_ForwardData.m_CommandQueue.empty())
             return;
+        m_ForwardData.m_DescriptorSet[2]->SetTexture("uSSAOMap", m_SSAOTexture ? m_SSAOTexture : Material::GetDefaultTexture().get());
         m_ForwardData.m_DescriptorSet[2]->Update();
 
         Graphics::CommandBuffer* commandBuffer = Renderer::GetMainSwapChain()->GetCurrentCommandBuffer();
@@ -1697,10 +2796,14 @@ namespace Lumos::Graphics
         {
             m_Stats.NumRenderedObjects++;
 
-            Mesh* mesh           = command.mesh;
             auto& worldTransform = command.transform;
             Material* material   = command.material ? command.material : m_ForwardData.m_DefaultMaterial;
             auto pipeline        = command.pipeline;
+
+            // Skipped until a new material's pipeline variant finishes compiling
+            if(!pipeline->IsReady())
+                continue;
+
             commandBuffer->BindPipeline(pipeline);
 
             m_ForwardData.m_CurrentDescriptorSets[0] = m_ForwardData.m_DescriptorSet[0].get();
@@ -1712,7 +2815,7 @@ namespace Lumos::Graphics
 
             m_ForwardData.m_Shader->BindPushConstants(commandBuffer, pipeline);
             Renderer::BindDescriptorSets(pipeline, commandBuffer, 0, m_ForwardData.m_CurrentDescriptorSets.data(), 3);
-            Renderer::DrawMesh(commandBuffer, pipeline, mesh);
+            DrawCommand(commandBuffer, pipeline, command);
         }
 
         if(commandBuffer)
@@ -1733,9 +2836,9 @@ namespace Lumos::Graphics
         int mode        = 0;
         float exposure  = m_Exposure * 120000.0f;
         float blurLevel = m_CurrentScene->GetSettings().RenderSettings.SkyboxMipLevel;
-        m_SkyboxDescriptorSet->SetUniform("UniformBuffer", "Mode", &mode);
-        m_SkyboxDescriptorSet->SetUniform("UniformBuffer", "Exposure", &exposure);
-        m_SkyboxDescriptorSet->SetUniform("UniformBuffer", "BlurLevel", &blurLevel);
+        m_SkyboxDescriptorSet->SetUniform(m_PassUniforms.SkyboxMode, &mode);
+        m_SkyboxDescriptorSet->SetUniform(m_PassUniforms.SkyboxExposure, &exposure);
+        m_SkyboxDescriptorSet->SetUniform(m_PassUniforms.SkyboxBlurLevel, &blurLevel);
         m_SkyboxDescriptorSet->SetTexture("u_CubeMap", m_CubeMap, 0, TextureType::CUBE);
         m_SkyboxDescriptorSet->Update();
 
@@ -1783,8 +2886,8 @@ namespace Lumos::Graphics
         glm::vec2 DepthConsts = { depthLinearizeMul, depthLinearizeAdd };
         glm::vec2 DOFParams   = { renderSettings.DepthOfFieldDistance, renderSettings.DepthOfFieldStrength };
 
-        m_DepthOfFieldPassDescriptorSet->SetUniform("UniformBuffer", "DOFParams", &DOFParams);
-        m_DepthOfFieldPassDescriptorSet->SetUniform("UniformBuffer", "DepthConsts", &DepthConsts);
+        m_DepthOfFieldPassDescriptorSet->SetUniform(m_PassUniforms.DOFParams, &DOFParams);
+        m_DepthOfFieldPassDescriptorSet->SetUniform(m_PassUniforms.DOFDepthConsts, &DepthConsts);
 
         m_DepthOfFieldPassDescriptorSet->SetTexture("u_Texture", m_MainTexture);
         m_DepthOfFieldPassDescriptorSet->SetTexture("u_DepthTexture", m_ForwardData.m_DepthTexture);
@@ -1845,6 +2948,83 @@ namespace Lumos::Graphics
         std::swap(m_PostProcessTexture1, m_MainTexture);
     }
 
+    void RenderPasses::MotionVectorPass()
+    {
+        LUMOS_PROFILE_FUNCTION();
+        LUMOS_PROFILE_GPU("Motion Vector Pass");
+
+        glm::mat4 view         = glm::inverse(m_CameraTransform->GetWorldMatrix());
+        glm::mat4 jitteredProj = glm::translate(glm::mat4(1.0f), glm::vec3(m_Jitter, 0.0f)) * m_Camera->GetProjectionMatrix();
+        glm::mat4 invViewProj  = glm::inverse(jitteredProj * view);
+
+        // Without a previous frame nothing has moved
+        glm::mat4 prevViewProj = m_HistoryValid ? m_PrevProjView : m_ProjView;
+
+        m_MotionVectorDescriptorSet->SetUniform(m_PassUniforms.MotionInvViewProj, &invViewProj);
+        m_MotionVectorDescriptorSet->SetUniform(m_PassUniforms.MotionViewProj, &m_ProjView);
+        m_MotionVectorDescriptorSet->SetUniform(m_PassUniforms.MotionPrevViewProj, &prevViewProj);
+        m_MotionVectorDescriptorSet->SetTexture("u_DepthTexture", m_ForwardData.m_DepthTexture);
+        m_MotionVectorDescriptorSet->Update();
+
+        Graphics::PipelineDesc pipelineDesc {};
+        pipelineDesc.shader              = m_MotionVectorShader;
+        pipelineDesc.polygonMode         = Graphics::PolygonMode::FILL;
+        pipelineDesc.cullMode            = Graphics::CullMode::BACK;
+        pipelineDesc.transparencyEnabled = false;
+        pipelineDesc.colourTargets[0]    = m_MotionVectorTexture;
+        pipelineDesc.DebugName           = "Motion Vectors";
+        auto commandBuffer               = Renderer::GetMainSwapChain()->GetCurrentCommandBuffer();
+        auto pipeline                    = Graphics::Pipeline::Get(pipelineDesc);
+        pipeline->Bind(commandBuffer);
+
+        auto set = m_MotionVectorDescriptorSet.get();
+        Renderer::BindDescriptorSets(pipeline.get(), commandBuffer, 0, &set, 1);
+        Renderer::Draw(commandBuffer, DrawType::TRIANGLE, 3);
+
+        pipeline->End(commandBuffer);
+    }
+
+    void RenderPasses::TemporalUpscalePass()
+    {
+        LUMOS_PROFILE_FUNCTION();
+        LUMOS_PROFILE_GPU("Temporal Upscale Pass");
+
+        Texture2D* previousHistory = m_TemporalHistory[(m_TemporalFrame + 1) % 2];
+
+        // Offset in uv from an output pixel to where this frame sampled it
+        glm::vec4 jitter = glm::vec4(m_Jitter * 0.5f, m_TemporalBlend, m_HistoryValid ? 1.0f : 0.0f);
+        glm::vec4 size   = glm::vec4(m_MainTexture->GetWidth(), m_MainTexture->GetHeight(), m_PostProcessTexture1->GetWidth(), m_PostProcessTexture1->GetHeight());
+
+        m_TemporalUpscaleDescriptorSet->SetUniform(m_PassUniforms.TemporalJitter, &jitter);
+        m_TemporalUpscaleDescriptorSet->SetUniform(m_PassUniforms.TemporalSize, &size);
+        m_TemporalUpscaleDescriptorSet->SetTexture("u_Texture", m_MainTexture);
+        m_TemporalUpscaleDescriptorSet->SetTexture("u_History", previousHistory);
+        m_TemporalUpscaleDescriptorSet->SetTexture("u_MotionVectors", m_MotionVectorTexture);
+        m_TemporalUpscaleDescriptorSet->SetTexture("u_DepthTexture", m_ForwardData.m_DepthTexture);
+        m_TemporalUpscaleDescriptorSet->Update();
+
+        Graphics::PipelineDesc pipelineDesc {};
+        pipelineDesc.shader              = m_TemporalUpscaleShader;
+        pipelineDesc.polygonMode         = Graphics::PolygonMode::FILL;
+        pipelineDesc.cullMode            = Graphics::CullMode::BACK;
+        pipelineDesc.transparencyEnabled = false;
+        pipelineDesc.colourTargets[0]    = m_PostProcessTexture1;
+        pipelineDesc.DebugName           = "Temporal Upscale";
+        auto commandBuffer               = Renderer::GetMainSwapChain()->GetCurrentCommandBuffer();
+        auto pipeline                    = Graphics::Pipeline::Get(pipelineDesc);
+        pipeline->Bind(commandBuffer);
+
+        auto set = m_TemporalUpscaleDescriptorSet.get();
+        Renderer::BindDescriptorSets(pipeline.get(), commandBuffer, 0, &set, 1);
+        Renderer::Draw(commandBuffer, DrawType::TRIANGLE, 3);
+
+        pipeline->End(commandBuffer);
+
+        m_HistoryValid     = true;
+        m_LastRenderTarget = m_PostProcessTexture1;
+        std::swap(m_PostProcessTexture1, m_MainTexture);
+    }
+
     void RenderPasses::ToneMappingPass()
     {
         LUMOS_PROFILE_FUNCTION();
@@ -1855,11 +3035,11 @@ namespace Lumos::Graphics
         float Brightness     = m_CurrentScene->GetSettings().RenderSettings.Brightness;
         float Contrast       = m_CurrentScene->GetSettings().RenderSettings.Contrast;
 
-        m_ToneMappingPassDescriptorSet->SetUniform("UniformBuffer", "BloomIntensity", &bloomIntensity);
-        m_ToneMappingPassDescriptorSet->SetUniform("UniformBuffer", "ToneMapIndex", &m_ToneMapIndex);
-        m_ToneMappingPassDescriptorSet->SetUniform("UniformBuffer", "Brightness", &Brightness);
-        m_ToneMappingPassDescriptorSet->SetUniform("UniformBuffer", "Contrast", &Contrast);
-        m_ToneMappingPassDescriptorSet->SetUniform("UniformBuffer", "Saturation", &Saturation);
+        m_ToneMappingPassDescriptorSet->SetUniform(m_PassUniforms.ToneMapBloomIntensity, &bloomIntensity);
+        m_ToneMappingPassDescriptorSet->SetUniform(m_PassUniforms.ToneMapIndex, &m_ToneMapIndex);
+        m_ToneMappingPassDescriptorSet->SetUniform(m_PassUniforms.ToneMapBrightness, &Brightness);
+        m_ToneMappingPassDescriptorSet->SetUniform(m_PassUniforms.ToneMapContrast, &Contrast);
+        m_ToneMappingPassDescriptorSet->SetUniform(m_PassUniforms.ToneMapSaturation, &Saturation);
 
         m_ToneMappingPassDescriptorSet->SetTexture("u_Texture", m_MainTexture);
         m_ToneMappingPassDescriptorSet->SetTexture("u_BloomTexture", m_BloomTextureLastRenderered);
@@ -1920,6 +3100,10 @@ namespace Lumos::Graphics
         default:
             break;
         }
+
+        // Intermediates of disabled effects are never allocated
+        if(!finalPassTexture)
+            finalPassTexture = m_MainTexture;
 #endif
         m_FinalPassDescriptorSet->SetTexture("u_Texture", finalPassTexture);
         m_FinalPassDescriptorSet->Update();
@@ -2304,6 +3488,106 @@ namespace Lumos::Graphics
         }
     }
 
+    void RenderPasses::BloomDownsamplePass()
+    {
+        LUMOS_PROFILE_FUNCTION();
+        LUMOS_PROFILE_GPU("Bloom Downsample Pass");
+
+        if(!m_BloomTexture || m_BloomTexture->GetWidth() == 0 || m_BloomTexture->GetHeight() == 0)
+            return;
+
+        auto commandBuffer = Renderer::GetMainSwapChain()->GetCurrentCommandBuffer();
+
+        struct BloomComputePushConstants
+        {
+            glm::vec4 Params;
+            glm::vec4 Params2;
+        } bloomComputePushConstants;
+
+        auto& renderSettings              = m_CurrentScene->GetSettings().RenderSettings;
+        uint32_t levels                   = Maths::Min(BloomPresetLevels[int(m_Settings.BloomQuality)], m_BloomTexture->GetMipMapLevels());
+        bloomComputePushConstants.Params  = { renderSettings.BloomThreshold, renderSettings.BloomThreshold - renderSettings.BloomKnee, renderSettings.BloomKnee * 2.0f, 0.25f / renderSettings.BloomKnee };
+        bloomComputePushConstants.Params2 = { (float)levels, 0.0f, 0.0f, 0.0f };
+
+        // Levels past the chain still need a valid image, they are not written
+        static const char* mipNames[] = { "o_Mip0", "o_Mip1", "o_Mip2", "o_Mip3", "o_Mip4", "o_Mip5" };
+
+        auto set = m_BloomDownsampleDescriptorSet.get();
+        set->SetTexture("u_Texture", m_MainTexture);
+        for(uint32_t i = 0; i < 6; i++)
+            set->SetTexture(mipNames[i], m_BloomTexture, Maths::Min(i, levels - 1));
+        set->TransitionImages(commandBuffer);
+        set->Update(commandBuffer);
+
+        Graphics::PipelineDesc pipelineDesc {};
+        pipelineDesc.shader    = m_BloomDownsampleShader;
+        pipelineDesc.DebugName = "Bloom Downsample";
+
+        auto pipeline = Graphics::Pipeline::Get(pipelineDesc);
+        pipeline->Bind(commandBuffer);
+
+        auto& pushConstants = m_BloomDownsampleShader->GetPushConstants();
+        memcpy(pushConstants[0].data, &bloomComputePushConstants, sizeof(BloomComputePushConstants));
+        m_BloomDownsampleShader->BindPushConstants(commandBuffer, pipeline.get());
+
+        Renderer::BindDescriptorSets(pipeline.get(), commandBuffer, 0, &set, 1);
+
+        // A workgroup covers 32x32 texels of the first level
+        uint32_t tileSize    = 32;
+        uint32_t workGroupsX = (m_BloomTexture->GetWidth() + tileSize - 1) / tileSize;
+        uint32_t workGroupsY = (m_BloomTexture->GetHeight() + tileSize - 1) / tileSize;
+        Renderer::GetRenderer()->Dispatch(commandBuffer, workGroupsX, workGroupsY, 1);
+
+        pipeline->End(commandBuffer);
+    }
+
+    void RenderPasses::BloomUpsamplePass()
+    {
+        LUMOS_PROFILE_FUNCTION();
+        LUMOS_PROFILE_GPU("Bloom Upsample Pass");
+
+        if(!m_BloomTexture || !m_BloomTexture1 || m_BloomTexture1->GetWidth() == 0 || m_BloomTexture1->GetHeight() == 0)
+            return;
+
+        auto commandBuffer = Renderer::GetMainSwapChain()->GetCurrentCommandBuffer();
+
+        struct BloomUpsamplePushConstants
+        {
+            glm::vec4 Params;
+        } bloomUpsamplePushConstants;
+
+        uint32_t levels                   = Maths::Min(BloomPresetLevels[int(m_Settings.BloomQuality)], m_BloomTexture->GetMipMapLevels());
+        bloomUpsamplePushConstants.Params = { (float)levels, m_CurrentScene->GetSettings().RenderSettings.BloomUpsampleScale, 0.0f, 0.0f };
+
+        auto set = m_BloomUpsampleDescriptorSet.get();
+        set->SetTexture("u_Downsample", m_BloomTexture);
+        set->SetTexture("o_Image", m_BloomTexture1);
+        set->TransitionImages(commandBuffer);
+        set->Update(commandBuffer);
+
+        Graphics::PipelineDesc pipelineDesc {};
+        pipelineDesc.shader    = m_BloomUpsampleShader;
+        pipelineDesc.DebugName = "Bloom Upsample";
+
+        auto pipeline = Graphics::Pipeline::Get(pipelineDesc);
+        pipeline->Bind(commandBuffer);
+
+        auto& pushConstants = m_BloomUpsampleShader->GetPushConstants();
+        memcpy(pushConstants[0].data, &bloomUpsamplePushConstants, sizeof(BloomUpsamplePushConstants));
+        m_BloomUpsampleShader->BindPushConstants(commandBuffer, pipeline.get());
+
+        Renderer::BindDescriptorSets(pipeline.get(), commandBuffer, 0, &set, 1);
+
+        uint32_t tileSize    = 16;
+        uint32_t workGroupsX = (m_BloomTexture1->GetWidth() + tileSize - 1) / tileSize;
+        uint32_t workGroupsY = (m_BloomTexture1->GetHeight() + tileSize - 1) / tileSize;
+        Renderer::GetRenderer()->Dispatch(commandBuffer, workGroupsX, workGroupsY, 1);
+
+        pipeline->End(commandBuffer);
+
+        m_BloomTextureLastRenderered = m_BloomTexture1;
+    }
+
     void RenderPasses::FXAAPass()
     {
         LUMOS_PROFILE_FUNCTION();
@@ -2479,8 +3763,8 @@ namespace Lumos::Graphics
         float intensity      = 100.0f;
 
         set->SetTexture("u_Texture", m_MainTexture);
-        set->SetUniform("UniformBuffer", "chromaticAberrationIntensity", &intensity);
-        set->SetUniform("UniformBuffer", "cameraAperture", &cameraAperture);
+        set->SetUniform(m_PassUniforms.ChromaticIntensity, &intensity);
+        set->SetUniform(m_PassUniforms.ChromaticAperture, &cameraAperture);
         set->Update();
 
         Graphics::PipelineDesc pipelineDesc {};
@@ -2561,7 +3845,7 @@ namespace Lumos::Graphics
         Renderer2DBeginBatch();
 
         auto projView = m_Camera->GetProjectionMatrix() * glm::inverse(m_CameraTransform->GetWorldMatrix());
-        m_Renderer2DData.m_DescriptorSet[0][0]->SetUniform("UBO", "projView", &projView);
+        m_Renderer2DData.m_DescriptorSet[0][0]->SetUniform(m_Renderer2DData.m_ProjViewUniform, &projView);
         m_Renderer2DData.m_DescriptorSet[0][0]->Update();
 
         for(auto& command : m_Renderer2DData.m_CommandQueue2D)
@@ -2829,7 +4113,7 @@ namespace Lumos::Graphics
         // m_TextBuffer = m_TextRendererData.m_VertexBuffers[currentFrame][m_TextRendererData.m_BatchDrawCallIndex]->GetPointer<TextVertexData>();
 
         auto projView = m_Camera->GetProjectionMatrix() * glm::inverse(m_CameraTransform->GetWorldMatrix());
-        m_TextRendererData.m_DescriptorSet[0][0]->SetUniform("UBO", "projView", &projView);
+        m_TextRendererData.m_DescriptorSet[0][0]->SetUniform(m_TextRendererData.m_ProjViewUniform, &projView);
         m_TextRendererData.m_DescriptorSet[0][0]->Update();
 
         m_TextRendererData.m_TextureCount = 0;
@@ -2997,7 +4281,7 @@ namespace Lumos::Graphics
 
             if(!lines.empty())
             {
-                m_DebugDrawData.m_LineDescriptorSet[0]->SetUniform("UBO", "projView", &projView);
+                m_DebugDrawData.m_LineDescriptorSet[0]->SetUniform(m_PassUniforms.DebugLineProjView, &projView);
                 m_DebugDrawData.m_LineDescriptorSet[0]->Update();
 
                 Graphics::CommandBuffer* commandBuffer = Renderer::GetMainSwapChain()->GetCurrentCommandBuffer();
@@ -3074,7 +4358,7 @@ namespace Lumos::Graphics
 
             if(!thickLines.empty())
             {
-                m_DebugDrawData.m_LineDescriptorSet[0]->SetUniform("UBO", "projView", &projView);
+                m_DebugDrawData.m_LineDescriptorSet[0]->SetUniform(m_PassUniforms.DebugLineProjView, &projView);
                 m_DebugDrawData.m_LineDescriptorSet[0]->Update();
 
                 Graphics::CommandBuffer* commandBuffer = Renderer::GetMainSwapChain()->GetCurrentCommandBuffer();
@@ -3151,7 +4435,7 @@ namespace Lumos::Graphics
 
             if(!points.empty())
             {
-                m_DebugDrawData.m_PointDescriptorSet[0]->SetUniform("UBO", "projView", &projView);
+                m_DebugDrawData.m_PointDescriptorSet[0]->SetUniform(m_PassUniforms.DebugPointProjView, &projView);
                 m_DebugDrawData.m_PointDescriptorSet[0]->Update();
 
                 Graphics::CommandBuffer* commandBuffer = Renderer::GetMainSwapChain()->GetCurrentCommandBuffer();
@@ -3239,7 +4523,7 @@ namespace Lumos::Graphics
 
             if(!triangles.empty())
             {
-                m_DebugDrawData.m_Renderer2DData.m_DescriptorSet[0][0]->SetUniform("UBO", "projView", &projView);
+                m_DebugDrawData.m_Renderer2DData.m_DescriptorSet[0][0]->SetUniform(m_DebugDrawData.m_Renderer2DData.m_ProjViewUniform, &projView);
                 m_DebugDrawData.m_Renderer2DData.m_DescriptorSet[0][0]->Update();
                 m_DebugDrawData.m_Renderer2DData.m_DescriptorSet[0][1]->Update();
 
@@ -3358,7 +4642,7 @@ namespace Lumos::Graphics
             DebugTextVertexBufferPtr = DebugTextVertexBufferBase[currentFrame];
             auto projView            = m_Camera->GetProjectionMatrix() * glm::inverse(m_CameraTransform->GetWorldMatrix());
 
-            m_DebugTextRendererData.m_DescriptorSet[m_DebugTextRendererData.m_BatchDrawCallIndex][0]->SetUniform("UBO", "projView", &projView);
+            m_DebugTextRendererData.m_DescriptorSet[m_DebugTextRendererData.m_BatchDrawCallIndex][0]->SetUniform(m_DebugTextRendererData.m_ProjViewUniform, &projView);
             m_DebugTextRendererData.m_DescriptorSet[m_DebugTextRendererData.m_BatchDrawCallIndex][0]->Update();
 
             m_DebugTextRendererData.m_TextureCount = 0;
@@ -3526,7 +4810,7 @@ namespace Lumos::Graphics
             DebugRenderer::GetInstance()->SetProjView(projView);
             DebugRenderer::SortLists();
 
-            m_DebugTextRendererData.m_DescriptorSet[m_DebugTextRendererData.m_BatchDrawCallIndex][0]->SetUniform("UBO", "projView", &projView);
+            m_DebugTextRendererData.m_DescriptorSet[m_DebugTextRendererData.m_BatchDrawCallIndex][0]->SetUniform(m_DebugTextRendererData.m_ProjViewUniform, &projView);
             m_DebugTextRendererData.m_DescriptorSet[m_DebugTextRendererData.m_BatchDrawCallIndex][0]->Update();
 
             m_DebugTextRendererData.m_TextureCount = 0;
@@ -3701,7 +4985,7 @@ namespace Lumos::Graphics
             m_DebugTextRendererData.m_VertexBuffers[currentFrame][m_DebugTextRendererData.m_BatchDrawCallIndex]->Bind(Renderer::GetMainSwapChain()->GetCurrentCommandBuffer(), m_DebugTextRendererData.m_Pipeline.get());
             DebugTextVertexBufferPtr = DebugTextVertexBufferBase[currentFrame];
 
-            m_DebugTextRendererData.m_DescriptorSet[m_DebugTextRendererData.m_BatchDrawCallIndex][0]->SetUniform("UBO", "projView", &projView);
+            m_DebugTextRendererData.m_DescriptorSet[m_DebugTextRendererData.m_BatchDrawCallIndex][0]->SetUniform(m_DebugTextRendererData.m_ProjViewUniform, &projView);
             m_DebugTextRendererData.m_DescriptorSet[m_DebugTextRendererData.m_BatchDrawCallIndex][0]->Update();
 
             m_DebugTextRendererData.m_TextureCount = 0;
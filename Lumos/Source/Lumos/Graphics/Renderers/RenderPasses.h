@@ -1,5 +1,10 @@
 #pragma once
 #include "Graphics/Renderers/IRenderer.h"
+#include "Graphics/Renderers/RenderGraph.h"
+#include "Graphics/Renderers/GPUCulling.h"
+#include "Graphics/Renderers/GPUSkinning.h"
+#include "Graphics/Renderers/OcclusionCuller.h"
+#include "Graphics/Renderers/DynamicResolution.h"
 #include "Graphics/Renderable2D.h"
 
 #define MAX_BOUND_TEXTURES 16
@@ -52,6 +57,13 @@ namespace Lumos
             }
         };
 
+        enum class EffectQuality : int32_t
+        {
+            Low,
+            Medium,
+            High
+        };
+
         struct RenderPassesSettings
         {
             bool DebugPass       = true;
@@ -59,6 +71,22 @@ namespace Lumos
             bool PostProcessPass = false;
             bool ShadowPass      = true;
             bool SkyboxPass      = true;
+
+            // Presets for the compute SSAO and bloom. Low SSAO runs at a quarter of the render resolution with 16
+            // samples, medium at half with 32 and high at half with 64. Bloom gets 4, 5 and 6 levels
+            EffectQuality SSAOQuality  = EffectQuality::Medium;
+            EffectQuality BloomQuality = EffectQuality::High;
+        };
+
+        // Renderer GPU timers, timer 0 times the whole frame
+        enum GPUTimer : uint32_t
+        {
+            GPUTimer_Frame = 0,
+            GPUTimer_SSAO,
+            GPUTimer_SSAOBlur,
+            GPUTimer_Bloom,
+            GPUTimer_BloomUpsample,
+            GPUTimer_Count
         };
 
         struct RenderPassesStats
@@ -68,6 +96,9 @@ namespace Lumos
             uint32_t NumRenderedObjects = 0;
             uint32_t NumShadowObjects   = 0;
             uint32_t NumDrawCalls       = 0;
+            uint32_t NumLODSwitches     = 0;
+            uint32_t NumOccluders       = 0;
+            uint32_t NumOcclusionCulled = 0;
         };
 
         class RenderPasses
@@ -101,6 +132,8 @@ namespace Lumos
             void DepthPrePass();
             void SSAOPass();
             void SSAOBlurPass();
+            void SSAOComputePass();
+            void SSAOUpsamplePass();
             void ForwardPass();
             void ShadowPass();
             void SkyboxPass();
@@ -114,6 +147,8 @@ namespace Lumos
             // Post Process
             void ToneMappingPass();
             void BloomPass();
+            void BloomDownsamplePass();
+            void BloomUpsamplePass();
             void FXAAPass();
             void DebandingPass();
             void ChromaticAberationPass();
@@ -122,10 +157,19 @@ namespace Lumos
             void OutlinePass();
             void DepthOfFieldPass();
             void SharpenPass();
+            void MotionVectorPass();
+            void TemporalUpscalePass();
 
             float SubmitTexture(Texture* texture);
             void UpdateCascades(Scene* scene, Light* light);
 
+            // Picks the coarsest LOD whose simplification error projects to under m_LODErrorThreshold pixels.
+            // currentLOD holds the previous choice for this instance and view, used for hysteresis
+            uint32_t SelectLOD(Mesh* mesh, float pixelsPerUnit, uint8_t& currentLOD);
+
+            // Picks this frame's occluders and rasterises them for the camera and, if shadows is set, each cascade
+            void RenderOccluders(Scene* scene, const glm::vec3& cameraPosition, float cameraPixelsPerUnit, bool cameraOrthographic, bool shadows);
+
             bool m_DebugRenderEnabled = false;
 
             struct LUMOS_EXPORT RenderCommand2D
@@ -207,6 +251,30 @@ namespace Lumos
                 bool m_DepthTest           = false;
                 size_t m_DynamicAlignment;
                 glm::mat4* m_TransformData = nullptr;
+
+                // UBOLight members, resolved once from the shader and shared by every set 2 created from it
+                struct LightUniforms
+                {
+                    UniformHandle Lights;
+                    UniformHandle CameraPosition;
+                    UniformHandle ViewMatrix;
+                    UniformHandle LightView;
+                    UniformHandle ShadowTransform;
+                    UniformHandle SplitDepths;
+                    UniformHandle BiasMatrix;
+                    UniformHandle LightSize;
+                    UniformHandle ShadowFade;
+                    UniformHandle CascadeFade;
+                    UniformHandle MaxShadowDist;
+                    UniformHandle InitialBias;
+                    UniformHandle Width;
+                    UniformHandle Height;
+                    UniformHandle ShadowEnabled;
+                    UniformHandle LightCount;
+                    UniformHandle ShadowCount;
+                    UniformHandle Mode;
+                    UniformHandle EnvMipCount;
+                } m_LightUniforms;
             };
 
             struct Renderer2DData
@@ -240,6 +308,7 @@ namespace Lumos
 
                 std::vector<std::vector<SharedPtr<Graphics::DescriptorSet>>> m_DescriptorSet;
                 std::vector<Graphics::DescriptorSet*> m_CurrentDescriptorSets;
+                UniformHandle m_ProjViewUniform; // UBO.projView, valid for every batch's set 0
             };
 
             struct DebugDrawData
@@ -277,12 +346,32 @@ namespace Lumos
             void SetDisablePostProcess(bool disabled) { m_DisablePostProcess = disabled; }
 
         private:
+            void BuildRenderGraph();
+            void DrawCommand(CommandBuffer* commandBuffer, Pipeline* pipeline, const RenderCommand& command);
+
+            // Sizes the scene and depth targets to the display size times the current render scale
+            void UpdateRenderResolution();
+
+            // Never below 1 without the temporal upscale shaders, the frame would only be stretched
+            float GetRenderScale() const;
+
+            // Runs a pass between the begin and end of one of the renderer's GPU timers
+            void TimedPass(GPUTimer timer, void (RenderPasses::*pass)());
+
+            // Resolves the handles in m_PassUniforms and each Renderer2DData, once every set has been created
+            void ResolvePassUniforms();
+
+            // Owned target the scene is drawn into, at the render resolution. The others are set by the render graph
+            // for the pass being executed, m_MainTexture and m_PostProcessTexture1 swap as post processing ping-pongs
+            Texture2D* m_SceneTexture     = nullptr;
             Texture2D* m_MainTexture      = nullptr;
             Texture2D* m_LastRenderTarget = nullptr;
 
             Texture2D* m_PostProcessTexture1 = nullptr;
             Texture2D* m_PostProcessTexture2 = nullptr;
 
+            UniquePtr<RenderGraph> m_RenderGraph;
+
             Camera* m_Camera                    = nullptr;
             Maths::Transform* m_CameraTransform = nullptr;
 
@@ -296,6 +385,58 @@ namespace Lumos
             DebugDrawData m_DebugDrawData;
             Renderer2DData m_DebugTextRendererData;
 
+            // Uniforms the passes write every frame. A handle outlives its set, so the skybox set can be recreated
+            struct PassUniforms
+            {
+                UniformHandle ForwardProjView;
+                UniformHandle ShadowLightMatrices;
+
+                UniformHandle SkyboxInvProjection;
+                UniformHandle SkyboxInvView;
+                UniformHandle SkyboxMode;
+                UniformHandle SkyboxExposure;
+                UniformHandle SkyboxBlurLevel;
+
+                UniformHandle SSAOInvProj;
+                UniformHandle SSAOProjection;
+                UniformHandle SSAOView;
+                UniformHandle SSAOSamples;
+                UniformHandle SSAORadius;
+                UniformHandle SSAONear;
+                UniformHandle SSAOFar;
+                UniformHandle SSAOStrength;
+                UniformHandle SSAOBlurTexelOffset;
+                UniformHandle SSAOBlurRadius;
+
+                UniformHandle SSAOComputeProjection;
+                UniformHandle SSAOComputeInvProj;
+                UniformHandle SSAOComputeView;
+                UniformHandle SSAOComputeSamples;
+                UniformHandle SSAOComputeRadius;
+                UniformHandle SSAOComputeStrength;
+                UniformHandle SSAOComputeSampleCount;
+                UniformHandle SSAOComputeScale;
+
+                UniformHandle DOFParams;
+                UniformHandle DOFDepthConsts;
+                UniformHandle MotionInvViewProj;
+                UniformHandle MotionViewProj;
+                UniformHandle MotionPrevViewProj;
+                UniformHandle TemporalJitter;
+                UniformHandle TemporalSize;
+
+                UniformHandle ToneMapBloomIntensity;
+                UniformHandle ToneMapIndex;
+                UniformHandle ToneMapBrightness;
+                UniformHandle ToneMapContrast;
+                UniformHandle ToneMapSaturation;
+                UniformHandle ChromaticIntensity;
+                UniformHandle ChromaticAperture;
+
+                UniformHandle DebugLineProjView;
+                UniformHandle DebugPointProjView;
+            } m_PassUniforms;
+
             TextVertexData* TextVertexBufferPtr = nullptr;
 
             std::vector<std::vector<VertexData*>> m_2DBufferBase;
@@ -362,6 +503,22 @@ namespace Lumos
             SharedPtr<Graphics::DescriptorSet> m_SSAOBlurPassDescriptorSet;
             SharedPtr<Graphics::DescriptorSet> m_SSAOBlurPassDescriptorSet2;
 
+            // Compute SSAO and bloom, used over the fragment passes when compute is supported. SSAO runs at a
+            // fraction of the render resolution and a bilateral upsample brings it back. The bloom chain is one
+            // dispatch down and one up, with the levels kept in shared memory tiles
+            SharedPtr<Graphics::Shader> m_SSAOComputeShader;
+            SharedPtr<Graphics::DescriptorSet> m_SSAOComputeDescriptorSet;
+            SharedPtr<Graphics::Shader> m_SSAOUpsampleShader;
+            SharedPtr<Graphics::DescriptorSet> m_SSAOUpsampleDescriptorSet;
+            SharedPtr<Graphics::Shader> m_BloomDownsampleShader;
+            SharedPtr<Graphics::DescriptorSet> m_BloomDownsampleDescriptorSet;
+            SharedPtr<Graphics::Shader> m_BloomUpsampleShader;
+            SharedPtr<Graphics::DescriptorSet> m_BloomUpsampleDescriptorSet;
+            bool m_SSAOCompute         = false;
+            bool m_BloomCompute        = false;
+            float m_SSAODepthSharpness = 20.0f;
+            uint32_t m_ActiveGPUTimers = 0; // Bit per timer run by the last graph
+
             SharedPtr<Graphics::Shader> m_ToneMappingPassShader;
             SharedPtr<Graphics::DescriptorSet> m_ToneMappingPassDescriptorSet;
 
@@ -377,9 +534,60 @@ namespace Lumos
             SharedPtr<Graphics::DescriptorSet> m_SharpenPassDescriptorSet;
             SharedPtr<Graphics::Shader> m_SharpenShader;
 
+            SharedPtr<Graphics::DescriptorSet> m_MotionVectorDescriptorSet;
+            SharedPtr<Graphics::Shader> m_MotionVectorShader;
+
+            SharedPtr<Graphics::DescriptorSet> m_TemporalUpscaleDescriptorSet;
+            SharedPtr<Graphics::Shader> m_TemporalUpscaleShader;
+
+            // Dynamic resolution. The scene and the post processing up to tone mapping render at a fraction of the
+            // display size, the temporal upscale reconstructs the display size from jittered frames and history
+            DynamicResolution m_DynamicResolution;
+            bool m_DynamicResolutionEnabled  = true;
+            bool m_TemporalUpscaling         = true;
+            bool m_TemporalActive            = false; // For the frame being built
+            bool m_HistoryValid              = false;
+            float m_RenderScale              = 1.0f; // Used while dynamic resolution is off
+            float m_TemporalBlend            = 0.1f;
+            uint32_t m_DisplayWidth          = 0;
+            uint32_t m_DisplayHeight         = 0;
+            uint32_t m_TemporalFrame         = 0;
+            glm::vec2 m_Jitter               = glm::vec2(0.0f); // In clip space
+            Texture2D* m_TemporalHistory[2]  = { nullptr, nullptr };
+            Texture2D* m_MotionVectorTexture = nullptr;
+
             RenderPassesSettings m_Settings;
             RenderPassesStats m_Stats;
 
+            // LOD selection. State lives on the ModelComponent, one entry per mesh for the camera (0) and each
+            // shadow cascade (1 + cascade), so it goes away with the entity
+            bool m_LODEnabled         = true;
+            float m_LODErrorThreshold = 1.0f;
+            float m_LODHysteresis     = 0.25f;
+
+            // GPU culling. The frustum tests move to a compute pass, which also tests the camera's draws against the
+            // previous frame's depth, and draws go through the indirect commands it writes
+            UniquePtr<GPUCuller> m_GPUCuller;
+            bool m_GPUCullingEnabled = true;
+            bool m_GPUCullingActive  = false; // For the frame being built
+            bool m_OcclusionCulling  = true;
+            bool m_HasPreviousDepth  = false;
+            glm::mat4 m_ProjView     = glm::mat4(1.0f);
+            glm::mat4 m_PrevProjView = glm::mat4(1.0f);
+
+            // Skinned meshes of animation instances are skinned by a compute pass before anything draws them
+            UniquePtr<GPUSkinning> m_GPUSkinning;
+
+            // CPU occlusion culling, used when GPU culling is not. Large meshes are rasterised into a small depth
+            // buffer for the camera (0) and each shadow cascade (1 + cascade), draws hidden behind them are not queued
+            std::vector<UniquePtr<OcclusionCuller>> m_OcclusionCullers;
+            bool m_CPUOcclusionEnabled = true;
+            bool m_CPUOcclusionShadows = true;
+            bool m_AutomaticOccluders  = true;  // Meshes without the OCCLUDER flag are picked by screen size
+            float m_OccluderMinSize    = 0.15f; // Fraction of the screen height
+            uint32_t m_MaxOccluders    = 64;
+            bool m_CPUOcclusionActive  = false; // For the frame being built
+
             // Outline pass
             Graphics::Model* m_SelectedModel           = nullptr;
             Maths::Transform* m_SelectedModelTransform = nullptr;
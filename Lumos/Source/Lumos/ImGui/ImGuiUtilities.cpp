@@ -234,6 +234,30 @@ namespace Lumos
         return updated;
     }
 
+    bool ImGuiUtilities::Property(const char* name, uint32_t& value, uint32_t min, uint32_t max, ImGuiUtilities::PropertyFlag flags)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        bool updated = false;
+
+        ImGui::AlignTextToFramePadding();
+        ImGui::TextUnformatted(name);
+        ImGui::NextColumn();
+        ImGui::PushItemWidth(-1);
+
+        if((int)flags & (int)PropertyFlag::ReadOnly)
+        {
+            ImGui::Text("%u", value);
+        }
+        else
+        {
+            updated = ImGui::DragScalar(GenerateID(), ImGuiDataType_U32, &value, 1.0f, &min, &max);
+        }
+        ImGui::PopItemWidth();
+        ImGui::NextColumn();
+
+        return updated;
+    }
+
     bool ImGuiUtilities::Property(const char* name, float& value, float min, float max, float delta, ImGuiUtilities::PropertyFlag flags)
     {
         LUMOS_PROFILE_FUNCTION();
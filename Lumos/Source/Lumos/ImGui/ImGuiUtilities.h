@@ -46,6 +46,7 @@ namespace Lumos
         bool Property(const char* name, bool& value, PropertyFlag flags = PropertyFlag::None);
         bool Property(const char* name, int& value, PropertyFlag flags);
         bool Property(const char* name, uint32_t& value, PropertyFlag flags = PropertyFlag::None);
+        bool Property(const char* name, uint32_t& value, uint32_t min, uint32_t max, PropertyFlag flags = PropertyFlag::None);
         bool PropertyMultiline(const char* label, std::string& value);
 
         bool Property(const char* name, double& value, double min = -1.0, double max = 1.0, PropertyFlag flags = PropertyFlag::None);
@@ -40,8 +40,6 @@ namespace Lumos
             SetLocalPosition(position);
         }
 
-        Transform::~Transform() = default;
-
         void Transform::UpdateMatrices()
         {
             LUMOS_PROFILE_FUNCTION();
@@ -13,7 +13,7 @@ namespace Lumos
             Transform();
             Transform(const glm::mat4& matrix);
             Transform(const glm::vec3& position);
-            ~Transform();
+            ~Transform() = default;
 
             void SetWorldMatrix(const glm::mat4& mat);
 
@@ -2,10 +2,12 @@
 #include "ALManager.h"
 #include "ALSoundNode.h"
 #include "Maths/Maths.h"
+#include "Maths/MathsUtilities.h"
 #include "Graphics/Camera/Camera.h"
 #include "Utilities/TimeStep.h"
 #include "Scene/Component/SoundComponent.h"
 #include "Scene/Scene.h"
+#include "Audio/AudioStream.h"
 #include <imgui/imgui.h>
 
 namespace Lumos
@@ -22,6 +24,15 @@ namespace Lumos
 
         ALManager::~ALManager()
         {
+            for(auto node : m_VoiceOwners)
+                node->DetachVoice();
+
+            for(auto& voice : m_Voices)
+            {
+                alDeleteSources(1, &voice.Source);
+                alDeleteBuffers(NUM_STREAM_BUFFERS, voice.StreamBuffers);
+            }
+
             alcDestroyContext(m_Context);
             alcCloseDevice(m_Device);
         }
@@ -38,6 +49,27 @@ namespace Lumos
             alcMakeContextCurrent(m_Context);
             alDistanceModel(AL_LINEAR_DISTANCE_CLAMPED);
 
+            m_StreamThread = CreateUniquePtr<AudioStreamThread>();
+
+            ALCint maxSources = m_NumChannels;
+            alcGetIntegerv(m_Device, ALC_MONO_SOURCES, 1, &maxSources);
+            if(maxSources > 0)
+                m_NumChannels = Maths::Min(m_NumChannels, int(maxSources));
+
+            for(int i = 0; i < m_NumChannels; i++)
+            {
+                ALVoice voice;
+                alGenSources(1, &voice.Source);
+                if(alGetError() != AL_NO_ERROR)
+                    break;
+
+                alGenBuffers(NUM_STREAM_BUFFERS, voice.StreamBuffers);
+                m_Voices.push_back(voice);
+            }
+
+            m_NumChannels = int(m_Voices.size());
+            m_FreeVoices  = m_Voices;
+
             LUMOS_LOG_INFO("Initialised AudioManager - {0}", alcGetString(m_Device, ALC_DEVICE_SPECIFIER));
         }
 
@@ -54,12 +86,81 @@ namespace Lumos
 
             auto soundsView = registry.view<SoundComponent, Maths::Transform>();
 
+            m_Nodes.clear();
             for(auto entity : soundsView)
             {
-                auto soundNode = soundsView.get<SoundComponent>(entity).GetSoundNode();
+                auto soundNode = static_cast<ALSoundNode*>(soundsView.get<SoundComponent>(entity).GetSoundNode());
                 soundNode->SetPosition(soundsView.get<Maths::Transform>(entity).GetWorldPosition());
                 soundNode->OnUpdate((float)dt.GetMillis());
+                m_Nodes.push_back(soundNode);
+            }
+
+            AssignVoices();
+        }
+
+        void ALManager::AssignVoices()
+        {
+            LUMOS_PROFILE_FUNCTION();
+            // Voices that finished fading out, or whose sound stopped, go back to the pool first
+            m_Candidates.clear();
+            for(auto node : m_Nodes)
+            {
+                if(node->HasVoice() && (!node->IsPlaying() || node->IsFadedOut()))
+                    ReleaseVoice(node);
+
+                if(!node->IsPlaying())
+                    continue;
+
+                // Sounds keep their voice unless clearly beaten, so two similar sounds don't trade it every frame
+                float audibility = node->GetAudibility(m_ListenerPosition);
+                if(node->HasVoice())
+                    audibility *= 1.25f;
+
+                m_Candidates.emplace_back(audibility, node);
             }
+
+            std::sort(m_Candidates.begin(), m_Candidates.end(), [](const std::pair<float, ALSoundNode*>& a, const std::pair<float, ALSoundNode*>& b)
+                      { return a.first > b.first; });
+
+            m_VoiceSteals = 0;
+            for(size_t i = 0; i < m_Candidates.size(); i++)
+            {
+                auto [audibility, node] = m_Candidates[i];
+                bool real               = i < m_Voices.size() && audibility > m_AudibilityThreshold;
+
+                if(!real)
+                {
+                    // Fade out, the voice is handed over once silent
+                    if(node->HasVoice())
+                    {
+                        node->SetVoiceFade(0.0f);
+                        m_VoiceSteals++;
+                    }
+                    continue;
+                }
+
+                if(node->HasVoice())
+                {
+                    node->SetVoiceFade(1.0f);
+                }
+                else if(!m_FreeVoices.empty())
+                {
+                    node->AttachVoice(m_FreeVoices.back(), this);
+                    m_FreeVoices.pop_back();
+                    m_VoiceOwners.insert(node);
+                }
+            }
+
+            m_RealVoiceCount    = uint32_t(m_VoiceOwners.size());
+            m_VirtualVoiceCount = uint32_t(m_Candidates.size()) - Maths::Min(uint32_t(m_Candidates.size()), m_RealVoiceCount);
+        }
+
+        void ALManager::ReleaseVoice(ALSoundNode* node)
+        {
+            if(m_VoiceOwners.erase(node) == 0)
+                return;
+
+            m_FreeVoices.push_back(node->DetachVoice());
         }
 
         void ALManager::UpdateListener(Scene* scene)
@@ -79,6 +180,7 @@ namespace Lumos
             LUMOS_PROFILE_FUNCTION();
             {
                 glm::vec3 worldPos = listenerTransform.GetWorldPosition();
+                m_ListenerPosition = worldPos;
                 glm::vec3 velocity = glm::vec3(0.0f); // TODO: m_Listener->GetVelocity();
 
                 ALfloat direction[6];
@@ -116,13 +218,45 @@ namespace Lumos
             ImGui::NextColumn();
 
             ImGui::AlignTextToFramePadding();
-            ImGui::TextUnformatted("Number Of Channels");
+            ImGui::TextUnformatted("Number Of Voices");
             ImGui::NextColumn();
             ImGui::PushItemWidth(-1);
             ImGui::Text("%5.2i", m_NumChannels);
             ImGui::PopItemWidth();
             ImGui::NextColumn();
 
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextUnformatted("Real Voices");
+            ImGui::NextColumn();
+            ImGui::PushItemWidth(-1);
+            ImGui::Text("%5.2u", m_RealVoiceCount);
+            ImGui::PopItemWidth();
+            ImGui::NextColumn();
+
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextUnformatted("Virtual Voices");
+            ImGui::NextColumn();
+            ImGui::PushItemWidth(-1);
+            ImGui::Text("%5.2u", m_VirtualVoiceCount);
+            ImGui::PopItemWidth();
+            ImGui::NextColumn();
+
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextUnformatted("Voices Fading Out");
+            ImGui::NextColumn();
+            ImGui::PushItemWidth(-1);
+            ImGui::Text("%5.2u", m_VoiceSteals);
+            ImGui::PopItemWidth();
+            ImGui::NextColumn();
+
+            ImGui::AlignTextToFramePadding();
+            ImGui::TextUnformatted("Streaming Sources");
+            ImGui::NextColumn();
+            ImGui::PushItemWidth(-1);
+            ImGui::Text("%5.2u", m_StreamThread ? m_StreamThread->GetStreamCount() : 0u);
+            ImGui::PopItemWidth();
+            ImGui::NextColumn();
+
             ImGui::Columns(1);
             ImGui::Separator();
             ImGui::PopStyleVar();
@@ -1,5 +1,6 @@
-
+#pragma once
 #include "Audio/AudioManager.h"
+#include "ALSoundNode.h"
 
 #include <AL/al.h>
 #include <AL/alc.h>
@@ -16,7 +17,7 @@ namespace Lumos
         class ALManager : public AudioManager
         {
         public:
-            ALManager(int numChannels = 8);
+            ALManager(int numChannels = 32);
             ~ALManager();
 
             void OnInit() override;
@@ -25,11 +26,30 @@ namespace Lumos
             void UpdateListener(Maths::Transform& listenerTransform);
             void OnImGui() override;
 
+            // Returns node's voice to the pool straight away, without fading out
+            void ReleaseVoice(ALSoundNode* node);
+
         private:
+            // Gives the real voices to the most audible playing sounds, the rest are virtual
+            void AssignVoices();
+
             ALCcontext* m_Context;
             ALCdevice* m_Device;
 
+            // Number of real voices, the pool is smaller if the device supports fewer sources
             int m_NumChannels = 0;
+
+            std::vector<ALVoice> m_Voices;
+            std::vector<ALVoice> m_FreeVoices;
+            std::unordered_set<ALSoundNode*> m_VoiceOwners;
+            std::vector<ALSoundNode*> m_Nodes;
+            std::vector<std::pair<float, ALSoundNode*>> m_Candidates;
+            glm::vec3 m_ListenerPosition = glm::vec3(0.0f);
+
+            float m_AudibilityThreshold  = 0.001f;
+            uint32_t m_RealVoiceCount    = 0;
+            uint32_t m_VirtualVoiceCount = 0;
+            uint32_t m_VoiceSteals       = 0;
         };
     }
 }
@@ -7,21 +7,42 @@
 namespace Lumos
 {
     ALSound::ALSound(const std::string& fileName, const std::string& format)
-        : m_Format(0)
+        : m_Buffer(0)
+        , m_Format(0)
     {
-        m_FilePath = fileName;
+        LUMOS_PROFILE_FUNCTION();
+        m_FilePath  = fileName;
+        m_Extension = format;
+
+        // Only the headers are read here, long sounds never get decoded up front
+        auto decoder = CreateDecoder();
+        if(decoder && decoder->GetInfo().Size > s_StreamingThreshold)
+        {
+            m_Data      = decoder->GetInfo();
+            m_Streaming = true;
+            m_Format    = GetOALFormat(m_Data.BitRate, m_Data.Channels);
+            return;
+        }
+
         if(format == "wav")
             m_Data = LoadWav(fileName);
         else if(format == "ogg")
             m_Data = LoadOgg(fileName);
 
+        m_Format = GetOALFormat(m_Data.BitRate, m_Data.Channels);
+
         alGenBuffers(1, &m_Buffer);
-        alBufferData(m_Buffer, GetOALFormat(m_Data.BitRate, m_Data.Channels), m_Data.Data, m_Data.Size, static_cast<ALsizei>(m_Data.FreqRate));
+        alBufferData(m_Buffer, m_Format, m_Data.Data, m_Data.Size, static_cast<ALsizei>(m_Data.FreqRate));
+
+        // OpenAL keeps its own copy
+        delete[] m_Data.Data;
+        m_Data.Data = nullptr;
     }
 
     ALSound::~ALSound()
     {
-        alDeleteBuffers(1, &m_Buffer);
+        if(m_Buffer)
+            alDeleteBuffers(1, &m_Buffer);
     }
 
     ALenum ALSound::GetOALFormat(uint32_t bitRate, uint32_t channels)
@@ -17,6 +17,11 @@ namespace Lumos
             return m_Buffer;
         }
 
+        ALenum GetFormat() const
+        {
+            return m_Format;
+        }
+
     private:
         static ALenum GetOALFormat(uint32_t bitRate, uint32_t channels);
         unsigned int m_Buffer;
@@ -4,36 +4,199 @@
 #include "ALManager.h"
 
 #include "Core/Application.h"
+#include "Audio/AudioManager.h"
+#include "Audio/AudioStream.h"
+#include "Maths/MathsUtilities.h"
 
 #include "Graphics/Camera/Camera.h"
 
 namespace Lumos
 {
+    // Long enough to avoid clicks when a voice starts or is taken away
+    static constexpr float VoiceFadeTimeMs = 50.0f;
+
     ALSoundNode::ALSoundNode()
     {
-        alGenSources(1, &m_Source);
     }
 
     ALSoundNode::~ALSoundNode()
     {
-        alDeleteSources(1, &m_Source);
+        if(m_VoiceOwner)
+            m_VoiceOwner->ReleaseVoice(this);
     }
 
-    void ALSoundNode::OnUpdate(float msec)
+    void ALSoundNode::AttachVoice(const ALVoice& voice, Audio::ALManager* owner)
     {
-        alSourcef(m_Source, AL_GAIN, m_Volume);
-        alSourcef(m_Source, AL_PITCH, m_Pitch);
-        alSourcef(m_Source, AL_MAX_DISTANCE, m_Radius);
-        alSourcef(m_Source, AL_REFERENCE_DISTANCE, m_ReferenceDistance);
+        m_Voice      = voice;
+        m_VoiceOwner = owner;
+        m_Fade       = 0.0f;
+        m_FadeTarget = 1.0f;
 
-        glm::vec3 position;
-        glm::vec3 velocity;
+        ALuint source = m_Voice.Source;
+        alSourcef(source, AL_GAIN, 0.0f);
+        alSourcef(source, AL_PITCH, m_Pitch);
+        alSourcef(source, AL_MAX_DISTANCE, m_Radius);
+        alSourcef(source, AL_ROLLOFF_FACTOR, m_RollOffFactor);
+        alSourcef(source, AL_REFERENCE_DISTANCE, m_ReferenceDistance);
+
+        if(!m_Sound)
+            return;
 
-        if(m_IsGlobal)
+        auto decoder = m_Sound->IsStreaming() ? m_Sound->CreateDecoder() : nullptr;
+        if(decoder)
         {
-            // position = Application::Get().GetSystem<AudioManager>()->GetListener()->GetPosition();
+            // Looping is done by the decoder, the source only ever sees a queue of chunks
+            decoder->Seek(m_PlaybackTime);
+            m_Stream = CreateSharedPtr<AudioStream>(std::move(decoder), m_IsLooping);
+            m_FreeStreamBuffers.assign(m_Voice.StreamBuffers, m_Voice.StreamBuffers + NUM_STREAM_BUFFERS);
+
+            auto audioManager = Application::Get().GetSystem<AudioManager>();
+            if(audioManager && audioManager->GetStreamThread())
+                audioManager->GetStreamThread()->AddStream(m_Stream);
+
+            alSourcei(source, AL_BUFFER, 0);
+            alSourcei(source, AL_LOOPING, 0);
+            return;
         }
-        else
+
+        alSourcei(source, AL_BUFFER, m_Sound.As<ALSound>()->GetBuffer());
+        alSourcei(source, AL_LOOPING, m_IsLooping ? 1 : 0);
+        alSourcef(source, AL_SEC_OFFSET, float(m_PlaybackTime * 0.001));
+
+        if(m_Playing)
+            alSourcePlay(source);
+    }
+
+    ALVoice ALSoundNode::DetachVoice()
+    {
+        ALVoice voice = m_Voice;
+        if(voice.Source)
+        {
+            // Detaching the buffer also unqueues any stream buffers, processed or not
+            alSourceStop(voice.Source);
+            alSourcei(voice.Source, AL_BUFFER, 0);
+        }
+
+        if(m_Stream)
+        {
+            m_Stream->Release();
+            m_Stream = nullptr;
+        }
+
+        m_FreeStreamBuffers.clear();
+        m_Voice      = {};
+        m_VoiceOwner = nullptr;
+        m_Fade       = 0.0f;
+        m_FadeTarget = 0.0f;
+        return voice;
+    }
+
+    void ALSoundNode::AdvancePlayback(float msec)
+    {
+        if(!m_Playing || !m_Sound)
+            return;
+
+        m_PlaybackTime += msec * m_Pitch;
+
+        // Follow the source while it is real so the virtual clock never drifts from what was heard
+        if(HasVoice() && !m_Stream)
+        {
+            ALint state = 0;
+            alGetSourcei(m_Voice.Source, AL_SOURCE_STATE, &state);
+            if(state == AL_PLAYING)
+            {
+                float offset = 0.0f;
+                alGetSourcef(m_Voice.Source, AL_SEC_OFFSET, &offset);
+                m_PlaybackTime = offset * 1000.0;
+            }
+        }
+
+        double length = m_Sound->GetLength();
+        if(length > 0.0 && m_PlaybackTime >= length)
+        {
+            if(m_IsLooping)
+            {
+                m_PlaybackTime = fmod(m_PlaybackTime, length);
+            }
+            else
+            {
+                m_PlaybackTime = 0.0;
+                m_Playing      = false;
+            }
+        }
+
+        m_TimeLeft = length - m_PlaybackTime;
+    }
+
+    void ALSoundNode::UpdateStream()
+    {
+        LUMOS_PROFILE_FUNCTION_LOW();
+        ALuint source   = m_Voice.Source;
+        ALint processed = 0;
+        alGetSourcei(source, AL_BUFFERS_PROCESSED, &processed);
+        while(processed-- > 0)
+        {
+            ALuint buffer;
+            alSourceUnqueueBuffers(source, 1, &buffer);
+            m_FreeStreamBuffers.push_back(buffer);
+        }
+
+        m_Stream->SetLooping(m_IsLooping);
+
+        // Without a decode thread (audio manager not initialised yet) decode here instead
+        auto audioManager = Application::Get().GetSystem<AudioManager>();
+        if(!audioManager || !audioManager->GetStreamThread())
+        {
+            while(m_Stream->Decode())
+                ;
+        }
+
+        const ALSound* sound = static_cast<const ALSound*>(m_Sound.get());
+        while(!m_FreeStreamBuffers.empty() && m_Stream->PopChunk(m_StreamChunk))
+        {
+            ALuint buffer = m_FreeStreamBuffers.back();
+            m_FreeStreamBuffers.pop_back();
+
+            alBufferData(buffer, sound->GetFormat(), m_StreamChunk.data(), ALsizei(m_StreamChunk.size()), ALsizei(sound->GetFrequency()));
+            alSourceQueueBuffers(source, 1, &buffer);
+        }
+
+        // The source stops by itself when the decode thread falls behind, restart it once data is queued again
+        ALint state  = 0;
+        ALint queued = 0;
+        alGetSourcei(source, AL_SOURCE_STATE, &state);
+        alGetSourcei(source, AL_BUFFERS_QUEUED, &queued);
+
+        if(m_Playing && state != AL_PLAYING && queued > 0)
+            alSourcePlay(source);
+    }
+
+    void ALSoundNode::OnUpdate(float msec)
+    {
+        AdvancePlayback(msec);
+
+        // Virtual voices only track their playback position
+        if(!HasVoice())
+            return;
+
+        if(m_Stream)
+            UpdateStream();
+
+        float step = Maths::Min(msec / VoiceFadeTimeMs, 1.0f);
+        m_Fade     = m_FadeTarget > m_Fade ? Maths::Min(m_Fade + step, m_FadeTarget) : Maths::Max(m_Fade - step, m_FadeTarget);
+
+        ALuint source = m_Voice.Source;
+        alSourcef(source, AL_GAIN, m_Volume * m_Fade);
+        alSourcef(source, AL_PITCH, m_Pitch);
+        alSourcef(source, AL_MAX_DISTANCE, m_Radius);
+        alSourcef(source, AL_REFERENCE_DISTANCE, m_ReferenceDistance);
+
+        glm::vec3 position = glm::vec3(0.0f);
+        glm::vec3 velocity;
+
+        // Global sounds sit on the listener
+        alSourcei(source, AL_SOURCE_RELATIVE, m_IsGlobal ? AL_TRUE : AL_FALSE);
+        if(!m_IsGlobal)
         {
             position = GetPosition();
         }
@@ -47,41 +210,45 @@ namespace Lumos
             velocity = m_Velocity;
         }
 
-        alSourcefv(m_Source, AL_POSITION, reinterpret_cast<float*>(&position));
-        alSourcefv(m_Source, AL_VELOCITY, reinterpret_cast<float*>(&velocity));
+        alSourcefv(source, AL_POSITION, reinterpret_cast<float*>(&position));
+        alSourcefv(source, AL_VELOCITY, reinterpret_cast<float*>(&velocity));
     }
 
     void ALSoundNode::Pause()
     {
-        alSourcePause(m_Source);
-        m_Paused = true;
+        if(HasVoice())
+            alSourcePause(m_Voice.Source);
+        m_Paused  = true;
+        m_Playing = false;
     }
 
     void ALSoundNode::Resume()
     {
-        alSourcePlay(m_Source);
-        m_Paused = false;
+        if(HasVoice())
+            alSourcePlay(m_Voice.Source);
+        m_Paused  = false;
+        m_Playing = true;
     }
 
     void ALSoundNode::Stop()
     {
-        alSourceStop(m_Source);
+        if(HasVoice())
+            alSourceStop(m_Voice.Source);
+        m_Playing      = false;
+        m_PlaybackTime = 0.0;
     }
 
     void ALSoundNode::SetSound(SharedPtr<Sound> s)
     {
-        m_Sound = s;
-        if(m_Sound)
+        m_Sound        = s;
+        m_PlaybackTime = 0.0;
+        m_TimeLeft     = m_Sound ? m_Sound->GetLength() : 0.0;
+
+        // Restart on the new sound with the same voice
+        if(HasVoice())
         {
-            m_TimeLeft = m_Sound->GetLength();
-            alSourcei(m_Source, AL_BUFFER, m_Sound.As<ALSound>()->GetBuffer());
-            alSourcef(m_Source, AL_MAX_DISTANCE, m_Radius);
-            alSourcef(m_Source, AL_ROLLOFF_FACTOR, m_RollOffFactor);
-            alSourcef(m_Source, AL_REFERENCE_DISTANCE, m_ReferenceDistance);
-            alSourcei(m_Source, AL_LOOPING, m_IsLooping ? 1 : 0);
-            alSourcef(m_Source, AL_GAIN, m_Volume);
-            alSourcef(m_Source, AL_PITCH, m_Pitch);
-            // alSourcePlay(m_Source);
+            Audio::ALManager* owner = m_VoiceOwner;
+            AttachVoice(DetachVoice(), owner);
         }
     }
 }
@@ -8,6 +8,22 @@
 
 namespace Lumos
 {
+    class AudioStream;
+
+    namespace Audio
+    {
+        class ALManager;
+    }
+
+    // Real voice from the ALManager pool, the buffers are only used by streaming sounds
+    struct ALVoice
+    {
+        ALuint Source                            = 0;
+        ALuint StreamBuffers[NUM_STREAM_BUFFERS] = {};
+    };
+
+    // Plays through a pooled voice while it is one of the most audible sounds. Without one it is
+    // virtual and only tracks its playback position, so it resumes in the right place when it gets a voice back
     class ALSoundNode : public SoundNode
     {
     public:
@@ -20,8 +36,30 @@ namespace Lumos
         void Stop() override;
         void SetSound(SharedPtr<Sound> s) override;
 
+        bool IsPlaying() const { return m_Playing; }
+        bool HasVoice() const { return m_Voice.Source != 0; }
+
+        // Called by ALManager. Voices fade in when attached and fade out before being taken away
+        void AttachVoice(const ALVoice& voice, Audio::ALManager* owner);
+        ALVoice DetachVoice();
+        void SetVoiceFade(float target) { m_FadeTarget = target; }
+        bool IsFadedOut() const { return m_FadeTarget <= 0.0f && m_Fade <= 0.0f; }
+
     private:
-        ALuint m_Source;
-        ALuint m_StreamBuffers[NUM_STREAM_BUFFERS];
+        void AdvancePlayback(float msec);
+
+        // Moves finished buffers back to the free list and queues newly decoded chunks
+        void UpdateStream();
+
+        ALVoice m_Voice;
+        Audio::ALManager* m_VoiceOwner = nullptr;
+        float m_Fade                   = 0.0f;
+        float m_FadeTarget             = 0.0f;
+        double m_PlaybackTime          = 0.0; // Milliseconds
+
+        std::vector<ALuint> m_FreeStreamBuffers;
+        std::vector<uint8_t> m_StreamChunk;
+        SharedPtr<AudioStream> m_Stream;
+        bool m_Playing = false;
     };
 }
@@ -26,11 +26,12 @@ namespace Lumos
                     localStorage.InitialiseEmpty();
 
                     UniformBufferInfo info;
+                    info.Name         = descriptor.name;
                     info.UB           = buffer;
                     info.LocalStorage = localStorage;
                     info.HasUpdated   = false;
                     info.m_Members    = descriptor.m_Members;
-                    m_UniformBuffers.emplace(descriptor.name, info);
+                    m_UniformBuffers.push_back(info);
 
                     if(descriptor.name != "")
                     {
@@ -48,10 +49,10 @@ namespace Lumos
             LUMOS_PROFILE_FUNCTION();
             for(auto& bufferInfo : m_UniformBuffers)
             {
-                if(bufferInfo.second.HasUpdated)
+                if(bufferInfo.HasUpdated && !bufferInfo.External)
                 {
-                    bufferInfo.second.UB->SetData(bufferInfo.second.LocalStorage.Data);
-                    bufferInfo.second.HasUpdated = false;
+                    bufferInfo.UB->SetData(bufferInfo.LocalStorage.Data);
+                    bufferInfo.HasUpdated = false;
                 }
             }
         }
@@ -104,51 +105,93 @@ namespace Lumos
             LUMOS_LOG_WARN("Buffer not found {0}", name);
         }
 
-        void GLDescriptorSet::SetUniform(const std::string& bufferName, const std::string& uniformName, void* data)
+        void GLDescriptorSet::SetBuffer(const std::string& name, const SharedPtr<UniformBuffer>* buffers, uint32_t offset, uint32_t size)
         {
-            std::unordered_map<std::string, UniformBufferInfo>::iterator itr = m_UniformBuffers.find(bufferName);
-            if(itr != m_UniformBuffers.end())
+            LUMOS_PROFILE_FUNCTION();
+            for(auto& descriptor : m_Descriptors)
             {
-                for(auto& member : itr->second.m_Members)
+                if(descriptor.type == DescriptorType::UNIFORM_BUFFER && descriptor.name == name)
                 {
-                    if(member.name == uniformName)
+                    // Only one frame in flight
+                    descriptor.buffer = buffers[0].get();
+                    descriptor.offset = offset;
+                    descriptor.size   = size;
+
+                    if(UniformBufferInfo* bufferInfo = FindUniformBuffer(name))
                     {
-                        itr->second.LocalStorage.Write(data, member.size, member.offset);
-                        itr->second.HasUpdated = true;
-                        return;
+                        bufferInfo->UB       = buffers[0];
+                        bufferInfo->External = true;
+                        bufferInfo->LocalStorage.Release();
                     }
+                    return;
                 }
             }
 
-            LUMOS_LOG_WARN("Uniform not found {0}.{1}", bufferName, uniformName);
+            LUMOS_LOG_WARN("Buffer not found {0}", name);
         }
 
-        void GLDescriptorSet::SetUniform(const std::string& bufferName, const std::string& uniformName, void* data, uint32_t size)
+        GLDescriptorSet::UniformBufferInfo* GLDescriptorSet::FindUniformBuffer(const std::string& name)
         {
-            std::unordered_map<std::string, UniformBufferInfo>::iterator itr = m_UniformBuffers.find(bufferName);
-            if(itr != m_UniformBuffers.end())
+            for(auto& bufferInfo : m_UniformBuffers)
             {
-                for(auto& member : itr->second.m_Members)
+                if(bufferInfo.Name == name)
+                    return &bufferInfo;
+            }
+
+            return nullptr;
+        }
+
+        UniformHandle GLDescriptorSet::GetUniformHandle(const std::string& bufferName, const std::string& uniformName)
+        {
+            UniformHandle handle;
+
+            if(UniformBufferInfo* bufferInfo = FindUniformBuffer(bufferName))
+            {
+                for(auto& member : bufferInfo->m_Members)
                 {
                     if(member.name == uniformName)
                     {
-                        itr->second.LocalStorage.Write(data, size, member.offset);
-                        itr->second.HasUpdated = true;
-                        return;
+                        handle.Buffer = uint32_t(bufferInfo - m_UniformBuffers.data());
+                        handle.Offset = member.offset;
+                        handle.Size   = member.size;
+                        return handle;
                     }
                 }
             }
 
             LUMOS_LOG_WARN("Uniform not found {0}.{1}", bufferName, uniformName);
+            return handle;
+        }
+
+        void GLDescriptorSet::SetUniform(const UniformHandle& handle, const void* data)
+        {
+            SetUniform(handle, data, handle.Size);
+        }
+
+        void GLDescriptorSet::SetUniform(const UniformHandle& handle, const void* data, uint32_t size)
+        {
+            if(!handle.IsValid())
+                return;
+
+            LUMOS_ASSERT(handle.Buffer < m_UniformBuffers.size(), "Uniform handle from a different layout");
+            UniformBufferInfo& bufferInfo = m_UniformBuffers[handle.Buffer];
+            if(bufferInfo.External)
+                return;
+
+            LUMOS_ASSERT(handle.Offset + size <= bufferInfo.LocalStorage.GetSize(), "Uniform write out of bounds");
+            memcpy(bufferInfo.LocalStorage.Data + handle.Offset, data, size);
+            bufferInfo.HasUpdated = true;
         }
 
         void GLDescriptorSet::SetUniformBufferData(const std::string& bufferName, void* data)
         {
-            std::unordered_map<std::string, UniformBufferInfo>::iterator itr = m_UniformBuffers.find(bufferName);
-            if(itr != m_UniformBuffers.end())
+            if(UniformBufferInfo* bufferInfo = FindUniformBuffer(bufferName))
             {
-                itr->second.LocalStorage.Write(data, itr->second.LocalStorage.GetSize(), 0);
-                itr->second.HasUpdated = true;
+                if(bufferInfo->External)
+                    return;
+
+                bufferInfo->LocalStorage.Write(data, bufferInfo->LocalStorage.GetSize(), 0);
+                bufferInfo->HasUpdated = true;
                 return;
             }
 
@@ -223,7 +266,7 @@ namespace Lumos
                     else
                     {
                         data = buffer->GetBuffer();
-                        size = buffer->GetSize();
+                        size = descriptor.size;
                     }
 
                     {
@@ -238,7 +281,7 @@ namespace Lumos
                         // if(buffer->GetDynamic())
                         {
                             LUMOS_PROFILE_SCOPE("glBindBufferRange");
-                            GLCall(glBindBufferRange(GL_UNIFORM_BUFFER, slot, bufferHandle, offset, size));
+                            GLCall(glBindBufferRange(GL_UNIFORM_BUFFER, slot, bufferHandle, descriptor.offset + offset, size));
                         }
 
                         //                        if(descriptor.name != "")
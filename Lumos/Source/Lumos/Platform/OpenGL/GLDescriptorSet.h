@@ -20,8 +20,11 @@ namespace Lumos
             void SetTexture(const std::string& name, Texture* texture, uint32_t mipIndex, TextureType textureType) override;
             void SetTexture(const std::string& name, Texture** texture, uint32_t textureCount, TextureType textureType) override;
             void SetBuffer(const std::string& name, UniformBuffer* buffer) override;
-            void SetUniform(const std::string& bufferName, const std::string& uniformName, void* data) override;
-            void SetUniform(const std::string& bufferName, const std::string& uniformName, void* data, uint32_t size) override;
+            void SetBuffer(const std::string& name, const SharedPtr<UniformBuffer>* buffers, uint32_t offset, uint32_t size) override;
+            UniformHandle GetUniformHandle(const std::string& bufferName, const std::string& uniformName) override;
+            void SetUniform(const UniformHandle& handle, const void* data) override;
+            void SetUniform(const UniformHandle& handle, const void* data, uint32_t size) override;
+            using DescriptorSet::SetUniform;
             void SetUniformBufferData(const std::string& bufferName, void* data) override;
 
             Graphics::UniformBuffer* GetUnifromBuffer(const std::string& name) override;
@@ -43,12 +46,17 @@ namespace Lumos
             std::vector<Descriptor> m_Descriptors;
             struct UniformBufferInfo
             {
+                std::string Name;
                 SharedPtr<UniformBuffer> UB;
                 std::vector<BufferMemberInfo> m_Members;
                 Buffer LocalStorage;
                 bool HasUpdated;
+                bool External = false; // Read from buffers set with SetBuffer, nothing to upload
             };
-            std::unordered_map<std::string, UniformBufferInfo> m_UniformBuffers;
+            UniformBufferInfo* FindUniformBuffer(const std::string& name);
+
+            // In layout order, UniformHandle::Buffer indexes this
+            std::vector<UniformBufferInfo> m_UniformBuffers;
         };
     }
 }
@@ -5,6 +5,8 @@
 #include "Core/VFS.h"
 #include "Core/OS/FileSystem.h"
 #include "Core/StringUtilities.h"
+#include "Core/Application.h"
+#include "Utilities/CombineHash.h"
 
 #include <glm/gtc/type_ptr.hpp>
 
@@ -96,7 +98,7 @@ namespace Lumos
             }
 
             GLShaderErrorInfo error;
-            m_Handle = Compile(sources, error);
+            m_Handle = CompileProgram(sources, error);
 
             if(!m_Handle)
             {
@@ -124,7 +126,7 @@ namespace Lumos
             }
 
             GLShaderErrorInfo error;
-            m_Handle = Compile(sources, error);
+            m_Handle = CompileProgram(sources, error);
 
             if(!m_Handle)
             {
@@ -159,9 +161,9 @@ namespace Lumos
 
             for(auto& file : *sources)
             {
-                auto fileSize    = FileSystem::GetFileSize(m_Path + file.second); // TODO: once process
-                uint32_t* source = reinterpret_cast<uint32_t*>(FileSystem::ReadFile(m_Path + file.second));
-                LoadFromData(source, uint32_t(fileSize), file.first, *sources);
+                VFSFile spirv;
+                if(VFS::Get().ReadFile(m_Path + file.second, spirv))
+                    LoadFromData(reinterpret_cast<const uint32_t*>(spirv.Data), uint32_t(spirv.Size), file.first, *sources);
             }
 
             for(auto& source : *sources)
@@ -170,7 +172,7 @@ namespace Lumos
             }
 
             GLShaderErrorInfo error;
-            m_Handle = Compile(sources, error);
+            m_Handle = CompileProgram(sources, error);
 
             if(!m_Handle)
             {
@@ -472,6 +474,140 @@ namespace Lumos
             }
         }
 
+        struct ProgramBinaryHeader
+        {
+            uint32_t Magic;
+            uint32_t Version;
+            uint64_t DriverHash;
+            uint32_t Format;
+            uint32_t Size;
+            uint64_t DataHash;
+        };
+
+        static constexpr uint32_t ProgramBinaryMagic = 0x4C4D5042; // "BPML"
+
+        // Bump when the SPIR-V to GLSL options change, cached programs are keyed by the SPIR-V alone
+        static constexpr uint32_t ProgramBinaryVersion = 1;
+
+        static bool ProgramBinariesSupported()
+        {
+            static bool supported = []()
+            {
+                GLint formats = 0;
+                GLCall(glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats));
+                return formats > 0;
+            }();
+            return supported;
+        }
+
+        // Binaries only load on the exact driver that wrote them
+        static uint64_t GetDriverHash()
+        {
+            static uint64_t hash = []()
+            {
+                uint64_t result = 0;
+                for(GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION })
+                {
+                    const char* value = reinterpret_cast<const char*>(glGetString(name));
+                    if(value)
+                        result = HashBytes(value, strlen(value), result);
+                }
+                return result;
+            }();
+            return hash;
+        }
+
+        static std::string GetProgramBinaryPath(uint64_t hash)
+        {
+            std::stringstream name;
+            name << "GLProgram_" << std::hex << hash << ".bin";
+            return Application::Get().GetCachePath() + name.str();
+        }
+
+        uint32_t GLShader::LoadProgramBinary(uint64_t hash)
+        {
+            LUMOS_PROFILE_FUNCTION();
+            if(!ProgramBinariesSupported())
+                return 0;
+
+            std::string path = GetProgramBinaryPath(hash);
+            int64_t fileSize = FileSystem::GetFileSize(path);
+            if(fileSize <= int64_t(sizeof(ProgramBinaryHeader)))
+                return 0;
+
+            std::vector<uint8_t> file(fileSize);
+            if(!FileSystem::ReadFile(path, file.data(), fileSize))
+                return 0;
+
+            ProgramBinaryHeader header;
+            memcpy(&header, file.data(), sizeof(header));
+            const uint8_t* data = file.data() + sizeof(header);
+
+            if(header.Magic != ProgramBinaryMagic || header.Version != ProgramBinaryVersion || header.DriverHash != GetDriverHash()
+               || header.Size != uint64_t(fileSize) - sizeof(header) || header.DataHash != HashBytes(data, header.Size))
+                return 0;
+
+            GLCall(uint32_t program = glCreateProgram());
+            GLCall(glProgramBinary(program, GLenum(header.Format), data, GLsizei(header.Size)));
+
+            // The driver may still refuse it, e.g. after an update that kept the version string
+            GLint result;
+            GLCall(glGetProgramiv(program, GL_LINK_STATUS, &result));
+            if(result == GL_FALSE)
+            {
+                GLCall(glDeleteProgram(program));
+                return 0;
+            }
+
+            return program;
+        }
+
+        void GLShader::SaveProgramBinary(uint32_t program, uint64_t hash)
+        {
+            LUMOS_PROFILE_FUNCTION();
+            if(!ProgramBinariesSupported())
+                return;
+
+            GLint length = 0;
+            GLCall(glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length));
+            if(length <= 0)
+                return;
+
+            std::vector<uint8_t> file(sizeof(ProgramBinaryHeader) + length);
+            uint8_t* data = file.data() + sizeof(ProgramBinaryHeader);
+
+            GLenum format = 0;
+            GLCall(glGetProgramBinary(program, length, &length, &format, data));
+
+            ProgramBinaryHeader header = {};
+            header.Magic               = ProgramBinaryMagic;
+            header.Version             = ProgramBinaryVersion;
+            header.DriverHash          = GetDriverHash();
+            header.Format              = uint32_t(format);
+            header.Size                = uint32_t(length);
+            header.DataHash            = HashBytes(data, length);
+            memcpy(file.data(), &header, sizeof(header));
+
+            FileSystem::WriteFile(GetProgramBinaryPath(hash), file.data(), uint32_t(sizeof(header) + length));
+        }
+
+        uint32_t GLShader::CompileProgram(std::map<ShaderType, std::string>* sources, GLShaderErrorInfo& info)
+        {
+            LUMOS_PROFILE_FUNCTION();
+            uint32_t program = LoadProgramBinary(m_ProgramHash);
+            if(program)
+                return program;
+
+            for(auto& [type, compiler] : m_StageCompilers)
+                (*sources)[type] = compiler->compile();
+
+            program = Compile(sources, info);
+            if(program)
+                SaveProgramBinary(program, m_ProgramHash);
+
+            return program;
+        }
+
         uint32_t GLShader::Compile(std::map<ShaderType, std::string>* sources, GLShaderErrorInfo& info)
         {
             LUMOS_PROFILE_FUNCTION();
@@ -497,6 +633,9 @@ namespace Lumos
             for(unsigned int shader : shaders)
                 glAttachShader(program, shader);
 
+            if(ProgramBinariesSupported())
+                GLCall(glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE));
+
             GLCall(glLinkProgram(program));
 
             GLint result;
@@ -960,18 +1099,18 @@ namespace Lumos
             options.vertex.fixup_clipspace               = true;
             glsl->set_common_options(options);
 
-            // Compile to GLSL, ready to give to GL driver.
-            std::string glslSource = glsl->compile();
-            sources[type]          = glslSource;
+            // GLSL is only generated if the program binary cache misses
+            sources[type]          = std::string();
+            m_StageCompilers[type] = glsl;
+            m_ProgramHash          = HashBytes(&type, sizeof(type), HashBytes(data, size, m_ProgramHash));
 
             m_ShaderCompilers.push_back(glsl);
         }
 
         Shader* GLShader::CreateFuncGL(const std::string& filePath)
         {
-            std::string physicalPath;
-            Lumos::VFS::Get().ResolvePhysicalPath(filePath, physicalPath);
-            GLShader* result = new GLShader(physicalPath);
+            // Kept as a VFS path so the .shader and its SPIR-V can come from a pack
+            GLShader* result = new GLShader(filePath);
             return result;
         }
 
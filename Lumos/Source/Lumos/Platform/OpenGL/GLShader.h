@@ -124,6 +124,12 @@ namespace Lumos
 
             void LoadFromData(const uint32_t* data, uint32_t size, ShaderType type, std::map<ShaderType, std::string>& sources);
 
+            // Links from the on disk program binary when one matches this driver and SPIR-V, otherwise
+            // cross compiles to GLSL, builds the program and caches its binary
+            uint32_t CompileProgram(std::map<ShaderType, std::string>* sources, GLShaderErrorInfo& info);
+            static uint32_t LoadProgramBinary(uint64_t hash);
+            static void SaveProgramBinary(uint32_t program, uint64_t hash);
+
             uint64_t GetHash() const override { return m_Hash; }
 
         private:
@@ -142,6 +148,8 @@ namespace Lumos
             std::map<uint32_t, uint32_t> m_UniformLocations;
 
             std::vector<spirv_cross::CompilerGLSL*> m_ShaderCompilers;
+            std::map<ShaderType, spirv_cross::CompilerGLSL*> m_StageCompilers;
+            uint64_t m_ProgramHash = 0; // SPIR-V of every stage, keys the program binary cache
             std::vector<PushConstant> m_PushConstants;
             std::vector<std::pair<GLUniformBuffer*, uint32_t>> m_PushConstantsBuffers;
 
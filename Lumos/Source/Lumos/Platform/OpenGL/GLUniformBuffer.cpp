@@ -85,6 +85,15 @@ namespace Lumos
             }
         }
 
+        void GLUniformBuffer::SetSubData(uint32_t offset, uint32_t size, const void* data)
+        {
+            LUMOS_PROFILE_FUNCTION();
+            LUMOS_ASSERT(offset + size <= m_Size, "Uniform buffer write out of bounds");
+
+            glBindBuffer(GL_UNIFORM_BUFFER, m_Handle);
+            glBufferSubData(GL_UNIFORM_BUFFER, offset, size, data);
+        }
+
         void GLUniformBuffer::Bind(uint32_t slot, GLShader* shader, std::string& name)
         {
             LUMOS_PROFILE_FUNCTION();
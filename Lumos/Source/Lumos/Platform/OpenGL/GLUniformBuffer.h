@@ -16,6 +16,7 @@ namespace Lumos
             void Init(uint32_t size, const void* data) override;
             void SetData(uint32_t size, const void* data) override;
             void SetDynamicData(uint32_t size, uint32_t typeSize, const void* data) override;
+            void SetSubData(uint32_t offset, uint32_t size, const void* data) override;
 
             void SetData(const void* data) override { SetData(m_Size, data); }
 
@@ -26,6 +26,7 @@ namespace Lumos
 
             void Map(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
             void UnMap();
+            void* GetMapped() const { return m_Mapped; }
             void Flush(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
             void Invalidate(VkDeviceSize size = VK_WHOLE_SIZE, VkDeviceSize offset = 0);
             void SetUsage(VkBufferUsageFlags flags) { m_UsageFlags = flags; }
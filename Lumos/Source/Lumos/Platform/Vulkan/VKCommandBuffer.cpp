@@ -152,6 +152,9 @@ namespace Lumos
 
             m_Fence->Reset();
 
+            // Uploads recorded since the last submission have to reach the queue first
+            VKDevice::Get().GetUploadRing()->Flush();
+
             {
                 LUMOS_PROFILE_SCOPE("vkQueueSubmit");
                 VK_CHECK_RESULT(vkQueueSubmit(VKDevice::Get().GetGraphicsQueue(), 1, &submitInfo, m_Fence->GetHandle()));
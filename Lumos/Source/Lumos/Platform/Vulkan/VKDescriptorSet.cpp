@@ -3,6 +3,8 @@
 #include "VKPipeline.h"
 #include "VKUtilities.h"
 #include "VKUniformBuffer.h"
+#include "VKStorageBuffer.h"
+#include "VKVertexBuffer.h"
 #include "VKTexture.h"
 #include "VKDevice.h"
 #include "VKRenderer.h"
@@ -32,25 +34,20 @@ namespace Lumos
             {
                 if(descriptor.type == DescriptorType::UNIFORM_BUFFER)
                 {
-                    for(uint32_t frame = 0; frame < m_FramesInFlight; frame++)
-                    {
-                        // Uniform Buffer per frame in flight
-                        auto buffer = SharedPtr<Graphics::UniformBuffer>(Graphics::UniformBuffer::Create());
-                        buffer->Init(descriptor.size, nullptr);
-                        m_UniformBuffers[frame][descriptor.name] = buffer;
-                    }
-
+                    // The per frame uniform buffers are created on first Update, so sets whose
+                    // buffer is replaced with SetBuffer never allocate their own
                     Buffer localStorage;
                     localStorage.Allocate(descriptor.size);
                     localStorage.InitialiseEmpty();
 
                     UniformBufferInfo info;
-                    info.LocalStorage                     = localStorage;
-                    info.HasUpdated[0]                    = false;
-                    info.HasUpdated[1]                    = false;
-                    info.HasUpdated[2]                    = false;
-                    info.m_Members                        = descriptor.m_Members;
-                    m_UniformBuffersData[descriptor.name] = info;
+                    info.Name          = descriptor.name;
+                    info.LocalStorage  = localStorage;
+                    info.HasUpdated[0] = false;
+                    info.HasUpdated[1] = false;
+                    info.HasUpdated[2] = false;
+                    info.m_Members     = descriptor.m_Members;
+                    m_UniformBuffersData.push_back(info);
                 }
             }
 
@@ -71,19 +68,18 @@ namespace Lumos
                 if(!m_DescriptorSet[frame])
                     continue;
 
-                auto descriptorSet                                      = m_DescriptorSet[frame];
-                auto pool                                               = VKRenderer::GetDescriptorPool();
-                auto device                                             = VKDevice::GetHandle();
-                std::map<std::string, SharedPtr<UniformBuffer>> buffers = m_UniformBuffers[frame];
+                auto descriptorSet = m_DescriptorSet[frame];
+                auto pool          = VKRenderer::GetDescriptorPool();
+                auto device        = VKDevice::GetHandle();
 
                 VKContext::DeletionQueue& deletionQueue = VKRenderer::GetCurrentDeletionQueue();
                 deletionQueue.PushFunction([descriptorSet, pool, device]
                                            { vkFreeDescriptorSets(device, pool, 1, &descriptorSet); });
             }
 
-            for(auto it = m_UniformBuffersData.begin(); it != m_UniformBuffersData.end(); it++)
+            for(auto& bufferInfo : m_UniformBuffersData)
             {
-                it->second.LocalStorage.Release();
+                bufferInfo.LocalStorage.Release();
             }
 
             g_DescriptorSetCount -= 3;
@@ -138,10 +134,21 @@ namespace Lumos
 
             for(auto& bufferInfo : m_UniformBuffersData)
             {
-                if(bufferInfo.second.HasUpdated[currentFrame])
+                if(bufferInfo.External)
+                    continue;
+
+                SharedPtr<UniformBuffer>& buffer = bufferInfo.Buffers[currentFrame];
+                if(!buffer)
                 {
-                    m_UniformBuffers[currentFrame][bufferInfo.first]->SetData(bufferInfo.second.LocalStorage.Data);
-                    bufferInfo.second.HasUpdated[currentFrame] = false;
+                    buffer = SharedPtr<Graphics::UniformBuffer>(Graphics::UniformBuffer::Create());
+                    buffer->Init(bufferInfo.LocalStorage.GetSize(), bufferInfo.LocalStorage.Data);
+                    bufferInfo.HasUpdated[currentFrame] = false;
+                    m_DescriptorDirty[currentFrame]     = true;
+                }
+                else if(bufferInfo.HasUpdated[currentFrame])
+                {
+                    buffer->SetData(bufferInfo.LocalStorage.Data);
+                    bufferInfo.HasUpdated[currentFrame] = false;
                 }
             }
 
@@ -150,6 +157,7 @@ namespace Lumos
                 m_DescriptorDirty[currentFrame] = false;
                 uint32_t imageIndex             = 0;
                 uint32_t index                  = 0;
+                uint32_t uniformBufferIndex     = 0;
 
                 for(auto& imageInfo : m_Descriptors.descriptors)
                 {
@@ -203,7 +211,7 @@ namespace Lumos
 
                             VkDescriptorImageInfo& des              = *static_cast<VkDescriptorImageInfo*>(imageInfo.texture->GetDescriptorInfo());
                             m_ImageInfoPool[imageIndex].imageLayout = des.imageLayout;
-                            m_ImageInfoPool[imageIndex].imageView   = imageInfo.mipLevel > 0 ? ((VKTexture2D*)imageInfo.texture)->GetMipImageView(imageInfo.mipLevel) : des.imageView;
+                            m_ImageInfoPool[imageIndex].imageView   = imageInfo.mipLevel > 0 || imageInfo.texture->GetMipMapLevels() > 1 ? ((VKTexture2D*)imageInfo.texture)->GetMipImageView(imageInfo.mipLevel) : des.imageView;
                             m_ImageInfoPool[imageIndex].sampler     = des.sampler;
                         }
 
@@ -222,7 +230,9 @@ namespace Lumos
 
                     else if(imageInfo.type == DescriptorType::UNIFORM_BUFFER)
                     {
-                        VKUniformBuffer* vkUniformBuffer = m_UniformBuffers[currentFrame][imageInfo.name].As<VKUniformBuffer>().get();
+                        // Uniform buffer descriptors are in the same order as m_UniformBuffersData
+                        auto& bufferInfo                 = m_UniformBuffersData[uniformBufferIndex++];
+                        VKUniformBuffer* vkUniformBuffer = bufferInfo.Buffers[currentFrame].As<VKUniformBuffer>().get();
                         m_BufferInfoPool[index].buffer   = *vkUniformBuffer->GetBuffer();
                         m_BufferInfoPool[index].offset   = imageInfo.offset;
                         m_BufferInfoPool[index].range    = imageInfo.size;
@@ -242,6 +252,27 @@ namespace Lumos
                         if(imageInfo.type == DescriptorType::UNIFORM_BUFFER_DYNAMIC)
                             m_Dynamic = true;
                     }
+                    else if(imageInfo.type == DescriptorType::STORAGE_BUFFER && (imageInfo.storageBuffer || imageInfo.vertexBuffer))
+                    {
+                        if(imageInfo.storageBuffer)
+                            m_BufferInfoPool[index].buffer = static_cast<VKStorageBuffer*>(imageInfo.storageBuffer)->GetBuffer();
+                        else
+                            m_BufferInfoPool[index].buffer = static_cast<VKVertexBuffer*>(imageInfo.vertexBuffer)->GetBuffer();
+                        m_BufferInfoPool[index].offset = 0;
+                        m_BufferInfoPool[index].range  = VK_WHOLE_SIZE;
+
+                        VkWriteDescriptorSet writeDescriptorSet = {};
+                        writeDescriptorSet.sType                = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+                        writeDescriptorSet.dstSet               = m_DescriptorSet[currentFrame];
+                        writeDescriptorSet.descriptorType       = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+                        writeDescriptorSet.dstBinding           = imageInfo.binding;
+                        writeDescriptorSet.pBufferInfo          = &m_BufferInfoPool[index];
+                        writeDescriptorSet.descriptorCount      = 1;
+
+                        m_WriteDescriptorSetPool[descriptorWritesCount] = writeDescriptorSet;
+                        index++;
+                        descriptorWritesCount++;
+                    }
                 }
 
                 vkUpdateDescriptorSets(VKDevice::Get().GetDevice(), descriptorWritesCount,
@@ -325,6 +356,79 @@ namespace Lumos
 #endif
         }
 
+        void VKDescriptorSet::SetBuffer(const std::string& name, const SharedPtr<UniformBuffer>* buffers, uint32_t offset, uint32_t size)
+        {
+            LUMOS_PROFILE_FUNCTION();
+
+            for(auto& descriptor : m_Descriptors.descriptors)
+            {
+                if(descriptor.type == DescriptorType::UNIFORM_BUFFER && descriptor.name == name)
+                {
+                    descriptor.offset = offset;
+                    descriptor.size   = size;
+
+                    // Replaces the set's own buffers, which are freed through the deletion queue
+                    if(UniformBufferInfo* bufferInfo = FindUniformBuffer(name))
+                    {
+                        for(uint32_t frame = 0; frame < m_FramesInFlight; frame++)
+                            bufferInfo->Buffers[frame] = buffers[frame];
+
+                        bufferInfo->External = true;
+                        bufferInfo->LocalStorage.Release();
+                    }
+
+                    m_DescriptorDirty[0] = true;
+                    m_DescriptorDirty[1] = true;
+                    m_DescriptorDirty[2] = true;
+                    return;
+                }
+            }
+
+            LUMOS_LOG_WARN("Buffer not found {0}", name);
+        }
+
+        void VKDescriptorSet::SetStorageBuffer(const std::string& name, StorageBuffer* buffer)
+        {
+            LUMOS_PROFILE_FUNCTION();
+
+            for(auto& descriptor : m_Descriptors.descriptors)
+            {
+                if(descriptor.type == DescriptorType::STORAGE_BUFFER && descriptor.name == name)
+                {
+                    descriptor.storageBuffer = buffer;
+                    descriptor.vertexBuffer  = nullptr;
+
+                    m_DescriptorDirty[0] = true;
+                    m_DescriptorDirty[1] = true;
+                    m_DescriptorDirty[2] = true;
+                    return;
+                }
+            }
+
+            LUMOS_LOG_WARN("Storage buffer not found {0}", name);
+        }
+
+        void VKDescriptorSet::SetStorageBuffer(const std::string& name, VertexBuffer* buffer)
+        {
+            LUMOS_PROFILE_FUNCTION();
+
+            for(auto& descriptor : m_Descriptors.descriptors)
+            {
+                if(descriptor.type == DescriptorType::STORAGE_BUFFER && descriptor.name == name)
+                {
+                    descriptor.storageBuffer = nullptr;
+                    descriptor.vertexBuffer  = buffer;
+
+                    m_DescriptorDirty[0] = true;
+                    m_DescriptorDirty[1] = true;
+                    m_DescriptorDirty[2] = true;
+                    return;
+                }
+            }
+
+            LUMOS_LOG_WARN("Storage buffer not found {0}", name);
+        }
+
         Graphics::UniformBuffer* VKDescriptorSet::GetUnifromBuffer(const std::string& name)
         {
             LUMOS_PROFILE_FUNCTION();
@@ -342,63 +446,77 @@ namespace Lumos
             return nullptr;
         }
 
-        void VKDescriptorSet::SetUniform(const std::string& bufferName, const std::string& uniformName, void* data)
+        VKDescriptorSet::UniformBufferInfo* VKDescriptorSet::FindUniformBuffer(const std::string& name)
         {
-            LUMOS_PROFILE_FUNCTION();
-            std::map<std::string, UniformBufferInfo>::iterator itr = m_UniformBuffersData.find(bufferName);
-            if(itr != m_UniformBuffersData.end())
+            // Sets only have a handful of uniform buffers
+            for(auto& bufferInfo : m_UniformBuffersData)
             {
-                for(auto& member : itr->second.m_Members)
-                {
-                    if(member.name == uniformName)
-                    {
-                        itr->second.LocalStorage.Write(data, member.size, member.offset);
-
-                        itr->second.HasUpdated[0] = true;
-                        itr->second.HasUpdated[1] = true;
-                        itr->second.HasUpdated[2] = true;
-                        return;
-                    }
-                }
+                if(bufferInfo.Name == name)
+                    return &bufferInfo;
             }
 
-            LUMOS_LOG_WARN("Uniform not found {0}.{1}", bufferName, uniformName);
+            return nullptr;
         }
 
-        void VKDescriptorSet::SetUniform(const std::string& bufferName, const std::string& uniformName, void* data, uint32_t size)
+        UniformHandle VKDescriptorSet::GetUniformHandle(const std::string& bufferName, const std::string& uniformName)
         {
             LUMOS_PROFILE_FUNCTION();
+            UniformHandle handle;
 
-            std::map<std::string, UniformBufferInfo>::iterator itr = m_UniformBuffersData.find(bufferName);
-            if(itr != m_UniformBuffersData.end())
+            if(UniformBufferInfo* bufferInfo = FindUniformBuffer(bufferName))
             {
-                for(auto& member : itr->second.m_Members)
+                for(auto& member : bufferInfo->m_Members)
                 {
                     if(member.name == uniformName)
                     {
-                        itr->second.LocalStorage.Write(data, size, member.offset);
-                        itr->second.HasUpdated[0] = true;
-                        itr->second.HasUpdated[1] = true;
-                        itr->second.HasUpdated[2] = true;
-                        return;
+                        handle.Buffer = uint32_t(bufferInfo - m_UniformBuffersData.data());
+                        handle.Offset = member.offset;
+                        handle.Size   = member.size;
+                        return handle;
                     }
                 }
             }
 
             LUMOS_LOG_WARN("Uniform not found {0}.{1}", bufferName, uniformName);
+            return handle;
+        }
+
+        void VKDescriptorSet::SetUniform(const UniformHandle& handle, const void* data)
+        {
+            SetUniform(handle, data, handle.Size);
+        }
+
+        void VKDescriptorSet::SetUniform(const UniformHandle& handle, const void* data, uint32_t size)
+        {
+            if(!handle.IsValid())
+                return;
+
+            LUMOS_ASSERT(handle.Buffer < m_UniformBuffersData.size(), "Uniform handle from a different layout");
+            UniformBufferInfo& bufferInfo = m_UniformBuffersData[handle.Buffer];
+            if(bufferInfo.External)
+                return;
+
+            LUMOS_ASSERT(handle.Offset + size <= bufferInfo.LocalStorage.GetSize(), "Uniform write out of bounds");
+            memcpy(bufferInfo.LocalStorage.Data + handle.Offset, data, size);
+
+            bufferInfo.HasUpdated[0] = true;
+            bufferInfo.HasUpdated[1] = true;
+            bufferInfo.HasUpdated[2] = true;
         }
 
         void VKDescriptorSet::SetUniformBufferData(const std::string& bufferName, void* data)
         {
             LUMOS_PROFILE_FUNCTION();
 
-            std::map<std::string, UniformBufferInfo>::iterator itr = m_UniformBuffersData.find(bufferName);
-            if(itr != m_UniformBuffersData.end())
+            if(UniformBufferInfo* bufferInfo = FindUniformBuffer(bufferName))
             {
-                itr->second.LocalStorage.Write(data, itr->second.LocalStorage.GetSize(), 0);
-                itr->second.HasUpdated[0] = true;
-                itr->second.HasUpdated[1] = true;
-                itr->second.HasUpdated[2] = true;
+                if(bufferInfo->External)
+                    return;
+
+                bufferInfo->LocalStorage.Write(data, bufferInfo->LocalStorage.GetSize(), 0);
+                bufferInfo->HasUpdated[0] = true;
+                bufferInfo->HasUpdated[1] = true;
+                bufferInfo->HasUpdated[2] = true;
                 return;
             }
 
@@ -407,11 +525,10 @@ namespace Lumos
 
         void VKDescriptorSet::SetUniformDynamic(const std::string& bufferName, uint32_t size)
         {
-            std::map<std::string, UniformBufferInfo>::iterator itr = m_UniformBuffersData.find(bufferName);
-            if(itr != m_UniformBuffersData.end())
+            if(UniformBufferInfo* bufferInfo = FindUniformBuffer(bufferName))
             {
-                itr->second.LocalStorage.Allocate(size);
-                for(auto& member : itr->second.m_Members)
+                bufferInfo->LocalStorage.Allocate(size);
+                for(auto& member : bufferInfo->m_Members)
                 {
                     member.size = size;
                 }
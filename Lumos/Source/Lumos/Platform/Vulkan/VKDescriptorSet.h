@@ -28,8 +28,13 @@ namespace Lumos
             void SetTexture(const std::string& name, Texture* texture, uint32_t mipIndex, TextureType textureType) override;
             void SetTexture(const std::string& name, Texture** texture, uint32_t textureCount, TextureType textureType) override;
             void SetBuffer(const std::string& name, UniformBuffer* buffer) override;
-            void SetUniform(const std::string& bufferName, const std::string& uniformName, void* data) override;
-            void SetUniform(const std::string& bufferName, const std::string& uniformName, void* data, uint32_t size) override;
+            void SetBuffer(const std::string& name, const SharedPtr<UniformBuffer>* buffers, uint32_t offset, uint32_t size) override;
+            void SetStorageBuffer(const std::string& name, StorageBuffer* buffer) override;
+            void SetStorageBuffer(const std::string& name, VertexBuffer* buffer) override;
+            UniformHandle GetUniformHandle(const std::string& bufferName, const std::string& uniformName) override;
+            void SetUniform(const UniformHandle& handle, const void* data) override;
+            void SetUniform(const UniformHandle& handle, const void* data, uint32_t size) override;
+            using DescriptorSet::SetUniform;
             void SetUniformBufferData(const std::string& bufferName, void* data) override;
             void TransitionImages(CommandBuffer* commandBuffer) override;
 
@@ -60,18 +65,23 @@ namespace Lumos
 
             struct UniformBufferInfo
             {
+                std::string Name;
                 std::vector<BufferMemberInfo> m_Members;
                 Buffer LocalStorage;
+                bool External = false; // Read from buffers set with SetBuffer, nothing to upload
 
                 // Per frame in flight
                 bool HasUpdated[10];
+                SharedPtr<UniformBuffer> Buffers[3];
             };
 
             std::map<uint32_t, VkDescriptorSet> m_DescriptorSet;
             DescriptorSetInfo m_Descriptors;
-            std::map<uint32_t, std::map<std::string, SharedPtr<UniformBuffer>>> m_UniformBuffers;
 
-            std::map<std::string, UniformBufferInfo> m_UniformBuffersData;
+            UniformBufferInfo* FindUniformBuffer(const std::string& name);
+
+            // In layout order, UniformHandle::Buffer indexes this and Update walks it alongside the descriptors
+            std::vector<UniformBufferInfo> m_UniformBuffersData;
             bool m_DescriptorDirty[3];
             bool m_DescriptorUpdated[3];
         };
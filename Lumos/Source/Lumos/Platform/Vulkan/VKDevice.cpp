@@ -3,6 +3,8 @@
 #include "Core/Application.h"
 #include "Core/Version.h"
 #include "Core/StringUtilities.h"
+#include "Core/OS/FileSystem.h"
+#include "Utilities/CombineHash.h"
 
 #include "VKDevice.h"
 #include "VKRenderer.h"
@@ -306,7 +308,10 @@ namespace Lumos
 
         VKDevice::~VKDevice()
         {
+            m_UploadRing.reset();
             m_CommandPool.reset();
+
+            SavePipelineCache();
             vkDestroyPipelineCache(m_Device, m_PipelineCache, VK_NULL_HANDLE);
 
 #ifdef USE_VMA_ALLOCATOR
@@ -395,6 +400,7 @@ namespace Lumos
             vkGetDeviceQueue(m_Device, m_PhysicalDevice->m_QueueFamilyIndices.Graphics, 0, &m_GraphicsQueue);
             vkGetDeviceQueue(m_Device, m_PhysicalDevice->m_QueueFamilyIndices.Graphics, 0, &m_PresentQueue);
             vkGetDeviceQueue(m_Device, m_PhysicalDevice->m_QueueFamilyIndices.Compute, 0, &m_ComputeQueue);
+            vkGetDeviceQueue(m_Device, m_PhysicalDevice->m_QueueFamilyIndices.Transfer, 0, &m_TransferQueue);
 
 #ifdef USE_VMA_ALLOCATOR
             VmaAllocatorCreateInfo allocatorInfo = {};
@@ -438,18 +444,135 @@ namespace Lumos
             }
 #endif
             m_CommandPool = CreateSharedPtr<VKCommandPool>(m_PhysicalDevice->GetGraphicsQueueFamilyIndex(), VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+            m_UploadRing  = CreateUniquePtr<VKUploadRing>(uint64_t(32) * 1024 * 1024);
 
             CreateTracyContext();
             CreatePipelineCache();
             return VK_SUCCESS;
         }
 
+        namespace
+        {
+            // Written in front of the driver's blob. Some drivers crash on cache data from another device
+            // or driver version instead of rejecting it, so nothing reaches vkCreatePipelineCache unless it matches
+            struct PipelineCacheFileHeader
+            {
+                uint32_t Magic;
+                uint32_t Version;
+                uint32_t VendorID;
+                uint32_t DeviceID;
+                uint32_t DriverVersion;
+                uint8_t UUID[VK_UUID_SIZE];
+                uint64_t DataSize;
+                uint64_t DataHash;
+            };
+
+            constexpr uint32_t PipelineCacheMagic   = 0x43504C4C; // "LLPC"
+            constexpr uint32_t PipelineCacheVersion = 1;
+
+            // Frames without a new pipeline before the cache is written back
+            constexpr uint32_t PipelineCacheSaveDelay = 120;
+
+            PipelineCacheFileHeader MakePipelineCacheHeader(const VkPhysicalDeviceProperties& properties)
+            {
+                PipelineCacheFileHeader header = {};
+                header.Magic                   = PipelineCacheMagic;
+                header.Version                 = PipelineCacheVersion;
+                header.VendorID                = properties.vendorID;
+                header.DeviceID                = properties.deviceID;
+                header.DriverVersion           = properties.driverVersion;
+                memcpy(header.UUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+                return header;
+            }
+
+            std::string GetPipelineCachePath(const VkPhysicalDeviceProperties& properties)
+            {
+                std::stringstream name;
+                name << "VulkanPipelineCache_" << std::hex << properties.vendorID << "_" << properties.deviceID << ".bin";
+                return Application::Get().GetCachePath() + name.str();
+            }
+        }
+
         void VKDevice::CreatePipelineCache()
         {
+            LUMOS_PROFILE_FUNCTION();
+            const auto& properties = m_PhysicalDevice->GetProperties();
+            std::string path       = GetPipelineCachePath(properties);
+
+            std::vector<uint8_t> initialData;
+            int64_t fileSize = FileSystem::GetFileSize(path);
+            if(fileSize > int64_t(sizeof(PipelineCacheFileHeader)))
+            {
+                std::vector<uint8_t> file(fileSize);
+                if(FileSystem::ReadFile(path, file.data(), fileSize))
+                {
+                    PipelineCacheFileHeader header;
+                    memcpy(&header, file.data(), sizeof(header));
+
+                    PipelineCacheFileHeader expected = MakePipelineCacheHeader(properties);
+                    const uint8_t* data              = file.data() + sizeof(header);
+                    bool valid                       = header.Magic == expected.Magic && header.Version == expected.Version
+                        && header.VendorID == expected.VendorID && header.DeviceID == expected.DeviceID
+                        && header.DriverVersion == expected.DriverVersion && memcmp(header.UUID, expected.UUID, VK_UUID_SIZE) == 0
+                        && header.DataSize == uint64_t(fileSize) - sizeof(header) && header.DataHash == HashBytes(data, header.DataSize);
+
+                    if(valid)
+                        initialData.assign(data, data + header.DataSize);
+                    else
+                        LUMOS_LOG_INFO("[VULKAN] Discarding pipeline cache from a different device or driver");
+                }
+            }
+
             VkPipelineCacheCreateInfo pipelineCacheCI = {};
             pipelineCacheCI.sType                     = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
             pipelineCacheCI.pNext                     = NULL;
-            vkCreatePipelineCache(m_Device, &pipelineCacheCI, VK_NULL_HANDLE, &m_PipelineCache);
+            pipelineCacheCI.initialDataSize           = initialData.size();
+            pipelineCacheCI.pInitialData              = initialData.empty() ? nullptr : initialData.data();
+
+            if(vkCreatePipelineCache(m_Device, &pipelineCacheCI, VK_NULL_HANDLE, &m_PipelineCache) != VK_SUCCESS && !initialData.empty())
+            {
+                LUMOS_LOG_WARN("[VULKAN] Pipeline cache data rejected, starting empty");
+                pipelineCacheCI.initialDataSize = 0;
+                pipelineCacheCI.pInitialData    = nullptr;
+                vkCreatePipelineCache(m_Device, &pipelineCacheCI, VK_NULL_HANDLE, &m_PipelineCache);
+            }
+        }
+
+        void VKDevice::SavePipelineCache()
+        {
+            LUMOS_PROFILE_FUNCTION();
+            if(!m_PipelineCache)
+                return;
+
+            size_t dataSize = 0;
+            if(vkGetPipelineCacheData(m_Device, m_PipelineCache, &dataSize, nullptr) != VK_SUCCESS || dataSize == 0)
+                return;
+
+            std::vector<uint8_t> file(sizeof(PipelineCacheFileHeader) + dataSize);
+            uint8_t* data = file.data() + sizeof(PipelineCacheFileHeader);
+            if(vkGetPipelineCacheData(m_Device, m_PipelineCache, &dataSize, data) != VK_SUCCESS)
+                return;
+
+            const auto& properties         = m_PhysicalDevice->GetProperties();
+            PipelineCacheFileHeader header = MakePipelineCacheHeader(properties);
+            header.DataSize                = dataSize;
+            header.DataHash                = HashBytes(data, dataSize);
+            memcpy(file.data(), &header, sizeof(header));
+
+            FileSystem::WriteFile(GetPipelineCachePath(properties), file.data(), uint32_t(sizeof(header) + dataSize));
+            m_PipelineCacheDirty = false;
+        }
+
+        void VKDevice::OnPipelineCreated()
+        {
+            m_PipelineCacheDirty      = true;
+            m_PipelineCacheIdleFrames = 0;
+        }
+
+        void VKDevice::UpdatePipelineCache()
+        {
+            if(m_PipelineCacheDirty && ++m_PipelineCacheIdleFrames > PipelineCacheSaveDelay)
+                SavePipelineCache();
         }
 
         void VKDevice::CreateTracyContext()
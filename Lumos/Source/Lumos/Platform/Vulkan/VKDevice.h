@@ -3,6 +3,7 @@
 #include "VK.h"
 #include "VKContext.h"
 #include "VKCommandPool.h"
+#include "VKUploadRing.h"
 #include "Graphics/RHI/Definitions.h"
 #include "Core/StringUtilities.h"
 
@@ -126,6 +127,11 @@ namespace Lumos
                 return m_QueueFamilyIndices.Graphics;
             }
 
+            int32_t GetTransferQueueFamilyIndex()
+            {
+                return m_QueueFamilyIndices.Transfer;
+            }
+
             VkPhysicalDeviceProperties GetProperties() const
             {
                 return m_PhysicalDeviceProperties;
@@ -179,6 +185,12 @@ namespace Lumos
             void CreatePipelineCache();
             void CreateTracyContext();
 
+            // The pipeline cache is loaded from the project cache folder at init and written back on shutdown,
+            // and once pipeline creation has gone quiet for a while after new pipelines were made
+            void SavePipelineCache();
+            void OnPipelineCreated();
+            void UpdatePipelineCache();
+
             VkDevice GetDevice() const
             {
                 return m_Device;
@@ -209,6 +221,11 @@ namespace Lumos
                 return m_ComputeQueue;
             }
 
+            VkQueue GetTransferQueue() const
+            {
+                return m_TransferQueue;
+            }
+
             const SharedPtr<VKCommandPool>& GetCommandPool() const
             {
                 return m_CommandPool;
@@ -219,6 +236,11 @@ namespace Lumos
                 return m_PipelineCache;
             }
 
+            VKUploadRing* GetUploadRing() const
+            {
+                return m_UploadRing.get();
+            }
+
 #if defined(LUMOS_PROFILE) && defined(TRACY_ENABLE)
             tracy::VkCtx* GetTracyContext(bool present = false);
 #endif
@@ -251,11 +273,15 @@ namespace Lumos
             VkQueue m_ComputeQueue;
             VkQueue m_GraphicsQueue;
             VkQueue m_PresentQueue;
-            VkPipelineCache m_PipelineCache;
+            VkQueue m_TransferQueue;
+            VkPipelineCache m_PipelineCache    = VK_NULL_HANDLE;
+            bool m_PipelineCacheDirty          = false;
+            uint32_t m_PipelineCacheIdleFrames = 0;
             VkDescriptorPool m_DescriptorPool;
             VkPhysicalDeviceFeatures m_EnabledFeatures;
 
             SharedPtr<VKCommandPool> m_CommandPool;
+            UniquePtr<VKUploadRing> m_UploadRing;
             SharedPtr<VKPhysicalDevice> m_PhysicalDevice;
 
             bool m_EnableDebugMarkers = false;
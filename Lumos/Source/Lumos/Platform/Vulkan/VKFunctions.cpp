@@ -11,6 +11,7 @@
 #include "VKRenderer.h"
 #include "VKRenderPass.h"
 #include "VKShader.h"
+#include "VKStorageBuffer.h"
 #include "VKSwapChain.h"
 #include "VKTexture.h"
 #include "VKUniformBuffer.h"
@@ -29,6 +30,7 @@ void Lumos::Graphics::Vulkan::MakeDefault()
     VKRenderer::MakeDefault();
     VKRenderPass::MakeDefault();
     VKShader::MakeDefault();
+    VKStorageBuffer::MakeDefault();
     VKSwapChain::MakeDefault();
     VKTexture2D::MakeDefault();
     VKTextureCube::MakeDefault();
@@ -9,254 +9,356 @@
 #include "VKUtilities.h"
 #include "Graphics/RHI/DescriptorSet.h"
 #include "VKInitialisers.h"
+#include "Core/JobSystem.h"
+#include "Utilities/CombineHash.h"
 
 namespace Lumos
 {
 
     namespace Graphics
     {
-        VKPipeline::VKPipeline(const PipelineDesc& pipelineDesc)
+        struct VKPipelineState
         {
-            Init(pipelineDesc);
-        }
+            ~VKPipelineState()
+            {
+                if(!Handle)
+                    return;
 
-        VKPipeline::~VKPipeline()
+                auto pipeline = Handle;
+                VKRenderer::GetCurrentDeletionQueue().PushFunction([pipeline]
+                                                                   { vkDestroyPipeline(VKDevice::Get().GetDevice(), pipeline, VK_NULL_HANDLE); });
+            }
+
+            PipelineDesc Description;
+            SharedPtr<RenderPass> Pass;
+            uint64_t Key            = 0;
+            VkPipeline Handle       = VK_NULL_HANDLE;
+            std::atomic<bool> Ready = false;
+        };
+
+        static std::unordered_map<uint64_t, SharedPtr<VKPipelineState>> s_PipelineStates;
+        static System::JobSystem::Context s_CompileContext;
+
+        // Only what the compiled VkPipeline depends on. Render passes are compatible when their attachment
+        // formats and sample counts match, so the size and identity of the targets are left out
+        static uint64_t GetStateKey(const PipelineDesc& desc)
         {
-            LUMOS_PROFILE_FUNCTION_LOW();
-            VKContext::DeletionQueue& deletionQueue = VKRenderer::GetCurrentDeletionQueue();
+            uint64_t key = 0;
+            HashCombine(key, desc.shader.get(), desc.cullMode, desc.polygonMode, desc.drawType, desc.blendMode, desc.transparencyEnabled, desc.depthBiasEnabled, desc.lineWidth, desc.swapchainTarget);
+
+            if(desc.swapchainTarget)
+                HashCombine(key, Renderer::GetMainSwapChain()->GetImage(0)->GetFormat());
+
+            for(auto texture : desc.colourTargets)
+            {
+                if(texture)
+                    HashCombine(key, texture->GetFormat());
+            }
 
-            auto pipeline = m_Pipeline;
+            for(auto texture : { desc.depthTarget, desc.depthArrayTarget, desc.cubeMapTarget })
+            {
+                if(texture)
+                    HashCombine(key, texture->GetType(), texture->GetFormat());
+            }
 
-            deletionQueue.PushFunction([pipeline]
-                                       { vkDestroyPipeline(VKDevice::Get().GetDevice(), pipeline, VK_NULL_HANDLE); });
+            // Every attachment is single sampled, CreateGraphicsPipeline hard codes VK_SAMPLE_COUNT_1_BIT
+            return key;
         }
 
-        bool VKPipeline::Init(const PipelineDesc& pipelineDesc)
+        // Reads nothing but its arguments so it can run on a job thread
+        static VkPipeline CreateGraphicsPipeline(const PipelineDesc& pipelineDesc, VKShader* shader, VKRenderPass* renderPass, VkPipelineLayout layout)
         {
             LUMOS_PROFILE_FUNCTION_LOW();
-            m_Description    = pipelineDesc;
-            m_Shader         = m_Description.shader;
-            m_PipelineLayout = m_Shader.As<VKShader>()->GetPipelineLayout();
-
-            TransitionAttachments();
-
-            // Pipeline
             std::vector<VkDynamicState> dynamicStateDescriptors;
             VkPipelineDynamicStateCreateInfo dynamicStateCI {};
             dynamicStateCI.sType          = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
             dynamicStateCI.pNext          = NULL;
             dynamicStateCI.pDynamicStates = dynamicStateDescriptors.data();
 
-            std::vector<VkVertexInputAttributeDescription> vertexInputDescription;
+            uint32_t stride = shader->GetVertexInputStride();
 
-            m_Compute = m_Shader.As<VKShader>()->IsCompute();
+            // Vertex layout
+            VkVertexInputBindingDescription vertexBindingDescription;
 
-            if(m_Compute)
+            if(stride > 0)
             {
-                VkComputePipelineCreateInfo pipelineInfo = {};
-                pipelineInfo.sType                       = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
-                pipelineInfo.layout                      = m_PipelineLayout;
-                pipelineInfo.stage                       = m_Shader.As<VKShader>()->GetShaderStages()[0];
-                VK_CHECK_RESULT(vkCreateComputePipelines(VKDevice::Get().GetDevice(), nullptr, 1, &pipelineInfo, nullptr, &m_Pipeline));
+                vertexBindingDescription.binding   = 0;
+                vertexBindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+                vertexBindingDescription.stride    = shader->GetVertexInputStride();
             }
-            else
-            {
-                CreateFramebuffers();
-
-                uint32_t stride = m_Shader.As<VKShader>()->GetVertexInputStride();
-
-                // Vertex layout
-                VkVertexInputBindingDescription vertexBindingDescription;
 
-                if(stride > 0)
-                {
-                    vertexBindingDescription.binding   = 0;
-                    vertexBindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-                    vertexBindingDescription.stride    = m_Shader.As<VKShader>()->GetVertexInputStride();
-                }
+            const std::vector<VkVertexInputAttributeDescription>& vertexInputAttributeDescription = shader->GetVertexInputAttributeDescription();
+
+            VkPipelineVertexInputStateCreateInfo vi {};
+            vi.sType                           = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+            vi.pNext                           = NULL;
+            vi.vertexBindingDescriptionCount   = stride > 0 ? 1 : 0;
+            vi.pVertexBindingDescriptions      = stride > 0 ? &vertexBindingDescription : nullptr;
+            vi.vertexAttributeDescriptionCount = stride > 0 ? uint32_t(vertexInputAttributeDescription.size()) : 0;
+            vi.pVertexAttributeDescriptions    = stride > 0 ? vertexInputAttributeDescription.data() : nullptr;
+
+            VkPipelineInputAssemblyStateCreateInfo inputAssemblyCI {};
+            inputAssemblyCI.sType                  = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
+            inputAssemblyCI.pNext                  = NULL;
+            inputAssemblyCI.primitiveRestartEnable = VK_FALSE;
+            inputAssemblyCI.topology               = VKUtilities::DrawTypeToVk(pipelineDesc.drawType);
+
+            VkPipelineRasterizationStateCreateInfo rs {};
+            rs.sType                   = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
+            rs.polygonMode             = VKUtilities::PolygonModeToVk(pipelineDesc.polygonMode);
+            rs.cullMode                = VKUtilities::CullModeToVK(pipelineDesc.cullMode);
+            rs.frontFace               = pipelineDesc.swapchainTarget ? VK_FRONT_FACE_COUNTER_CLOCKWISE : VK_FRONT_FACE_CLOCKWISE;
+            rs.depthClampEnable        = VK_FALSE;
+            rs.rasterizerDiscardEnable = VK_FALSE;
+            rs.depthBiasEnable         = (pipelineDesc.depthBiasEnabled ? VK_TRUE : VK_FALSE);
+            rs.depthBiasConstantFactor = pipelineDesc.depthBiasConstantFactor;
+            rs.depthBiasClamp          = 0;
+            rs.depthBiasSlopeFactor    = pipelineDesc.depthBiasSlopeFactor;
+
+            if(Renderer::GetCapabilities().WideLines)
+                rs.lineWidth = pipelineDesc.lineWidth;
+            else
+                rs.lineWidth = 1.0f;
+            rs.pNext = NULL;
 
-                const std::vector<VkVertexInputAttributeDescription>& vertexInputAttributeDescription = m_Shader.As<VKShader>()->GetVertexInputAttributeDescription();
-
-                VkPipelineVertexInputStateCreateInfo vi {};
-                vi.sType                           = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-                vi.pNext                           = NULL;
-                vi.vertexBindingDescriptionCount   = stride > 0 ? 1 : 0;
-                vi.pVertexBindingDescriptions      = stride > 0 ? &vertexBindingDescription : nullptr;
-                vi.vertexAttributeDescriptionCount = stride > 0 ? uint32_t(vertexInputAttributeDescription.size()) : 0;
-                vi.pVertexAttributeDescriptions    = stride > 0 ? vertexInputAttributeDescription.data() : nullptr;
-
-                VkPipelineInputAssemblyStateCreateInfo inputAssemblyCI {};
-                inputAssemblyCI.sType                  = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-                inputAssemblyCI.pNext                  = NULL;
-                inputAssemblyCI.primitiveRestartEnable = VK_FALSE;
-                inputAssemblyCI.topology               = VKUtilities::DrawTypeToVk(pipelineDesc.drawType);
-
-                VkPipelineRasterizationStateCreateInfo rs {};
-                rs.sType                   = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
-                rs.polygonMode             = VKUtilities::PolygonModeToVk(pipelineDesc.polygonMode);
-                rs.cullMode                = VKUtilities::CullModeToVK(pipelineDesc.cullMode);
-                rs.frontFace               = pipelineDesc.swapchainTarget ? VK_FRONT_FACE_COUNTER_CLOCKWISE : VK_FRONT_FACE_CLOCKWISE;
-                rs.depthClampEnable        = VK_FALSE;
-                rs.rasterizerDiscardEnable = VK_FALSE;
-                rs.depthBiasEnable         = (pipelineDesc.depthBiasEnabled ? VK_TRUE : VK_FALSE);
-                rs.depthBiasConstantFactor = pipelineDesc.depthBiasConstantFactor;
-                rs.depthBiasClamp          = 0;
-                rs.depthBiasSlopeFactor    = pipelineDesc.depthBiasSlopeFactor;
-
-                if(Renderer::GetCapabilities().WideLines)
-                    rs.lineWidth = pipelineDesc.lineWidth;
-                else
-                    rs.lineWidth = 1.0f;
-                rs.pNext = NULL;
+            VkPipelineColorBlendStateCreateInfo cb {};
+            cb.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
+            cb.pNext = NULL;
+            cb.flags = 0;
 
-                VkPipelineColorBlendStateCreateInfo cb {};
-                cb.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
-                cb.pNext = NULL;
-                cb.flags = 0;
+            std::vector<VkPipelineColorBlendAttachmentState> blendAttachState;
+            blendAttachState.resize(renderPass->GetColourAttachmentCount());
 
-                std::vector<VkPipelineColorBlendAttachmentState> blendAttachState;
-                blendAttachState.resize(m_RenderPass.As<VKRenderPass>()->GetColourAttachmentCount());
+            for(unsigned int i = 0; i < blendAttachState.size(); i++)
+            {
+                blendAttachState[i]                = VkPipelineColorBlendAttachmentState();
+                blendAttachState[i].colorWriteMask = 0x0f;
+                blendAttachState[i].alphaBlendOp   = VK_BLEND_OP_ADD;
+                blendAttachState[i].colorBlendOp   = VK_BLEND_OP_ADD;
 
-                for(unsigned int i = 0; i < blendAttachState.size(); i++)
+                if(pipelineDesc.transparencyEnabled)
                 {
-                    blendAttachState[i]                = VkPipelineColorBlendAttachmentState();
-                    blendAttachState[i].colorWriteMask = 0x0f;
-                    blendAttachState[i].alphaBlendOp   = VK_BLEND_OP_ADD;
-                    blendAttachState[i].colorBlendOp   = VK_BLEND_OP_ADD;
+                    blendAttachState[i].blendEnable         = VK_TRUE;
+                    blendAttachState[i].srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
+                    blendAttachState[i].dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
 
-                    if(pipelineDesc.transparencyEnabled)
+                    if(pipelineDesc.blendMode == BlendMode::SrcAlphaOneMinusSrcAlpha)
                     {
-                        blendAttachState[i].blendEnable         = VK_TRUE;
-                        blendAttachState[i].srcAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
-                        blendAttachState[i].dstAlphaBlendFactor = VK_BLEND_FACTOR_ONE;
-
-                        if(pipelineDesc.blendMode == BlendMode::SrcAlphaOneMinusSrcAlpha)
-                        {
-                            blendAttachState[i].srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
-                            blendAttachState[i].dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
-                        }
-                        else if(pipelineDesc.blendMode == BlendMode::ZeroSrcColor)
-                        {
-                            blendAttachState[i].srcColorBlendFactor = VK_BLEND_FACTOR_ZERO;
-                            blendAttachState[i].dstColorBlendFactor = VK_BLEND_FACTOR_SRC_COLOR;
-                        }
-                        else if(pipelineDesc.blendMode == BlendMode::OneZero)
-                        {
-                            blendAttachState[i].srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
-                            blendAttachState[i].dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
-                        }
-                        else
-                        {
-                            blendAttachState[i].srcColorBlendFactor = VK_BLEND_FACTOR_ZERO;
-                            blendAttachState[i].dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
-                        }
+                        blendAttachState[i].srcColorBlendFactor = VK_BLEND_FACTOR_SRC_ALPHA;
+                        blendAttachState[i].dstColorBlendFactor = VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA;
+                    }
+                    else if(pipelineDesc.blendMode == BlendMode::ZeroSrcColor)
+                    {
+                        blendAttachState[i].srcColorBlendFactor = VK_BLEND_FACTOR_ZERO;
+                        blendAttachState[i].dstColorBlendFactor = VK_BLEND_FACTOR_SRC_COLOR;
+                    }
+                    else if(pipelineDesc.blendMode == BlendMode::OneZero)
+                    {
+                        blendAttachState[i].srcColorBlendFactor = VK_BLEND_FACTOR_ONE;
+                        blendAttachState[i].dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
                     }
                     else
                     {
-                        blendAttachState[i].blendEnable         = VK_FALSE;
                         blendAttachState[i].srcColorBlendFactor = VK_BLEND_FACTOR_ZERO;
                         blendAttachState[i].dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
-                        blendAttachState[i].srcAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
-                        blendAttachState[i].dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
                     }
                 }
-
-                cb.attachmentCount   = static_cast<uint32_t>(blendAttachState.size());
-                cb.pAttachments      = blendAttachState.data();
-                cb.logicOpEnable     = VK_FALSE;
-                cb.logicOp           = VK_LOGIC_OP_NO_OP;
-                cb.blendConstants[0] = 1.0f;
-                cb.blendConstants[1] = 1.0f;
-                cb.blendConstants[2] = 1.0f;
-                cb.blendConstants[3] = 1.0f;
-
-                VkPipelineViewportStateCreateInfo vp {};
-                vp.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
-                vp.pNext         = NULL;
-                vp.viewportCount = 1;
-                vp.scissorCount  = 1;
-                vp.pScissors     = NULL;
-                vp.pViewports    = NULL;
-                dynamicStateDescriptors.push_back(VK_DYNAMIC_STATE_VIEWPORT);
-                dynamicStateDescriptors.push_back(VK_DYNAMIC_STATE_SCISSOR);
-
-                if(Renderer::GetCapabilities().WideLines && pipelineDesc.polygonMode == PolygonMode::LINE) // || pipelineDesc.polygonMode == PolygonMode::LINESTRIP)
-                    dynamicStateDescriptors.push_back(VK_DYNAMIC_STATE_LINE_WIDTH);
-
-                if(pipelineDesc.depthBiasEnabled)
-                {
-                    dynamicStateDescriptors.push_back(VK_DYNAMIC_STATE_DEPTH_BIAS);
-                    m_DepthBiasConstant = pipelineDesc.depthBiasConstantFactor;
-                    m_DepthBiasSlope    = pipelineDesc.depthBiasSlopeFactor;
-                    m_DepthBiasEnabled  = true;
-                }
                 else
                 {
-                    m_DepthBiasEnabled = false;
+                    blendAttachState[i].blendEnable         = VK_FALSE;
+                    blendAttachState[i].srcColorBlendFactor = VK_BLEND_FACTOR_ZERO;
+                    blendAttachState[i].dstColorBlendFactor = VK_BLEND_FACTOR_ZERO;
+                    blendAttachState[i].srcAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
+                    blendAttachState[i].dstAlphaBlendFactor = VK_BLEND_FACTOR_ZERO;
                 }
-
-                VkPipelineDepthStencilStateCreateInfo ds {};
-                ds.sType                 = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-                ds.pNext                 = NULL;
-                ds.depthTestEnable       = VK_TRUE;
-                ds.depthWriteEnable      = VK_TRUE;
-                ds.depthCompareOp        = VK_COMPARE_OP_LESS_OR_EQUAL;
-                ds.depthBoundsTestEnable = VK_FALSE;
-                ds.stencilTestEnable     = VK_FALSE;
-                ds.back.failOp           = VK_STENCIL_OP_KEEP;
-                ds.back.passOp           = VK_STENCIL_OP_KEEP;
-                ds.back.compareOp        = VK_COMPARE_OP_ALWAYS;
-                ds.back.compareMask      = 0;
-                ds.back.reference        = 0;
-                ds.back.depthFailOp      = VK_STENCIL_OP_KEEP;
-                ds.back.writeMask        = 0;
-                ds.minDepthBounds        = 0;
-                ds.maxDepthBounds        = 0;
-                ds.front                 = ds.back;
-
-                VkPipelineMultisampleStateCreateInfo ms {};
-                ms.sType                 = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
-                ms.pNext                 = NULL;
-                ms.pSampleMask           = NULL;
-                ms.rasterizationSamples  = VK_SAMPLE_COUNT_1_BIT;
-                ms.sampleShadingEnable   = VK_FALSE;
-                ms.alphaToCoverageEnable = VK_FALSE;
-                ms.alphaToOneEnable      = VK_FALSE;
-                ms.minSampleShading      = 0.0;
-
-                dynamicStateCI.dynamicStateCount = uint32_t(dynamicStateDescriptors.size());
-                dynamicStateCI.pDynamicStates    = dynamicStateDescriptors.data();
-
-                auto vkshader = pipelineDesc.shader.As<VKShader>();
-                VkGraphicsPipelineCreateInfo graphicsPipelineCreateInfo {};
-                graphicsPipelineCreateInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-                graphicsPipelineCreateInfo.pNext               = NULL;
-                graphicsPipelineCreateInfo.layout              = m_PipelineLayout;
-                graphicsPipelineCreateInfo.basePipelineHandle  = VK_NULL_HANDLE;
-                graphicsPipelineCreateInfo.basePipelineIndex   = -1;
-                graphicsPipelineCreateInfo.pVertexInputState   = &vi;
-                graphicsPipelineCreateInfo.pInputAssemblyState = &inputAssemblyCI;
-                graphicsPipelineCreateInfo.pRasterizationState = &rs;
-                graphicsPipelineCreateInfo.pColorBlendState    = &cb;
-                graphicsPipelineCreateInfo.pTessellationState  = VK_NULL_HANDLE;
-                graphicsPipelineCreateInfo.pMultisampleState   = &ms;
-                graphicsPipelineCreateInfo.pDynamicState       = &dynamicStateCI;
-                graphicsPipelineCreateInfo.pViewportState      = &vp;
-                graphicsPipelineCreateInfo.pDepthStencilState  = &ds;
-                graphicsPipelineCreateInfo.pStages             = vkshader->GetShaderStages();
-                graphicsPipelineCreateInfo.stageCount          = vkshader->GetStageCount();
-                graphicsPipelineCreateInfo.renderPass          = m_RenderPass.As<VKRenderPass>()->GetHandle();
-                graphicsPipelineCreateInfo.subpass             = 0;
-
-                VK_CHECK_RESULT(vkCreateGraphicsPipelines(VKDevice::Get().GetDevice(), VKDevice::Get().GetPipelineCache(), 1, &graphicsPipelineCreateInfo, VK_NULL_HANDLE, &m_Pipeline));
             }
 
+            cb.attachmentCount   = static_cast<uint32_t>(blendAttachState.size());
+            cb.pAttachments      = blendAttachState.data();
+            cb.logicOpEnable     = VK_FALSE;
+            cb.logicOp           = VK_LOGIC_OP_NO_OP;
+            cb.blendConstants[0] = 1.0f;
+            cb.blendConstants[1] = 1.0f;
+            cb.blendConstants[2] = 1.0f;
+            cb.blendConstants[3] = 1.0f;
+
+            VkPipelineViewportStateCreateInfo vp {};
+            vp.sType         = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
+            vp.pNext         = NULL;
+            vp.viewportCount = 1;
+            vp.scissorCount  = 1;
+            vp.pScissors     = NULL;
+            vp.pViewports    = NULL;
+            dynamicStateDescriptors.push_back(VK_DYNAMIC_STATE_VIEWPORT);
+            dynamicStateDescriptors.push_back(VK_DYNAMIC_STATE_SCISSOR);
+
+            if(Renderer::GetCapabilities().WideLines && pipelineDesc.polygonMode == PolygonMode::LINE) // || pipelineDesc.polygonMode == PolygonMode::LINESTRIP)
+                dynamicStateDescriptors.push_back(VK_DYNAMIC_STATE_LINE_WIDTH);
+
+            if(pipelineDesc.depthBiasEnabled)
+                dynamicStateDescriptors.push_back(VK_DYNAMIC_STATE_DEPTH_BIAS);
+
+            VkPipelineDepthStencilStateCreateInfo ds {};
+            ds.sType                 = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
+            ds.pNext                 = NULL;
+            ds.depthTestEnable       = VK_TRUE;
+            ds.depthWriteEnable      = VK_TRUE;
+            ds.depthCompareOp        = VK_COMPARE_OP_LESS_OR_EQUAL;
+            ds.depthBoundsTestEnable = VK_FALSE;
+            ds.stencilTestEnable     = VK_FALSE;
+            ds.back.failOp           = VK_STENCIL_OP_KEEP;
+            ds.back.passOp           = VK_STENCIL_OP_KEEP;
+            ds.back.compareOp        = VK_COMPARE_OP_ALWAYS;
+            ds.back.compareMask      = 0;
+            ds.back.reference        = 0;
+            ds.back.depthFailOp      = VK_STENCIL_OP_KEEP;
+            ds.back.writeMask        = 0;
+            ds.minDepthBounds        = 0;
+            ds.maxDepthBounds        = 0;
+            ds.front                 = ds.back;
+
+            VkPipelineMultisampleStateCreateInfo ms {};
+            ms.sType                 = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO;
+            ms.pNext                 = NULL;
+            ms.pSampleMask           = NULL;
+            ms.rasterizationSamples  = VK_SAMPLE_COUNT_1_BIT;
+            ms.sampleShadingEnable   = VK_FALSE;
+            ms.alphaToCoverageEnable = VK_FALSE;
+            ms.alphaToOneEnable      = VK_FALSE;
+            ms.minSampleShading      = 0.0;
+
+            dynamicStateCI.dynamicStateCount = uint32_t(dynamicStateDescriptors.size());
+            dynamicStateCI.pDynamicStates    = dynamicStateDescriptors.data();
+
+            VkGraphicsPipelineCreateInfo graphicsPipelineCreateInfo {};
+            graphicsPipelineCreateInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+            graphicsPipelineCreateInfo.pNext               = NULL;
+            graphicsPipelineCreateInfo.layout              = layout;
+            graphicsPipelineCreateInfo.basePipelineHandle  = VK_NULL_HANDLE;
+            graphicsPipelineCreateInfo.basePipelineIndex   = -1;
+            graphicsPipelineCreateInfo.pVertexInputState   = &vi;
+            graphicsPipelineCreateInfo.pInputAssemblyState = &inputAssemblyCI;
+            graphicsPipelineCreateInfo.pRasterizationState = &rs;
+            graphicsPipelineCreateInfo.pColorBlendState    = &cb;
+            graphicsPipelineCreateInfo.pTessellationState  = VK_NULL_HANDLE;
+            graphicsPipelineCreateInfo.pMultisampleState   = &ms;
+            graphicsPipelineCreateInfo.pDynamicState       = &dynamicStateCI;
+            graphicsPipelineCreateInfo.pViewportState      = &vp;
+            graphicsPipelineCreateInfo.pDepthStencilState  = &ds;
+            graphicsPipelineCreateInfo.pStages             = shader->GetShaderStages();
+            graphicsPipelineCreateInfo.stageCount          = shader->GetStageCount();
+            graphicsPipelineCreateInfo.renderPass          = renderPass->GetHandle();
+            graphicsPipelineCreateInfo.subpass             = 0;
+
+            VkPipeline pipeline = VK_NULL_HANDLE;
+            VK_CHECK_RESULT(vkCreateGraphicsPipelines(VKDevice::Get().GetDevice(), VKDevice::Get().GetPipelineCache(), 1, &graphicsPipelineCreateInfo, VK_NULL_HANDLE, &pipeline));
+
             if(!pipelineDesc.DebugName.empty())
-                VKUtilities::SetDebugUtilsObjectName(VKDevice::Get().GetDevice(), VK_OBJECT_TYPE_PIPELINE, pipelineDesc.DebugName, m_Pipeline);
+                VKUtilities::SetDebugUtilsObjectName(VKDevice::Get().GetDevice(), VK_OBJECT_TYPE_PIPELINE, pipelineDesc.DebugName, pipeline);
+
+            return pipeline;
+        }
 
+        VKPipeline::VKPipeline(const PipelineDesc& pipelineDesc)
+        {
+            Init(pipelineDesc);
+        }
+
+        VKPipeline::~VKPipeline()
+        {
+            LUMOS_PROFILE_FUNCTION_LOW();
+            if(!m_State)
+                return;
+
+            // A job may still be writing to the state
+            if(!m_State->Ready)
+                System::JobSystem::Wait(s_CompileContext);
+
+            // The cache and this are the last owners, drop the compiled pipeline with its last user
+            auto found = s_PipelineStates.find(m_State->Key);
+            if(found != s_PipelineStates.end() && found->second.get() == m_State.get() && m_State.GetCounter()->GetReferenceCount() == 2)
+                s_PipelineStates.erase(found);
+        }
+
+        bool VKPipeline::Init(const PipelineDesc& pipelineDesc)
+        {
+            LUMOS_PROFILE_FUNCTION_LOW();
+            m_Description    = pipelineDesc;
+            m_Shader         = m_Description.shader;
+            m_PipelineLayout = m_Shader.As<VKShader>()->GetPipelineLayout();
+
+            TransitionAttachments();
+
+            m_Compute = m_Shader.As<VKShader>()->IsCompute();
+
+            if(m_Compute)
+            {
+                m_State = CreateSharedPtr<VKPipelineState>();
+
+                VkComputePipelineCreateInfo pipelineInfo = {};
+                pipelineInfo.sType                       = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+                pipelineInfo.layout                      = m_PipelineLayout;
+                pipelineInfo.stage                       = m_Shader.As<VKShader>()->GetShaderStages()[0];
+                VK_CHECK_RESULT(vkCreateComputePipelines(VKDevice::Get().GetDevice(), VKDevice::Get().GetPipelineCache(), 1, &pipelineInfo, nullptr, &m_State->Handle));
+                VKDevice::Get().OnPipelineCreated();
+                m_State->Ready = true;
+
+                if(!pipelineDesc.DebugName.empty())
+                    VKUtilities::SetDebugUtilsObjectName(VKDevice::Get().GetDevice(), VK_OBJECT_TYPE_PIPELINE, pipelineDesc.DebugName, m_State->Handle);
+
+                return true;
+            }
+
+            CreateFramebuffers();
+
+            m_DepthBiasEnabled  = pipelineDesc.depthBiasEnabled;
+            m_DepthBiasConstant = pipelineDesc.depthBiasConstantFactor;
+            m_DepthBiasSlope    = pipelineDesc.depthBiasSlopeFactor;
+
+            uint64_t key = GetStateKey(pipelineDesc);
+            auto found   = s_PipelineStates.find(key);
+            if(found != s_PipelineStates.end())
+            {
+                m_State = found->second;
+                if(!m_State->Ready && !pipelineDesc.asyncCompile)
+                    System::JobSystem::Wait(s_CompileContext);
+                return true;
+            }
+
+            m_State               = CreateSharedPtr<VKPipelineState>();
+            m_State->Description  = pipelineDesc;
+            m_State->Pass         = m_RenderPass;
+            m_State->Key          = key;
+            s_PipelineStates[key] = m_State;
+
+            VKPipelineState* state  = m_State.get();
+            VKShader* shader        = static_cast<VKShader*>(m_Shader.get());
+            VkPipelineLayout layout = m_PipelineLayout;
+            auto compile            = [state, shader, layout](JobDispatchArgs args)
+            {
+                state->Handle = CreateGraphicsPipeline(state->Description, shader, static_cast<VKRenderPass*>(state->Pass.get()), layout);
+                state->Ready  = true;
+            };
+
+            if(pipelineDesc.asyncCompile)
+                System::JobSystem::Execute(s_CompileContext, compile);
+            else
+                compile({});
+
+            VKDevice::Get().OnPipelineCreated();
             return true;
         }
 
+        const VkPipeline& VKPipeline::GetPipeline() const
+        {
+            return m_State->Handle;
+        }
+
+        bool VKPipeline::IsReady() const
+        {
+            return m_State->Ready;
+        }
+
         void VKPipeline::Bind(CommandBuffer* commandBuffer, uint32_t layer)
         {
             LUMOS_PROFILE_FUNCTION_LOW();
@@ -290,7 +392,11 @@ namespace Lumos
                 // commandBuffer->UpdateViewport(width, height, false);
             }
 
-            vkCmdBindPipeline(static_cast<VKCommandBuffer*>(commandBuffer)->GetHandle(), m_Compute ? VK_PIPELINE_BIND_POINT_COMPUTE : VK_PIPELINE_BIND_POINT_GRAPHICS, m_Pipeline);
+            // Callers that asked for async compilation check IsReady first, anyone else waits here
+            if(!m_State->Ready)
+                System::JobSystem::Wait(s_CompileContext);
+
+            vkCmdBindPipeline(static_cast<VKCommandBuffer*>(commandBuffer)->GetHandle(), m_Compute ? VK_PIPELINE_BIND_POINT_COMPUTE : VK_PIPELINE_BIND_POINT_GRAPHICS, m_State->Handle);
 
             // Bug in moltenVK. Needs to happen after pipeline bound for now.
             if(m_DepthBiasEnabled)
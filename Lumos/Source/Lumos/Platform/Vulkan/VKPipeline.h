@@ -12,6 +12,7 @@ namespace Lumos
     namespace Graphics
     {
         class VKCommandBuffer;
+        struct VKPipelineState;
 
         class VKPipeline : public Pipeline
         {
@@ -28,10 +29,8 @@ namespace Lumos
                 return m_PipelineLayout;
             };
 
-            const VkPipeline& GetPipeline() const
-            {
-                return m_Pipeline;
-            }
+            const VkPipeline& GetPipeline() const;
+            bool IsReady() const override;
 
             Shader* GetShader() const override
             {
@@ -54,7 +53,9 @@ namespace Lumos
             std::vector<SharedPtr<VKFramebuffer>> m_Framebuffers;
 
             VkPipelineLayout m_PipelineLayout;
-            VkPipeline m_Pipeline;
+
+            // Compiled pipeline, shared by every VKPipeline with the same state and attachment formats
+            SharedPtr<VKPipelineState> m_State;
             bool m_DepthBiasEnabled;
             float m_DepthBiasConstant;
             float m_DepthBiasSlope;
@@ -7,6 +7,7 @@
 #include "VKPipeline.h"
 #include "VKInitialisers.h"
 #include "VKCommandBuffer.h"
+#include "VKStorageBuffer.h"
 #include "Core/Engine.h"
 #include "Core/Application.h"
 
@@ -77,6 +78,9 @@ namespace Lumos
         VKRenderer::~VKRenderer()
         {
             // DescriptorPool deleted by VKContext
+
+            if(m_TimerQueryPool)
+                vkDestroyQueryPool(VKDevice::Get().GetDevice(), m_TimerQueryPool, nullptr);
         }
 
         void VKRenderer::PresentInternal(CommandBuffer* commandBuffer)
@@ -113,6 +117,28 @@ namespace Lumos
             }
         }
 
+        void VKRenderer::TransitionTexture(Graphics::Texture* texture, TextureAccess access, Graphics::CommandBuffer* commandBuffer)
+        {
+            // TransitionImage skips the barrier when the image is already in the requested layout
+            switch(texture->GetType())
+            {
+            case TextureType::COLOUR:
+                ((VKTexture2D*)texture)->TransitionImage(access == TextureAccess::STORAGE ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, (VKCommandBuffer*)commandBuffer);
+                break;
+            case TextureType::CUBE:
+                ((VKTextureCube*)texture)->TransitionImage(access == TextureAccess::STORAGE ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, (VKCommandBuffer*)commandBuffer);
+                break;
+            case TextureType::DEPTH:
+                ((VKTextureDepth*)texture)->TransitionImage(VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, (VKCommandBuffer*)commandBuffer);
+                break;
+            case TextureType::DEPTHARRAY:
+                ((VKTextureDepthArray*)texture)->TransitionImage(VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL, (VKCommandBuffer*)commandBuffer);
+                break;
+            default:
+                break;
+            }
+        }
+
         void VKRenderer::ClearSwapChainImage() const
         {
             LUMOS_PROFILE_FUNCTION_LOW();
@@ -154,6 +180,8 @@ namespace Lumos
             s_DeletionQueueIndex++;
             s_DeletionQueueIndex = s_DeletionQueueIndex % int(s_DeletionQueue.size());
             s_DeletionQueue[s_DeletionQueueIndex].Flush();
+            VKDevice::Get().UpdatePipelineCache();
+            VKDevice::Get().GetUploadRing()->Update();
 
             SharedPtr<VKSwapChain> swapChain = Application::Get().GetWindow()->GetSwapChain().As<VKSwapChain>();
             swapChain->Begin();
@@ -449,6 +477,72 @@ file.close();
             vkCmdDraw(static_cast<VKCommandBuffer*>(commandBuffer)->GetHandle(), count, 1, 0, 0);
         }
 
+        void VKRenderer::DrawIndexedIndirect(CommandBuffer* commandBuffer, StorageBuffer* commands, uint32_t offset, uint32_t drawCount, uint32_t stride)
+        {
+            LUMOS_PROFILE_FUNCTION_LOW();
+            Engine::Get().Statistics().NumDrawCalls++;
+            vkCmdDrawIndexedIndirect(static_cast<VKCommandBuffer*>(commandBuffer)->GetHandle(), static_cast<VKStorageBuffer*>(commands)->GetBuffer(), offset, drawCount, stride);
+        }
+
+        void VKRenderer::ComputeBarrier(CommandBuffer* commandBuffer)
+        {
+            VkMemoryBarrier barrier = {};
+            barrier.sType           = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+            barrier.srcAccessMask   = VK_ACCESS_SHADER_WRITE_BIT;
+            barrier.dstAccessMask   = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_HOST_READ_BIT;
+
+            VkPipelineStageFlags dstStages = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_HOST_BIT;
+            vkCmdPipelineBarrier(static_cast<VKCommandBuffer*>(commandBuffer)->GetHandle(), VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, dstStages, 0, 1, &barrier, 0, nullptr, 0, nullptr);
+        }
+
+        void VKRenderer::BeginGPUTimer(CommandBuffer* commandBuffer, uint32_t timer)
+        {
+            LUMOS_PROFILE_FUNCTION_LOW();
+            LUMOS_ASSERT(timer < MaxGPUTimers, "GPU timer out of range");
+
+            const auto& properties = VKDevice::Get().GetPhysicalDevice()->GetProperties();
+            if(!properties.limits.timestampComputeAndGraphics)
+                return;
+
+            uint32_t bufferCount = uint32_t(Renderer::GetMainSwapChain()->GetSwapChainBufferCount());
+            if(!m_TimerQueryPool)
+            {
+                VkQueryPoolCreateInfo queryPoolInfo = {};
+                queryPoolInfo.sType                 = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+                queryPoolInfo.queryType             = VK_QUERY_TYPE_TIMESTAMP;
+                queryPoolInfo.queryCount            = bufferCount * MaxGPUTimers * 2;
+
+                VK_CHECK_RESULT(vkCreateQueryPool(VKDevice::Get().GetDevice(), &queryPoolInfo, nullptr, &m_TimerQueryPool));
+                m_TimerPending.resize(bufferCount * MaxGPUTimers, false);
+            }
+
+            uint32_t slot       = Renderer::GetMainSwapChain()->GetCurrentBufferIndex() * MaxGPUTimers + timer;
+            uint32_t firstQuery = slot * 2;
+
+            // Not waited on, a result that is not ready yet is skipped
+            if(m_TimerPending[slot])
+            {
+                uint64_t timestamps[2];
+                if(vkGetQueryPoolResults(VKDevice::Get().GetDevice(), m_TimerQueryPool, firstQuery, 2, sizeof(timestamps), timestamps, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT) == VK_SUCCESS)
+                    m_GPUTimes[timer] = float(double(timestamps[1] - timestamps[0]) * properties.limits.timestampPeriod * 1e-6);
+            }
+
+            VkCommandBuffer vkCommandBuffer = static_cast<VKCommandBuffer*>(commandBuffer)->GetHandle();
+            vkCmdResetQueryPool(vkCommandBuffer, m_TimerQueryPool, firstQuery, 2);
+            vkCmdWriteTimestamp(vkCommandBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_TimerQueryPool, firstQuery);
+            m_TimerPending[slot] = false;
+        }
+
+        void VKRenderer::EndGPUTimer(CommandBuffer* commandBuffer, uint32_t timer)
+        {
+            if(!m_TimerQueryPool)
+                return;
+
+            uint32_t slot = Renderer::GetMainSwapChain()->GetCurrentBufferIndex() * MaxGPUTimers + timer;
+            vkCmdWriteTimestamp(static_cast<VKCommandBuffer*>(commandBuffer)->GetHandle(), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, m_TimerQueryPool, slot * 2 + 1);
+            m_TimerPending[slot] = true;
+        }
+
         void VKRenderer::Dispatch(CommandBuffer* commandBuffer, uint32_t workGroupSizeX, uint32_t workGroupSizeY, uint32_t workGroupSizeZ)
         {
             VkCommandBuffer buffer = static_cast<VKCommandBuffer*>(commandBuffer)->GetHandle();
@@ -46,6 +46,7 @@ namespace Lumos
             void PresentInternal(CommandBuffer* commandBuffer) override;
 
             void ClearRenderTarget(Graphics::Texture* texture, Graphics::CommandBuffer* commandBuffer, glm::vec4 clearColour) override;
+            void TransitionTexture(Graphics::Texture* texture, TextureAccess access, Graphics::CommandBuffer* commandBuffer) override;
             void ClearSwapChainImage() const;
 
             void SaveScreenshot(const std::string& path, Graphics::Texture* texture = nullptr) override;
@@ -59,6 +60,11 @@ namespace Lumos
             uint32_t GetGPUCount() const override;
             bool SupportsCompute() override { return true; }
             void Dispatch(CommandBuffer* commandBuffer, uint32_t workGroupSizeX, uint32_t workGroupSizeY, uint32_t workGroupSizeZ) override;
+            void DrawIndexedIndirect(CommandBuffer* commandBuffer, StorageBuffer* commands, uint32_t offset, uint32_t drawCount, uint32_t stride) override;
+            void ComputeBarrier(CommandBuffer* commandBuffer) override;
+            void BeginGPUTimer(CommandBuffer* commandBuffer, uint32_t timer = 0) override;
+            void EndGPUTimer(CommandBuffer* commandBuffer, uint32_t timer = 0) override;
+            float GetGPUTime(uint32_t timer = 0) const override { return m_GPUTimes[timer]; }
 
             static VkDescriptorPool& GetDescriptorPool()
             {
@@ -101,6 +107,11 @@ namespace Lumos
 
             VkDescriptorSet m_DescriptorSetPool[16] = {};
 
+            // Two timestamps per timer and swap chain buffer, read back when the buffer is next used
+            VkQueryPool m_TimerQueryPool = VK_NULL_HANDLE;
+            std::vector<bool> m_TimerPending;
+            float m_GPUTimes[MaxGPUTimers] = {};
+
             static VkDescriptorPool s_DescriptorPool;
             static std::vector<VKContext::DeletionQueue> s_DeletionQueue;
             static int s_DeletionQueueIndex;
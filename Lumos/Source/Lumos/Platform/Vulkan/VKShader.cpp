@@ -472,15 +472,12 @@ namespace Lumos
             {
                 HashCombine(m_Hash, m_FilePath + file.second);
 
-                uint32_t fileSize = uint32_t(FileSystem::GetFileSize(m_FilePath + file.second));
-                uint32_t* source  = reinterpret_cast<uint32_t*>(FileSystem::ReadFile(m_FilePath + file.second));
-
-                if(source)
+                VFSFile spirv;
+                if(VFS::Get().ReadFile(m_FilePath + file.second, spirv))
                 {
-                    LoadFromData(source, fileSize, file.first, currentShaderStage);
+                    LoadFromData(reinterpret_cast<const uint32_t*>(spirv.Data), uint32_t(spirv.Size), file.first, currentShaderStage);
 
                     currentShaderStage++;
-                    delete[] source;
                 }
             }
 
@@ -745,6 +742,24 @@ namespace Lumos
                 descriptor.texture      = Graphics::Material::GetDefaultTexture().get(); // TODO: Move
             }
 
+            for(auto& u : resources.storage_buffers)
+            {
+                uint32_t set         = comp.get_decoration(u.id, spv::DecorationDescriptorSet);
+                uint32_t binding     = comp.get_decoration(u.id, spv::DecorationBinding);
+                auto& descriptorInfo = m_DescriptorInfos[set];
+                auto& descriptor     = descriptorInfo.descriptors.emplace_back();
+
+                SHADER_LOG(LUMOS_LOG_INFO("Found Storage Buffer {0} at set = {1}, binding = {2}", u.name.c_str(), set, binding));
+
+                m_DescriptorLayoutInfo.push_back({ Graphics::DescriptorType::STORAGE_BUFFER, shaderType, binding, set, 1 });
+
+                descriptor.type          = Graphics::DescriptorType::STORAGE_BUFFER;
+                descriptor.binding       = binding;
+                descriptor.name          = u.name;
+                descriptor.shaderType    = shaderType;
+                descriptor.storageBuffer = nullptr;
+            }
+
             m_ShaderStages[currentShaderStage].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
             m_ShaderStages[currentShaderStage].stage = VKUtilities::ShaderTypeToVK(shaderType);
             m_ShaderStages[currentShaderStage].pName = "main";
@@ -875,9 +890,8 @@ namespace Lumos
 
         Shader* VKShader::CreateFuncVulkan(const std::string& filepath)
         {
-            std::string physicalPath;
-            Lumos::VFS::Get().ResolvePhysicalPath(filepath, physicalPath, false);
-            return new VKShader(physicalPath);
+            // Kept as a VFS path so the .shader and its SPIR-V can come from a pack
+            return new VKShader(filepath);
         }
 
         Shader* VKShader::CreateFromEmbeddedFuncVulkan(const uint32_t* vertData, uint32_t vertDataSize, const uint32_t* fragData, uint32_t fragDataSize)
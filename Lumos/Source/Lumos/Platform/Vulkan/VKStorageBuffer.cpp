@@ -0,0 +1,48 @@
+#include "Precompiled.h"
+#include "VKStorageBuffer.h"
+
+namespace Lumos
+{
+    namespace Graphics
+    {
+        VKStorageBuffer::VKStorageBuffer(uint32_t size, const void* data)
+        {
+            VKBuffer::Init(VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, size, data);
+        }
+
+        VKStorageBuffer::~VKStorageBuffer()
+        {
+        }
+
+        void VKStorageBuffer::SetData(uint32_t size, const void* data)
+        {
+            VKBuffer::SetData(size, data);
+        }
+
+        void VKStorageBuffer::SetSubData(uint32_t offset, uint32_t size, const void* data)
+        {
+            // The VMA path always maps the whole allocation, so map it all and offset the copy
+            VKBuffer::Map();
+            memcpy(static_cast<uint8_t*>(m_Mapped) + offset, data, static_cast<size_t>(size));
+            VKBuffer::UnMap();
+        }
+
+        void VKStorageBuffer::GetData(uint32_t offset, uint32_t size, void* data)
+        {
+            VKBuffer::Map();
+            VKBuffer::Invalidate();
+            memcpy(data, static_cast<uint8_t*>(m_Mapped) + offset, static_cast<size_t>(size));
+            VKBuffer::UnMap();
+        }
+
+        void VKStorageBuffer::MakeDefault()
+        {
+            CreateFunc = CreateFuncVulkan;
+        }
+
+        StorageBuffer* VKStorageBuffer::CreateFuncVulkan(uint32_t size, const void* data)
+        {
+            return new VKStorageBuffer(size, data);
+        }
+    }
+}
@@ -0,0 +1,28 @@
+#pragma once
+#include "VK.h"
+#include "VKBuffer.h"
+#include "Graphics/RHI/StorageBuffer.h"
+
+namespace Lumos
+{
+    namespace Graphics
+    {
+        class VKStorageBuffer : public StorageBuffer, public VKBuffer
+        {
+        public:
+            VKStorageBuffer(uint32_t size, const void* data);
+            ~VKStorageBuffer();
+
+            void SetData(uint32_t size, const void* data) override;
+            void SetSubData(uint32_t offset, uint32_t size, const void* data) override;
+            void GetData(uint32_t offset, uint32_t size, void* data) override;
+
+            uint32_t GetSize() const override { return uint32_t(m_Size); }
+
+            static void MakeDefault();
+
+        protected:
+            static StorageBuffer* CreateFuncVulkan(uint32_t, const void*);
+        };
+    }
+}
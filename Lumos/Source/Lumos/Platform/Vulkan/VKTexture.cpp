@@ -271,11 +271,6 @@ namespace Lumos
 #endif
             }
 
-            if(m_StagingBuffer)
-                delete m_StagingBuffer;
-
-            m_StagingBuffer = nullptr;
-
             m_ImageLayout = VK_IMAGE_LAYOUT_UNDEFINED;
         }
 
@@ -301,15 +296,6 @@ namespace Lumos
 
         void GenerateMipmaps(CommandBuffer* commandBuffer, VkImage image, VkFormat imageFormat, int32_t texWidth, int32_t texHeight, uint32_t mipLevels, uint32_t layer = 0, uint32_t layerCount = 1)
         {
-            LUMOS_PROFILE_FUNCTION();
-            VkFormatProperties formatProperties;
-            vkGetPhysicalDeviceFormatProperties(VKDevice::Get().GetGPU(), imageFormat, &formatProperties);
-
-            if(!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT))
-            {
-                LUMOS_LOG_ERROR("Texture image format does not support linear blitting!");
-            }
-
             VkCommandBuffer vkCommandBuffer;
 
             if(commandBuffer)
@@ -317,100 +303,7 @@ namespace Lumos
             else
                 vkCommandBuffer = VKUtilities::BeginSingleTimeCommands();
 
-            VkImageMemoryBarrier barrier {};
-            barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-            barrier.image                           = image;
-            barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-            barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
-            barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-            barrier.subresourceRange.baseArrayLayer = layer;
-            barrier.subresourceRange.layerCount     = layerCount;
-            barrier.subresourceRange.levelCount     = 1;
-
-            int32_t mipWidth  = texWidth;
-            int32_t mipHeight = texHeight;
-
-            for(uint32_t i = 1; i < mipLevels; i++)
-            {
-                barrier.subresourceRange.baseMipLevel = i - 1;
-                barrier.oldLayout                     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-                barrier.newLayout                     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-                barrier.srcAccessMask                 = VK_ACCESS_TRANSFER_WRITE_BIT;
-                barrier.dstAccessMask                 = VK_ACCESS_TRANSFER_READ_BIT;
-
-                vkCmdPipelineBarrier(vkCommandBuffer,
-                                     VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                     VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                     0,
-                                     0,
-                                     nullptr,
-                                     0,
-                                     nullptr,
-                                     1,
-                                     &barrier);
-
-                VkImageBlit blit {};
-                blit.srcOffsets[0]                 = { 0, 0, 0 };
-                blit.srcOffsets[1]                 = { mipWidth, mipHeight, 1 };
-                blit.srcSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-                blit.srcSubresource.mipLevel       = i - 1;
-                blit.srcSubresource.baseArrayLayer = layer;
-                blit.srcSubresource.layerCount     = layerCount;
-
-                blit.dstOffsets[0]                 = { 0, 0, 0 };
-                blit.dstOffsets[1]                 = { mipWidth > 1 ? mipWidth / 2 : 1, mipHeight > 1 ? mipHeight / 2 : 1, 1 };
-                blit.dstSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-                blit.dstSubresource.mipLevel       = i;
-                blit.dstSubresource.baseArrayLayer = layer;
-                blit.dstSubresource.layerCount     = layerCount;
-
-                vkCmdBlitImage(vkCommandBuffer,
-                               image,
-                               VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
-                               image,
-                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                               1,
-                               &blit,
-                               VK_FILTER_LINEAR);
-
-                barrier.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-                barrier.newLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-                barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-                barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-                vkCmdPipelineBarrier(vkCommandBuffer,
-                                     VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                     VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-                                     0,
-                                     0,
-                                     nullptr,
-                                     0,
-                                     nullptr,
-                                     1,
-                                     &barrier);
-
-                if(mipWidth > 1)
-                    mipWidth /= 2;
-                if(mipHeight > 1)
-                    mipHeight /= 2;
-            }
-
-            barrier.subresourceRange.baseMipLevel = mipLevels - 1;
-            barrier.oldLayout                     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-            barrier.newLayout                     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-            barrier.srcAccessMask                 = VK_ACCESS_TRANSFER_WRITE_BIT;
-            barrier.dstAccessMask                 = VK_ACCESS_SHADER_READ_BIT;
-
-            vkCmdPipelineBarrier(vkCommandBuffer,
-                                 VK_PIPELINE_STAGE_TRANSFER_BIT,
-                                 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
-                                 0,
-                                 0,
-                                 nullptr,
-                                 0,
-                                 nullptr,
-                                 1,
-                                 &barrier);
+            VKUtilities::GenerateMipmaps(vkCommandBuffer, image, imageFormat, texWidth, texHeight, mipLevels, layer, layerCount);
 
             if(!commandBuffer)
                 VKUtilities::EndSingleTimeCommands(vkCommandBuffer);
@@ -457,27 +350,32 @@ namespace Lumos
             if(!(m_Flags & TextureFlags::Texture_CreateMips) || m_Parameters.generateMipMaps == false)
                 m_MipLevels = 1;
 
-            VKBuffer* stagingBuffer = new VKBuffer(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, static_cast<uint32_t>(imageSize), pixels);
-
-            if(m_Data == nullptr)
-                delete[] pixels;
 #ifdef USE_VMA_ALLOCATOR
             Graphics::CreateImage(m_Width, m_Height, m_MipLevels, m_VKFormat, VK_IMAGE_TYPE_2D, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_TextureImage, m_TextureImageMemory, 1, 0, m_Allocation);
 #else
             Graphics::CreateImage(m_Width, m_Height, m_MipLevels, m_VKFormat, VK_IMAGE_TYPE_2D, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_TextureImage, m_TextureImageMemory, 1, 0);
 #endif
 
-            VKUtilities::TransitionImageLayout(m_TextureImage, m_VKFormat, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_MipLevels);
-            VKUtilities::CopyBufferToImage(stagingBuffer->GetBuffer(), m_TextureImage, static_cast<uint32_t>(m_Width), static_cast<uint32_t>(m_Height));
+            VKImageUpload upload;
+            upload.Image        = m_TextureImage;
+            upload.Format       = m_VKFormat;
+            upload.Width        = m_Width;
+            upload.Height       = m_Height;
+            upload.MipLevels    = m_MipLevels;
+            upload.TexelSize    = Maths::Max(1u, bits / 8);
+            upload.Data         = pixels;
+            upload.Size         = imageSize;
+            upload.GenerateMips = (m_Flags & TextureFlags::Texture_CreateMips) != 0;
 
-            delete stagingBuffer;
+            VKDevice::Get().GetUploadRing()->UploadImage(upload);
 
-            if(m_Flags & TextureFlags::Texture_CreateMips)
-                GenerateMipmaps(nullptr, m_TextureImage, m_VKFormat, m_Width, m_Height, m_MipLevels);
+            if(m_Data == nullptr)
+                delete[] pixels;
 
             m_UUID = Random64::Rand(0, std::numeric_limits<uint64_t>::max());
 
-            TransitionImage(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+            m_ImageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            UpdateDescriptor();
 
             return true;
         }
@@ -566,15 +464,20 @@ namespace Lumos
 
             m_MipLevels = 1;
 
-            if(!m_StagingBuffer)
-                m_StagingBuffer = new VKBuffer(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, static_cast<uint32_t>(imageSize), pixels);
-            else
-                m_StagingBuffer->SetData(static_cast<uint32_t>(imageSize), pixels);
+            VKImageUpload upload;
+            upload.Image     = m_TextureImage;
+            upload.Format    = m_VKFormat;
+            upload.Width     = m_Width;
+            upload.Height    = m_Height;
+            upload.TexelSize = m_BitsPerChannel / 2;
+            upload.Data      = pixels;
+            upload.Size      = imageSize;
+            upload.OldLayout = m_ImageLayout;
 
-            TransitionImage(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-            VKUtilities::CopyBufferToImage(m_StagingBuffer->GetBuffer(), m_TextureImage, static_cast<uint32_t>(m_Width), static_cast<uint32_t>(m_Height));
+            VKDevice::Get().GetUploadRing()->UploadImage(upload);
 
-            TransitionImage(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+            m_ImageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            UpdateDescriptor();
         }
 
         VKTextureCube::VKTextureCube(uint32_t size, void* data, bool hdr)
@@ -598,7 +501,6 @@ namespace Lumos
             m_ChannelCount   = 4;
 
             uint32_t dataSize      = m_Width * m_Height * GetBytesPerPixel() * m_NumLayers;
-            uint8_t* allData       = new uint8_t[dataSize];
             uint32_t pointeroffset = 0;
 
             uint32_t faceOrder[6] = { 3, 1, 0, 4, 2, 5 };
@@ -614,72 +516,22 @@ namespace Lumos
 
             if(m_Data)
             {
-                memcpy(allData, m_Data, dataSize);
-
-                VKBuffer* stagingBuffer = new VKBuffer(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, static_cast<uint32_t>(dataSize), allData);
-
-                if(m_Data == nullptr)
-                {
-                    delete[] allData;
-                    allData = nullptr;
-                }
-
-                VkCommandBuffer commandBuffer = VKUtilities::BeginSingleTimeCommands();
-
-                //// Setup buffer copy regions for each face including all of it's miplevels
-                std::vector<VkBufferImageCopy> bufferCopyRegions;
-                uint32_t offset = 0;
-
-                for(uint32_t face = 0; face < m_NumLayers; face++)
-                {
-                    for(uint32_t level = 0; level < m_NumMips; level++)
-                    {
-                        VkBufferImageCopy bufferCopyRegion               = {};
-                        bufferCopyRegion.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
-                        bufferCopyRegion.imageSubresource.mipLevel       = level;
-                        bufferCopyRegion.imageSubresource.baseArrayLayer = face;
-                        bufferCopyRegion.imageSubresource.layerCount     = 1;
-                        bufferCopyRegion.imageExtent.width               = m_Width;
-                        bufferCopyRegion.imageExtent.height              = m_Height;
-                        bufferCopyRegion.imageExtent.depth               = 1;
-                        bufferCopyRegion.bufferOffset                    = offset;
-
-                        bufferCopyRegions.push_back(bufferCopyRegion);
-
-                        // Increase offset into staging buffer for next level / face
-                        offset += m_Width * m_Height * GetBytesPerPixel();
-                    }
-                }
-
-                // Image barrier for optimal image (target)
-                // Set initial layout for all array layers (faces) of the optimal (target) tiled texture
-                VkImageSubresourceRange subresourceRange = {};
-                subresourceRange.aspectMask              = VK_IMAGE_ASPECT_COLOR_BIT;
-                subresourceRange.baseMipLevel            = 0;
-                subresourceRange.levelCount              = m_NumMips;
-                subresourceRange.layerCount              = m_NumLayers;
-
-                VKUtilities::TransitionImageLayout(m_TextureImage, m_VKFormat, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_NumMips, m_NumLayers, commandBuffer);
-
-                // Copy the cube map faces from the staging buffer to the optimal tiled image
-                vkCmdCopyBufferToImage(
-                    commandBuffer,
-                    stagingBuffer->GetBuffer(),
-                    m_TextureImage,
-                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                    static_cast<uint32_t>(bufferCopyRegions.size()),
-                    bufferCopyRegions.data());
-
-                // Change texture image layout to shader read after all faces have been copied
-                VKUtilities::TransitionImageLayout(m_TextureImage, m_VKFormat, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, m_NumMips, m_NumLayers, commandBuffer);
+                // The data holds mip 0 of each face, one copy per face is set up by the upload
+                VKImageUpload upload;
+                upload.Image      = m_TextureImage;
+                upload.Format     = m_VKFormat;
+                upload.Width      = m_Width;
+                upload.Height     = m_Height;
+                upload.MipLevels  = m_NumMips;
+                upload.LayerCount = m_NumLayers;
+                upload.TexelSize  = GetBytesPerPixel();
+                upload.Data       = m_Data;
+                upload.Size       = dataSize;
+
+                VKDevice::Get().GetUploadRing()->UploadImage(upload);
 
                 m_ImageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-                VKUtilities::EndSingleTimeCommands(commandBuffer);
-
-                delete stagingBuffer;
             }
-            delete[] allData;
 
             // for(uint32_t i = 0; i < m_NumLayers; i++)
             // {
@@ -920,23 +772,14 @@ namespace Lumos
                 }
             }
 
-            VKBuffer* stagingBuffer = new VKBuffer(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT, static_cast<uint32_t>(size), allData);
-
-            if(m_Data == nullptr)
-            {
-                delete[] allData;
-                allData = nullptr;
-            }
 #ifdef USE_VMA_ALLOCATOR
             Graphics::CreateImage(faceWidths[0], faceHeights[0], m_NumMips, m_VKFormat, VK_IMAGE_TYPE_2D, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_TextureImage, m_TextureImageMemory, 6, VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT, m_Allocation);
 #else
             Graphics::CreateImage(faceWidths[0], faceHeights[0], m_NumMips, m_VKFormat, VK_IMAGE_TYPE_2D, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, m_TextureImage, m_TextureImageMemory, 6, VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT);
 #endif
 
-            VkCommandBuffer commandBuffer = VKUtilities::BeginSingleTimeCommands();
-
             //// Setup buffer copy regions for each face including all of it's miplevels
-            std::vector<VkBufferImageCopy> bufferCopyRegions;
+            VKImageUpload upload;
             uint32_t offset = 0;
 
             for(uint32_t face = 0; face < 6; face++)
@@ -953,46 +796,32 @@ namespace Lumos
                     bufferCopyRegion.imageExtent.depth               = 1;
                     bufferCopyRegion.bufferOffset                    = offset;
 
-                    bufferCopyRegions.push_back(bufferCopyRegion);
+                    upload.Regions.push_back(bufferCopyRegion);
 
                     // Increase offset into staging buffer for next level / face
                     offset += faceWidths[level] * faceWidths[level] * GetBytesPerChannel();
                 }
             }
 
-            // Image barrier for optimal image (target)
-            // Set initial layout for all array layers (faces) of the optimal (target) tiled texture
-            VkImageSubresourceRange subresourceRange = {};
-            subresourceRange.aspectMask              = VK_IMAGE_ASPECT_COLOR_BIT;
-            subresourceRange.baseMipLevel            = 0;
-            subresourceRange.levelCount              = m_NumMips;
-            subresourceRange.layerCount              = 6;
-
-            VKUtilities::TransitionImageLayout(m_TextureImage, m_VKFormat, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, m_NumMips, 6, commandBuffer);
+            upload.Image      = m_TextureImage;
+            upload.Format     = m_VKFormat;
+            upload.Width      = faceWidths[0];
+            upload.Height     = faceHeights[0];
+            upload.MipLevels  = m_NumMips;
+            upload.LayerCount = 6;
+            upload.TexelSize  = GetBytesPerChannel();
+            upload.Data       = allData;
+            upload.Size       = size;
 
-            // Copy the cube map faces from the staging buffer to the optimal tiled image
-            vkCmdCopyBufferToImage(
-                commandBuffer,
-                stagingBuffer->GetBuffer(),
-                m_TextureImage,
-                VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                static_cast<uint32_t>(bufferCopyRegions.size()),
-                bufferCopyRegions.data());
-
-            // Change texture image layout to shader read after all faces have been copied
-            VKUtilities::TransitionImageLayout(m_TextureImage, m_VKFormat, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, m_NumMips, 6, commandBuffer);
+            VKDevice::Get().GetUploadRing()->UploadImage(upload);
 
             m_ImageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 
-            VKUtilities::EndSingleTimeCommands(commandBuffer);
-
             m_TextureSampler   = Graphics::CreateTextureSampler(VK_FILTER_LINEAR, VK_FILTER_LINEAR, 0.0f, static_cast<float>(m_NumMips), false, VKDevice::Get().GetPhysicalDevice()->GetProperties().limits.maxSamplerAnisotropy, VK_SAMPLER_ADDRESS_MODE_REPEAT, VK_SAMPLER_ADDRESS_MODE_REPEAT, VK_SAMPLER_ADDRESS_MODE_REPEAT);
             m_TextureImageView = Graphics::CreateImageView(m_TextureImage, m_VKFormat, m_NumMips, VK_IMAGE_VIEW_TYPE_CUBE, VK_IMAGE_ASPECT_COLOR_BIT, 6);
 
             m_UUID = Random64::Rand(0, std::numeric_limits<uint64_t>::max());
 
-            delete stagingBuffer;
-
             for(uint32_t m = 0; m < mips; m++)
             {
                 for(uint32_t f = 0; f < 6; f++)
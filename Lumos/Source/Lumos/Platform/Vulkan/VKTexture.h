@@ -166,8 +166,6 @@ namespace Lumos
 
             std::unordered_map<uint32_t, VkImageView> m_MipImageViews;
 
-            VKBuffer* m_StagingBuffer = nullptr;
-
 #ifdef USE_VMA_ALLOCATOR
             VmaAllocation m_Allocation {};
 #endif
@@ -43,6 +43,14 @@ namespace Lumos
             VKBuffer::UnMap();
         }
 
+        void VKUniformBuffer::SetSubData(uint32_t offset, uint32_t size, const void* data)
+        {
+            // The VMA path always maps the whole allocation, so map it all and offset the copy
+            VKBuffer::Map();
+            memcpy(static_cast<uint8_t*>(m_Mapped) + offset, data, static_cast<size_t>(size));
+            VKBuffer::UnMap();
+        }
+
         void VKUniformBuffer::MakeDefault()
         {
             CreateFunc     = CreateFuncVulkan;
@@ -23,6 +23,7 @@ namespace Lumos
             void SetData(uint32_t size, const void* data) override;
             void SetData(const void* data) override { SetData((uint32_t)m_Size, data); }
             void SetDynamicData(uint32_t size, uint32_t typeSize, const void* data) override;
+            void SetSubData(uint32_t offset, uint32_t size, const void* data) override;
 
             VkBuffer* GetBuffer() { return &m_Buffer; }
             VkDeviceMemory* GetMemory() { return &m_Memory; }
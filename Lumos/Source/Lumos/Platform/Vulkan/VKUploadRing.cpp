@@ -0,0 +1,367 @@
+#include "Precompiled.h"
+#include "VKUploadRing.h"
+#include "VKDevice.h"
+#include "VKInitialisers.h"
+#include "VKUtilities.h"
+#include "Maths/MathsUtilities.h"
+#include <numeric>
+
+namespace Lumos
+{
+    namespace Graphics
+    {
+        VKUploadRing::VKUploadRing(uint64_t size)
+            : m_Size(size)
+        {
+            LUMOS_PROFILE_FUNCTION();
+            auto& device         = VKDevice::Get();
+            auto& physicalDevice = device.GetPhysicalDevice();
+
+            m_Buffer = CreateUniquePtr<VKBuffer>(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, uint32_t(size), nullptr);
+            m_Buffer->Map();
+            m_Mapped = static_cast<uint8_t*>(m_Buffer->GetMapped());
+
+            m_GraphicsFamily    = physicalDevice->GetGraphicsQueueFamilyIndex();
+            m_TransferFamily    = physicalDevice->GetTransferQueueFamilyIndex();
+            m_DedicatedTransfer = m_TransferFamily != m_GraphicsFamily;
+            m_TransferQueue     = device.GetTransferQueue();
+            m_CopyAlignment     = Maths::Max(uint64_t(4), uint64_t(physicalDevice->GetProperties().limits.optimalBufferCopyOffsetAlignment));
+
+            m_GraphicsPool = CreateUniquePtr<VKCommandPool>(m_GraphicsFamily, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+            if(m_DedicatedTransfer)
+                m_TransferPool = CreateUniquePtr<VKCommandPool>(m_TransferFamily, VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+
+            LUMOS_LOG_INFO("[VULKAN] Upload ring {0} MB, {1}", m_Size / (1024 * 1024), m_DedicatedTransfer ? "dedicated transfer queue" : "graphics queue");
+        }
+
+        VKUploadRing::~VKUploadRing()
+        {
+            WaitIdle();
+
+            if(m_OpenBatch)
+                DestroyBatch(*m_OpenBatch);
+            for(auto& batch : m_FreeBatches)
+                DestroyBatch(*batch);
+
+            m_Buffer->UnMap();
+            m_Buffer->Destroy(false);
+        }
+
+        VKUploadRing::Handle VKUploadRing::UploadImage(const VKImageUpload& upload, const std::function<void()>& onComplete)
+        {
+            LUMOS_PROFILE_FUNCTION();
+            std::vector<std::function<void()>> callbacks;
+            Handle handle;
+
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+
+                // Copy offsets must be a multiple of the texel size as well as 4
+                uint64_t alignment = Maths::Max(m_CopyAlignment, uint64_t(std::lcm(4u, Maths::Max(1u, upload.TexelSize))));
+                uint64_t offset    = 0;
+                bool inRing        = upload.Size <= m_Size;
+
+                if(inRing)
+                {
+                    // The ring is full of uploads the GPU has not finished with, so wait on the oldest
+                    while(!Allocate(upload.Size, alignment, offset))
+                    {
+                        if(m_OpenBatch)
+                            SubmitOpenBatch();
+                        Retire(true, callbacks);
+                    }
+                }
+
+                Batch& batch       = GetOpenBatch();
+                VkBuffer srcBuffer = m_Buffer->GetBuffer();
+
+                if(inRing)
+                {
+                    memcpy(m_Mapped + offset, upload.Data, upload.Size);
+#ifdef USE_VMA_ALLOCATOR
+                    m_Buffer->Flush(upload.Size, offset);
+#endif
+                    batch.RingEnd = m_Head;
+                }
+                else
+                {
+                    // Larger than the whole ring, give it its own staging buffer for the life of the batch
+                    batch.OverflowBuffers.push_back(CreateUniquePtr<VKBuffer>(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, uint32_t(upload.Size), upload.Data));
+                    srcBuffer = batch.OverflowBuffers.back()->GetBuffer();
+                }
+
+                std::vector<VkBufferImageCopy> regions = upload.Regions;
+                if(regions.empty())
+                {
+                    for(uint32_t layer = 0; layer < upload.LayerCount; layer++)
+                    {
+                        VkBufferImageCopy region               = {};
+                        region.bufferOffset                    = uint64_t(layer) * upload.Width * upload.Height * upload.TexelSize;
+                        region.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+                        region.imageSubresource.mipLevel       = 0;
+                        region.imageSubresource.baseArrayLayer = layer;
+                        region.imageSubresource.layerCount     = 1;
+                        region.imageExtent                     = { upload.Width, upload.Height, 1 };
+                        regions.push_back(region);
+                    }
+                }
+
+                for(auto& region : regions)
+                    region.bufferOffset += offset;
+
+                // An image that may be in use has to stay on the graphics queue to be ordered after its readers
+                bool onTransfer                  = m_DedicatedTransfer && upload.OldLayout == VK_IMAGE_LAYOUT_UNDEFINED;
+                VkCommandBuffer copyCommands     = GetCommands(batch, onTransfer);
+                VkCommandBuffer graphicsCommands = GetCommands(batch, false);
+                VkImageLayout copiedLayout       = upload.GenerateMips ? VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL : upload.FinalLayout;
+
+                VKUtilities::TransitionImageLayout(upload.Image, upload.Format, upload.OldLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, upload.MipLevels, upload.LayerCount, copyCommands);
+                vkCmdCopyBufferToImage(copyCommands, srcBuffer, upload.Image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, uint32_t(regions.size()), regions.data());
+
+                if(onTransfer)
+                {
+                    // Release from the transfer queue and acquire on the graphics queue, the layout change is part of the transfer
+                    VkImageMemoryBarrier barrier = VKInitialisers::ImageMemoryBarrier();
+                    barrier.oldLayout            = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                    barrier.newLayout            = copiedLayout;
+                    barrier.srcQueueFamilyIndex  = m_TransferFamily;
+                    barrier.dstQueueFamilyIndex  = m_GraphicsFamily;
+                    barrier.image                = upload.Image;
+                    barrier.subresourceRange     = { VK_IMAGE_ASPECT_COLOR_BIT, 0, upload.MipLevels, 0, upload.LayerCount };
+                    barrier.srcAccessMask        = VK_ACCESS_TRANSFER_WRITE_BIT;
+                    barrier.dstAccessMask        = 0;
+
+                    vkCmdPipelineBarrier(copyCommands, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+                    barrier.srcAccessMask = 0;
+                    barrier.dstAccessMask = VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+
+                    vkCmdPipelineBarrier(graphicsCommands, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+                }
+
+                if(upload.GenerateMips)
+                    VKUtilities::GenerateMipmaps(graphicsCommands, upload.Image, upload.Format, upload.Width, upload.Height, upload.MipLevels, 0, upload.LayerCount);
+                else if(!onTransfer)
+                    VKUtilities::TransitionImageLayout(upload.Image, upload.Format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, upload.FinalLayout, upload.MipLevels, upload.LayerCount, graphicsCommands);
+
+                if(onComplete)
+                    batch.Callbacks.push_back(onComplete);
+
+                handle = batch.ID;
+            }
+
+            for(auto& callback : callbacks)
+                callback();
+
+            return handle;
+        }
+
+        void VKUploadRing::Flush()
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            if(m_OpenBatch)
+                SubmitOpenBatch();
+        }
+
+        void VKUploadRing::Update()
+        {
+            LUMOS_PROFILE_FUNCTION_LOW();
+            std::vector<std::function<void()>> callbacks;
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                Retire(false, callbacks);
+            }
+
+            for(auto& callback : callbacks)
+                callback();
+        }
+
+        void VKUploadRing::Wait(Handle handle)
+        {
+            LUMOS_PROFILE_FUNCTION();
+            std::vector<std::function<void()>> callbacks;
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                if(m_OpenBatch && handle >= m_OpenBatch->ID)
+                    SubmitOpenBatch();
+
+                while(handle > m_CompletedBatch && !m_InFlight.empty())
+                    Retire(true, callbacks);
+            }
+
+            for(auto& callback : callbacks)
+                callback();
+        }
+
+        void VKUploadRing::WaitIdle()
+        {
+            Wait(m_NextBatch);
+        }
+
+        VKUploadRing::Batch& VKUploadRing::GetOpenBatch()
+        {
+            if(!m_OpenBatch)
+            {
+                if(!m_FreeBatches.empty())
+                {
+                    m_OpenBatch = std::move(m_FreeBatches.back());
+                    m_FreeBatches.pop_back();
+                }
+                else
+                {
+                    m_OpenBatch = CreateUniquePtr<Batch>();
+
+                    VkFenceCreateInfo fenceCreateInfo = VKInitialisers::FenceCreateInfo();
+                    VK_CHECK_RESULT(vkCreateFence(VKDevice::GetHandle(), &fenceCreateInfo, nullptr, &m_OpenBatch->Fence));
+                }
+
+                m_OpenBatch->ID      = m_NextBatch++;
+                m_OpenBatch->RingEnd = m_Head;
+            }
+
+            return *m_OpenBatch;
+        }
+
+        VkCommandBuffer VKUploadRing::GetCommands(Batch& batch, bool transfer)
+        {
+            VkCommandBuffer& commandBuffer = transfer ? batch.TransferCommands : batch.GraphicsCommands;
+            bool& recording                = transfer ? batch.TransferRecording : batch.GraphicsRecording;
+
+            if(!commandBuffer)
+            {
+                VkCommandBufferAllocateInfo allocInfo = {};
+                allocInfo.sType                       = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+                allocInfo.level                       = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+                allocInfo.commandPool                 = transfer ? m_TransferPool->GetHandle() : m_GraphicsPool->GetHandle();
+                allocInfo.commandBufferCount          = 1;
+
+                VK_CHECK_RESULT(vkAllocateCommandBuffers(VKDevice::GetHandle(), &allocInfo, &commandBuffer));
+            }
+
+            if(!recording)
+            {
+                VkCommandBufferBeginInfo beginInfo = {};
+                beginInfo.sType                    = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+                beginInfo.flags                    = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+                VK_CHECK_RESULT(vkBeginCommandBuffer(commandBuffer, &beginInfo));
+                recording = true;
+            }
+
+            return commandBuffer;
+        }
+
+        bool VKUploadRing::Allocate(uint64_t size, uint64_t alignment, uint64_t& offset)
+        {
+            // Reset to the start whenever nothing is using the ring, so it only wraps under load
+            if(!m_OpenBatch && m_InFlight.empty())
+                m_Head = m_Tail = 0;
+
+            // Free space is [head, size) and [0, tail) when head is not behind tail, else [head, tail).
+            // Allocations never reach the tail so head == tail always means empty
+            uint64_t aligned = (m_Head + alignment - 1) / alignment * alignment;
+
+            if(m_Head >= m_Tail)
+            {
+                if(aligned + size <= m_Size)
+                    offset = aligned;
+                else if(size < m_Tail)
+                    offset = 0;
+                else
+                    return false;
+            }
+            else
+            {
+                if(aligned + size < m_Tail)
+                    offset = aligned;
+                else
+                    return false;
+            }
+
+            m_Head = offset + size;
+            return true;
+        }
+
+        void VKUploadRing::SubmitOpenBatch()
+        {
+            LUMOS_PROFILE_FUNCTION();
+            Batch& batch = *m_OpenBatch;
+
+            VkCommandBuffer graphicsCommands = GetCommands(batch, false);
+            bool useTransfer                 = batch.TransferRecording;
+
+            VK_CHECK_RESULT(vkResetFences(VKDevice::GetHandle(), 1, &batch.Fence));
+
+            if(useTransfer)
+            {
+                VK_CHECK_RESULT(vkEndCommandBuffer(batch.TransferCommands));
+
+                if(!batch.TransferDone)
+                {
+                    VkSemaphoreCreateInfo semaphoreCreateInfo = VKInitialisers::SemaphoreCreateInfo();
+                    VK_CHECK_RESULT(vkCreateSemaphore(VKDevice::GetHandle(), &semaphoreCreateInfo, nullptr, &batch.TransferDone));
+                }
+
+                VkSubmitInfo submitInfo         = VKInitialisers::SubmitInfo();
+                submitInfo.commandBufferCount   = 1;
+                submitInfo.pCommandBuffers      = &batch.TransferCommands;
+                submitInfo.signalSemaphoreCount = 1;
+                submitInfo.pSignalSemaphores    = &batch.TransferDone;
+
+                VK_CHECK_RESULT(vkQueueSubmit(m_TransferQueue, 1, &submitInfo, VK_NULL_HANDLE));
+            }
+
+            VK_CHECK_RESULT(vkEndCommandBuffer(graphicsCommands));
+
+            VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_ALL_COMMANDS_BIT;
+
+            VkSubmitInfo submitInfo       = VKInitialisers::SubmitInfo();
+            submitInfo.waitSemaphoreCount = useTransfer ? 1 : 0;
+            submitInfo.pWaitSemaphores    = &batch.TransferDone;
+            submitInfo.pWaitDstStageMask  = &waitStage;
+            submitInfo.commandBufferCount = 1;
+            submitInfo.pCommandBuffers    = &graphicsCommands;
+
+            VK_CHECK_RESULT(vkQueueSubmit(VKDevice::Get().GetGraphicsQueue(), 1, &submitInfo, batch.Fence));
+
+            batch.TransferRecording = false;
+            batch.GraphicsRecording = false;
+            m_InFlight.push_back(std::move(m_OpenBatch));
+        }
+
+        void VKUploadRing::Retire(bool waitOldest, std::vector<std::function<void()>>& callbacks)
+        {
+            while(!m_InFlight.empty())
+            {
+                Batch& batch = *m_InFlight.front();
+
+                if(waitOldest)
+                {
+                    LUMOS_PROFILE_SCOPE("Wait for upload");
+                    VK_CHECK_RESULT(vkWaitForFences(VKDevice::GetHandle(), 1, &batch.Fence, VK_TRUE, UINT64_MAX));
+                    waitOldest = false;
+                }
+                else if(vkGetFenceStatus(VKDevice::GetHandle(), batch.Fence) != VK_SUCCESS)
+                    break;
+
+                // Batches finish in submission order, so the ring frees up to the end of this one
+                m_Tail           = batch.RingEnd;
+                m_CompletedBatch = batch.ID;
+
+                callbacks.insert(callbacks.end(), batch.Callbacks.begin(), batch.Callbacks.end());
+                batch.Callbacks.clear();
+                batch.OverflowBuffers.clear();
+
+                m_FreeBatches.push_back(std::move(m_InFlight.front()));
+                m_InFlight.pop_front();
+            }
+        }
+
+        void VKUploadRing::DestroyBatch(Batch& batch)
+        {
+            vkDestroyFence(VKDevice::GetHandle(), batch.Fence, nullptr);
+            if(batch.TransferDone)
+                vkDestroySemaphore(VKDevice::GetHandle(), batch.TransferDone, nullptr);
+        }
+    }
+}
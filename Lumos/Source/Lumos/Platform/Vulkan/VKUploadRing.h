@@ -0,0 +1,108 @@
+#pragma once
+#include "VK.h"
+#include "VKBuffer.h"
+#include "VKCommandPool.h"
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace Lumos
+{
+    namespace Graphics
+    {
+        struct VKImageUpload
+        {
+            VkImage Image       = VK_NULL_HANDLE;
+            VkFormat Format     = VK_FORMAT_UNDEFINED;
+            uint32_t Width      = 0;
+            uint32_t Height     = 0;
+            uint32_t MipLevels  = 1;
+            uint32_t LayerCount = 1;
+            uint32_t TexelSize  = 4;
+            const void* Data    = nullptr;
+            uint64_t Size       = 0;
+
+            // Buffer offsets are relative to Data. Left empty, mip 0 of each layer is copied from tightly packed data
+            std::vector<VkBufferImageCopy> Regions;
+
+            // Images that may already be in use (OldLayout is not undefined) are written on the graphics queue
+            VkImageLayout OldLayout   = VK_IMAGE_LAYOUT_UNDEFINED;
+            VkImageLayout FinalLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+            // Blits the other mips down from mip 0, the image then ends in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+            bool GenerateMips = false;
+        };
+
+        // Uploads are written into a persistently mapped staging ring and recorded into a batch of copy commands.
+        // The batch is submitted before the next graphics queue submission, on the dedicated transfer queue when
+        // the device has one, with the ownership transfer and any mip generation done on the graphics queue.
+        // Ring space is reclaimed once the batch's fence signals, nothing waits for the GPU unless the ring is full
+        class VKUploadRing
+        {
+        public:
+            typedef uint64_t Handle;
+
+            VKUploadRing(uint64_t size);
+            ~VKUploadRing();
+
+            Handle UploadImage(const VKImageUpload& upload, const std::function<void()>& onComplete = nullptr);
+
+            // Submits the open batch. Called before anything else is submitted to the graphics queue so uploads
+            // are always ordered before the commands that use them
+            void Flush();
+
+            // Retires finished batches and runs their completion callbacks, once a frame
+            void Update();
+
+            bool IsComplete(Handle handle) const { return handle <= m_CompletedBatch; }
+            void Wait(Handle handle);
+            void WaitIdle();
+
+            uint64_t GetSize() const { return m_Size; }
+
+        private:
+            struct Batch
+            {
+                uint64_t ID                      = 0;
+                VkCommandBuffer TransferCommands = VK_NULL_HANDLE;
+                VkCommandBuffer GraphicsCommands = VK_NULL_HANDLE;
+                VkSemaphore TransferDone         = VK_NULL_HANDLE; // Signalled by the transfer queue submission
+                VkFence Fence                    = VK_NULL_HANDLE;
+                uint64_t RingEnd                 = 0;
+                bool TransferRecording           = false;
+                bool GraphicsRecording           = false;
+                std::vector<UniquePtr<VKBuffer>> OverflowBuffers;
+                std::vector<std::function<void()>> Callbacks;
+            };
+
+            Batch& GetOpenBatch();
+            VkCommandBuffer GetCommands(Batch& batch, bool transfer);
+            bool Allocate(uint64_t size, uint64_t alignment, uint64_t& offset);
+            void SubmitOpenBatch();
+            void Retire(bool waitOldest, std::vector<std::function<void()>>& callbacks);
+            void DestroyBatch(Batch& batch);
+
+            UniquePtr<VKBuffer> m_Buffer;
+            uint8_t* m_Mapped = nullptr;
+            uint64_t m_Size   = 0;
+            uint64_t m_Head   = 0;
+            uint64_t m_Tail   = 0;
+
+            UniquePtr<VKCommandPool> m_GraphicsPool;
+            UniquePtr<VKCommandPool> m_TransferPool;
+            VkQueue m_TransferQueue   = VK_NULL_HANDLE;
+            uint32_t m_GraphicsFamily = 0;
+            uint32_t m_TransferFamily = 0;
+            bool m_DedicatedTransfer  = false;
+            uint64_t m_CopyAlignment  = 4;
+
+            UniquePtr<Batch> m_OpenBatch;
+            std::deque<UniquePtr<Batch>> m_InFlight;
+            std::vector<UniquePtr<Batch>> m_FreeBatches;
+            uint64_t m_NextBatch      = 1;
+            uint64_t m_CompletedBatch = 0;
+
+            mutable std::mutex m_Mutex;
+        };
+    }
+}
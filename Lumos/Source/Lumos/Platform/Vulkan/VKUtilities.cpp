@@ -109,8 +109,12 @@ namespace Lumos
 
         void VKUtilities::EndSingleTimeCommands(VkCommandBuffer commandBuffer)
         {
+            LUMOS_PROFILE_FUNCTION();
             VK_CHECK_RESULT(vkEndCommandBuffer(commandBuffer));
 
+            // Keep pending uploads ahead of these commands on the queue
+            VKDevice::Get().GetUploadRing()->Flush();
+
             VkSubmitInfo submitInfo;
             submitInfo.sType                = VK_STRUCTURE_TYPE_SUBMIT_INFO;
             submitInfo.commandBufferCount   = 1;
@@ -121,8 +125,15 @@ namespace Lumos
             submitInfo.signalSemaphoreCount = 0;
             submitInfo.waitSemaphoreCount   = 0;
 
-            VK_CHECK_RESULT(vkQueueSubmit(VKDevice::Get().GetGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE));
-            VK_CHECK_RESULT(vkQueueWaitIdle(VKDevice::Get().GetGraphicsQueue()));
+            // Wait on this submission only rather than idling the whole queue
+            VkFenceCreateInfo fenceCreateInfo = VKInitialisers::FenceCreateInfo();
+            VkFence fence;
+            VK_CHECK_RESULT(vkCreateFence(VKDevice::Get().GetDevice(), &fenceCreateInfo, nullptr, &fence));
+
+            VK_CHECK_RESULT(vkQueueSubmit(VKDevice::Get().GetGraphicsQueue(), 1, &submitInfo, fence));
+            VK_CHECK_RESULT(vkWaitForFences(VKDevice::Get().GetDevice(), 1, &fence, VK_TRUE, UINT64_MAX));
+
+            vkDestroyFence(VKDevice::Get().GetDevice(), fence, nullptr);
 
             vkFreeCommandBuffers(VKDevice::Get().GetDevice(),
                                  VKDevice::Get().GetCommandPool()->GetHandle(), 1, &commandBuffer);
@@ -461,6 +472,113 @@ namespace Lumos
                 EndSingleTimeCommands(commandBuffer);
         }
 
+        void VKUtilities::GenerateMipmaps(VkCommandBuffer commandBuffer, VkImage image, VkFormat imageFormat, int32_t texWidth, int32_t texHeight, uint32_t mipLevels, uint32_t layer, uint32_t layerCount)
+        {
+            LUMOS_PROFILE_FUNCTION();
+            VkFormatProperties formatProperties;
+            vkGetPhysicalDeviceFormatProperties(VKDevice::Get().GetGPU(), imageFormat, &formatProperties);
+
+            if(!(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT))
+            {
+                LUMOS_LOG_ERROR("Texture image format does not support linear blitting!");
+            }
+
+            VkImageMemoryBarrier barrier {};
+            barrier.sType                           = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+            barrier.image                           = image;
+            barrier.srcQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+            barrier.dstQueueFamilyIndex             = VK_QUEUE_FAMILY_IGNORED;
+            barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+            barrier.subresourceRange.baseArrayLayer = layer;
+            barrier.subresourceRange.layerCount     = layerCount;
+            barrier.subresourceRange.levelCount     = 1;
+
+            int32_t mipWidth  = texWidth;
+            int32_t mipHeight = texHeight;
+
+            for(uint32_t i = 1; i < mipLevels; i++)
+            {
+                barrier.subresourceRange.baseMipLevel = i - 1;
+                barrier.oldLayout                     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+                barrier.newLayout                     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+                barrier.srcAccessMask                 = VK_ACCESS_TRANSFER_WRITE_BIT;
+                barrier.dstAccessMask                 = VK_ACCESS_TRANSFER_READ_BIT;
+
+                vkCmdPipelineBarrier(commandBuffer,
+                                     VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                     VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                     0,
+                                     0,
+                                     nullptr,
+                                     0,
+                                     nullptr,
+                                     1,
+                                     &barrier);
+
+                VkImageBlit blit {};
+                blit.srcOffsets[0]                 = { 0, 0, 0 };
+                blit.srcOffsets[1]                 = { mipWidth, mipHeight, 1 };
+                blit.srcSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+                blit.srcSubresource.mipLevel       = i - 1;
+                blit.srcSubresource.baseArrayLayer = layer;
+                blit.srcSubresource.layerCount     = layerCount;
+
+                blit.dstOffsets[0]                 = { 0, 0, 0 };
+                blit.dstOffsets[1]                 = { mipWidth > 1 ? mipWidth / 2 : 1, mipHeight > 1 ? mipHeight / 2 : 1, 1 };
+                blit.dstSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+                blit.dstSubresource.mipLevel       = i;
+                blit.dstSubresource.baseArrayLayer = layer;
+                blit.dstSubresource.layerCount     = layerCount;
+
+                vkCmdBlitImage(commandBuffer,
+                               image,
+                               VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                               image,
+                               VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                               1,
+                               &blit,
+                               VK_FILTER_LINEAR);
+
+                barrier.oldLayout     = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+                barrier.newLayout     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+                barrier.srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+                barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+                vkCmdPipelineBarrier(commandBuffer,
+                                     VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                     VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                                     0,
+                                     0,
+                                     nullptr,
+                                     0,
+                                     nullptr,
+                                     1,
+                                     &barrier);
+
+                if(mipWidth > 1)
+                    mipWidth /= 2;
+                if(mipHeight > 1)
+                    mipHeight /= 2;
+            }
+
+            barrier.subresourceRange.baseMipLevel = mipLevels - 1;
+            barrier.oldLayout                     = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+            barrier.newLayout                     = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+            barrier.srcAccessMask                 = VK_ACCESS_TRANSFER_WRITE_BIT;
+            barrier.dstAccessMask                 = VK_ACCESS_SHADER_READ_BIT;
+
+            vkCmdPipelineBarrier(commandBuffer,
+                                 VK_PIPELINE_STAGE_TRANSFER_BIT,
+                                 VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                                 0,
+                                 0,
+                                 nullptr,
+                                 0,
+                                 nullptr,
+                                 1,
+                                 &barrier);
+        }
+
         VkFormat VKUtilities::FindSupportedFormat(const std::vector<VkFormat>& candidates, VkImageTiling tiling,
                                                   VkFormatFeatureFlags features)
         {
@@ -581,6 +699,8 @@ namespace Lumos
                 return VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
             case DescriptorType::IMAGE_STORAGE:
                 return VK_DESCRIPTOR_TYPE_STORAGE_IMAGE;
+            case DescriptorType::STORAGE_BUFFER:
+                return VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
             }
 
             LUMOS_LOG_INFO("Unsupported Descriptor Type");
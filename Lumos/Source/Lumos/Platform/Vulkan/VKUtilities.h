@@ -43,6 +43,9 @@ namespace Lumos
 
             void TransitionImageLayout(VkImage image, VkFormat format, VkImageLayout oldLayout, VkImageLayout newLayout, uint32_t mipLevels = 1, uint32_t layerCount = 1, VkCommandBuffer commandBuffer = nullptr);
 
+            // Blits each mip from the one above it, every mip must start in VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL and ends in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+            void GenerateMipmaps(VkCommandBuffer commandBuffer, VkImage image, VkFormat imageFormat, int32_t texWidth, int32_t texHeight, uint32_t mipLevels, uint32_t layer = 0, uint32_t layerCount = 1);
+
             uint32_t FindMemoryType(uint32_t typeFilter, VkMemoryPropertyFlags properties);
             VkFormat FindSupportedFormat(const std::vector<VkFormat>& candidates, VkImageTiling tiling, VkFormatFeatureFlags features);
             VkFormat FindDepthFormat();
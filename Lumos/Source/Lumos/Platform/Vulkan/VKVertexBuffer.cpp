@@ -13,7 +13,8 @@ namespace Lumos
             , m_Usage(usage)
             , m_Size(0)
         {
-            VKBuffer::SetUsage(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT);
+            // Storage usage lets compute passes write vertices in place, e.g. skinning
+            VKBuffer::SetUsage(VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT);
             VKBuffer::SetMemoryProperyFlags(VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT);
         }
 
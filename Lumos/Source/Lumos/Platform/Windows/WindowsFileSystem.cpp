@@ -54,18 +54,31 @@ namespace Lumos
         return result;
     }
 
+    uint64_t FileSystem::GetLastModifiedTime(const std::string& path)
+    {
+        WIN32_FILE_ATTRIBUTE_DATA data;
+        if(!GetFileAttributesEx(WindowsUtilities::StringToWString(path).c_str(), GetFileExInfoStandard, &data))
+            return 0;
+
+        ULARGE_INTEGER time;
+        time.LowPart  = data.ftLastWriteTime.dwLowDateTime;
+        time.HighPart = data.ftLastWriteTime.dwHighDateTime;
+        return time.QuadPart;
+    }
+
     bool FileSystem::ReadFile(const std::string& path, void* buffer, int64_t size)
     {
         std::ifstream stream(path, std::ios::binary | std::ios::ate);
+        if(!stream)
+            return false;
 
         auto end = stream.tellg();
         stream.seekg(0, std::ios::beg);
-        size   = end - stream.tellg();
-        buffer = new char[size];
+        if(size < 0)
+            size = end - stream.tellg();
         stream.read((char*)buffer, size);
-        stream.close();
 
-        return buffer;
+        return bool(stream);
     }
 
     uint8_t* FileSystem::ReadFile(const std::string& path)
@@ -124,6 +137,42 @@ namespace Lumos
     {
         return WriteFile(path, (uint8_t*)&text[0], (uint32_t)text.size());
     }
+
+    uint8_t* FileSystem::MapFile(const std::string& path, int64_t& size)
+    {
+        size        = 0;
+        HANDLE file = CreateFile(WindowsUtilities::StringToWString(path).c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if(file == INVALID_HANDLE_VALUE)
+            return nullptr;
+
+        int64_t fileSize = GetFileSizeInternal(file);
+        if(fileSize <= 0)
+        {
+            CloseHandle(file);
+            return nullptr;
+        }
+
+        HANDLE mapping = CreateFileMapping(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+        if(!mapping)
+            return nullptr;
+
+        // The view keeps the mapping alive, so the handle can be closed straight away
+        void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+
+        if(!data)
+            return nullptr;
+
+        size = fileSize;
+        return (uint8_t*)data;
+    }
+
+    void FileSystem::UnmapFile(uint8_t* data, int64_t size)
+    {
+        if(data)
+            UnmapViewOfFile(data);
+    }
 }
 
 #endif
\ No newline at end of file
@@ -125,13 +125,20 @@ namespace Lumos
         return buffer.st_size;
     }
 
+    uint64_t FileSystem::GetLastModifiedTime(const std::string& path)
+    {
+        struct stat buffer;
+        if(stat(path.c_str(), &buffer) != 0)
+            return 0;
+        return (uint64_t)buffer.st_mtime;
+    }
+
     bool FileSystem::ReadFile(const std::string& path, void* buffer, int64_t size)
     {
         if(!FileExists(path))
             return false;
         if(size < 0)
             size = GetFileSize(path);
-        buffer = new uint8_t[size + 1];
         FILE* file = fopen(path.c_str(), "r");
         bool result = false;
         if(file)
@@ -189,4 +196,34 @@ namespace Lumos
         filestr.close();
         return true;
     }
+
+    uint8_t* FileSystem::MapFile(const std::string& path, int64_t& size)
+    {
+        size = 0;
+        int fd = open(path.c_str(), O_RDONLY);
+        if(fd < 0)
+            return nullptr;
+
+        struct stat buffer;
+        if(fstat(fd, &buffer) != 0 || buffer.st_size == 0)
+        {
+            close(fd);
+            return nullptr;
+        }
+
+        void* data = mmap(nullptr, buffer.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+
+        if(data == MAP_FAILED)
+            return nullptr;
+
+        size = buffer.st_size;
+        return (uint8_t*)data;
+    }
+
+    void FileSystem::UnmapFile(uint8_t* data, int64_t size)
+    {
+        if(data)
+            munmap(data, size);
+    }
 }
@@ -1,5 +1,8 @@
 #include "Precompiled.h"
 #include "AIComponent.h"
+#include "AI/NavMeshSystem.h"
+#include "Core/Application.h"
+#include "ImGui/ImGuiUtilities.h"
 
 #include <imgui/imgui.h>
 
@@ -15,8 +18,53 @@ namespace Lumos
     {
     }
 
+    void AIComponent::RequestPath(const glm::vec3& from, const glm::vec3& to)
+    {
+        m_Path.clear();
+        m_PathRequest = nullptr;
+
+        auto navigation = Application::Get().GetSystem<NavMeshSystem>();
+        if(navigation)
+            m_PathRequest = navigation->RequestPath(from, to);
+    }
+
+    bool AIComponent::IsPathPending() const
+    {
+        return m_PathRequest && m_PathRequest->State == PathRequestState::Pending;
+    }
+
+    void AIComponent::ResolvePath()
+    {
+        if(!m_PathRequest || m_PathRequest->State == PathRequestState::Pending)
+            return;
+
+        if(m_PathRequest->State == PathRequestState::Ready)
+            m_Path = std::move(m_PathRequest->Path);
+        m_PathRequest = nullptr;
+    }
+
+    bool AIComponent::HasPath()
+    {
+        ResolvePath();
+        return !m_Path.empty();
+    }
+
+    const std::vector<glm::vec3>& AIComponent::GetPath()
+    {
+        ResolvePath();
+        return m_Path;
+    }
+
     void AIComponent::OnImGui()
     {
+        ImGui::Columns(2);
+        ImGui::Separator();
+
+        ImGuiUtilities::PropertyConst("Path", IsPathPending() ? "Pending" : (HasPath() ? "Found" : "None"));
+        ImGuiUtilities::PropertyConst("Path Points", std::to_string(m_Path.size()).c_str());
+
+        ImGui::Columns(1);
+        ImGui::Separator();
     }
 
 }
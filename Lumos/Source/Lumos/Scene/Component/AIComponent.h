@@ -1,18 +1,32 @@
 #pragma once
 
 #include "AI/AINode.h"
+#include <glm/vec3.hpp>
+#include <vector>
 
 namespace Lumos
 {
+    struct NavMeshPathRequest;
+
     class LUMOS_EXPORT AIComponent
     {
     public:
         AIComponent();
         explicit AIComponent(SharedPtr<AINode>& aiNode);
 
+        // Queues a search on the NavMeshSystem, the result is available a frame or more later
+        void RequestPath(const glm::vec3& from, const glm::vec3& to);
+        bool IsPathPending() const;
+        bool HasPath();
+        const std::vector<glm::vec3>& GetPath();
+
         void OnImGui();
 
     private:
+        void ResolvePath();
+
         SharedPtr<AINode> m_AINode;
+        SharedPtr<NavMeshPathRequest> m_PathRequest;
+        std::vector<glm::vec3> m_Path;
     };
 }
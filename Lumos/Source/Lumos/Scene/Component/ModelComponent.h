@@ -1,6 +1,7 @@
 #pragma once
 #include "Precompiled.h"
 #include "Graphics/Model.h"
+#include "Graphics/Animation/AnimationInstance.h"
 #include "Core/VFS.h"
 #include <cereal/cereal.hpp>
 
@@ -24,6 +25,23 @@ namespace Lumos::Graphics
         {
         }
 
+        // Copies get their own animation instance on the next scene update
+        ModelComponent(const ModelComponent& other)
+            : ModelRef(other.ModelRef)
+        {
+        }
+
+        ModelComponent(ModelComponent&&) = default;
+
+        ModelComponent& operator=(const ModelComponent& other)
+        {
+            ModelRef  = other.ModelRef;
+            Animation = nullptr;
+            return *this;
+        }
+
+        ModelComponent& operator=(ModelComponent&&) = default;
+
         void LoadFromLibrary(const std::string& path);
         void LoadPrimitive(PrimitiveType primitive)
         {
@@ -32,6 +50,12 @@ namespace Lumos::Graphics
 
         SharedPtr<Model> ModelRef;
 
+        // Created by the scene for models with a skeleton, not serialised
+        SharedPtr<AnimationInstance> Animation;
+
+        // Current LOD of each mesh for each view, managed by RenderPasses and not serialised
+        std::vector<uint8_t> LODState;
+
         template <typename Archive>
         void save(Archive& archive) const
         {
@@ -7,7 +7,9 @@
 #include "Graphics/Camera/Camera.h"
 #include "Graphics/Sprite.h"
 #include "Graphics/AnimatedSprite.h"
+#include "Graphics/Animation/AnimationInstance.h"
 #include "Utilities/TimeStep.h"
+#include "Core/JobSystem.h"
 #include "Audio/AudioManager.h"
 #include "Physics/LumosPhysicsEngine/LumosPhysicsEngine.h"
 #include "Physics/LumosPhysicsEngine/CollisionShapes/SphereCollisionShape.h"
@@ -21,6 +23,7 @@
 
 #include "Maths/Transform.h"
 #include "Core/OS/FileSystem.h"
+#include "Core/VFS.h"
 #include "Scene/Component/Components.h"
 #include "Scripting/Lua/LuaScriptComponent.h"
 #include "Scripting/Lua/LuaManager.h"
@@ -32,6 +35,7 @@
 #include "Scene/Component/SoundComponent.h"
 #include "Scene/Component/ModelComponent.h"
 #include "SceneGraph.h"
+#include "SceneBinarySerialiser.h"
 
 #include <cereal/types/polymorphic.hpp>
 #include <cereal/archives/binary.hpp>
@@ -217,6 +221,10 @@ namespace Lumos
 
         m_SceneGraph = CreateUniquePtr<SceneGraph>();
         m_SceneGraph->Init(m_EntityManager->GetRegistry());
+        m_EntityManager->GetRegistry().on_construct<LuaScriptComponent>().connect<&LuaScriptComponent::OnConstruct>();
+        m_EntityManager->GetRegistry().on_update<LuaScriptComponent>().connect<&LuaScriptComponent::OnConstruct>();
+
+        m_AnimationPoseCache = CreateUniquePtr<AnimationPoseCache>();
     }
 
     Scene::~Scene()
@@ -301,6 +309,38 @@ namespace Lumos
             auto& animSprite = entity.GetComponent<Graphics::AnimatedSprite>();
             animSprite.OnUpdate((float)timeStep.GetSeconds());
         }
+
+        UpdateAnimations((float)timeStep.GetSeconds());
+    }
+
+    void Scene::UpdateAnimations(float dt)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        m_AnimationUpdates.clear();
+        m_AnimationPoseCache->Clear();
+        AnimationInstance::GetLODStats().Reset();
+
+        auto modelView = m_EntityManager->GetRegistry().view<Graphics::ModelComponent>();
+        for(auto entity : modelView)
+        {
+            auto& model = modelView.get<Graphics::ModelComponent>(entity);
+            if(!model.ModelRef || !model.ModelRef->GetAnimationController())
+            {
+                model.Animation = nullptr;
+                continue;
+            }
+
+            if(!model.Animation || model.Animation->GetModel() != model.ModelRef.get())
+                model.Animation = CreateSharedPtr<AnimationInstance>(model.ModelRef);
+
+            m_AnimationUpdates.push_back(model.Animation);
+        }
+
+        // Sampling, local to model and the joint palettes are independent per instance, apart from the shared pose lookups
+        System::JobSystem::Context ctx;
+        System::JobSystem::Dispatch(ctx, uint32_t(m_AnimationUpdates.size()), 4, [this, dt](JobDispatchArgs args)
+                                    { m_AnimationUpdates[args.jobIndex]->Update(dt, *m_AnimationPoseCache, m_AnimationUpdates[args.jobIndex]); });
+        System::JobSystem::Wait(ctx);
     }
 
     void Scene::OnEvent(Event& e)
@@ -363,15 +403,8 @@ namespace Lumos
         {
             path += std::string(".bin");
 
-            std::ofstream file(path, std::ios::binary);
-
-            {
-                // output finishes flushing its contents when it goes out of scope
-                cereal::BinaryOutputArchive output { file };
-                output(*this);
-                entt::snapshot { m_EntityManager->GetRegistry() }.get<entt::entity>(output).ALL_COMPONENTSENTTV8(output);
-            }
-            file.close();
+            if(!BinaryScene::Save<ALL_COMPONENTSLISTV8>(path, *this, m_EntityManager->GetRegistry()))
+                LUMOS_LOG_ERROR("Failed to save binary scene - {0}", path);
         }
         else
         {
@@ -400,77 +433,87 @@ namespace Lumos
         {
             path += std::string(".bin");
 
-            if(!FileSystem::FileExists(path))
+            VFSFile file;
+            if(!VFS::Get().MapFile(path, file))
             {
                 LUMOS_LOG_ERROR("No saved scene file found {0}", path);
                 return;
             }
 
-            try
+            if(BinaryScene::IsBinaryScene(file.Data, file.Size))
             {
-                std::ifstream file(path, std::ios::binary);
-                cereal::BinaryInputArchive input(file);
-                input(*this);
-                if(m_SceneSerialisationVersion < 2)
-                    entt::basic_snapshot_loader_legacy { m_EntityManager->GetRegistry() }.entities(input).component<ALL_COMPONENTSV1>(input).orphans();
-                else if(m_SceneSerialisationVersion == 3)
-                    entt::basic_snapshot_loader_legacy { m_EntityManager->GetRegistry() }.entities(input).component<ALL_COMPONENTSV2>(input).orphans();
-                else if(m_SceneSerialisationVersion == 4)
-                    entt::basic_snapshot_loader_legacy { m_EntityManager->GetRegistry() }.entities(input).component<ALL_COMPONENTSV3>(input).orphans();
-                else if(m_SceneSerialisationVersion == 5)
-                    entt::basic_snapshot_loader_legacy { m_EntityManager->GetRegistry() }.entities(input).component<ALL_COMPONENTSV4>(input);
-                else if(m_SceneSerialisationVersion == 6)
-                    entt::basic_snapshot_loader_legacy { m_EntityManager->GetRegistry() }.entities(input).component<ALL_COMPONENTSV5>(input);
-                else if(m_SceneSerialisationVersion == 7)
-                    entt::basic_snapshot_loader_legacy { m_EntityManager->GetRegistry() }.entities(input).component<ALL_COMPONENTSV6>(input);
-                else if(m_SceneSerialisationVersion >= 8 && m_SceneSerialisationVersion < 14)
-                    entt::basic_snapshot_loader_legacy { m_EntityManager->GetRegistry() }.entities(input).component<ALL_COMPONENTSV7>(input);
-                else if(m_SceneSerialisationVersion >= 14 && m_SceneSerialisationVersion < 21)
-                    entt::basic_snapshot_loader_legacy { m_EntityManager->GetRegistry() }.entities(input).component<ALL_COMPONENTSLISTV8>(input);
-                else if(m_SceneSerialisationVersion >= 21)
-                    entt::snapshot_loader { m_EntityManager->GetRegistry() }.get<entt::entity>(input).ALL_COMPONENTSENTTV8(input);
-
-                if(m_SceneSerialisationVersion < 6)
+                if(!BinaryScene::Load<ALL_COMPONENTSLISTV8>(file.Data, file.Size, path, *this, m_EntityManager->GetRegistry()))
+                    LUMOS_LOG_ERROR("Failed to load scene - {0}", path);
+            }
+            else
+            {
+                try
                 {
-                    // m_EntityManager->GetRegistry().each([&](auto entity)
-                    for(auto [entity] : m_EntityManager->GetRegistry().storage<entt::entity>().each())
+                    BinaryScene::MemoryStreamBuffer buffer(file.Data, file.Size);
+                    std::istream stream(&buffer);
+                    cereal::BinaryInputArchive input(stream);
+                    input(*this);
+                    if(m_SceneSerialisationVersion < 2)
+                        entt::basic_snapshot_loader_legacy { m_EntityManager->GetRegistry() }.entities(input).component<ALL_COMPONENTSV1>(input).orphans();
+                    else if(m_SceneSerialisationVersion == 3)
+                        entt::basic_snapshot_loader_legacy { m_EntityManager->GetRegistry() }.entities(input).component<ALL_COMPONENTSV2>(input).orphans();
+                    else if(m_SceneSerialisationVersion == 4)
+                        entt::basic_snapshot_loader_legacy { m_EntityManager->GetRegistry() }.entities(input).component<ALL_COMPONENTSV3>(input).orphans();
+                    else if(m_SceneSerialisationVersion == 5)
+                        entt::basic_snapshot_loader_legacy { m_EntityManager->GetRegistry() }.entities(input).component<ALL_COMPONENTSV4>(input);
+                    else if(m_SceneSerialisationVersion == 6)
+                        entt::basic_snapshot_loader_legacy { m_EntityManager->GetRegistry() }.entities(input).component<ALL_COMPONENTSV5>(input);
+                    else if(m_SceneSerialisationVersion == 7)
+                        entt::basic_snapshot_loader_legacy { m_EntityManager->GetRegistry() }.entities(input).component<ALL_COMPONENTSV6>(input);
+                    else if(m_SceneSerialisationVersion >= 8 && m_SceneSerialisationVersion < 14)
+                        entt::basic_snapshot_loader_legacy { m_EntityManager->GetRegistry() }.entities(input).component<ALL_COMPONENTSV7>(input);
+                    else if(m_SceneSerialisationVersion >= 14 && m_SceneSerialisationVersion < 21)
+                        entt::basic_snapshot_loader_legacy { m_EntityManager->GetRegistry() }.entities(input).component<ALL_COMPONENTSLISTV8>(input);
+                    else if(m_SceneSerialisationVersion >= 21)
+                        entt::snapshot_loader { m_EntityManager->GetRegistry() }.get<entt::entity>(input).ALL_COMPONENTSENTTV8(input);
+
+                    if(m_SceneSerialisationVersion < 6)
                     {
-                        m_EntityManager->GetRegistry().emplace<IDComponent>(entity, Random64::Rand(0, std::numeric_limits<uint64_t>::max()));
+                        // m_EntityManager->GetRegistry().each([&](auto entity)
+                        for(auto [entity] : m_EntityManager->GetRegistry().storage<entt::entity>().each())
+                        {
+                            m_EntityManager->GetRegistry().emplace<IDComponent>(entity, Random64::Rand(0, std::numeric_limits<uint64_t>::max()));
+                        }
                     }
-                }
 
-                if(m_SceneSerialisationVersion < 7)
-                {
-                    // m_EntityManager->GetRegistry().each([&](auto entity)
-                    for(auto [entity] : m_EntityManager->GetRegistry().storage<entt::entity>().each())
+                    if(m_SceneSerialisationVersion < 7)
                     {
-                        Graphics::Model* model;
-                        if(model = m_EntityManager->GetRegistry().try_get<Graphics::Model>(entity))
+                        // m_EntityManager->GetRegistry().each([&](auto entity)
+                        for(auto [entity] : m_EntityManager->GetRegistry().storage<entt::entity>().each())
                         {
-                            Graphics::Model* modelCopy = new Graphics::Model(*model);
-                            m_EntityManager->GetRegistry().emplace<Graphics::ModelComponent>(entity, SharedPtr<Graphics::Model>(modelCopy));
-                            m_EntityManager->GetRegistry().remove<Graphics::Model>(entity);
+                            Graphics::Model* model;
+                            if(model = m_EntityManager->GetRegistry().try_get<Graphics::Model>(entity))
+                            {
+                                Graphics::Model* modelCopy = new Graphics::Model(*model);
+                                m_EntityManager->GetRegistry().emplace<Graphics::ModelComponent>(entity, SharedPtr<Graphics::Model>(modelCopy));
+                                m_EntityManager->GetRegistry().remove<Graphics::Model>(entity);
+                            }
                         }
                     }
                 }
-            }
-            catch(...)
-            {
-                LUMOS_LOG_ERROR("Failed to load scene - {0}", path);
+                catch(...)
+                {
+                    LUMOS_LOG_ERROR("Failed to load scene - {0}", path);
+                }
             }
         }
         else
         {
             path += std::string(".lsn");
 
-            if(!FileSystem::FileExists(path))
+            if(!VFS::Get().FileExists(path))
             {
                 LUMOS_LOG_ERROR("No saved scene file found {0}", path);
                 return;
             }
             try
             {
-                std::string data = FileSystem::ReadTextFile(path);
+                std::string data = VFS::Get().ReadTextFile(path);
                 std::istringstream istr;
                 istr.str(data);
                 cereal::JSONInputArchive input(istr);
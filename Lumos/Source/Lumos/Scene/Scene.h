@@ -18,6 +18,8 @@ namespace Lumos
     class SceneGraph;
     class Event;
     class WindowResizeEvent;
+    class AnimationInstance;
+    class AnimationPoseCache;
 
     namespace Graphics
     {
@@ -278,6 +280,10 @@ namespace Lumos
         NONCOPYABLE(Scene)
 
         bool OnWindowResize(WindowResizeEvent& e);
+        void UpdateAnimations(float dt);
+
+        std::vector<SharedPtr<AnimationInstance>> m_AnimationUpdates;
+        UniquePtr<AnimationPoseCache> m_AnimationPoseCache;
 
         friend class Entity;
     };
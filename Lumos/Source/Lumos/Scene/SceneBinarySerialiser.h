@@ -0,0 +1,527 @@
+#pragma once
+#include "Scene/Scene.h"
+#include "Scene/Serialisation.h"
+#include "Scene/Component/Components.h"
+#include "Scene/Component/ModelComponent.h"
+#include "Core/OS/FileSystem.h"
+#include "Core/VFS.h"
+
+#include <cereal/archives/binary.hpp>
+#include <cereal/types/memory.hpp>
+
+DISABLE_WARNING_PUSH
+DISABLE_WARNING_CONVERSION_TO_SMALLER_TYPE
+#include <entt/entity/registry.hpp>
+DISABLE_WARNING_POP
+
+// Packed binary scene format (.bin)
+//  - A FileHeader followed by BlockCount blocks, each starting with a BlockHeader and padded to BlockAlignment.
+//  - Every component pool is written as one block: all entity ids, then all components.
+//    Trivially copyable components are copied as raw memory and bulk inserted straight from the mapped file,
+//    everything else is streamed through cereal's binary archive.
+//  - Asset references (models, fonts) are stored as UUIDs into a single asset table block.
+// Raw blocks depend on the compiler/ABI that wrote them, so .lsn (JSON) remains the editable interchange format.
+namespace Lumos::BinaryScene
+{
+    constexpr uint32_t Magic          = 0x424E534C; // "LSNB"
+    constexpr uint32_t FormatVersion  = 2;
+    constexpr uint64_t BlockAlignment = 16;
+
+    enum class BlockType : uint32_t
+    {
+        Settings  = 0,
+        Entities  = 1,
+        Assets    = 2,
+        Component = 3
+    };
+
+    enum BlockFlags : uint32_t
+    {
+        BlockFlags_None = 0,
+        BlockFlags_Raw  = BIT(0)
+    };
+
+    struct FileHeader
+    {
+        uint32_t Magic;
+        uint32_t FormatVersion;
+        uint32_t SceneVersion;
+        uint32_t BlockCount;
+    };
+
+    struct BlockHeader
+    {
+        uint32_t Type;
+        uint32_t ID;          // Index of the component in the saved component list, which is append only
+        uint32_t Version;     // Scene serialisation version the block was written with
+        uint32_t Flags;
+        uint32_t Count;       // Number of elements in the block
+        uint32_t ElementSize; // sizeof(T) for raw blocks, used to reject blocks with a stale layout
+        uint64_t Size;        // Payload size in bytes, excluding header and padding
+    };
+
+    static_assert(sizeof(FileHeader) % BlockAlignment == 0);
+    static_assert(sizeof(BlockHeader) % BlockAlignment == 0);
+
+    inline uint64_t AlignBlockSize(uint64_t size)
+    {
+        return (size + BlockAlignment - 1) & ~(BlockAlignment - 1);
+    }
+
+    // Read only stream over a memory range, so archived blocks can be read in place from the mapped file
+    class MemoryStreamBuffer : public std::streambuf
+    {
+    public:
+        MemoryStreamBuffer(const uint8_t* data, uint64_t size)
+        {
+            char* begin = (char*)data;
+            setg(begin, begin, begin + size);
+        }
+    };
+
+    class AssetTable
+    {
+    public:
+        // Asset ids are derived from the VFS path so the same asset gets the same id in every scene
+        uint64_t Add(const std::string& path)
+        {
+            if(path.empty())
+                return 0;
+
+            uint64_t hash = 14695981039346656037ull;
+            for(char c : path)
+            {
+                hash ^= (uint8_t)c;
+                hash *= 1099511628211ull;
+            }
+
+            m_Paths.emplace(hash, path);
+            return hash;
+        }
+
+        const std::string* Find(uint64_t id) const
+        {
+            auto it = m_Paths.find(id);
+            return it != m_Paths.end() ? &it->second : nullptr;
+        }
+
+        template <typename Archive>
+        void save(Archive& archive) const
+        {
+            archive((uint32_t)m_Paths.size());
+            for(auto& [id, path] : m_Paths)
+                archive(id, path);
+        }
+
+        template <typename Archive>
+        void load(Archive& archive)
+        {
+            uint32_t count;
+            archive(count);
+            for(uint32_t i = 0; i < count; i++)
+            {
+                uint64_t id;
+                std::string path;
+                archive(id, path);
+                m_Paths.emplace(id, path);
+            }
+        }
+
+    private:
+        std::unordered_map<uint64_t, std::string> m_Paths;
+    };
+
+    // Default component (de)serialisation goes through the component's own cereal functions
+    template <typename T>
+    void WriteComponent(cereal::BinaryOutputArchive& archive, const T& component, AssetTable& assets)
+    {
+        archive(component);
+    }
+
+    template <typename T>
+    void ReadComponent(cereal::BinaryInputArchive& archive, T& component, const AssetTable& assets)
+    {
+        archive(component);
+    }
+
+    inline void WriteComponent(cereal::BinaryOutputArchive& archive, const Graphics::ModelComponent& component, AssetTable& assets)
+    {
+        auto primitiveType = Graphics::PrimitiveType::None;
+        uint64_t assetID   = 0;
+
+        if(component.ModelRef && !component.ModelRef->GetMeshes().empty())
+        {
+            primitiveType = component.ModelRef->GetPrimitiveType();
+            if(primitiveType == Graphics::PrimitiveType::File)
+                assetID = assets.Add(VFS::Get().AbsoulePathToVFS(component.ModelRef->GetFilePath()));
+        }
+
+        archive(primitiveType, assetID);
+
+        // Models loaded from file use the materials stored in the model file
+        if(primitiveType != Graphics::PrimitiveType::None && primitiveType != Graphics::PrimitiveType::File)
+        {
+            auto material = std::unique_ptr<Graphics::Material>(component.ModelRef->GetMeshes().front()->GetMaterial().get());
+            archive(material);
+            material.release();
+        }
+    }
+
+    inline void ReadComponent(cereal::BinaryInputArchive& archive, Graphics::ModelComponent& component, const AssetTable& assets)
+    {
+        Graphics::PrimitiveType primitiveType;
+        uint64_t assetID;
+        archive(primitiveType, assetID);
+
+        if(primitiveType == Graphics::PrimitiveType::File)
+        {
+            if(auto path = assets.Find(assetID))
+                component.LoadFromLibrary(*path);
+            else
+                LUMOS_LOG_ERROR("Missing model asset {0} in binary scene", assetID);
+        }
+        else if(primitiveType != Graphics::PrimitiveType::None)
+        {
+            auto material = std::unique_ptr<Graphics::Material>();
+            archive(material);
+
+            component.ModelRef = CreateSharedPtr<Graphics::Model>(primitiveType);
+            component.ModelRef->GetMeshes().back()->SetMaterial(SharedPtr<Graphics::Material>(material.release()));
+        }
+    }
+
+    inline void WriteComponent(cereal::BinaryOutputArchive& archive, const TextComponent& component, AssetTable& assets)
+    {
+        uint64_t fontID = 0;
+        if(component.FontHandle && component.FontHandle != Graphics::Font::GetDefaultFont())
+            fontID = assets.Add(VFS::Get().AbsoulePathToVFS(component.FontHandle->GetFilePath()));
+
+        archive(component.TextString, fontID, component.Colour, component.OutlineColour, component.LineSpacing, component.Kerning, component.MaxWidth, component.OutlineWidth);
+    }
+
+    inline void ReadComponent(cereal::BinaryInputArchive& archive, TextComponent& component, const AssetTable& assets)
+    {
+        uint64_t fontID;
+        archive(component.TextString, fontID, component.Colour, component.OutlineColour, component.LineSpacing, component.Kerning, component.MaxWidth, component.OutlineWidth);
+
+        auto path = assets.Find(fontID);
+        if(path && VFS::Get().FileExists(*path))
+            Application::Get().GetFontLibrary()->Load(*path, component.FontHandle);
+        else
+            component.FontHandle = Graphics::Font::GetDefaultFont();
+    }
+
+    class Writer
+    {
+    public:
+        Writer()
+        {
+            m_Data.resize(sizeof(FileHeader));
+        }
+
+        void WriteBlock(BlockHeader header, const void* data, uint64_t size)
+        {
+            header.Size = size;
+
+            uint64_t offset = m_Data.size();
+            m_Data.resize(offset + sizeof(BlockHeader) + AlignBlockSize(size), 0);
+            memcpy(m_Data.data() + offset, &header, sizeof(BlockHeader));
+            if(size > 0)
+                memcpy(m_Data.data() + offset + sizeof(BlockHeader), data, size);
+
+            m_BlockCount++;
+        }
+
+        bool WriteToFile(const std::string& path)
+        {
+            FileHeader header;
+            header.Magic         = Magic;
+            header.FormatVersion = FormatVersion;
+            header.SceneVersion  = SceneSerialisationVersion;
+            header.BlockCount    = m_BlockCount;
+            memcpy(m_Data.data(), &header, sizeof(FileHeader));
+
+            return FileSystem::WriteFile(path, m_Data.data(), (uint32_t)m_Data.size());
+        }
+
+    private:
+        std::vector<uint8_t> m_Data;
+        uint32_t m_BlockCount = 0;
+    };
+
+    template <typename T>
+    void WriteComponentBlock(Writer& writer, const entt::registry& registry, AssetTable& assets, uint32_t id)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        constexpr bool isEmpty = entt::component_traits<T>::page_size == 0u;
+        constexpr bool isRaw   = !isEmpty && std::is_trivially_copyable_v<T>;
+
+        // Empty pools still get a block so the loader can tell a missing block from an unused component
+        const auto* storage = registry.storage<T>();
+
+        BlockHeader header = {};
+        header.Type        = (uint32_t)BlockType::Component;
+        header.ID          = id;
+        header.Version     = SceneSerialisationVersion;
+        header.Flags       = isRaw ? BlockFlags_Raw : BlockFlags_None;
+        header.Count       = storage ? (uint32_t)storage->size() : 0;
+        header.ElementSize = isRaw ? (uint32_t)sizeof(T) : 0;
+
+        if(header.Count == 0)
+        {
+            writer.WriteBlock(header, nullptr, 0);
+            return;
+        }
+
+        const uint64_t entitiesSize = AlignBlockSize(header.Count * sizeof(entt::entity));
+        std::vector<uint8_t> payload(entitiesSize);
+        entt::entity* entities = reinterpret_cast<entt::entity*>(payload.data());
+
+        if constexpr(isRaw)
+            payload.resize(entitiesSize + header.Count * sizeof(T));
+
+        std::ostringstream stream;
+        {
+            cereal::BinaryOutputArchive archive(stream);
+
+            uint32_t index = 0;
+            for(auto elem : storage->reach())
+            {
+                entities[index] = std::get<0>(elem);
+
+                if constexpr(isRaw)
+                    memcpy(payload.data() + entitiesSize + index * sizeof(T), &std::get<1>(elem), sizeof(T));
+                else if constexpr(!isEmpty)
+                    WriteComponent(archive, std::get<1>(elem), assets);
+
+                index++;
+            }
+        }
+
+        if constexpr(!isRaw && !isEmpty)
+        {
+            const std::string archived = stream.str();
+            payload.insert(payload.end(), archived.begin(), archived.end());
+        }
+
+        writer.WriteBlock(header, payload.data(), payload.size());
+    }
+
+    template <typename T>
+    void ReadComponentBlock(const BlockHeader& header, const uint8_t* payload, entt::registry& registry, const AssetTable& assets)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        constexpr bool isEmpty = entt::component_traits<T>::page_size == 0u;
+
+        const entt::entity* entities = reinterpret_cast<const entt::entity*>(payload);
+        const uint8_t* data          = payload + AlignBlockSize(header.Count * sizeof(entt::entity));
+        const uint64_t dataSize      = header.Size - (data - payload);
+        auto& storage                = registry.storage<T>();
+
+        if constexpr(isEmpty)
+        {
+            storage.insert(entities, entities + header.Count);
+        }
+        else if(header.Flags & BlockFlags_Raw)
+        {
+            if constexpr(std::is_trivially_copyable_v<T>)
+            {
+                if(header.ElementSize != sizeof(T))
+                {
+                    LUMOS_LOG_ERROR("Binary scene block for {0} has element size {1}, expected {2}", entt::type_id<T>().name(), header.ElementSize, sizeof(T));
+                    return;
+                }
+
+                storage.insert(entities, entities + header.Count, reinterpret_cast<const T*>(data));
+            }
+            else
+            {
+                LUMOS_LOG_ERROR("Binary scene block for {0} is raw but the component is no longer trivially copyable", entt::type_id<T>().name());
+            }
+        }
+        else
+        {
+            MemoryStreamBuffer buffer(data, dataSize);
+            std::istream stream(&buffer);
+            cereal::BinaryInputArchive archive(stream);
+
+            storage.reserve(storage.size() + header.Count);
+            for(uint32_t i = 0; i < header.Count; i++)
+                ReadComponent(archive, storage.emplace(entities[i]), assets);
+        }
+    }
+
+    inline bool IsBinaryScene(const uint8_t* file, int64_t fileSize)
+    {
+        return fileSize >= (int64_t)sizeof(FileHeader) && reinterpret_cast<const FileHeader*>(file)->Magic == Magic;
+    }
+
+    template <typename... Component>
+    bool Save(const std::string& path, const Scene& scene, const entt::registry& registry)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        Writer writer;
+
+        {
+            std::ostringstream stream;
+            {
+                cereal::BinaryOutputArchive archive(stream);
+                archive(scene);
+            }
+            const std::string settings = stream.str();
+
+            BlockHeader header = {};
+            header.Type        = (uint32_t)BlockType::Settings;
+            header.Version     = SceneSerialisationVersion;
+            writer.WriteBlock(header, settings.data(), settings.size());
+        }
+
+        if(const auto* storage = registry.storage<entt::entity>())
+        {
+            // Entity pool including the free list, so entity ids and versions match the source registry
+            std::vector<uint64_t> payload(1 + (storage->size() + 1) / 2);
+            payload[0] = storage->in_use();
+            memcpy(payload.data() + 1, storage->data(), storage->size() * sizeof(entt::entity));
+
+            BlockHeader header = {};
+            header.Type        = (uint32_t)BlockType::Entities;
+            header.Version     = SceneSerialisationVersion;
+            header.Count       = (uint32_t)storage->size();
+            header.ElementSize = sizeof(entt::entity);
+            writer.WriteBlock(header, payload.data(), sizeof(uint64_t) + storage->size() * sizeof(entt::entity));
+        }
+
+        AssetTable assets;
+        uint32_t componentID = 0;
+        (WriteComponentBlock<Component>(writer, registry, assets, componentID++), ...);
+
+        {
+            std::ostringstream stream;
+            {
+                cereal::BinaryOutputArchive archive(stream);
+                archive(assets);
+            }
+            const std::string table = stream.str();
+
+            BlockHeader header = {};
+            header.Type        = (uint32_t)BlockType::Assets;
+            header.Version     = SceneSerialisationVersion;
+            writer.WriteBlock(header, table.data(), table.size());
+        }
+
+        return writer.WriteToFile(path);
+    }
+
+    // file is read in place, path is only used for errors
+    template <typename... Component>
+    bool Load(const uint8_t* file, int64_t fileSize, const std::string& path, Scene& scene, entt::registry& registry)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        const uint8_t* end = file + fileSize;
+        auto header        = reinterpret_cast<const FileHeader*>(file);
+
+        if(fileSize < (int64_t)sizeof(FileHeader) || header->Magic != Magic || header->FormatVersion != FormatVersion)
+        {
+            LUMOS_LOG_ERROR("Unsupported binary scene format - {0}", path);
+            return false;
+        }
+
+        // Index the blocks first so the load order does not depend on the order they were written in
+        const BlockHeader* settingsBlock = nullptr;
+        const BlockHeader* entitiesBlock = nullptr;
+        const BlockHeader* assetsBlock   = nullptr;
+        std::unordered_map<uint32_t, const BlockHeader*> componentBlocks;
+
+        const uint8_t* current = file + sizeof(FileHeader);
+        for(uint32_t i = 0; i < header->BlockCount; i++)
+        {
+            auto block = reinterpret_cast<const BlockHeader*>(current);
+            if(current + sizeof(BlockHeader) > end || current + sizeof(BlockHeader) + block->Size > end)
+            {
+                LUMOS_LOG_ERROR("Truncated binary scene - {0}", path);
+                return false;
+            }
+
+            switch((BlockType)block->Type)
+            {
+            case BlockType::Settings:
+                settingsBlock = block;
+                break;
+            case BlockType::Entities:
+                entitiesBlock = block;
+                break;
+            case BlockType::Assets:
+                assetsBlock = block;
+                break;
+            case BlockType::Component:
+                componentBlocks[block->ID] = block;
+                break;
+            default:
+                LUMOS_LOG_ERROR("Unknown block type {0} in binary scene - {1}", block->Type, path);
+                break;
+            }
+
+            current += sizeof(BlockHeader) + AlignBlockSize(block->Size);
+        }
+
+        auto payload = [](const BlockHeader* block)
+        {
+            return reinterpret_cast<const uint8_t*>(block) + sizeof(BlockHeader);
+        };
+
+        if(settingsBlock)
+        {
+            MemoryStreamBuffer buffer(payload(settingsBlock), settingsBlock->Size);
+            std::istream stream(&buffer);
+            cereal::BinaryInputArchive archive(stream);
+            archive(scene);
+        }
+        else
+        {
+            LUMOS_LOG_ERROR("Missing settings block in binary scene - {0}", path);
+        }
+
+        AssetTable assets;
+        if(assetsBlock)
+        {
+            MemoryStreamBuffer buffer(payload(assetsBlock), assetsBlock->Size);
+            std::istream stream(&buffer);
+            cereal::BinaryInputArchive archive(stream);
+            archive(assets);
+        }
+
+        if(entitiesBlock)
+        {
+            const uint8_t* data  = payload(entitiesBlock);
+            const auto entities  = reinterpret_cast<const entt::entity*>(data + sizeof(uint64_t));
+            const uint64_t inUse = *reinterpret_cast<const uint64_t*>(data);
+            auto& storage        = registry.storage<entt::entity>();
+
+            storage.reserve(entitiesBlock->Count);
+            for(uint32_t i = 0; i < entitiesBlock->Count; i++)
+                storage.emplace(entities[i]);
+            storage.in_use(inUse);
+        }
+
+        for(const auto& [id, block] : componentBlocks)
+        {
+            if(id >= sizeof...(Component))
+                LUMOS_LOG_ERROR("Unknown component block {0} in binary scene - {1}", id, path);
+        }
+
+        auto readBlock = [&](auto tag, uint32_t id)
+        {
+            using T = typename decltype(tag)::type;
+            auto it = componentBlocks.find(id);
+            if(it == componentBlocks.end())
+                LUMOS_LOG_ERROR("Missing component block for {0} in binary scene - {1}", entt::type_id<T>().name(), path);
+            else if(it->second->Count > 0)
+                ReadComponentBlock<T>(*it->second, payload(it->second), registry, assets);
+        };
+
+        uint32_t componentID = 0;
+        (readBlock(entt::type_identity<Component> {}, componentID++), ...);
+
+        return true;
+    }
+}
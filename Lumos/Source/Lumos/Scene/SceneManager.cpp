@@ -107,12 +107,20 @@ namespace Lumos
         app.GetSystem<B2PhysicsEngine>()->SetDefaults();
         app.GetSystem<LumosPhysicsEngine>()->SetPaused(false);
 
-        std::string physicalPath;
-        if(Lumos::VFS::Get().ResolvePhysicalPath("//Scenes/" + m_CurrentScene->GetSceneName() + ".lsn", physicalPath))
-        {
-            auto newPath = StringUtilities::RemoveName(physicalPath);
-            m_CurrentScene->Deserialise(newPath, false);
-        }
+        // Prefer the packed binary scene unless the json scene has been edited since it was written.
+        // Scenes are read through the VFS, so they load from a mounted pack as well
+        const std::string scenePath = "//Scenes/" + m_CurrentScene->GetSceneName();
+        bool hasTextScene           = Lumos::VFS::Get().FileExists(scenePath + ".lsn");
+        bool hasBinaryScene         = Lumos::VFS::Get().FileExists(scenePath + ".bin");
+        bool loadBinary             = hasBinaryScene;
+
+        std::string physicalPath, binaryPath;
+        if(hasTextScene && hasBinaryScene && !Lumos::VFS::Get().IsPacked(scenePath + ".lsn") && !Lumos::VFS::Get().IsPacked(scenePath + ".bin")
+           && Lumos::VFS::Get().ResolvePhysicalPath(scenePath + ".lsn", physicalPath) && Lumos::VFS::Get().ResolvePhysicalPath(scenePath + ".bin", binaryPath))
+            loadBinary = FileSystem::GetLastModifiedTime(binaryPath) >= FileSystem::GetLastModifiedTime(physicalPath);
+
+        if(hasBinaryScene || hasTextScene)
+            m_CurrentScene->Deserialise("//Scenes/", loadBinary);
 
         auto screenSize = app.GetWindowSize();
         m_CurrentScene->SetScreenSize(static_cast<uint32_t>(screenSize.x), static_cast<uint32_t>(screenSize.y));
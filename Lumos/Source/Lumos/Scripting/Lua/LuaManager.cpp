@@ -3,6 +3,10 @@
 #include "Maths/Transform.h"
 #include "Core/OS/Window.h"
 #include "Core/VFS.h"
+#include "Core/OS/FileSystem.h"
+#include "Utilities/Timer.h"
+#include "Core/StringUtilities.h"
+#include "ImGui/ImGuiUtilities.h"
 #include "Scene/Scene.h"
 #include "Core/Application.h"
 #include "Core/Engine.h"
@@ -182,6 +186,15 @@ namespace Lumos
         "GetTransform"
     };
 
+    struct LuaManager::ScriptGroup
+    {
+        std::vector<LuaScriptComponent*> Components;
+        sol::table Batch;
+        size_t BatchSize  = 0;
+        float PendingTime = 0.0f; // Time since the script last updated, passed as dt when it runs
+        LuaScriptProfile Profile;
+    };
+
     LuaManager::LuaManager()
         : m_State(nullptr)
     {
@@ -247,23 +260,213 @@ namespace Lumos
 
         auto view = registry.view<LuaScriptComponent>();
 
+        for(auto& [path, group] : m_ScriptGroups)
+            group->Components.clear();
+
+        m_ScriptTimeMs = 0.0f;
+
         if(view.empty())
+        {
+            m_ScriptGroups.clear();
             return;
+        }
 
         float dt = (float)Engine::Get().GetTimeStep().GetSeconds();
 
         for(auto entity : view)
         {
             auto& luaScript = registry.get<LuaScriptComponent>(entity);
-            luaScript.OnUpdate(dt);
+            if(!luaScript.HasUpdate())
+                continue;
+
+            auto& group = m_ScriptGroups[luaScript.GetFilePath()];
+            if(!group)
+            {
+                group               = CreateUniquePtr<ScriptGroup>();
+                group->Profile.Name = luaScript.GetFilePath();
+            }
+
+            group->Components.push_back(&luaScript);
         }
+
+        m_UpdateOrder.clear();
+        for(auto it = m_ScriptGroups.begin(); it != m_ScriptGroups.end();)
+        {
+            ScriptGroup& group = *it->second;
+            if(group.Components.empty())
+            {
+                it = m_ScriptGroups.erase(it);
+                continue;
+            }
+
+            group.PendingTime += dt;
+            group.Profile.Entities       = uint32_t(group.Components.size());
+            group.Profile.Priority       = group.Components.front()->GetUpdatePriority();
+            group.Profile.Calls          = 0;
+            group.Profile.Deferred       = 0;
+            group.Profile.TimeMs         = 0.0f;
+            group.Profile.AllocatedBytes = 0;
+
+            m_UpdateOrder.push_back(&group);
+            ++it;
+        }
+
+        // Highest priority first, then whichever script has waited longest
+        std::sort(m_UpdateOrder.begin(), m_UpdateOrder.end(), [](const ScriptGroup* a, const ScriptGroup* b)
+                  { return a->Profile.Priority != b->Profile.Priority ? a->Profile.Priority < b->Profile.Priority : a->PendingTime > b->PendingTime; });
+
+        bool lowPriorityUpdated = false;
+        for(ScriptGroup* group : m_UpdateOrder)
+        {
+            if(group->Profile.Priority > 0)
+            {
+                if(lowPriorityUpdated && m_UpdateBudgetMs > 0.0f && m_ScriptTimeMs > m_UpdateBudgetMs)
+                {
+                    group->Profile.Deferred = group->Profile.Entities;
+                    continue;
+                }
+
+                lowPriorityUpdated = true;
+            }
+
+            UpdateScriptGroup(*group);
+            m_ScriptTimeMs += group->Profile.TimeMs;
+        }
+
+        // Spread collection over frames instead of stalling on full cycles
+        m_State->step_gc(GCStepKilobytes);
+    }
+
+    void LuaManager::UpdateScriptGroup(ScriptGroup& group)
+    {
+        LUMOS_PROFILE_SCOPE("Lua Script");
+        LUMOS_PROFILE_ZONE_NAME(group.Profile.Name.c_str(), group.Profile.Name.size());
+
+        float dt          = group.PendingTime;
+        group.PendingTime = 0.0f;
+
+        size_t memoryStart = m_State->memory_used();
+        TimeStamp start    = Timer::Now();
+
+        LuaScriptComponent* first = group.Components.front();
+        if(first->HasUpdateBatch())
+        {
+            // The table is kept between frames so only the entries change
+            if(!group.Batch.valid())
+                group.Batch = m_State->create_table(int(group.Components.size()), 0);
+
+            for(size_t i = 0; i < group.Components.size(); i++)
+                group.Batch[i + 1] = group.Components[i];
+            for(size_t i = group.Components.size(); i < group.BatchSize; i++)
+                group.Batch[i + 1] = sol::lua_nil;
+
+            group.BatchSize = group.Components.size();
+            first->OnUpdateBatch(group.Batch, dt);
+            group.Profile.Calls = 1;
+        }
+        else
+        {
+            for(LuaScriptComponent* component : group.Components)
+                component->OnUpdate(dt);
+            group.Profile.Calls = uint32_t(group.Components.size());
+        }
+
+        group.Profile.TimeMs         = Timer::Duration(start, Timer::Now(), 1000.0f);
+        group.Profile.AverageTimeMs  = Maths::Lerp(group.Profile.AverageTimeMs, group.Profile.TimeMs, 0.05f);
+        group.Profile.AllocatedBytes = Maths::Max(int64_t(m_State->memory_used()) - int64_t(memoryStart), int64_t(0));
+    }
+
+    std::vector<LuaScriptProfile> LuaManager::GetScriptProfiles() const
+    {
+        std::vector<LuaScriptProfile> profiles;
+        profiles.reserve(m_ScriptGroups.size());
+        for(auto& [path, group] : m_ScriptGroups)
+            profiles.push_back(group->Profile);
+
+        std::sort(profiles.begin(), profiles.end(), [](const LuaScriptProfile& a, const LuaScriptProfile& b)
+                  { return a.AverageTimeMs > b.AverageTimeMs; });
+        return profiles;
+    }
+
+    void LuaManager::OnImGui()
+    {
+        LUMOS_PROFILE_FUNCTION();
+        float memoryKB = float(m_State->memory_used()) / 1024.0f;
+
+        ImGui::Columns(2);
+        ImGuiUtilities::Property("Update Budget (ms)", m_UpdateBudgetMs, 0.0f, 33.0f, 0.1f);
+        ImGuiUtilities::Property("Script Time (ms)", m_ScriptTimeMs, 0.0f, 0.0f, 0.0f, ImGuiUtilities::PropertyFlag::ReadOnly);
+        ImGuiUtilities::Property("Lua Memory (KB)", memoryKB, 0.0f, 0.0f, 0.0f, ImGuiUtilities::PropertyFlag::ReadOnly);
+        ImGui::Columns(1);
+
+        if(ImGui::BeginTable("Scripts", 7, ImGuiTableFlags_NoSavedSettings | ImGuiTableFlags_Borders | ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_RowBg))
+        {
+            ImGui::TableSetupColumn("Script");
+            ImGui::TableSetupColumn("Entities");
+            ImGui::TableSetupColumn("Calls");
+            ImGui::TableSetupColumn("Time (ms)");
+            ImGui::TableSetupColumn("Avg (ms)");
+            ImGui::TableSetupColumn("Alloc (KB)");
+            ImGui::TableSetupColumn("Deferred");
+            ImGui::TableHeadersRow();
+
+            for(auto& profile : GetScriptProfiles())
+            {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(StringUtilities::GetFileName(profile.Name).c_str());
+                ImGuiUtilities::Tooltip(profile.Name.c_str());
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", profile.Entities);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", profile.Calls);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", profile.TimeMs);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", profile.AverageTimeMs);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.1f", float(profile.AllocatedBytes) / 1024.0f);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", profile.Deferred);
+            }
+
+            ImGui::EndTable();
+        }
+    }
+
+    const LuaCompiledScript& LuaManager::GetCompiledScript(const std::string& physicalPath)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        uint64_t lastModified     = FileSystem::GetLastModifiedTime(physicalPath);
+        LuaCompiledScript& script = m_ScriptCache[physicalPath];
+
+        if(script.LastModified == lastModified && (!script.Bytecode.empty() || !script.Error.empty()))
+            return script;
+
+        script.LastModified = lastModified;
+        script.Bytecode.clear();
+        script.Error.clear();
+
+        sol::load_result chunk = m_State->load_file(physicalPath);
+        if(!chunk.valid())
+        {
+            sol::error err = chunk;
+            script.Error   = err.what();
+            return script;
+        }
+
+        sol::function function = chunk;
+        sol::bytecode bytecode = function.dump();
+        script.Bytecode        = std::string(bytecode.as_string_view());
+
+        return script;
     }
 
     void LuaManager::OnNewProject(const std::string& projectPath)
     {
         auto& state = *m_State;
         std::string ScriptsPath;
-        VFS::Get().ResolvePhysicalPath("//Scripts", ScriptsPath);
+        VFS::Get().ExtractPhysicalPath("//Scripts", ScriptsPath, true);
 
         // Setup the lua path to see luarocks packages
         auto package_path = std::filesystem::path(ScriptsPath) / "lua" / "?.lua;";
@@ -598,7 +801,8 @@ namespace Lumos
             { "DEFERREDRENDER", Material::RenderFlags::DEFERREDRENDER },
             { "NOSHADOW", Material::RenderFlags::NOSHADOW },
             { "TWOSIDED", Material::RenderFlags::TWOSIDED },
-            { "ALPHABLEND", Material::RenderFlags::ALPHABLEND }
+            { "ALPHABLEND", Material::RenderFlags::ALPHABLEND },
+            { "OCCLUDER", Material::RenderFlags::OCCLUDER }
 
         };
 
@@ -11,6 +11,27 @@ namespace Lumos
 {
     class Scene;
 
+    // Bytecode for one script file, compiled the first time it is loaded and again whenever the file changes
+    struct LuaCompiledScript
+    {
+        uint64_t LastModified = 0;
+        std::string Bytecode;
+        std::string Error; // Set when the file failed to compile
+    };
+
+    // Per script update cost, all of the components using a script are updated together
+    struct LuaScriptProfile
+    {
+        std::string Name;
+        uint32_t Entities      = 0;
+        uint32_t Calls         = 0; // Lua calls made this frame, one for scripts using OnUpdateBatch
+        uint32_t Deferred      = 0; // Entities whose update was pushed to a later frame by the budget
+        uint32_t Priority      = 0;
+        float TimeMs           = 0.0f;
+        float AverageTimeMs    = 0.0f;
+        int64_t AllocatedBytes = 0; // Lua heap growth while the script ran
+    };
+
     class LUMOS_EXPORT LuaManager : public ThreadSafeSingleton<LuaManager>
     {
         friend class TSingleton<LuaManager>;
@@ -22,6 +43,7 @@ namespace Lumos
         void OnInit();
         void OnInit(Scene* scene);
         void OnUpdate(Scene* scene);
+        void OnImGui();
 
         void OnNewProject(const std::string& projectPath);
 
@@ -33,6 +55,17 @@ namespace Lumos
 
         static std::vector<std::string>& GetIdentifiers() { return s_Identifiers; }
 
+        // Scripts shared by many entities are only parsed once, each instance loads its own chunk from the bytecode
+        const LuaCompiledScript& GetCompiledScript(const std::string& physicalPath);
+        void ClearScriptCache() { m_ScriptCache.clear(); }
+
+        // Milliseconds per frame for scripts with an UpdatePriority above 0. Priority 0 scripts always run,
+        // the longest waiting low priority script always runs too so nothing is starved. 0 disables the budget
+        void SetUpdateBudget(float milliseconds) { m_UpdateBudgetMs = milliseconds; }
+        float GetUpdateBudget() const { return m_UpdateBudgetMs; }
+
+        std::vector<LuaScriptProfile> GetScriptProfiles() const;
+
         sol::state& GetState()
         {
             return *m_State;
@@ -41,6 +74,17 @@ namespace Lumos
         static std::vector<std::string> s_Identifiers;
 
     private:
+        struct ScriptGroup;
+
+        void UpdateScriptGroup(ScriptGroup& group);
+
+        static constexpr int GCStepKilobytes = 64;
+
         sol::state* m_State;
+        std::unordered_map<std::string, LuaCompiledScript> m_ScriptCache;
+        std::unordered_map<std::string, UniquePtr<ScriptGroup>> m_ScriptGroups;
+        std::vector<ScriptGroup*> m_UpdateOrder;
+        float m_UpdateBudgetMs = 2.0f;
+        float m_ScriptTimeMs   = 0.0f;
     };
 }
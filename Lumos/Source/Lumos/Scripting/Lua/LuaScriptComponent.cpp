@@ -16,6 +16,7 @@ namespace Lumos
         m_Scene    = nullptr;
         m_FileName = "";
         m_Env      = nullptr;
+        m_Entity   = entt::null;
         // m_UUID = UUID();
     }
     LuaScriptComponent::LuaScriptComponent(const std::string& fileName, Scene* scene)
@@ -23,6 +24,7 @@ namespace Lumos
         m_Scene    = scene;
         m_FileName = fileName;
         m_Env      = nullptr;
+        m_Entity   = entt::null;
         // m_UUID = UUID();
 
         Init();
@@ -47,7 +49,7 @@ namespace Lumos
     {
         m_FileName = fileName;
         std::string physicalPath;
-        if(!VFS::Get().ResolvePhysicalPath(fileName, physicalPath))
+        if(!VFS::Get().ExtractPhysicalPath(fileName, physicalPath))
         {
             LUMOS_LOG_ERROR("Failed to Load Lua script {0}", fileName);
             m_Env = nullptr;
@@ -56,16 +58,40 @@ namespace Lumos
 
         VFS::Get().AbsoulePathToVFS(m_FileName, m_FileName);
 
-        m_Env = CreateSharedPtr<sol::environment>(LuaManager::Get().GetState(), sol::create, LuaManager::Get().GetState().globals());
+        auto& state = LuaManager::Get().GetState();
+        m_Env       = CreateSharedPtr<sol::environment>(state, sol::create, state.globals());
 
-        auto loadFileResult = LuaManager::Get().GetState().script_file(physicalPath, *m_Env, sol::script_pass_on_error);
-        if(!loadFileResult.valid())
+        // Every component gets its own chunk so functions defined by the script see this component's environment
+        const LuaCompiledScript& script = LuaManager::Get().GetCompiledScript(physicalPath);
+        std::string errorMessage        = script.Error;
+        if(errorMessage.empty())
+        {
+            sol::load_result chunk = state.load(script.Bytecode, "@" + physicalPath, sol::load_mode::binary);
+            if(chunk.valid())
+            {
+                sol::protected_function function = chunk;
+                sol::set_environment(*m_Env, function);
+
+                sol::protected_function_result result = function();
+                if(!result.valid())
+                {
+                    sol::error err = result;
+                    errorMessage   = err.what();
+                }
+            }
+            else
+            {
+                sol::error err = chunk;
+                errorMessage   = err.what();
+            }
+        }
+
+        if(!errorMessage.empty())
         {
-            sol::error err = loadFileResult;
             LUMOS_LOG_ERROR("Failed to Execute Lua script {0}", physicalPath);
-            LUMOS_LOG_ERROR("Error : {0}", err.what());
+            LUMOS_LOG_ERROR("Error : {0}", errorMessage);
             std::string filename = StringUtilities::GetFileName(m_FileName);
-            std::string error    = std::string(err.what());
+            std::string error    = errorMessage;
 
             int line              = 1;
             auto linepos          = error.find(".lua:");
@@ -94,6 +120,12 @@ namespace Lumos
         if(!m_UpdateFunc->valid())
             m_UpdateFunc.reset();
 
+        m_UpdateBatchFunc = CreateSharedPtr<sol::protected_function>((*m_Env)["OnUpdateBatch"]);
+        if(!m_UpdateBatchFunc->valid())
+            m_UpdateBatchFunc.reset();
+
+        m_UpdatePriority = m_Env->get_or("UpdatePriority", 0u);
+
         m_Phys2DBeginFunc = CreateSharedPtr<sol::protected_function>((*m_Env)["OnCollision2DBegin"]);
         if(!m_Phys2DBeginFunc->valid())
             m_Phys2DBeginFunc.reset();
@@ -109,8 +141,6 @@ namespace Lumos
         m_Phys3DEndFunc = CreateSharedPtr<sol::protected_function>((*m_Env)["OnCollision3DEnd"]);
         if(!m_Phys3DEndFunc->valid())
             m_Phys3DEndFunc.reset();
-
-        LuaManager::Get().GetState().collect_garbage();
     }
 
     void LuaScriptComponent::OnInit()
@@ -141,6 +171,20 @@ namespace Lumos
         }
     }
 
+    void LuaScriptComponent::OnUpdateBatch(const sol::table& components, float dt)
+    {
+        if(m_UpdateBatchFunc)
+        {
+            sol::protected_function_result result = m_UpdateBatchFunc->call(components, dt);
+            if(!result.valid())
+            {
+                sol::error err = result;
+                LUMOS_LOG_ERROR("Failed to Execute Script Lua OnUpdateBatch");
+                LUMOS_LOG_ERROR("Error : {0}", err.what());
+            }
+        }
+    }
+
     void LuaScriptComponent::Reload()
     {
         if(m_Env)
@@ -155,20 +199,15 @@ namespace Lumos
 
     Entity LuaScriptComponent::GetCurrentEntity()
     {
-        // TODO: Faster alternative
         if(!m_Scene)
             m_Scene = Application::Get().GetCurrentScene();
 
-        auto entities = m_Scene->GetEntityManager()->GetEntitiesWithType<LuaScriptComponent>();
-
-        for(auto entity : entities)
-        {
-            LuaScriptComponent* comp = &entity.GetComponent<LuaScriptComponent>();
-            if(comp->GetFilePath() == GetFilePath())
-                return entity;
-        }
+        return Entity(m_Entity, m_Scene);
+    }
 
-        return Entity();
+    void LuaScriptComponent::OnConstruct(entt::registry& registry, entt::entity entity)
+    {
+        registry.get<LuaScriptComponent>(entity).m_Entity = entity;
     }
 
     void LuaScriptComponent::SetThisComponent()
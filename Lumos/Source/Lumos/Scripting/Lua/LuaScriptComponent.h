@@ -5,6 +5,7 @@
 
 #include <sol/forward.hpp>
 #include <cereal/cereal.hpp>
+#include <entt/entity/fwd.hpp>
 
 namespace Lumos
 {
@@ -21,10 +22,18 @@ namespace Lumos
         void Init();
         void OnInit();
         void OnUpdate(float dt);
+
+        // Scripts can define OnUpdateBatch(components, dt) instead of OnUpdate. It is called once per frame
+        // for every component using the script, through the first component's environment
+        void OnUpdateBatch(const sol::table& components, float dt);
         void Reload();
         void Load(const std::string& fileName);
         Entity GetCurrentEntity();
 
+        // Connected to on_construct and on_update (replace copies a component from another entity),
+        // so the owning entity is known without searching the registry
+        static void OnConstruct(entt::registry& registry, entt::entity entity);
+
         // For accessing this component in lua
         void SetThisComponent();
 
@@ -60,6 +69,13 @@ namespace Lumos
             return m_Env.get() != nullptr;
         }
 
+        bool HasUpdate() const { return m_UpdateFunc || m_UpdateBatchFunc; }
+        bool HasUpdateBatch() const { return m_UpdateBatchFunc != nullptr; }
+
+        // Set by the script as UpdatePriority. 0 always updates, higher values can be deferred to a later
+        // frame when the script update budget runs out
+        uint32_t GetUpdatePriority() const { return m_UpdatePriority; }
+
         template <typename Archive>
         void save(Archive& archive) const
         {
@@ -84,11 +100,14 @@ namespace Lumos
     private:
         Scene* m_Scene = nullptr;
         std::string m_FileName;
+        entt::entity m_Entity;
         std::map<int, std::string> m_Errors;
+        uint32_t m_UpdatePriority = 0;
 
         SharedPtr<sol::environment> m_Env;
         SharedPtr<sol::protected_function> m_OnInitFunc;
         SharedPtr<sol::protected_function> m_UpdateFunc;
+        SharedPtr<sol::protected_function> m_UpdateBatchFunc;
         SharedPtr<sol::protected_function> m_OnReleaseFunc;
 
         SharedPtr<sol::protected_function> m_Phys2DBeginFunc;
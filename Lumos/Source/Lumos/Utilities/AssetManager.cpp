@@ -1,40 +1,68 @@
 #include "Precompiled.h"
 #include "AssetManager.h"
 #include "Core/Application.h"
+#include "Core/VFS.h"
 
 namespace Lumos
 {
-    inline static std::vector<std::future<void>> m_Futures;
-
-    static void LoadTexture2D(Graphics::Texture2D* tex, const std::string& path)
+    // The library handle is cleared by Destroy()/~TextureLibrary so a late upload never touches a dead library
+    static void LoadTexture2D(const SharedPtr<TextureLibrary*>& library, const SharedPtr<Graphics::Texture2D>& tex, const std::string& path, const VFSFile& file)
     {
         LUMOS_PROFILE_FUNCTION();
         uint32_t width, height, channels;
         bool hdr;
         uint32_t bits;
-        uint8_t* data = Lumos::LoadImageFromFile(path, &width, &height, &bits, &hdr);
+        uint8_t* data = Lumos::LoadImageFromMemory(file.Data, file.Size, path.c_str(), &width, &height, &bits, &hdr);
 
         Graphics::TextureDesc desc;
         desc.format = bits / 4 == 8 ? Graphics::RHIFormat::R8G8B8A8_Unorm : Graphics::RHIFormat::R32G32B32A32_Float;
 
-        Application::Get().SubmitToMainThread([tex, path, width, height, data, desc]()
-                                              { tex->Load(width, height, data, desc); });
+        Application::Get().SubmitToMainThread([library, tex, path, width, height, data, desc]()
+                                              {
+                                                  tex->Load(width, height, data, desc);
+                                                  if(*library)
+                                                      (*library)->RefreshCost(path); });
     }
 
     TextureLibrary::~TextureLibrary()
     {
+        *m_Handle = nullptr;
     }
 
     bool TextureLibrary::Load(const std::string& filePath, SharedPtr<Graphics::Texture2D>& texture)
     {
         texture = SharedPtr<Graphics::Texture2D>(Graphics::Texture2D::Create({}, 1, 1));
-        m_Futures.push_back(std::async(std::launch::async, &LoadTexture2D, texture.get(), filePath));
+
+        // Read and decoded on a job, uploaded on the main thread
+        SharedPtr<TextureLibrary*> library = m_Handle;
+        SharedPtr<Graphics::Texture2D> tex = texture;
+        VFS::Get().ReadFileAsync(filePath, [library, tex, filePath](bool result, VFSFile& file)
+                                 {
+                                     if(!result)
+                                     {
+                                         LUMOS_LOG_ERROR("Failed to read texture {0}", filePath);
+                                         return;
+                                     }
+                                     LoadTexture2D(library, tex, filePath, file); });
         return true;
     }
 
+    ResourceCost TextureLibrary::Cost(const SharedPtr<Graphics::Texture2D>& texture)
+    {
+        ResourceCost cost;
+        uint64_t size = uint64_t(texture->GetWidth()) * texture->GetHeight() * Graphics::Texture::GetBitsFromFormat(texture->GetFormat()) / 8;
+
+        // A full mip chain adds roughly a third
+        cost.GPUBytes = texture->GetMipMapLevels() > 1 ? size * 4 / 3 : size;
+        return cost;
+    }
+
     void TextureLibrary::Destroy()
     {
-        m_Futures.clear();
+        // Uploads already queued on the main thread no longer refresh this library
+        *m_Handle = nullptr;
+        m_Handle  = CreateSharedPtr<TextureLibrary*>(this);
+
         typename MapType::iterator itr = m_NameResourceMap.begin();
 
         if(m_ReleaseFunc)
@@ -46,6 +74,8 @@ namespace Lumos
             }
         }
         m_NameResourceMap.clear();
+        m_Stats.CPUBytes = 0;
+        m_Stats.GPUBytes = 0;
     }
 
     ModelLibrary::~ModelLibrary()
@@ -57,4 +87,18 @@ namespace Lumos
         model = CreateSharedPtr<Graphics::Model>(filePath);
         return true;
     }
+
+    ResourceCost ModelLibrary::Cost(const SharedPtr<Graphics::Model>& model)
+    {
+        ResourceCost cost;
+        for(auto& mesh : model->GetMeshes())
+        {
+            uint64_t cpuBytes, gpuBytes;
+            mesh->GetMemoryUsage(cpuBytes, gpuBytes);
+            cost.CPUBytes += cpuBytes;
+            cost.GPUBytes += gpuBytes;
+        }
+
+        return cost;
+    }
 }
@@ -15,6 +15,25 @@ namespace Lumos
         class Model;
     }
 
+    struct ResourceCost
+    {
+        uint64_t CPUBytes = 0;
+        uint64_t GPUBytes = 0;
+    };
+
+    struct ResourceStats
+    {
+        uint64_t Hits      = 0;
+        uint64_t Misses    = 0;
+        uint64_t Evictions = 0;
+        uint64_t CPUBytes  = 0;
+        uint64_t GPUBytes  = 0;
+    };
+
+    // Caches resources by name. Unreferenced resources stay cached until the total cost goes over
+    // the budget, then the least recently used ones are evicted first. A budget of 0 means unlimited.
+    // Costs are measured when a resource is added or reloaded, resources that finish loading
+    // asynchronously call RefreshCost once they are ready
     template <typename T>
     class ResourceManager
     {
@@ -28,6 +47,7 @@ namespace Lumos
             float timeSinceReload = 0.0f;
             float lastAccessed    = 0.0f;
             ResourceHandle data;
+            ResourceCost cost;
             bool onDisk = false;
         };
 
@@ -37,16 +57,20 @@ namespace Lumos
         typedef std::function<void(ResourceHandle&)> ReleaseFunc;
         typedef std::function<bool(const IDType&, ResourceHandle&)> ReloadFunc;
         typedef std::function<IDType(const ResourceHandle&)> GetIdFunc;
+        typedef std::function<ResourceCost(const ResourceHandle&)> CostFunc;
 
         ResourceHandle GetResource(const IDType& name)
         {
             typename MapType::iterator itr = m_NameResourceMap.find(name);
             if(itr != m_NameResourceMap.end())
             {
+                m_Stats.Hits++;
                 itr->second.lastAccessed = (float)Engine::GetTimeStep().GetElapsedSeconds();
                 return itr->second.data;
             }
 
+            m_Stats.Misses++;
+
             ResourceHandle resourceData;
             if(!m_LoadFunc(name, resourceData))
             {
@@ -60,7 +84,7 @@ namespace Lumos
             newResource.onDisk          = true;
             newResource.lastAccessed    = (float)Engine::GetTimeStep().GetElapsedSeconds();
 
-            m_NameResourceMap.emplace(name, newResource);
+            RefreshCost(m_NameResourceMap.emplace(name, newResource).first->second);
 
             return resourceData;
         }
@@ -78,7 +102,7 @@ namespace Lumos
                 newResource.data            = resourceData;
                 newResource.timeSinceReload = 0;
                 newResource.onDisk          = false;
-                m_NameResourceMap.emplace(newId, newResource);
+                RefreshCost(m_NameResourceMap.emplace(newId, newResource).first->second);
 
                 return resourceData;
             }
@@ -93,6 +117,8 @@ namespace Lumos
             {
                 itr->second.lastAccessed = (float)Engine::GetTimeStep().GetElapsedSeconds();
                 itr->second.data         = data;
+                RefreshCost(itr->second);
+                return;
             }
 
             Resource newResource;
@@ -101,7 +127,7 @@ namespace Lumos
             newResource.onDisk          = true;
             newResource.lastAccessed    = (float)Engine::GetTimeStep().GetElapsedSeconds();
 
-            m_NameResourceMap.emplace(name, newResource);
+            RefreshCost(m_NameResourceMap.emplace(name, newResource).first->second);
         }
 
         virtual void Destroy()
@@ -117,28 +143,66 @@ namespace Lumos
                 }
             }
             m_NameResourceMap.clear();
+            m_Stats.CPUBytes = 0;
+            m_Stats.GPUBytes = 0;
         }
 
         void Update(const float elapsedSeconds)
         {
-            typename MapType::iterator itr = m_NameResourceMap.begin();
+            LUMOS_PROFILE_FUNCTION();
+            if(!IsOverBudget())
+                return;
 
-            static IDType keysToDelete[256];
-            std::size_t keysToDeleteCount = 0;
-
-            for(auto&& [key, value] : m_NameResourceMap)
+            // Only the cache holds a reference to these
+            m_EvictionCandidates.clear();
+            for(auto itr = m_NameResourceMap.begin(); itr != m_NameResourceMap.end(); ++itr)
             {
-                if(value.data.GetCounter()->GetReferenceCount() == 1 && m_ExpirationTime < (elapsedSeconds - itr->second.lastAccessed))
-                {
-                    keysToDelete[keysToDeleteCount] = key;
-                    keysToDeleteCount++;
-                }
+                if(!itr->second.data || itr->second.data.GetCounter()->GetReferenceCount() == 1)
+                    m_EvictionCandidates.push_back(itr);
             }
 
-            for(std::size_t i = 0; i < keysToDeleteCount; i++)
+            std::sort(m_EvictionCandidates.begin(), m_EvictionCandidates.end(), [](const typename MapType::iterator& a, const typename MapType::iterator& b)
+                      { return a->second.lastAccessed < b->second.lastAccessed; });
+
+            for(auto& itr : m_EvictionCandidates)
             {
-                m_NameResourceMap.erase(keysToDelete[i]);
+                if(!IsOverBudget())
+                    break;
+
+                m_Stats.CPUBytes -= itr->second.cost.CPUBytes;
+                m_Stats.GPUBytes -= itr->second.cost.GPUBytes;
+                m_Stats.Evictions++;
+
+                if(m_ReleaseFunc)
+                    m_ReleaseFunc(itr->second.data);
+
+                m_NameResourceMap.erase(itr);
             }
+
+            m_EvictionCandidates.clear();
+        }
+
+        void SetBudget(uint64_t cpuBytes, uint64_t gpuBytes)
+        {
+            m_CPUBudget = cpuBytes;
+            m_GPUBudget = gpuBytes;
+        }
+
+        uint64_t GetCPUBudget() const { return m_CPUBudget; }
+        uint64_t GetGPUBudget() const { return m_GPUBudget; }
+        const ResourceStats& GetStats() const { return m_Stats; }
+        size_t GetResourceCount() const { return m_NameResourceMap.size(); }
+
+        bool IsOverBudget() const
+        {
+            return (m_CPUBudget > 0 && m_Stats.CPUBytes > m_CPUBudget) || (m_GPUBudget > 0 && m_Stats.GPUBytes > m_GPUBudget);
+        }
+
+        void RefreshCost(const IDType& name)
+        {
+            typename MapType::iterator itr = m_NameResourceMap.find(name);
+            if(itr != m_NameResourceMap.end())
+                RefreshCost(itr->second);
         }
 
         bool ReloadResources()
@@ -151,6 +215,7 @@ namespace Lumos
                 {
                     LUMOS_LOG_ERROR("Resource Manager could not reload resource name {0} of type {1}", itr->first, typeid(T).name());
                 }
+                RefreshCost(itr->second);
                 ++itr;
             }
             return true;
@@ -170,14 +235,32 @@ namespace Lumos
         LoadFunc& LoadFunction() { return m_LoadFunc; }
         ReleaseFunc& ReleaseFunction() { return m_ReleaseFunc; }
         ReloadFunc& ReloadFunction() { return m_ReloadFunc; }
+        CostFunc& CostFunction() { return m_CostFunc; }
 
     protected:
+        void RefreshCost(Resource& resource)
+        {
+            if(!m_CostFunc)
+                return;
+
+            m_Stats.CPUBytes -= resource.cost.CPUBytes;
+            m_Stats.GPUBytes -= resource.cost.GPUBytes;
+            resource.cost = resource.data ? m_CostFunc(resource.data) : ResourceCost();
+            m_Stats.CPUBytes += resource.cost.CPUBytes;
+            m_Stats.GPUBytes += resource.cost.GPUBytes;
+        }
+
         MapType m_NameResourceMap = {};
         LoadFunc m_LoadFunc;
         ReleaseFunc m_ReleaseFunc;
         ReloadFunc m_ReloadFunc;
         GetIdFunc m_GetIdFunc;
-        float m_ExpirationTime = 3.0f;
+        CostFunc m_CostFunc;
+
+        uint64_t m_CPUBudget = 0;
+        uint64_t m_GPUBudget = 0;
+        ResourceStats m_Stats;
+        std::vector<typename MapType::iterator> m_EvictionCandidates;
     };
 
     class ShaderLibrary : public ResourceManager<Graphics::Shader>
@@ -204,13 +287,22 @@ namespace Lumos
     public:
         TextureLibrary()
         {
-            m_LoadFunc = Load;
+            m_LoadFunc = [this](const std::string& filePath, SharedPtr<Graphics::Texture2D>& texture)
+            { return Load(filePath, texture); };
+            m_CostFunc = Cost;
+            m_Handle   = CreateSharedPtr<TextureLibrary*>(this);
+            SetBudget(0, 512ull * 1024 * 1024);
         }
         ~TextureLibrary();
 
-        static bool Load(const std::string& filePath, SharedPtr<Graphics::Texture2D>& texture);
+        // Loads on a worker thread and refreshes the cost once the texture is uploaded
+        bool Load(const std::string& filePath, SharedPtr<Graphics::Texture2D>& texture);
+        static ResourceCost Cost(const SharedPtr<Graphics::Texture2D>& texture);
 
         void Destroy() override;
+
+    private:
+        SharedPtr<TextureLibrary*> m_Handle;
     };
 
     class ModelLibrary : public ResourceManager<Graphics::Model>
@@ -219,10 +311,13 @@ namespace Lumos
         ModelLibrary()
         {
             m_LoadFunc = Load;
+            m_CostFunc = Cost;
+            SetBudget(256ull * 1024 * 1024, 256ull * 1024 * 1024);
         }
         ~ModelLibrary();
 
         static bool Load(const std::string& filePath, SharedPtr<Graphics::Model>& model);
+        static ResourceCost Cost(const SharedPtr<Graphics::Model>& model);
     };
 
     class FontLibrary : public ResourceManager<Graphics::Font>
@@ -231,6 +326,8 @@ namespace Lumos
         FontLibrary()
         {
             m_LoadFunc = Load;
+            m_CostFunc = Cost;
+            SetBudget(0, 64ull * 1024 * 1024);
         }
 
         ~FontLibrary()
@@ -242,5 +339,10 @@ namespace Lumos
             font = CreateSharedPtr<Graphics::Font>(filePath);
             return true;
         }
+
+        static ResourceCost Cost(const SharedPtr<Graphics::Font>& font)
+        {
+            return font->GetFontAtlas() ? TextureLibrary::Cost(font->GetFontAtlas()) : ResourceCost();
+        }
     };
 }
@@ -13,4 +13,16 @@ namespace Lumos
         seed ^= hasher(v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
         HashCombine(seed, rest...);
     }
+
+    // FNV-1a over raw bytes, stable across runs so it can key data on disk
+    inline uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 14695981039346656037ull)
+    {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        for(size_t i = 0; i < size; i++)
+        {
+            seed ^= bytes[i];
+            seed *= 1099511628211ull;
+        }
+        return seed;
+    }
 }
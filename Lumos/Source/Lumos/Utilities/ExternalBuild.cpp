@@ -3,6 +3,11 @@
 #pragma warning(push, 0)
 #include <Tracy/TracyClient.cpp>
 
+// LZ4 is built as part of the Tracy client, pack files still need it when profiling is disabled
+#ifndef TRACY_ENABLE
+#include <Tracy/common/tracy_lz4.cpp>
+#endif
+
 #ifdef LUMOS_RENDER_API_OPENGL
 #include <glad/src/glad.c>
 #endif
@@ -19,27 +19,33 @@ namespace Lumos
     uint8_t* LoadImageFromFile(const char* filename, uint32_t* width, uint32_t* height, uint32_t* bits, bool* isHDR, bool flipY, bool srgb)
     {
         LUMOS_PROFILE_FUNCTION();
-        std::string filePath = std::string(filename);
-        std::string physicalPath;
-        if(!VFS::Get().ResolvePhysicalPath(filePath, physicalPath))
+        // Decoded straight from the pack or a mapping of the file
+        VFSFile file;
+        if(!VFS::Get().MapFile(filename, file))
             return nullptr;
 
-        filename = physicalPath.c_str();
+        return LoadImageFromMemory(file.Data, file.Size, filename, width, height, bits, isHDR);
+    }
+
+    uint8_t* LoadImageFromMemory(const uint8_t* data, int64_t dataSize, const char* name, uint32_t* width, uint32_t* height, uint32_t* bits, bool* isHDR)
+    {
+        LUMOS_PROFILE_FUNCTION();
+        const int fileSize = int(dataSize);
 
         int texWidth = 0, texHeight = 0, texChannels = 0;
         stbi_uc* pixels   = nullptr;
         int sizeOfChannel = 8;
-        if(stbi_is_hdr(filename))
+        if(stbi_is_hdr_from_memory(data, fileSize))
         {
             sizeOfChannel = 32;
-            pixels        = (uint8_t*)stbi_loadf(filename, &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
+            pixels        = (uint8_t*)stbi_loadf_from_memory(data, fileSize, &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
 
             if(isHDR)
                 *isHDR = true;
         }
         else
         {
-            pixels = stbi_load(filename, &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
+            pixels = stbi_load_from_memory(data, fileSize, &texWidth, &texHeight, &texChannels, STBI_rgb_alpha);
 
             if(isHDR)
                 *isHDR = false;
@@ -47,7 +53,7 @@ namespace Lumos
 
         if(!pixels)
         {
-            LUMOS_LOG_ERROR("Could not load image '{0}'!", filename);
+            LUMOS_LOG_ERROR("Could not load image '{0}'!", name);
             // Return magenta checkerboad image
 
             texChannels = 4;
@@ -4,4 +4,7 @@ namespace Lumos
 {
     LUMOS_EXPORT uint8_t* LoadImageFromFile(const char* filename, uint32_t* width = nullptr, uint32_t* height = nullptr, uint32_t* bits = nullptr, bool* isHDR = nullptr, bool flipY = false, bool srgb = true);
     LUMOS_EXPORT uint8_t* LoadImageFromFile(const std::string& filename, uint32_t* width = nullptr, uint32_t* height = nullptr, uint32_t* bits = nullptr, bool* isHDR = nullptr, bool flipY = false, bool srgb = true);
+
+    // Decodes an encoded image already in memory, name is only used for logging
+    LUMOS_EXPORT uint8_t* LoadImageFromMemory(const uint8_t* data, int64_t dataSize, const char* name, uint32_t* width = nullptr, uint32_t* height = nullptr, uint32_t* bits = nullptr, bool* isHDR = nullptr);
 }
@@ -0,0 +1,84 @@
+#include <Lumos/Core/Core.h>
+#include <Lumos/Core/LMLog.h>
+#include <Lumos/Core/PackFile.h>
+#include <Lumos/Core/OS/FileSystem.h>
+
+#include <filesystem>
+
+// Builds a pack file from a project's Assets folder.
+// Usage : LumosPack <assets folder> <output .lpak> [--store | --lz4 | --deflate]
+
+using namespace Lumos;
+
+int main(int argc, char** argv)
+{
+    Debug::Log::OnInit();
+
+    if(argc < 3)
+    {
+        LUMOS_LOG_INFO("Usage : LumosPack <assets folder> <output .lpak> [--store | --lz4 | --deflate]");
+        Debug::Log::OnRelease();
+        return 1;
+    }
+
+    std::filesystem::path assetsFolder = argv[1];
+    std::string outputPath             = argv[2];
+    PackCompression compression        = PackCompression::LZ4;
+
+    for(int i = 3; i < argc; i++)
+    {
+        std::string option = argv[i];
+        if(option == "--store")
+            compression = PackCompression::None;
+        else if(option == "--lz4")
+            compression = PackCompression::LZ4;
+        else if(option == "--deflate")
+            compression = PackCompression::Deflate;
+        else
+            LUMOS_LOG_WARN("Unknown option {0}", option);
+    }
+
+    if(!std::filesystem::is_directory(assetsFolder))
+    {
+        LUMOS_LOG_ERROR("{0} is not a folder", assetsFolder.string());
+        Debug::Log::OnRelease();
+        return 1;
+    }
+
+    PackFileWriter writer;
+    uint64_t totalSize = 0;
+
+    for(auto& file : std::filesystem::recursive_directory_iterator(assetsFolder))
+    {
+        if(!file.is_regular_file())
+            continue;
+
+        // Skip editor side files that are never loaded at runtime
+        std::string name = file.path().filename().string();
+        if(name == ".DS_Store" || file.path().extension() == ".lpak")
+            continue;
+
+        std::string physicalPath = file.path().string();
+        std::string packPath     = std::filesystem::relative(file.path(), assetsFolder).generic_string();
+
+        int64_t size = FileSystem::GetFileSize(physicalPath);
+        std::vector<uint8_t> data(size > 0 ? size : 0);
+        if(size > 0 && !FileSystem::ReadFile(physicalPath, data.data(), size))
+        {
+            LUMOS_LOG_ERROR("Failed to read {0}", physicalPath);
+            continue;
+        }
+
+        writer.AddFile(packPath, data.data(), data.size(), compression);
+        totalSize += data.size();
+    }
+
+    bool result = writer.Write(outputPath);
+    if(result)
+        LUMOS_LOG_INFO("Packed {0} files ({1} bytes) into {2}", writer.GetEntryCount(), totalSize, outputPath);
+    else
+        LUMOS_LOG_ERROR("Failed to write {0}", outputPath);
+
+    Debug::Log::OnRelease();
+    return result ? 0 : 1;
+}
@@ -0,0 +1,112 @@
+IncludeDir = {}
+IncludeDir["Lumos"] = "../../Lumos/Source"
+IncludeDir["External"] = "../../Lumos/External/"
+IncludeDir["spdlog"] = "../../Lumos/External/spdlog/include"
+IncludeDir["glm"] = "../../Lumos/External/glm"
+IncludeDir["cereal"] = "../../Lumos/External/cereal/include"
+
+-- Builds the few engine sources the packer uses instead of linking the whole engine
+project "LumosPack"
+	kind "ConsoleApp"
+	language "C++"
+	cppdialect "C++17"
+	staticruntime "Off"
+
+	files
+	{
+		"Source/**.h",
+		"Source/**.cpp",
+		"../../Lumos/Source/Lumos/Core/LMLog.cpp",
+		"../../Lumos/Source/Lumos/Core/PackFile.cpp",
+		"../../Lumos/External/Tracy/common/tracy_lz4.cpp",
+		"../../Lumos/External/OpenFBX/miniz.c"
+	}
+
+	externalincludedirs
+	{
+		"%{IncludeDir.Lumos}",
+		"%{IncludeDir.External}",
+		"%{IncludeDir.spdlog}",
+		"%{IncludeDir.glm}",
+		"%{IncludeDir.cereal}",
+	}
+
+	includedirs
+	{
+		"../../Lumos/Source/Lumos",
+	}
+
+	links
+	{
+		"spdlog"
+	}
+
+	defines
+	{
+		"SPDLOG_COMPILED_LIB"
+	}
+
+	filter "system:windows"
+		systemversion "latest"
+		conformancemode "on"
+
+		files
+		{
+			"../../Lumos/Source/Lumos/Platform/Windows/WindowsFileSystem.cpp",
+			"../../Lumos/Source/Lumos/Platform/Windows/WindowsUtilities.cpp"
+		}
+
+		defines
+		{
+			"LUMOS_PLATFORM_WINDOWS",
+			"WIN32_LEAN_AND_MEAN",
+			"_CRT_SECURE_NO_WARNINGS"
+		}
+
+	filter "system:macosx"
+		systemversion "11.0"
+
+		files
+		{
+			"../../Lumos/Source/Lumos/Platform/Unix/UnixFileSystem.cpp"
+		}
+
+		defines
+		{
+			"LUMOS_PLATFORM_MACOS",
+			"LUMOS_PLATFORM_UNIX"
+		}
+
+	filter "system:linux"
+		systemversion "latest"
+
+		files
+		{
+			"../../Lumos/Source/Lumos/Platform/Unix/UnixFileSystem.cpp"
+		}
+
+		defines
+		{
+			"LUMOS_PLATFORM_LINUX",
+			"LUMOS_PLATFORM_UNIX"
+		}
+
+		links { "pthread", "stdc++fs" }
+
+	filter "configurations:Debug"
+		defines { "LUMOS_DEBUG", "_DEBUG" }
+		symbols "On"
+		runtime "Debug"
+		optimize "Off"
+
+	filter "configurations:Release"
+		defines { "LUMOS_RELEASE", "NDEBUG" }
+		optimize "Speed"
+		symbols "On"
+		runtime "Release"
+
+	filter "configurations:Production"
+		defines { "LUMOS_PRODUCTION", "NDEBUG" }
+		symbols "Off"
+		optimize "Full"
+		runtime "Release"
@@ -85,3 +85,9 @@ SetRecommendedSettings()
 	include "Lumos/premake5"
 	include "Runtime/premake5"
 	include "Editor/premake5"
+
+	if not os.istarget(premake.IOS) and not os.istarget(premake.ANDROID) then
+		group "Tools"
+			include "Tools/LumosPack/premake5"
+		group ""
+	end